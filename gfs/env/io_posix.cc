@@ -33,9 +33,19 @@
 #include "util/coding.h"
 #include "util/string_util.h"
 #include "util/sync_point.h"
+#include "util/ThreadPool.h"
 #include "env.h"
 #include "port_posix.h"
 
+#ifdef SKG_IOURING_PRESENT
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#ifndef IORING_FEAT_SINGLE_MMAP
+#define IORING_FEAT_SINGLE_MMAP (1U << 0)  // 5.4 之前的头文件中没有
+#endif
+#endif
+
 #if defined(OS_LINUX) && !defined(F_SET_RW_HINT)
 #define F_LINUX_SPECIFIC_BASE 1024
 #define F_SET_RW_HINT         (F_LINUX_SPECIFIC_BASE + 12)
@@ -297,6 +307,186 @@ namespace skg {
     }
 #endif
 
+    namespace {
+        // 请求数不超过该值时直接在调用线程中读取, 不值得切换线程
+        const size_t kMultiReadInlineRequests = 2;
+        // MultiRead 线程池的大小, 即 pread 回退路径下最多同时在途的读请求数
+        const size_t kMultiReadThreads = 16;
+
+        ThreadPool *MultiReadThreadPool() {
+            // 不析构: 进程退出时可能还有线程在等待读取结果
+            static ThreadPool *pool = new ThreadPool(kMultiReadThreads);
+            return pool;
+        }
+
+#ifdef SKG_IOURING_PRESENT
+        /**
+         * 每个线程一个 io_uring 实例, 直接使用系统调用, 不依赖 liburing.
+         * 一次 Read 提交一批 READV 请求, 并等待这一批全部完成.
+         */
+        class IOUring {
+        public:
+            static const unsigned kQueueDepth = 256;
+
+            IOUring()
+                    : ring_fd_(-1), sq_ptr_(MAP_FAILED), cq_ptr_(MAP_FAILED), sqes_(MAP_FAILED),
+                      sq_ring_size_(0), cq_ring_size_(0), sqes_size_(0),
+                      sq_tail_(nullptr), sq_mask_(nullptr), sq_array_(nullptr),
+                      cq_head_(nullptr), cq_tail_(nullptr), cq_mask_(nullptr), cqes_(nullptr) {
+            }
+
+            ~IOUring() {
+              if (sqes_ != MAP_FAILED) { munmap(sqes_, sqes_size_); }
+              if (cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) { munmap(cq_ptr_, cq_ring_size_); }
+              if (sq_ptr_ != MAP_FAILED) { munmap(sq_ptr_, sq_ring_size_); }
+              if (ring_fd_ >= 0) { close(ring_fd_); }
+            }
+
+            bool Init() {
+              struct io_uring_params params;
+              memset(&params, 0, sizeof(params));
+              ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, kQueueDepth, &params));
+              if (ring_fd_ < 0) { return false; }
+              sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+              cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+              const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+              if (single_mmap) {
+                sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+              }
+              sq_ptr_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+              if (sq_ptr_ == MAP_FAILED) { return false; }
+              if (single_mmap) {
+                cq_ptr_ = sq_ptr_;
+              } else {
+                cq_ptr_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                               MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+                if (cq_ptr_ == MAP_FAILED) { return false; }
+              }
+              sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+              sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+              if (sqes_ == MAP_FAILED) { return false; }
+
+              char *sq = static_cast<char *>(sq_ptr_);
+              sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+              sq_mask_ = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+              sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+              char *cq = static_cast<char *>(cq_ptr_);
+              cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+              cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+              cq_mask_ = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+              cqes_ = reinterpret_cast<struct io_uring_cqe *>(cq + params.cq_off.cqes);
+              return true;
+            }
+
+            /**
+             * 提交 reqs[0, n) 并等待全部完成, n <= kQueueDepth.
+             * 返回 false 表示 io_uring 不可用, 所有请求都没有被读取.
+             * 每个请求的结果放在 res[i]: 读取的字节数, 或 -errno
+             */
+            bool ReadBatch(int fd, const ReadRequest *reqs, size_t n, int *res) {
+              assert(n <= kQueueDepth);
+              iovecs_.resize(n);
+              const unsigned mask = *sq_mask_;
+              const unsigned tail = __atomic_load_n(sq_tail_, __ATOMIC_RELAXED);
+              struct io_uring_sqe *sqes = static_cast<struct io_uring_sqe *>(sqes_);
+              for (size_t i = 0; i < n; ++i) {
+                iovecs_[i].iov_base = reqs[i].scratch;
+                iovecs_[i].iov_len = reqs[i].len;
+                const unsigned index = (tail + i) & mask;
+                struct io_uring_sqe *sqe = &sqes[index];
+                memset(sqe, 0, sizeof(*sqe));
+                sqe->opcode = IORING_OP_READV;
+                sqe->fd = fd;
+                sqe->addr = reinterpret_cast<uint64_t>(&iovecs_[i]);
+                sqe->len = 1;
+                sqe->off = reqs[i].offset;
+                sqe->user_data = i;
+                sq_array_[index] = index;
+              }
+              __atomic_store_n(sq_tail_, tail + static_cast<unsigned>(n), __ATOMIC_RELEASE);
+
+              size_t submitted = 0;
+              while (submitted < n) {
+                unsigned to_submit = static_cast<unsigned>(n - submitted);
+                int inject_errno = 0;
+                // 测试用: 限制一次提交的请求数, 或让这一次提交失败, 以覆盖撤回未提交请求的路径
+                TEST_SYNC_POINT_CALLBACK("IOUring::ReadBatch:ToSubmit", &to_submit);
+                TEST_SYNC_POINT_CALLBACK("IOUring::ReadBatch:InjectError", &inject_errno);
+                long ret;
+                if (inject_errno != 0) {
+                  errno = inject_errno;
+                  ret = -1;
+                } else {
+                  ret = syscall(__NR_io_uring_enter, ring_fd_, to_submit, 0, 0, nullptr, 0);
+                }
+                if (ret < 0) {
+                  if (errno == EINTR || errno == EAGAIN) { continue; }
+                  // 撤回未被内核取走的请求. 已经提交的请求仍然需要收割
+                  const int err = errno;
+                  __atomic_store_n(sq_tail_, tail + static_cast<unsigned>(submitted), __ATOMIC_RELEASE);
+                  if (submitted == 0) { return false; }
+                  for (size_t i = submitted; i < n; ++i) { res[i] = -err; }
+                  n = submitted;
+                  break;
+                }
+                submitted += static_cast<size_t>(ret);
+              }
+
+              size_t completed = 0;
+              while (completed < n) {
+                unsigned head = __atomic_load_n(cq_head_, __ATOMIC_RELAXED);
+                const unsigned cq_tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+                if (head == cq_tail) {
+                  // 等待至少一个请求完成. 请求还在内核中, 出错时也只能继续等待
+                  syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                  continue;
+                }
+                for (; head != cq_tail; ++head) {
+                  const struct io_uring_cqe &cqe = cqes_[head & *cq_mask_];
+                  res[cqe.user_data] = cqe.res;
+                  ++completed;
+                }
+                __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+              }
+              return true;
+            }
+
+        private:
+            int ring_fd_;
+            void *sq_ptr_;
+            void *cq_ptr_;
+            void *sqes_;
+            size_t sq_ring_size_;
+            size_t cq_ring_size_;
+            size_t sqes_size_;
+            unsigned *sq_tail_;
+            unsigned *sq_mask_;
+            unsigned *sq_array_;
+            unsigned *cq_head_;
+            unsigned *cq_tail_;
+            unsigned *cq_mask_;
+            struct io_uring_cqe *cqes_;
+            std::vector<struct iovec> iovecs_;
+        };
+
+        // 当前线程的 io_uring. 内核不支持 (或被 seccomp 禁止) 时返回 nullptr
+        IOUring *ThreadLocalIOUring() {
+          static thread_local std::unique_ptr<IOUring> ring;
+          static thread_local bool unavailable = false;
+          if (!ring && !unavailable) {
+            ring.reset(new IOUring());
+            if (!ring->Init()) {
+              ring.reset();
+              unavailable = true;
+            }
+          }
+          return ring.get();
+        }
+#endif
+    }
+
     /*
      * PosixRandomAccessFile
      *
@@ -353,6 +543,74 @@ namespace skg {
       return s;
     }
 
+    void PosixRandomAccessFile::ReadRange(ReadRequest *reqs, size_t begin, size_t end) const {
+      for (size_t i = begin; i < end; ++i) {
+        ReadRequest &req = reqs[i];
+        req.status = Read(req.offset, req.len, &req.result, req.scratch);
+      }
+    }
+
+    Status PosixRandomAccessFile::MultiRead(ReadRequest *reqs, size_t num_reqs) {
+      assert(reqs != nullptr);
+      if (num_reqs <= kMultiReadInlineRequests) {
+        ReadRange(reqs, 0, num_reqs);
+        return Status::OK();
+      }
+#ifdef SKG_IOURING_PRESENT
+      bool use_io_uring = true;
+      // 测试用: 关闭 io_uring, 覆盖线程池回退路径
+      TEST_SYNC_POINT_CALLBACK("PosixRandomAccessFile::MultiRead:UseIOUring", &use_io_uring);
+      IOUring *ring = use_io_uring ? ThreadLocalIOUring() : nullptr;
+      if (ring != nullptr) {
+        int res[IOUring::kQueueDepth];
+        for (size_t begin = 0; begin < num_reqs; begin += IOUring::kQueueDepth) {
+          const size_t n = std::min<size_t>(num_reqs - begin, IOUring::kQueueDepth);
+          if (!ring->ReadBatch(fd_, reqs + begin, n, res)) {
+            ReadRange(reqs, begin, num_reqs);
+            return Status::OK();
+          }
+          // 测试用: 修改这一批第一个请求的结果, 模拟文件中间的短读
+          TEST_SYNC_POINT_CALLBACK("PosixRandomAccessFile::MultiRead:IOUringResult", res);
+          for (size_t i = 0; i < n; ++i) {
+            ReadRequest &req = reqs[begin + i];
+            if (res[i] < 0) {
+              req.status = IOError(
+                      "While io_uring read offset " + ToString(req.offset) + " len " + ToString(req.len),
+                      filename_, -res[i]);
+              req.result = Slice(req.scratch, 0);
+              continue;
+            }
+            const size_t nread = static_cast<size_t>(res[i]);
+            req.status = Status::OK();
+            req.result = Slice(req.scratch, nread);
+            if (nread > 0 && nread < req.len) {
+              // 短读: 剩余部分用 pread 补齐, 到达文件末尾时 result 比 len 短
+              Slice rest;
+              req.status = Read(req.offset + nread, req.len - nread, &rest, req.scratch + nread);
+              req.result = Slice(req.scratch, nread + rest.size());
+            }
+          }
+        }
+        return Status::OK();
+      }
+#endif
+      // 回退: 请求平均分给线程池, 调用线程读取第一段
+      const size_t num_tasks = std::min(num_reqs, kMultiReadThreads);
+      std::vector<std::future<void>> futures;
+      futures.reserve(num_tasks - 1);
+      for (size_t t = 1; t < num_tasks; ++t) {
+        const size_t begin = num_reqs * t / num_tasks;
+        const size_t end = num_reqs * (t + 1) / num_tasks;
+        futures.emplace_back(MultiReadThreadPool()->enqueue(
+                [this, reqs, begin, end]() { ReadRange(reqs, begin, end); }));
+      }
+      ReadRange(reqs, 0, num_reqs / num_tasks);
+      for (auto &f : futures) {
+        f.get();
+      }
+      return Status::OK();
+    }
+
     Status PosixRandomAccessFile::Prefetch(uint64_t offset, size_t n) {
       Status s;
       if (!use_direct_io()) {
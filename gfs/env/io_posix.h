@@ -77,6 +77,10 @@ namespace skg {
         virtual Status Read(uint64_t offset, size_t n, Slice *result,
                             char *scratch) const override;
 
+        // 定义 SKG_IOURING_PRESENT 时通过 io_uring 一次提交全部请求,
+        // 否则 (或内核不支持 io_uring 时) 在专用线程池中并发 pread
+        virtual Status MultiRead(ReadRequest *reqs, size_t num_reqs) override;
+
         virtual Status Prefetch(uint64_t offset, size_t n) override;
 
 #if defined(OS_LINUX) || defined(OS_MACOSX) || defined(OS_AIX)
@@ -94,6 +98,10 @@ namespace skg {
         virtual size_t GetRequiredBufferAlignment() const override {
             return logical_sector_size_;
         }
+
+    private:
+        // 在调用线程中顺序读取 reqs[begin, end)
+        void ReadRange(ReadRequest *reqs, size_t begin, size_t end) const;
     };
 
     class PosixWritableFile : public WritableFile {
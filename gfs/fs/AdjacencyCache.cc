@@ -0,0 +1,126 @@
+#include "AdjacencyCache.h"
+#include "IRequest.h"
+
+namespace skg {
+
+    AdjacencyCache::AdjacencyCache(size_t budget_mb, size_t min_degree, metrics *m)
+            : m_budget_bytes(budget_mb * 1024 * 1024),
+              m_min_degree(min_degree),
+              m_metrics(m),
+              m_mutex(),
+              m_epoch(0),
+              m_lru(), m_index(), m_misses(),
+              m_bytes(0),
+              m_nhit(0), m_nmiss(0) {
+    }
+
+    bool AdjacencyCache::Get(vid_t vid, bool in_edges, ssize_t limit, VertexQueryResult *result) {
+        std::shared_ptr<const NeighborList> list;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto iter = m_index.find(Key(vid, in_edges));
+            if (iter != m_index.end()) {
+                // 移到表头
+                m_lru.splice(m_lru.begin(), m_lru, iter->second);
+                list = iter->second->list;
+            }
+        }
+        if (!list) {
+            ++m_nmiss;
+            if (m_metrics != nullptr) { m_metrics->add("AdjacencyCache.miss", 1.0); }
+            return false;
+        }
+        ++m_nhit;
+        if (m_metrics != nullptr) { m_metrics->add("AdjacencyCache.hit", 1.0); }
+
+        size_t n = list->vids.size();
+        if (limit != IRequest::NO_LIMIT) {
+            n = std::min<size_t>(n, static_cast<size_t>(std::max<ssize_t>(limit, 0)));
+        }
+        result->m_vertices.reserve(result->m_vertices.size() + n);
+        size_t pos = 0;
+        for (const auto &run : list->tag_runs) {
+            if (pos >= n) { break; }
+            const size_t len = std::min<size_t>(run.second, n - pos);
+            result->Receive(run.first, list->vids.data() + pos, len);
+            pos += len;
+        }
+        return true;
+    }
+
+    void AdjacencyCache::Put(vid_t vid, bool in_edges, uint64_t epoch, const VertexQueryResult &neighbors) {
+        const Key key(vid, in_edges);
+        const size_t degree = neighbors.m_vertices.size();
+        if (degree < m_min_degree) {
+            // 度较小的节点, 多次未命中之后才缓存
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_misses.size() >= MAX_TRACKED_MISSES) { m_misses.clear(); }
+            uint32_t &nmiss = m_misses[key];
+            if (++nmiss < ADMIT_AFTER_MISSES) { return; }
+            m_misses.erase(key);
+        }
+
+        std::shared_ptr<NeighborList> list = std::make_shared<NeighborList>();
+        list->vids.reserve(degree);
+        for (const auto &v : neighbors.m_vertices) {
+            list->vids.push_back(v.m_vertex);
+            if (list->tag_runs.empty() || list->tag_runs.back().first != v.tag) {
+                list->tag_runs.emplace_back(v.tag, 0);
+            }
+            ++list->tag_runs.back().second;
+        }
+        list->tag_runs.shrink_to_fit();
+        const size_t bytes = list->MemoryUsage();
+        if (bytes > m_budget_bytes) { return; }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // 查询期间有写入, 列表可能已经过期
+        if (epoch != m_epoch.load(std::memory_order_relaxed)) { return; }
+        EraseUnlocked(key);
+        while (!m_lru.empty() && m_bytes + bytes > m_budget_bytes) {
+            EraseUnlocked(m_lru.back().key);
+        }
+        m_lru.push_front(Entry{key, std::move(list), bytes});
+        m_index[key] = m_lru.begin();
+        m_bytes += bytes;
+    }
+
+    void AdjacencyCache::Invalidate(vid_t vid) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_epoch.fetch_add(1, std::memory_order_release);
+        EraseUnlocked(Key(vid, true));
+        EraseUnlocked(Key(vid, false));
+    }
+
+    void AdjacencyCache::Clear() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_epoch.fetch_add(1, std::memory_order_release);
+        m_lru.clear();
+        m_index.clear();
+        m_misses.clear();
+        m_bytes = 0;
+    }
+
+    void AdjacencyCache::ReportMetrics() {
+        if (m_metrics == nullptr) { return; }
+        const uint64_t nhit = m_nhit.load(), nmiss = m_nmiss.load();
+        size_t nentries = 0, nbytes = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            nentries = m_index.size();
+            nbytes = m_bytes;
+        }
+        m_metrics->set("AdjacencyCache.hit_rate", nhit + nmiss == 0 ? 0.0 : static_cast<double>(nhit) / (nhit + nmiss));
+        m_metrics->set("AdjacencyCache.entries", nentries);
+        m_metrics->set("AdjacencyCache.bytes", nbytes);
+    }
+
+    void AdjacencyCache::EraseUnlocked(const Key &key) {
+        auto iter = m_index.find(key);
+        if (iter == m_index.end()) { return; }
+        m_bytes -= iter->second->bytes;
+        m_lru.erase(iter->second);
+        m_index.erase(iter);
+    }
+
+}
@@ -0,0 +1,120 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_ADJACENCYCACHE_H
+#define STARKNOWLEDGEGRAPHDATABASE_ADJACENCYCACHE_H
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "util/types.h"
+#include "metrics/metrics.hpp"
+#include "VertexQueryResult.h"
+
+namespace skg {
+
+    /**
+     * @brief 热点节点的邻居列表缓存.
+     *
+     * 缓存的是所有 ShardTree 合并之后 (磁盘 + MemTable) 的完整邻居列表, 按存储层的方向区分入/出.
+     * 邻居按 vid 数组存放, 邻居的类型按连续相同的段存放.
+     * 度不小于 min_degree 的节点第一次查询即缓存; 度较小的节点在多次未命中之后才缓存.
+     * 按 LRU 淘汰, 总内存不超过 budget_mb.
+     *
+     * 写入边时由 SkgDBImpl 调用 Invalidate. 为避免查询与写入并发时缓存旧的列表,
+     * 查询前通过 GetEpoch 取得版本, Put 时版本已变化则放弃写入缓存.
+     */
+    class AdjacencyCache {
+    public:
+        // 度较小的节点, 未命中多少次之后缓存
+        static const uint32_t ADMIT_AFTER_MISSES = 4;
+        // 统计未命中次数的节点数上限, 超过后清空重新统计
+        static const size_t MAX_TRACKED_MISSES = 64 * 1024;
+
+        struct NeighborList {
+            std::vector<vid_t> vids;
+            // (tag, 连续的个数)
+            std::vector<std::pair<EdgeTag_t, uint32_t>> tag_runs;
+
+            size_t MemoryUsage() const {
+                return sizeof(NeighborList)
+                       + vids.capacity() * sizeof(vid_t)
+                       + tag_runs.capacity() * sizeof(std::pair<EdgeTag_t, uint32_t>);
+            }
+        };
+
+    public:
+        AdjacencyCache(size_t budget_mb, size_t min_degree, metrics *m);
+
+        uint64_t GetEpoch() const {
+            return m_epoch.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief 命中时把邻居加入 result (最多 limit 个), 返回 true
+         */
+        bool Get(vid_t vid, bool in_edges, ssize_t limit, VertexQueryResult *result);
+
+        /**
+         * @brief 查询得到的完整邻居列表. epoch 为查询前 GetEpoch 的返回值
+         */
+        void Put(vid_t vid, bool in_edges, uint64_t epoch, const VertexQueryResult &neighbors);
+
+        /**
+         * @brief 节点的边发生变化, 删除节点两个方向的缓存
+         */
+        void Invalidate(vid_t vid);
+
+        void Clear();
+
+        /**
+         * @brief 命中率, 条目数, 内存占用写入 metrics
+         */
+        void ReportMetrics();
+
+    private:
+        typedef std::pair<vid_t, bool> Key;
+
+        struct KeyHash {
+            size_t operator()(const Key &key) const {
+                return std::hash<vid_t>()(key.first) * 2 + (key.second ? 1 : 0);
+            }
+        };
+
+        struct Entry {
+            Key key;
+            std::shared_ptr<const NeighborList> list;
+            size_t bytes;
+        };
+
+        typedef std::list<Entry>::iterator EntryIter;
+
+        void EraseUnlocked(const Key &key);
+
+    private:
+        const size_t m_budget_bytes;
+        const size_t m_min_degree;
+        metrics *m_metrics;
+
+        std::mutex m_mutex;
+        std::atomic<uint64_t> m_epoch;
+        // 表头为最近使用的
+        std::list<Entry> m_lru;
+        std::unordered_map<Key, EntryIter, KeyHash> m_index;
+        std::unordered_map<Key, uint32_t, KeyHash> m_misses;
+        size_t m_bytes;
+
+        std::atomic<uint64_t> m_nhit;
+        std::atomic<uint64_t> m_nmiss;
+
+    public:
+        // no copying allow
+        AdjacencyCache(const AdjacencyCache &) = delete;
+        AdjacencyCache &operator=(const AdjacencyCache &) = delete;
+    };
+
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_ADJACENCYCACHE_H
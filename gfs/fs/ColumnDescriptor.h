@@ -13,6 +13,8 @@ namespace skg {
         static const int32_t ID_INVALID = -1;
         static const int32_t ID_VERTICES_TAG = -2;
         static const int32_t ID_VERTICES_BITSET = -3;
+        static const int32_t ID_VERTICES_IN_DEGREE = -4;
+        static const int32_t ID_VERTICES_OUT_DEGREE = -5;
     public:
         ColumnDescriptor();
 
@@ -66,6 +66,25 @@ private:
     std::shared_ptr<SubEdgePartitionWithMemTable> m_partition;
 };
 
+/**
+ * 重写 sub-partition 的磁盘数据, 去除已删除的边及其属性
+ */
+class TombstoneCompaction : public Compaction {
+public:
+    TombstoneCompaction(const SubEdgePartitionPtr &partition) : m_partition(partition) {
+    }
+
+    Status Run() override {
+        if (!m_partition->IsNeedReclaim()) {
+            return Status::OK();
+        }
+        return m_partition->ReclaimDeadEdges();
+    }
+
+private:
+    SubEdgePartitionPtr m_partition;
+};
+
 class LevelCompaction : public Compaction {
 public:
 
@@ -90,8 +109,10 @@ public:
         if (!s.ok()) { return s; }
         // TODO 获取 Partition 的写锁
 
-        // 读入 Partition 的所有边 && 属性数据
-        std::vector<MemoryEdge> edges = m_partition->LoadAllEdges();
+        // 读入 Partition 的所有边 && 属性数据. 读取失败时不能清空原来的数据
+        std::vector<MemoryEdge> edges;
+        s = m_partition->LoadAllEdges(&edges);
+        if (!s.ok()) { return s; }
         // 按dst排序
         std::sort(edges.begin(), edges.end(), MemoryEdgeDstLessFunc());
         // 去除重复边
@@ -165,8 +186,12 @@ public:
         if (!s.ok()) { return s;}
         // TODO 获取 Partition 的写锁
 
-        // 读入 Partition 的所有边 && 属性数据
-        std::vector<MemoryEdge> edges = m_partition->LoadAllEdges();
+        // 读入 Partition 的所有边 && 属性数据. 读取失败时不能清空原来的数据
+        std::vector<MemoryEdge> edges;
+        s = m_partition->LoadAllEdges(&edges);
+        if (!s.ok()) { return s; }
+        // 已经没有存活的边, 不拆分
+        if (edges.empty()) { return s; }
         // 按dst排序
         std::sort(edges.begin(), edges.end(), MemoryEdgeDstLessFunc());
         // 去除重复边
@@ -187,6 +212,9 @@ public:
 
     Status SplitShard(std::vector<MemoryEdge> &&edges) {
         Status s;
+        if (edges.empty()) {
+            return Status::InvalidArgument(fmt::format("no edges to split partition[{}]", m_partition->GetInterval()));
+        }
         const size_t num_children_to_split = m_options.shard_split_factor;
         size_t num_created_child = 0;
         // 每个子区间至少的边数
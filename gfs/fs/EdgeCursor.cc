@@ -0,0 +1,90 @@
+#include <cinttypes>
+#include <cstdio>
+
+#include "fmt/format.h"
+
+#include "EdgeCursor.h"
+#include "ShardTree.h"
+
+namespace skg {
+
+    EdgeCursor::EdgeCursor(const std::vector<std::shared_ptr<ShardTree>> &trees,
+                           const VertexRequest &req, bool in_edges, size_t batch_size,
+                           const std::shared_ptr<IDEncoder> &encoder,
+                           const MetaHeterogeneousAttributes &attributes)
+            : m_trees(trees), m_req(req), m_in_edges(in_edges),
+              m_batch_size(batch_size == 0 ? DEFAULT_BATCH_SIZE : batch_size),
+              m_encoder(encoder), m_attributes(attributes),
+              m_pos(), m_nreceived(0), m_done(false) {
+    }
+
+    Status EdgeCursor::Next(EdgesQueryResult *batch) {
+        assert(batch != nullptr);
+        batch->Clear();
+        Status s;
+        if (m_done) { return s; }
+
+        // 本批最多读取的边数
+        size_t room = m_batch_size;
+        if (m_req.GetLimit() != IRequest::NO_LIMIT) {
+            const uint64_t nlimit = static_cast<uint64_t>(m_req.GetLimit());
+            room = std::min<uint64_t>(room, nlimit > m_nreceived ? nlimit - m_nreceived : 0);
+        }
+        if (room == 0) {
+            m_done = true;
+            return s;
+        }
+        batch->m_nlimit = room;
+
+        while (m_pos.tree < m_trees.size()) {
+            const auto &tree = m_trees[m_pos.tree];
+            bool finished = true;
+            // in-edges 仅存在于一个 ShardTree 中
+            if (!m_in_edges || tree->GetInterval().Contain(m_req.GetVid())) {
+                s = tree->ScanEdgesFrom(m_req, m_in_edges, &m_pos, batch, &finished);
+                if (!s.ok()) { return s; }
+            }
+            if (!finished) { break; }  // 本批已满
+            m_pos.NextTree();
+        }
+        m_nreceived += batch->Size();
+        m_done = m_pos.tree >= m_trees.size();
+
+        // 组织回包数据. long-id 转换为 string-id
+        s = batch->TranslateEdgeVertex(m_encoder);
+        if (!s.ok()) { return s; }
+        return batch->SetResultMetadata(m_attributes);
+    }
+
+    std::string EdgeCursor::GetToken() const {
+        return fmt::format("{}:{}:{}:{}:{}:{}:{}:{}",
+                           m_req.GetVid(), m_in_edges ? 1 : 0,
+                           m_pos.tree, m_pos.partition, m_pos.subpartition,
+                           m_pos.stage, m_pos.offset, m_nreceived);
+    }
+
+    Status EdgeCursor::Seek(const std::string &token) {
+        uint64_t vid = 0, in_edges = 0, tree = 0, partition = 0, subpartition = 0, stage = 0;
+        uint64_t offset = 0, nreceived = 0;
+        const int n = sscanf(token.c_str(),
+                             "%" SCNu64 ":%" SCNu64 ":%" SCNu64 ":%" SCNu64 ":%" SCNu64 ":%" SCNu64 ":%" SCNu64 ":%" SCNu64,
+                             &vid, &in_edges, &tree, &partition, &subpartition, &stage, &offset, &nreceived);
+        if (n != 8 || stage > EdgeScanPosition::SCAN_DISK) {
+            return Status::InvalidArgument(fmt::format("invalid edge cursor token: `{}'", token));
+        }
+        if (vid != m_req.GetVid() || (in_edges != 0) != m_in_edges) {
+            return Status::InvalidArgument(fmt::format(
+                    "edge cursor token: `{}' does not belong to [{}:{}]",
+                    token, m_req.GetLabel(), m_req.GetVertex()));
+        }
+        m_pos.tree = static_cast<uint32_t>(tree);
+        m_pos.partition = static_cast<uint32_t>(partition);
+        m_pos.subpartition = static_cast<uint32_t>(subpartition);
+        m_pos.stage = static_cast<uint32_t>(stage);
+        m_pos.offset = offset;
+        m_nreceived = nreceived;
+        m_done = m_pos.tree >= m_trees.size();
+        return Status::OK();
+    }
+
+}
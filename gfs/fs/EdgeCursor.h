@@ -0,0 +1,143 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_EDGECURSOR_H
+#define STARKNOWLEDGEGRAPHDATABASE_EDGECURSOR_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "util/types.h"
+#include "util/status.h"
+#include "VertexRequest.h"
+#include "EdgesQueryResult.h"
+#include "MetaHeterogeneousAttributes.h"
+#include "IDEncoder.h"
+
+namespace skg {
+
+    class ShardTree;
+
+    enum class EdgeDirection : uint32_t {
+        IN = 0,
+        OUT = 1,
+    };
+
+    /**
+     * @brief 分批读取一个节点的边时, 在存储中的读取位置.
+     *
+     * 按 ShardTree -> partition -> sub-partition(边类型) 的顺序读取,
+     * 每个 sub-partition 先读 MemTable 中的边, 再读磁盘上的边.
+     */
+    struct EdgeScanPosition {
+        enum Stage : uint32_t {
+            SCAN_MEMTABLE = 0,
+            SCAN_DISK = 1,
+        };
+
+        uint32_t tree;
+        uint32_t partition;
+        uint32_t subpartition;
+        uint32_t stage;
+        // MemTable: 已读取的边数;
+        // 磁盘出边: 在 src 索引范围内已读取的边数; 磁盘入边: 0 表示从头读取, 否则为下一条边的 idx + 1
+        uint64_t offset;
+
+        EdgeScanPosition()
+                : tree(0), partition(0), subpartition(0),
+                  stage(SCAN_MEMTABLE), offset(0) {
+        }
+
+        void NextSubPartition() {
+            ++subpartition;
+            stage = SCAN_MEMTABLE;
+            offset = 0;
+        }
+
+        void NextPartition() {
+            ++partition;
+            subpartition = 0;
+            stage = SCAN_MEMTABLE;
+            offset = 0;
+        }
+
+        void NextTree() {
+            ++tree;
+            partition = 0;
+            subpartition = 0;
+            stage = SCAN_MEMTABLE;
+            offset = 0;
+        }
+    };
+
+    /**
+     * @brief 节点出边/入边的游标, 由 SkgDB::OpenEdgeCursor 创建.
+     *
+     * 每次 Next 只从存储中读取至多 batch_size 条边, 内存占用与节点的度无关.
+     * 读取顺序固定, 可以通过 GetToken 得到的分页 token 在新的游标中从断点继续读取.
+     * 两次读取之间 partition 发生 flush / 合并时, 断点之后的结果可能有重复或遗漏.
+     * 游标持有 ShardTree 的引用, 不能在数据库 Close 之后使用.
+     */
+    class EdgeCursor {
+    public:
+        static const size_t DEFAULT_BATCH_SIZE = 4096;
+
+    public:
+        /**
+         * @brief 清空 batch 并读取下一批边. 没有更多的边时, batch 为空
+         */
+        Status Next(EdgesQueryResult *batch);
+
+        /**
+         * @brief 是否已经读完所有的边 (或达到 request 的 limit)
+         */
+        bool Done() const {
+            return m_done;
+        }
+
+        /**
+         * @brief 已经返回的边数
+         */
+        uint64_t GetNumReceived() const {
+            return m_nreceived;
+        }
+
+        /**
+         * @brief 当前读取位置的分页 token
+         */
+        std::string GetToken() const;
+
+    private:
+        friend class SkgDBImpl;
+
+        EdgeCursor(const std::vector<std::shared_ptr<ShardTree>> &trees,
+                   const VertexRequest &req, bool in_edges, size_t batch_size,
+                   const std::shared_ptr<IDEncoder> &encoder,
+                   const MetaHeterogeneousAttributes &attributes);
+
+        /**
+         * @brief 从 token 记录的位置继续读取. token 与当前游标的节点 / 方向不符时返回 InvalidArgument
+         */
+        Status Seek(const std::string &token);
+
+    private:
+        std::vector<std::shared_ptr<ShardTree>> m_trees;
+        // 已经转换为 long-id 的请求
+        VertexRequest m_req;
+        // 存储层的方向. 定义 SKG_SRC_SPLIT_SHARD 时与请求的方向相反
+        bool m_in_edges;
+        size_t m_batch_size;
+        std::shared_ptr<IDEncoder> m_encoder;
+        MetaHeterogeneousAttributes m_attributes;
+
+        EdgeScanPosition m_pos;
+        uint64_t m_nreceived;
+        bool m_done;
+
+    public:
+        // no copying allow
+        EdgeCursor(const EdgeCursor &) = delete;
+        EdgeCursor &operator=(const EdgeCursor &) = delete;
+    };
+
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_EDGECURSOR_H
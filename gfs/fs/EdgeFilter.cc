@@ -0,0 +1,77 @@
+#include <cassert>
+#include <cstring>
+#include <ctime>
+
+#include "EdgeFilter.h"
+#include "MetaAttributes.h"
+
+namespace skg {
+
+    bool BoundEdgeFilter::Bind(const EdgeFilter &filter, const MetaAttributes &attributes) {
+        m_terms.clear();
+        if (!filter.MatchLabel(attributes.label)) { return false; }
+        for (const auto &range : filter.ranges()) {
+            const ColumnDescriptor *col = attributes.GetColumn(ColumnDescriptor(range.column, ColumnType::NONE), false);
+            // 该类边没有此属性列, 所有边的值都为 null
+            if (col == nullptr || !IsRangeColumn(col->columnType())) { return false; }
+            // 空区间
+            if (range.lower > range.upper) { return false; }
+            m_terms.push_back(Term{*col, range.lower, range.upper});
+        }
+        return true;
+    }
+
+    bool BoundEdgeFilter::IsRangeColumn(ColumnType type) {
+        switch (type) {
+            case ColumnType::WEIGHT:
+            case ColumnType::INT32:
+            case ColumnType::INT64:
+            case ColumnType::FLOAT:
+            case ColumnType::DOUBLE:
+            case ColumnType::TIME:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    double BoundEdgeFilter::ToDouble(ColumnType type, const void *bytes) {
+        // 列存储的数据不保证对齐, 通过 memcpy 读取
+        switch (type) {
+            case ColumnType::WEIGHT: {
+                EdgeWeight_t v;
+                memcpy(&v, bytes, sizeof(v));
+                return v;
+            }
+            case ColumnType::INT32: {
+                int32_t v;
+                memcpy(&v, bytes, sizeof(v));
+                return v;
+            }
+            case ColumnType::INT64: {
+                int64_t v;
+                memcpy(&v, bytes, sizeof(v));
+                return static_cast<double>(v);
+            }
+            case ColumnType::FLOAT: {
+                float v;
+                memcpy(&v, bytes, sizeof(v));
+                return v;
+            }
+            case ColumnType::DOUBLE: {
+                double v;
+                memcpy(&v, bytes, sizeof(v));
+                return v;
+            }
+            case ColumnType::TIME: {
+                time_t v;
+                memcpy(&v, bytes, sizeof(v));
+                return static_cast<double>(v);
+            }
+            default:
+                assert(false);
+                return 0;
+        }
+    }
+
+}
@@ -0,0 +1,125 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_EDGEFILTER_H
+#define STARKNOWLEDGEGRAPHDATABASE_EDGEFILTER_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "util/types.h"
+#include "ColumnDescriptor.h"
+
+namespace skg {
+
+    class MetaAttributes;
+
+    /**
+     * @brief 边的过滤条件, 在 SubEdgePartition / MemTable 扫描时求值, 不满足条件的边不会进入结果集.
+     *
+     * 所有条件之间为 AND 关系:
+     *  - 边的 label 属于 labels (为空时不限制)
+     *  - 每个范围条件对应的列有值, 且值落在闭区间 [lower, upper] 中
+     * 范围条件支持 int32/int64/float/double 列, 时间列 (按 time_t 比较) 以及边的权重
+     */
+    class EdgeFilter {
+    public:
+        struct Range {
+            std::string column;
+            double lower;
+            double upper;
+        };
+
+    public:
+        EdgeFilter() = default;
+
+        void AddLabel(const std::string &edge_label) {
+            m_labels.insert(edge_label);
+        }
+
+        void AddRange(const std::string &column, double lower, double upper) {
+            m_ranges.push_back(Range{column, lower, upper});
+        }
+
+        void Clear() {
+            m_labels.clear();
+            m_ranges.clear();
+        }
+
+        bool empty() const {
+            return m_labels.empty() && m_ranges.empty();
+        }
+
+        bool MatchLabel(const std::string &edge_label) const {
+            return m_labels.empty() || m_labels.count(edge_label) != 0;
+        }
+
+        const std::set<std::string> &labels() const {
+            return m_labels;
+        }
+
+        const std::vector<Range> &ranges() const {
+            return m_ranges;
+        }
+
+    private:
+        std::set<std::string> m_labels;
+        std::vector<Range> m_ranges;
+    };
+
+    /**
+     * @brief 绑定到某一类边属性列上的过滤条件. 每次查询时在 sub-partition / MemTable 中构造
+     */
+    class BoundEdgeFilter {
+    public:
+        struct Term {
+            ColumnDescriptor column;
+            double lower;
+            double upper;
+        };
+
+    public:
+        /**
+         * @return false -- 该类边一定不满足过滤条件 (label 不符, 列不存在或不是可比较的数值类型)
+         */
+        bool Bind(const EdgeFilter &filter, const MetaAttributes &attributes);
+
+        bool empty() const {
+            return m_terms.empty();
+        }
+
+        const std::vector<Term> &terms() const {
+            return m_terms;
+        }
+
+        /**
+         * @brief 对一条边求值.
+         * @param get   bool get(size_t term_index, const ColumnDescriptor &col, double *value),
+         *              读取边在该列上的值, 属性为 null 时返回 false
+         */
+        template <typename ValueGetter>
+        bool Match(const ValueGetter &get) const {
+            double value = 0;
+            for (size_t i = 0; i < m_terms.size(); ++i) {
+                const Term &term = m_terms[i];
+                if (!get(i, term.column, &value)) { return false; }
+                if (value < term.lower || value > term.upper) { return false; }
+            }
+            return true;
+        }
+
+        /**
+         * @brief 可以做范围比较(以及记录 zone map)的列类型
+         */
+        static bool IsRangeColumn(ColumnType type);
+
+        /**
+         * @brief 把列存储的定长值转换为 double 以便比较
+         */
+        static double ToDouble(ColumnType type, const void *bytes);
+
+    private:
+        std::vector<Term> m_terms;
+    };
+
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_EDGEFILTER_H
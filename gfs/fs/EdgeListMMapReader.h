@@ -93,6 +93,18 @@ public:
         return m_mapped_edges[idx];
     }
 
+    const PersistentEdge *GetImmutableEdges(const idx_t begin, const idx_t /* end */, std::string * /* buf */) const override {
+        return m_mapped_edges + begin;
+    }
+
+    Status GetImmutableEdgesMulti(const std::pair<idx_t, idx_t> *ranges, size_t n,
+                                  std::string * /* buf */, const PersistentEdge **blocks) const override {
+        for (size_t i = 0; i < n; ++i) {
+            blocks[i] = m_mapped_edges + ranges[i].first;
+        }
+        return Status::OK();
+    }
+
 
     PersistentEdge *GetMutableEdge(const idx_t idx, char * /* buf */) {
         m_flags |= MODIFIED;
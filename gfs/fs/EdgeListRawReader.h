@@ -4,6 +4,7 @@
 #include <sys/mman.h>
 
 #include "util/skgfilenames.h"
+#include "env/env.h"
 #include "EdgeListReader.h"
 
 namespace skg {
@@ -16,7 +17,7 @@ public:
             const std::string &basefile,
             uint32_t shard_id, uint32_t partition_id,
             const interval_t &interval, const EdgeTag_t tag=0)
-            : m_filename(FILENAME::sub_partition_edgelist(basefile, shard_id, partition_id, interval, tag)), m_fd(-1), m_num_edges(0) {
+            : m_filename(FILENAME::sub_partition_edgelist(basefile, shard_id, partition_id, interval, tag)), m_fd(-1), m_file(), m_num_edges(0) {
     }
 
     ~EdgeListRawReader() {
@@ -33,7 +34,8 @@ public:
                                                m_filename, strerror(errno), errno));
         }
         m_num_edges = static_cast<idx_t>(file_size / sizeof(PersistentEdge));
-        return Status::OK();
+        // 批量读取使用 RandomAccessFile::MultiRead, 同时提交多段读请求
+        return Env::Default()->NewRandomAccessFile(m_filename, &m_file, EnvOptions());
     }
 
     Status Flush() {
@@ -43,6 +45,7 @@ public:
     void Close() {
         Flush();
         m_num_edges = 0;
+        m_file.reset();
         if (m_fd >= 0) {
             int iRet = close(m_fd);
             if (iRet != 0) {
@@ -57,6 +60,42 @@ public:
         return *reinterpret_cast<const PersistentEdge *>(buf);
     }
 
+    const PersistentEdge *GetImmutableEdges(const idx_t begin, const idx_t end, std::string *buf) const {
+        buf->resize((end - begin) * sizeof(PersistentEdge));
+        preada(m_fd, &(*buf)[0], buf->size(), begin * sizeof(PersistentEdge));
+        return reinterpret_cast<const PersistentEdge *>(buf->data());
+    }
+
+    Status GetImmutableEdgesMulti(const std::pair<idx_t, idx_t> *ranges, size_t n,
+                                  std::string *buf, const PersistentEdge **blocks) const override {
+        size_t total = 0;
+        for (size_t i = 0; i < n; ++i) {
+            total += (ranges[i].second - ranges[i].first) * sizeof(PersistentEdge);
+        }
+        if (total == 0) { return Status::OK(); }
+        buf->resize(total);
+        std::vector<ReadRequest> reqs(n);
+        char *scratch = &(*buf)[0];
+        for (size_t i = 0; i < n; ++i) {
+            reqs[i].offset = ranges[i].first * sizeof(PersistentEdge);
+            reqs[i].len = (ranges[i].second - ranges[i].first) * sizeof(PersistentEdge);
+            reqs[i].scratch = scratch;
+            blocks[i] = reinterpret_cast<const PersistentEdge *>(scratch);
+            scratch += reqs[i].len;
+        }
+        Status s = m_file->MultiRead(reqs.data(), n);
+        for (size_t i = 0; s.ok() && i < n; ++i) {
+            s = reqs[i].status;
+            if (s.ok() && reqs[i].result.size() != reqs[i].len) {
+                s = Status::IOError(fmt::format("edges-partition file: `{}`, short read at {}, {}/{} bytes",
+                                                m_filename, reqs[i].offset, reqs[i].result.size(), reqs[i].len));
+            } else if (s.ok() && reqs[i].result.data() != reqs[i].scratch) {
+                memcpy(reqs[i].scratch, reqs[i].result.data(), reqs[i].len);
+            }
+        }
+        return s;
+    }
+
     PersistentEdge *GetMutableEdge(const idx_t idx, char *buf) {
         preada(m_fd, buf, sizeof(PersistentEdge), idx * sizeof(PersistentEdge));
         return reinterpret_cast<PersistentEdge *>(buf);
@@ -78,6 +117,7 @@ public:
 private:
     std::string m_filename;
     int m_fd;
+    std::unique_ptr<RandomAccessFile> m_file;
     idx_t m_num_edges;
 };
 }
@@ -20,6 +20,18 @@ public:
 
     virtual const PersistentEdge &GetImmutableEdge(const idx_t idx, char *buf) const = 0;
 
+    /**
+     * @brief 读取连续的一段边 [begin, end). mmap 时直接返回映射区域的指针, 否则读到 buf 中
+     */
+    virtual const PersistentEdge *GetImmutableEdges(const idx_t begin, const idx_t end, std::string *buf) const = 0;
+
+    /**
+     * @brief 一次读取多段连续的边, 第 i 段 [ranges[i].first, ranges[i].second) 的起始地址写入 blocks[i].
+     * mmap 时直接指向映射区域; 否则所有段一起提交 (RandomAccessFile::MultiRead) 并发读取, 数据存放在 buf 中
+     */
+    virtual Status GetImmutableEdgesMulti(const std::pair<idx_t, idx_t> *ranges, size_t n,
+                                          std::string *buf, const PersistentEdge **blocks) const = 0;
+
     virtual PersistentEdge *GetMutableEdge(const idx_t idx, char *buf) = 0;
 
     virtual Status Set(const idx_t idx, const PersistentEdge *const pEdge) = 0;
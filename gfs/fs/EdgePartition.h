@@ -3,6 +3,7 @@
 
 #include <string>
 #include <stack>
+#include <set>
 #include <sys/mman.h>
 
 #include "util/types.h"
@@ -144,6 +145,8 @@ namespace skg {
         Status GetInEdges(const VertexRequest &req, EdgesQueryResult *pQueryResult) const {
             Status s;
             for (const auto &subpartition : m_subpartitions) {
+                // label 不满足过滤条件的 sub-partition 整个跳过
+                if (!req.GetEdgeFilter().MatchLabel(subpartition->label().edge_label)) { continue; }
                 s = subpartition->GetInEdges(req, pQueryResult);
                 if (!s.ok()) { break; }
             }
@@ -158,6 +161,7 @@ namespace skg {
         Status GetOutEdges(const VertexRequest &req, EdgesQueryResult *pQueryResult) const {
             Status s;
             for (const auto &subpartition : m_subpartitions) {
+                if (!req.GetEdgeFilter().MatchLabel(subpartition->label().edge_label)) { continue; }
                 s = subpartition->GetOutEdges(req, pQueryResult);
                 if (!s.ok()) { return s; }
                 if (s.IsOverLimit()) { break; } // 如果结果集超过大小了, 不再到其他 SubPartition 中获取数据
@@ -168,6 +172,7 @@ namespace skg {
         Status GetBothEdges(const VertexRequest &req, EdgesQueryResult *result) const {
             Status s;
             for (const auto &subpartition: m_subpartitions) {
+                if (!req.GetEdgeFilter().MatchLabel(subpartition->label().edge_label)) { continue; }
                 s = subpartition->GetBothEdges(req, result);
                 if (!s.ok()) { break; }
                 if (s.IsOverLimit()) { break; } // 如果结果集超过大小了, 不再到其他 SubPartition 中获取数据
@@ -175,9 +180,41 @@ namespace skg {
             return s;
         }
 
+        /**
+         * @brief 从 pos->subpartition 开始, 继续读取 req.m_vid 的入边/出边, 直到 result 装满或读完
+         * @param finished  是否已经读完该 partition 中的边
+         */
+        Status ScanEdgesFrom(const VertexRequest &req, bool in_edges,
+                             EdgeScanPosition *pos, EdgesQueryResult *result, bool *finished) const {
+            Status s;
+            *finished = true;
+            for (; pos->subpartition < m_subpartitions.size(); pos->NextSubPartition()) {
+                const auto &subpartition = m_subpartitions[pos->subpartition];
+                if (!req.GetEdgeFilter().MatchLabel(subpartition->label().edge_label)) { continue; }
+                s = subpartition->ScanEdgesFrom(req, in_edges, pos, result, finished);
+                if (!s.ok() || !*finished) { return s; }
+            }
+            return s;
+        }
+
+        /**
+         * @brief 批量读取 vids (升序, 无重复) 的入边/出边, 追加到 edges
+         */
+        Status GetEdgesBatch(const vid_t *vids, size_t n, uint32_t pos_base, bool in_edges,
+                             const EdgeFilter &filter, std::vector<BatchNeighbor> *edges) const {
+            Status s;
+            for (const auto &subpartition : m_subpartitions) {
+                if (!filter.MatchLabel(subpartition->label().edge_label)) { continue; }
+                s = subpartition->GetEdgesBatch(vids, n, pos_base, in_edges, filter, edges);
+                if (!s.ok()) { return s; }
+            }
+            return s;
+        }
+
         Status GetInVertices(const VertexRequest &req, VertexQueryResult *result) const {
             Status s;
             for (const auto &subpartition: m_subpartitions) {
+                if (!req.GetEdgeFilter().MatchLabel(subpartition->label().edge_label)) { continue; }
                 s = subpartition->GetInVertices(req, result);
                 if (!s.ok()) { break; }
                 if (s.IsOverLimit()) { break; } // 如果结果集超过大小了, 不再到其他 SubPartition 中获取数据
@@ -188,6 +225,7 @@ namespace skg {
         Status GetOutVertices(const VertexRequest &req, VertexQueryResult *result) const {
             Status s;
             for (const auto &subpartition: m_subpartitions) {
+                if (!req.GetEdgeFilter().MatchLabel(subpartition->label().edge_label)) { continue; }
                 s = subpartition->GetOutVertices(req, result);
                 if (!s.ok()) { break; }
                 if (s.IsOverLimit()) { break; } // 如果结果集超过大小了, 不再到其他 SubPartition 中获取数据
@@ -198,6 +236,7 @@ namespace skg {
         Status GetBothVertices(const VertexRequest &req, VertexQueryResult *result) const {
             Status s;
             for (const auto &subpartition: m_subpartitions) {
+                if (!req.GetEdgeFilter().MatchLabel(subpartition->label().edge_label)) { continue; }
                 s = subpartition->GetBothVertices(req, result);
                 if (!s.ok()) { break; }
                 if (s.IsOverLimit()) { break; } // 如果结果集超过大小了, 不再到其他 SubPartition 中获取数据
@@ -223,6 +262,36 @@ namespace skg {
             return s;
         }
 
+        /**
+         * @brief 扫描 dst 落在 window 内的边
+         * @param labels    参与扫描的边类型, 为空表示所有类型
+         */
+        Status ScanInEdges(const interval_t &window, const std::set<std::string> &labels,
+                           const EdgeVisitor &visitor) const {
+            Status s;
+            for (const auto &subpartition : m_subpartitions) {
+                if (!labels.empty() && labels.count(subpartition->label().edge_label) == 0) { continue; }
+                s = subpartition->ScanInEdges(window, visitor);
+                if (!s.ok()) { return s; }
+            }
+            return s;
+        }
+
+        /**
+         * @brief 扫描 src 落在 window 内的边
+         * @param labels    参与扫描的边类型, 为空表示所有类型
+         */
+        Status ScanOutEdges(const interval_t &window, const std::set<std::string> &labels,
+                            const EdgeVisitor &visitor) const {
+            Status s;
+            for (const auto &subpartition : m_subpartitions) {
+                if (!labels.empty() && labels.count(subpartition->label().edge_label) == 0) { continue; }
+                s = subpartition->ScanOutEdges(window, visitor);
+                if (!s.ok()) { return s; }
+            }
+            return s;
+        }
+
         Status AddEdge(const EdgeRequest &req) {
             Status s;
             m_interval.ExtendTo(req.m_dstVid);
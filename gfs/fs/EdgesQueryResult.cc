@@ -40,7 +40,7 @@ namespace skg {
         // 使用 std::lock_guard 获取锁, 在析构时自动释放锁. http://zh.cppreference.com/w/cpp/thread/lock_guard
         std::lock_guard<std::mutex> lock(m_receive_lock);
 #endif
-        if (m_nlimit == IRequest::NO_LIMIT || m_nlimit < static_cast<ssize_t>(m_edges.size()) + 1) {
+        if (m_nlimit == IRequest::NO_LIMIT || static_cast<ssize_t>(m_edges.size()) < m_nlimit) {
 #ifndef SKG_SRC_SPLIT_SHARD
             m_edges.emplace_back(src, dst, weight, tag, column_bytes, column_bytes_len, bitset);
 #else
@@ -52,6 +52,50 @@ namespace skg {
         }
     }
 
+    Status EdgesQueryResult::ReceiveEdge(const ResultEdge &edge) {
+#ifdef SKG_QUERY_USE_MT
+        std::lock_guard<std::mutex> lock(m_receive_lock);
+#endif
+        if (m_nlimit == IRequest::NO_LIMIT || static_cast<ssize_t>(m_edges.size()) < m_nlimit) {
+            m_edges.push_back(edge);
+            return Status::OK();
+        } else {
+            return Status::ResultSizeOverLimit(fmt::format("{}", m_nlimit));
+        }
+    }
+
+    Status EdgesQueryResult::ReceiveEdges(
+            const vid_t src, const vid_t *dsts,
+            const EdgeWeight_t *weights, const size_t n,
+            const EdgeTag_t tag, const size_t column_bytes_len) {
+        static const char EMPTY_COLUMNS[SKG_MAX_EDGE_PROPERTIES_BYTES] = {'\0'};
+        const PropertiesBitset_t bitset;
+        if (n == 0) { return Status::OK(); }
+#ifdef SKG_QUERY_USE_MT
+        std::lock_guard<std::mutex> lock(m_receive_lock);
+#endif
+        if (m_nlimit != IRequest::NO_LIMIT && static_cast<ssize_t>(m_edges.size()) >= m_nlimit) {
+            return Status::ResultSizeOverLimit(fmt::format("{}", m_nlimit));
+        }
+        // 只接收到达上限为止的边, 多出的部分截断
+        size_t num_receive = n;
+        if (m_nlimit != IRequest::NO_LIMIT) {
+            num_receive = std::min(n, static_cast<size_t>(m_nlimit) - m_edges.size());
+        }
+        m_edges.reserve(m_edges.size() + num_receive);
+        for (size_t i = 0; i < num_receive; ++i) {
+#ifndef SKG_SRC_SPLIT_SHARD
+            m_edges.emplace_back(src, dsts[i], weights[i], tag, EMPTY_COLUMNS, column_bytes_len, bitset);
+#else
+            m_edges.emplace_back(dsts[i], src, weights[i], tag, EMPTY_COLUMNS, column_bytes_len, bitset);
+#endif
+        }
+        if (num_receive < n) {
+            return Status::ResultSizeOverLimit(fmt::format("{}", m_nlimit));
+        }
+        return Status::OK();
+    }
+
     void EdgesQueryResult::Clear() {
         m_row_position = 0;
         m_edges.clear();
@@ -254,6 +254,7 @@ namespace skg {
 
         // For call SetResultMetadata/TranslateEdgeVertex
         friend class SkgDBImpl;
+        friend class EdgeCursor;
 
         Status ReceiveEdge(
                 const vid_t src, const vid_t dst,
@@ -261,6 +262,20 @@ namespace skg {
                 const char *column_bytes, const size_t column_bytes_len,
                 const PropertiesBitset_t &bitset);
 
+        /**
+         * @brief 批量接收同一个 src 的不带属性的边, 只加一次锁.
+         * 属性值全部为空, column_bytes_len 为该 label 属性的字节数
+         */
+        Status ReceiveEdges(
+                const vid_t src, const vid_t *dsts,
+                const EdgeWeight_t *weights, const size_t n,
+                const EdgeTag_t tag, const size_t column_bytes_len);
+
+        /**
+         * @brief 接收其他结果集中已经组织好的边 (src/dst 已经按 ReceiveEdge 的规则存放)
+         */
+        Status ReceiveEdge(const ResultEdge &edge);
+
         // For call ReceiveEdge
         friend class ShardTree;
         friend class dbquery_grpc_server;
@@ -269,6 +284,7 @@ namespace skg {
         friend class HashMemTable;
         friend class VecMemTable;
         friend class SubEdgePartition;
+        friend class SubEdgePartitionWithMemTable;
 
         friend class EdgesQueryResultUtils;
     };
@@ -15,12 +15,14 @@ namespace skg {
     }
 
     Status HashMemTable::GetInEdges(const VertexRequest &request, EdgesQueryResult *pQueryResult) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         // get in edges from memory buffer
         Status s;
         char colData[SKG_MAX_EDGE_PROPERTIES_BYTES];
         PropertiesBitset_t bitset;
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
-            if (request.m_vid == iter->first.dst) {
+            if (request.m_vid == iter->first.dst && MatchFilter(filter, iter->second)) {
                 memset(colData, 0, SKG_MAX_EDGE_PROPERTIES_BYTES);
                 bitset.Clear();
                 CollectProperties(iter->second, request.GetColumns(), colData, &bitset);
@@ -37,12 +39,14 @@ namespace skg {
     }
 
     Status HashMemTable::GetOutEdges(const VertexRequest &request, EdgesQueryResult *pQueryResult) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         // get out edges from memory buffer
         Status s;
         char colData[SKG_MAX_EDGE_PROPERTIES_BYTES];
         PropertiesBitset_t bitset;
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
-            if (request.m_vid == iter->first.src) {
+            if (request.m_vid == iter->first.src && MatchFilter(filter, iter->second)) {
                 memset(colData, 0, SKG_MAX_EDGE_PROPERTIES_BYTES);
                 bitset.Clear();
                 CollectProperties(iter->second, request.GetColumns(), colData, &bitset);
@@ -59,11 +63,13 @@ namespace skg {
     }
 
     Status HashMemTable::GetBothEdges(const VertexRequest &request, EdgesQueryResult *result) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         Status s;
         char colData[SKG_MAX_EDGE_PROPERTIES_BYTES];
         PropertiesBitset_t bitset;
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
-            if (request.m_vid == iter->first.dst || request.m_vid == iter->first.src) {
+            if ((request.m_vid == iter->first.dst || request.m_vid == iter->first.src) && MatchFilter(filter, iter->second)) {
                 memset(colData, 0, SKG_MAX_EDGE_PROPERTIES_BYTES);
                 bitset.Clear();
                 CollectProperties(iter->second, request.GetColumns(), colData, &bitset);
@@ -79,10 +85,28 @@ namespace skg {
         return s;
     }
 
+    Status HashMemTable::GetEdgesBatch(const vid_t *vids, size_t n, uint32_t pos_base, bool in_edges,
+                                       const EdgeFilter &filter, std::vector<BatchNeighbor> *edges) const {
+        BoundEdgeFilter bound;
+        if (n == 0 || !bound.Bind(filter, m_attributes)) { return Status::OK(); }
+        for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
+            const vid_t key = in_edges ? iter->first.dst : iter->first.src;
+            if (key < vids[0] || key > vids[n - 1]) { continue; }
+            const vid_t *found = std::lower_bound(vids, vids + n, key);
+            if (*found != key || !MatchFilter(bound, iter->second)) { continue; }
+            edges->emplace_back(pos_base + static_cast<uint32_t>(found - vids),
+                                in_edges ? iter->first.src : iter->first.dst,
+                                iter->second.weight, m_attributes.label_tag);
+        }
+        return Status::OK();
+    }
+
     Status HashMemTable::GetInVertices(const VertexRequest &request, VertexQueryResult *result) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         // get in edges from memory buffer
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
-            if (request.m_vid == iter->first.dst) {
+            if (request.m_vid == iter->first.dst && MatchFilter(filter, iter->second)) {
                 result->Receive(m_attributes.src_tag, iter->first.src);
             }
         }
@@ -94,9 +118,11 @@ namespace skg {
     }
 
     Status HashMemTable::GetOutVertices(const VertexRequest &request, VertexQueryResult *result) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         // get out edges from memory buffer
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
-            if (request.m_vid == iter->first.src) {
+            if (request.m_vid == iter->first.src && MatchFilter(filter, iter->second)) {
                 result->Receive(m_attributes.dst_tag, iter->first.dst);
             }
         }
@@ -108,8 +134,11 @@ namespace skg {
     }
 
     Status HashMemTable::GetBothVertices(const VertexRequest &request, VertexQueryResult *result) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         // get out edges from memory buffer
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
+            if (!MatchFilter(filter, iter->second)) { continue; }
             if (request.m_vid == iter->first.src) {
                 result->Receive(m_attributes.dst_tag, iter->first.dst);
             } else if (request.m_vid == iter->first.dst) {
@@ -211,6 +240,20 @@ namespace skg {
         return Status::OK();
     }
 
+    bool HashMemTable::MatchFilter(const BoundEdgeFilter &filter, const HashEdgeData &edge) const {
+        if (filter.empty()) { return true; }
+        return filter.Match([&edge](size_t, const ColumnDescriptor &col, double *value) {
+            if (col.columnType() == ColumnType::WEIGHT) {
+                *value = edge.weight;
+                return true;
+            }
+            if (edge.m_properties.is_null(col.id())) { return false; }
+            Slice bytes = edge.m_properties.get(col.offset(), col.offset() + col.value_size());
+            *value = BoundEdgeFilter::ToDouble(col.columnType(), bytes.data());
+            return true;
+        });
+    }
+
     void HashMemTable::CollectProperties(
             const HashEdgeData &edge,
             const std::vector<ColumnDescriptor> &columns,
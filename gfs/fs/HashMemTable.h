@@ -7,6 +7,7 @@
 #include "EdgesQueryResult.h"
 
 #include "MemTable.h"
+#include "EdgeFilter.h"
 #include "EdgePartition.h"
 #include "IDEncoder.h"
 #include "preprocessing/parse/fileparse/fileparser.hpp"
@@ -89,6 +90,9 @@ namespace skg {
         Status GetOutEdges(const VertexRequest &request, EdgesQueryResult *result) const override ;
         Status GetBothEdges(const VertexRequest &request, EdgesQueryResult *result) const override ;
 
+        Status GetEdgesBatch(const vid_t *vids, size_t n, uint32_t pos_base, bool in_edges,
+                             const EdgeFilter &filter, std::vector<BatchNeighbor> *edges) const override;
+
         Status GetInVertices(const VertexRequest &request, VertexQueryResult *result) const override ;
         Status GetOutVertices(const VertexRequest &request, VertexQueryResult *result) const override ;
         Status GetBothVertices(const VertexRequest &request, VertexQueryResult *result) const override ;
@@ -156,6 +160,11 @@ namespace skg {
                 const std::vector<ColumnDescriptor> &columns,
                 char *buff, PropertiesBitset_t *bitset) const;
 
+        /**
+         * 边是否满足 filter 中的属性范围条件 (label 条件在 Bind 时已经检查)
+         */
+        bool MatchFilter(const BoundEdgeFilter &filter, const HashEdgeData &edge) const;
+
         /**
          * 按照
          */
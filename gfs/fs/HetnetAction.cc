@@ -0,0 +1,154 @@
+#include <cmath>
+#include <algorithm>
+
+#include "fs/HetnetAction.h"
+
+namespace skg {
+
+namespace {
+
+/**
+ * PageRank, 与 GraphChi 的实现相同: rank(v) = (1 - d) + d * sum(rank(u) / outdeg(u)).
+ * 第 0 轮记录每个节点的出度并初始化 rank; rank 变化超过 tolerance 时调度出边的邻居.
+ */
+class PageRankProgram : public VertexProgram<float> {
+public:
+    PageRankProgram(MappedVertexValues<int32_t> *outdeg, float damping, float tolerance)
+            : m_outdeg(outdeg), m_damping(damping), m_tolerance(tolerance) {
+    }
+
+    void Update(const VertexNeighbors &vertex, float *values, const VertexProgramContext &ctx) override {
+        int32_t *outdeg = m_outdeg->data();
+        if (ctx.iteration == 0) {
+            outdeg[vertex.vid] = static_cast<int32_t>(vertex.num_out);
+            values[vertex.vid] = 1.0f;
+            if (ctx.scheduler != nullptr) { ctx.scheduler->add_task(vertex.vid); }
+            return;
+        }
+        float sum = 0;
+        for (size_t i = 0; i < vertex.num_in; ++i) {
+            const vid_t u = vertex.in[i];
+            if (outdeg[u] > 0) {
+                sum += values[u] / outdeg[u];
+            }
+        }
+        const float rank = (1.0f - m_damping) + m_damping * sum;
+        if (ctx.scheduler != nullptr && std::fabs(rank - values[vertex.vid]) > m_tolerance) {
+            for (size_t i = 0; i < vertex.num_out; ++i) {
+                ctx.scheduler->add_task(vertex.out[i]);
+            }
+        }
+        values[vertex.vid] = rank;
+    }
+
+private:
+    MappedVertexValues<int32_t> *m_outdeg;
+    const float m_damping;
+    const float m_tolerance;
+};
+
+/**
+ * 标签传播. 每个节点取邻居(入边与出边)中出现次数最多的标签, 次数相同时取较小的标签.
+ * 标签变化时调度所有邻居.
+ */
+class LabelPropagationProgram : public VertexProgram<vid_t> {
+public:
+    void Update(const VertexNeighbors &vertex, vid_t *values, const VertexProgramContext &ctx) override {
+        if (ctx.iteration == 0) {
+            values[vertex.vid] = vertex.vid;
+            if (ctx.scheduler != nullptr) { ctx.scheduler->add_task(vertex.vid); }
+            return;
+        }
+        if (vertex.num_in + vertex.num_out == 0) { return; }
+        std::vector<vid_t> labels;
+        labels.reserve(vertex.num_in + vertex.num_out);
+        for (size_t i = 0; i < vertex.num_in; ++i) { labels.push_back(values[vertex.in[i]]); }
+        for (size_t i = 0; i < vertex.num_out; ++i) { labels.push_back(values[vertex.out[i]]); }
+        std::sort(labels.begin(), labels.end());
+
+        vid_t best = labels[0];
+        size_t best_count = 0;
+        for (size_t beg = 0; beg < labels.size();) {
+            size_t end = beg + 1;
+            while (end < labels.size() && labels[end] == labels[beg]) { ++end; }
+            if (end - beg > best_count) {
+                best = labels[beg];
+                best_count = end - beg;
+            }
+            beg = end;
+        }
+        if (best != values[vertex.vid]) {
+            values[vertex.vid] = best;
+            if (ctx.scheduler != nullptr) {
+                for (size_t i = 0; i < vertex.num_in; ++i) { ctx.scheduler->add_task(vertex.in[i]); }
+                for (size_t i = 0; i < vertex.num_out; ++i) { ctx.scheduler->add_task(vertex.out[i]); }
+            }
+        }
+    }
+};
+
+}  // namespace
+
+HetnetAction::HetnetAction(const std::vector<ShardTreePtr> &trees, vid_t num_vertices,
+                           const std::string &basefile, size_t default_threads)
+        : m_trees(trees), m_num_vertices(num_vertices),
+          m_basefile(basefile), m_default_threads(default_threads) {
+}
+
+HetnetAction::~HetnetAction() {
+}
+
+VertexProgramOptions HetnetAction::engine_options(const HetnetRequest &hn_req) const {
+    VertexProgramOptions options;
+    // 第 0 轮为初始化
+    options.niters = hn_req.niters + 1;
+    options.nthreads = hn_req.nthreads > 0 ? static_cast<size_t>(hn_req.nthreads) : m_default_threads;
+    options.membudget_edges = static_cast<size_t>(std::max(1, hn_req.membudget_medges)) * 1000000;
+    options.selective = true;
+    options.labels.insert(hn_req.label_constraint.begin(), hn_req.label_constraint.end());
+    return options;
+}
+
+Status HetnetAction::pagerank(const HetnetRequest &hn_req, int *niters,
+                              std::vector<vertex_value<float>> *top) {
+    Status s;
+    MappedVertexValues<int32_t> outdeg(m_basefile, "pagerank.outdeg");
+    s = outdeg.Open(m_num_vertices);
+    if (!s.ok()) { return s; }
+    VertexProgramEngine<float> engine(m_trees, m_num_vertices, m_basefile, "pagerank", engine_options(hn_req));
+    s = engine.Open();
+    if (!s.ok()) { return s; }
+
+    PageRankProgram program(&outdeg, static_cast<float>(hn_req.damping), static_cast<float>(hn_req.tolerance));
+    int niters_run = 0;
+    s = engine.Run(&program, &niters_run);
+    if (!s.ok()) { return s; }
+    *niters = std::max(0, niters_run - 1);
+    *top = get_top_vertices<float>(engine.values(), engine.num_vertices(), hn_req.ntop);
+    return engine.Close();
+}
+
+Status HetnetAction::lpa(const HetnetRequest &hn_req, int *niters,
+                         std::vector<vertex_value<uint32_t>> *top) {
+    Status s;
+    VertexProgramEngine<vid_t> engine(m_trees, m_num_vertices, m_basefile, "lpa", engine_options(hn_req));
+    s = engine.Open();
+    if (!s.ok()) { return s; }
+
+    LabelPropagationProgram program;
+    int niters_run = 0;
+    s = engine.Run(&program, &niters_run);
+    if (!s.ok()) { return s; }
+    *niters = std::max(0, niters_run - 1);
+
+    // 统计每个社区的大小, 标签即社区中某个节点的 vid
+    std::vector<uint32_t> community_size(engine.num_vertices(), 0);
+    const vid_t *labels = engine.values();
+    for (vid_t v = 0; v < engine.num_vertices(); ++v) {
+        ++community_size[labels[v]];
+    }
+    *top = get_top_vertices<uint32_t>(community_size.data(), engine.num_vertices(), hn_req.ntop);
+    return engine.Close();
+}
+
+}
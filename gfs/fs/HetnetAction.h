@@ -0,0 +1,46 @@
+#ifndef _HETNET_ACTION_H_
+#define _HETNET_ACTION_H_
+
+#include <string>
+#include <vector>
+
+#include "util/types.h"
+#include "util/status.h"
+#include "util/toplist.h"
+#include "fs/HetnetAux.h"
+#include "fs/ShardTree.h"
+#include "fs/VertexProgramEngine.h"
+
+namespace skg {
+    /**
+     * @brief 基于 VertexProgramEngine 的全图计算.
+     * 节点值保存在 `vdata/prop.v._engine.*` 中, 计算结束后仍可读取.
+     */
+    class HetnetAction {
+    private:
+        const std::vector<ShardTreePtr> &m_trees;
+        const vid_t m_num_vertices;
+        const std::string m_basefile;
+        const size_t m_default_threads;
+
+        VertexProgramOptions engine_options(const HetnetRequest &hn_req) const;
+    public:
+        HetnetAction(const std::vector<ShardTreePtr> &trees, vid_t num_vertices,
+                     const std::string &basefile, size_t default_threads);
+        ~HetnetAction();
+
+        /**
+         * @brief PageRank, 返回 rank 最大的 ntop 个节点
+         */
+        Status pagerank(const HetnetRequest &hn_req, int *niters,
+                        std::vector<vertex_value<float>> *top);
+
+        /**
+         * @brief 标签传播 (label propagation) 社区发现.
+         * 返回最大的 ntop 个社区, vertex 为社区的标签(社区中的一个节点), value 为社区大小
+         */
+        Status lpa(const HetnetRequest &hn_req, int *niters,
+                   std::vector<vertex_value<uint32_t>> *top);
+    };
+}
+#endif
@@ -0,0 +1,50 @@
+#include "HetnetAux.h"
+#include "util/types.h"
+#include "fmt/format.h"
+
+namespace skg {
+HetnetRequest::HetnetRequest() {
+    niters = 10;
+    damping = 0.85;
+    tolerance = 1e-3;
+    ntop = 20;
+    nthreads = 0;
+    membudget_medges = 64;
+}
+
+bool HetnetRequest::any_label() const {
+    return label_constraint.empty();
+}
+
+HetnetVertex::HetnetVertex(std::string _label, std::string _id, double _value) {
+    label = _label;
+    id = _id;
+    value = _value;
+}
+
+HetnetVertex::HetnetVertex() {
+    label = "";
+    id = "";
+    value = 0;
+}
+
+std::string HetnetVertex::to_str() const {
+    return fmt::format("{{\"label\":\"{}\",\"id\":\"{}\",\"value\":{}}}", label, id, value);
+}
+
+HetnetResult::HetnetResult() {
+    niters = 0;
+}
+
+std::string HetnetResult::to_str() const {
+    std::string data_str;
+    for (size_t i = 0; i < top.size(); ++i) {
+        if (i != 0) {
+            data_str += ",";
+        }
+        data_str += top[i].to_str();
+    }
+    return fmt::format("{{\"niters\":{},\"data\":[{}]}}", niters, data_str);
+}
+
+}
@@ -0,0 +1,53 @@
+#ifndef _HETNET_AUX_HPP_
+#define _HETNET_AUX_HPP_
+
+#include <stdlib.h>
+#include <vector>
+#include <string>
+
+namespace skg {
+
+    class HetnetRequest {
+    public:
+        // 参与计算的边类型, 为空表示所有类型
+        std::vector<std::string> label_constraint;
+        int niters;
+        // PageRank 的阻尼系数
+        double damping;
+        // 节点值的变化小于 tolerance 时不再调度其邻居
+        double tolerance;
+        // 返回结果中的节点数
+        int ntop;
+        // 计算线程数, 0 表示使用 Options::query_threads
+        int nthreads;
+        // 一个窗口最多加载到内存中的边数(百万)
+        int membudget_medges;
+
+        HetnetRequest();
+        bool any_label() const;
+    };
+
+    class HetnetVertex {
+    public:
+        std::string label;
+        std::string id;
+        // PageRank: 节点的 rank; LPA: 节点所在社区的大小
+        double value;
+
+        HetnetVertex(std::string _label, std::string _id, double _value);
+        HetnetVertex();
+        std::string to_str() const;
+    };
+
+    class HetnetResult {
+    public:
+        // 实际执行的迭代次数
+        int niters;
+        // 按 value 从大到小排序
+        std::vector<HetnetVertex> top;
+
+        HetnetResult();
+        std::string to_str() const;
+    };
+}
+#endif
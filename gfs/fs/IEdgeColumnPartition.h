@@ -356,6 +356,8 @@ namespace skg {
                     SKG_LOG_ERROR("error msync, {}", strerror(errno));
                 }
                 munmap(m_mapped_buf, m_mapped_size);
+                m_mapped_buf = nullptr;
+                m_mapped_size = 0;
             }
             return Status::OK();
         }
@@ -165,6 +165,29 @@ namespace skg {
             return m_value_size;
         }
 
+        /**
+         * @brief mmap 区域的首地址, 计算引擎按 vid 直接读写定长的值.
+         * 调用后视为已修改, Flush 时会 msync
+         */
+        char *mutable_data() {
+            m_modified = true;
+            return m_mapped_vattrs;
+        }
+
+        /**
+         * @brief mmap 区域的首地址, 只读. EnsureStorage 之后地址可能改变, 不能长期持有
+         */
+        const char *data() const {
+            return m_mapped_vattrs;
+        }
+
+        /**
+         * @brief 已分配存储空间的节点数
+         */
+        size_t capacity() const {
+            return m_mapped_size / m_value_size;
+        }
+
     private:
         size_t num_vertices() const {
             assert(m_value_size != 0);
@@ -24,7 +24,33 @@ public:
 
     virtual std::pair<idx_t, idx_t> GetOutIdxRange(const vid_t src) const = 0;
     virtual idx_t GetFirstInIndex(const vid_t dst) const = 0;
+
+    /**
+     * @brief 批量查找, vids 必须升序. ranges[i] 与 GetOutIdxRange(vids[i]) 相同
+     * @return 读取索引文件出错时返回错误, 不会把出错的节点当作不存在
+     */
+    virtual Status GetOutIdxRanges(const vid_t *vids, size_t n, std::pair<idx_t, idx_t> *ranges) const {
+        for (size_t i = 0; i < n; ++i) {
+            ranges[i] = GetOutIdxRange(vids[i]);
+        }
+        return Status::OK();
+    }
+
+    /**
+     * @brief 批量查找, vids 必须升序. indexes[i] 与 GetFirstInIndex(vids[i]) 相同
+     */
+    virtual Status GetFirstInIndexes(const vid_t *vids, size_t n, idx_t *indexes) const {
+        for (size_t i = 0; i < n; ++i) {
+            indexes[i] = GetFirstInIndex(vids[i]);
+        }
+        return Status::OK();
+    }
     virtual const std::string& filename() const = 0;
+
+    /**
+     * @brief 索引项数, 即有边的节点数
+     */
+    virtual idx_t num_indices() const = 0;
 };
 
 struct ValueIndex {
@@ -117,14 +143,62 @@ public:
         }
     }
 
+    Status GetOutIdxRanges(const vid_t *vids, size_t n, std::pair<idx_t, idx_t> *ranges) const override {
+        // vids 有序, 每次从上一个 vid 的位置向后查找, 整批只扫过索引一遍
+        const ValueIndex *iter = m_mapped_indices;
+        for (size_t i = 0; i < n; ++i) {
+            iter = SeekForward(iter, vids[i]);
+            if (iter == indices_end() || iter->value != vids[i]) {
+                ranges[i] = std::make_pair(INDEX_NOT_EXIST, INDEX_NOT_EXIST);
+            } else if (iter + 1 == indices_end()) {
+                ranges[i] = std::make_pair(iter->idx, INDEX_NOT_EXIST);
+            } else {
+                ranges[i] = std::make_pair(iter->idx, (iter + 1)->idx);
+            }
+        }
+        return Status::OK();
+    }
+
+    Status GetFirstInIndexes(const vid_t *vids, size_t n, idx_t *indexes) const override {
+        const ValueIndex *iter = m_mapped_indices;
+        for (size_t i = 0; i < n; ++i) {
+            iter = SeekForward(iter, vids[i]);
+            if (iter == indices_end() || iter->value != vids[i]) {
+                indexes[i] = INDEX_NOT_EXIST;
+            } else {
+                indexes[i] = iter->idx;
+            }
+        }
+        return Status::OK();
+    }
+
     inline const std::string& filename() const {
         return m_filename;
     }
+
+    idx_t num_indices() const override {
+        return m_num_indices;
+    }
 private:
     inline
     ValueIndex * const indices_end() const {
         return m_mapped_indices + m_num_indices;
     }
+
+    /**
+     * 从 begin 开始, 查找第一个 value >= vid 的位置.
+     * 先按倍增的步长向后跳, 再在最后一段中二分, 代价只与两次查找之间的距离有关
+     */
+    const ValueIndex *SeekForward(const ValueIndex *begin, const vid_t vid) const {
+        const ValueIndex *end = indices_end();
+        if (begin == end || !(*begin < vid)) { return begin; }
+        size_t bound = 1;
+        while (bound < static_cast<size_t>(end - begin) && begin[bound] < vid) {
+            bound <<= 1;
+        }
+        const ValueIndex *last = bound < static_cast<size_t>(end - begin) ? begin + bound + 1 : end;
+        return std::lower_bound(begin + bound / 2, last, vid);
+    }
 private:
     std::string m_filename;
     size_t m_mapped_size;
@@ -137,7 +211,7 @@ public:
     explicit
     IndexRawReader(const std::string &filename)
             : m_filename(filename),
-              m_fd(-1), m_num_indices(0) {
+              m_fd(-1), m_file(), m_num_indices(0) {
     }
 
     ~IndexRawReader() override {
@@ -154,11 +228,13 @@ public:
                                                m_filename, strerror(errno), errno));
         }
         m_num_indices = static_cast<idx_t>(file_size / sizeof(ValueIndex));
-        return Status::OK();
+        // 批量查找使用 RandomAccessFile::MultiRead, 同时提交一批节点的探测
+        return Env::Default()->NewRandomAccessFile(m_filename, &m_file, EnvOptions());
     }
 
     void Close() override {
         m_num_indices = 0;
+        m_file.reset();
         if (m_fd >= 0) {
             close(m_fd);
             m_fd = -1;
@@ -206,12 +282,118 @@ public:
         }
     }
 
+    Status GetOutIdxRanges(const vid_t *vids, size_t n, std::pair<idx_t, idx_t> *ranges) const override {
+        std::vector<int64_t> positions(n);
+        std::vector<ValueIndex> founds(n);
+        Status s = MultiBinFind(vids, n, positions.data(), founds.data());
+        if (!s.ok()) { return s; }
+        // 找到的节点, 再一次性读取下一项得到范围的结尾
+        std::vector<size_t> nexts;
+        for (size_t i = 0; i < n; ++i) {
+            if (positions[i] < 0) {
+                ranges[i] = std::make_pair(INDEX_NOT_EXIST, INDEX_NOT_EXIST);
+            } else {
+                ranges[i] = std::make_pair(founds[i].idx, INDEX_NOT_EXIST);
+                if (static_cast<idx_t>(positions[i] + 1) < m_num_indices) { nexts.push_back(i); }
+            }
+        }
+        if (nexts.empty()) { return s; }
+        std::vector<ReadRequest> reqs(nexts.size());
+        for (size_t k = 0; k < nexts.size(); ++k) {
+            PrepareRead(positions[nexts[k]] + 1, &founds[nexts[k]], &reqs[k]);
+        }
+        s = m_file->MultiRead(reqs.data(), reqs.size());
+        if (!s.ok()) { return s; }
+        for (size_t k = 0; k < nexts.size(); ++k) {
+            s = FinishRead(&reqs[k]);
+            if (!s.ok()) { return s; }
+            ranges[nexts[k]].second = founds[nexts[k]].idx;
+        }
+        return s;
+    }
+
+    Status GetFirstInIndexes(const vid_t *vids, size_t n, idx_t *indexes) const override {
+        std::vector<int64_t> positions(n);
+        std::vector<ValueIndex> founds(n);
+        Status s = MultiBinFind(vids, n, positions.data(), founds.data());
+        if (!s.ok()) { return s; }
+        for (size_t i = 0; i < n; ++i) {
+            indexes[i] = positions[i] < 0 ? INDEX_NOT_EXIST : founds[i].idx;
+        }
+        return s;
+    }
+
 public:
     inline const std::string& filename() const {
         return m_filename;
     }
 
+    idx_t num_indices() const override {
+        return m_num_indices;
+    }
+
 private:
+    void PrepareRead(int64_t pos, ValueIndex *index_st, ReadRequest *req) const {
+        req->offset = pos * sizeof(ValueIndex);
+        req->len = sizeof(ValueIndex);
+        req->scratch = reinterpret_cast<char *>(index_st);
+    }
+
+    Status FinishRead(ReadRequest *req) const {
+        if (!req->status.ok()) { return req->status; }
+        if (req->result.size() != req->len) {
+            return Status::IOError(fmt::format("index file: `{}`, short read at offset {}: {} of {} bytes",
+                                               m_filename, req->offset, req->result.size(), req->len));
+        }
+        if (req->result.data() != req->scratch) {
+            memcpy(req->scratch, req->result.data(), req->len);
+        }
+        return Status::OK();
+    }
+
+    /**
+     * 同时对 n 个节点做二分查找: 每一轮为所有还未结束的节点各读一项, 通过一次 MultiRead 提交.
+     * positions[i] 为 vids[i] 在索引文件中的位置, 不存在时为 -1; 存在时 founds[i] 为该项的内容.
+     * 任一读取出错时返回错误, 此时 positions 的内容无意义
+     */
+    Status MultiBinFind(const vid_t *vids, size_t n, int64_t *positions, ValueIndex *founds) const {
+        std::vector<int64_t> lows(n, 0), highs(n, static_cast<int64_t>(m_num_indices) - 1);
+        std::vector<size_t> actives;
+        actives.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            positions[i] = -1;
+            if (m_num_indices != 0) { actives.push_back(i); }
+        }
+        std::vector<ReadRequest> reqs;
+        while (!actives.empty()) {
+            reqs.resize(actives.size());
+            for (size_t k = 0; k < actives.size(); ++k) {
+                const size_t i = actives[k];
+                PrepareRead((lows[i] + highs[i]) / 2, &founds[i], &reqs[k]);
+            }
+            Status s = m_file->MultiRead(reqs.data(), reqs.size());
+            if (!s.ok()) { return s; }
+            size_t remains = 0;
+            for (size_t k = 0; k < actives.size(); ++k) {
+                const size_t i = actives[k];
+                const int64_t mid = (lows[i] + highs[i]) / 2;
+                s = FinishRead(&reqs[k]);
+                if (!s.ok()) { return s; }
+                if (vids[i] == founds[i].value) {
+                    positions[i] = mid;
+                    continue;
+                } else if (vids[i] > founds[i].value) {
+                    lows[i] = mid + 1;
+                } else {
+                    highs[i] = mid - 1;
+                }
+                if (lows[i] <= highs[i]) { actives[remains++] = i; }
+            }
+            actives.resize(remains);
+        }
+        return Status::OK();
+    }
+
     Status Read(idx_t idx, ValueIndex *index_st) const {
         assert(m_num_indices == 0 || idx < m_num_indices);
         Status s = preada(m_fd, index_st, sizeof(ValueIndex), idx * sizeof(ValueIndex));
@@ -239,6 +421,7 @@ private:
 private:
     std::string m_filename;
     int m_fd;
+    std::unique_ptr<RandomAccessFile> m_file;
     idx_t m_num_indices;
 };
 
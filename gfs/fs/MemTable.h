@@ -40,6 +40,13 @@ namespace skg {
         virtual
         Status GetBothEdges(const VertexRequest &request, EdgesQueryResult *result) const = 0;
 
+        /**
+         * @brief 批量查询 vids (升序, 无重复) 的入边/出边, 追加到 edges. 整个 MemTable 只扫描一遍
+         */
+        virtual
+        Status GetEdgesBatch(const vid_t *vids, size_t n, uint32_t pos_base, bool in_edges,
+                             const EdgeFilter &filter, std::vector<BatchNeighbor> *edges) const = 0;
+
         virtual
         Status GetInVertices(const VertexRequest &request, VertexQueryResult *result) const = 0;
         virtual
@@ -29,8 +29,10 @@ public:
     vid_t storage_capacity_vid;
     // 有效的节点数量 FIXME 未实际使用, 在 id-encoder 为 Long 型 DB, 插入 vid=1亿 场景下, 仍会出现不符合预期的情况
     vid_t num_vertices;
+    // 节点的出/入度列是否已经建好 (GenDegreeFile 之后为 true, 之后随边的增删增量维护)
+    bool degree_built;
 public:
-    MetaNumVertices() : max_allocated_vid(0), storage_capacity_vid(0), num_vertices(0) {
+    MetaNumVertices() : max_allocated_vid(0), storage_capacity_vid(0), num_vertices(0), degree_built(false) {
     }
 };
 
@@ -143,16 +145,21 @@ public:
                 // if can not load, rollback
                 vertices_info->num_vertices = vertices_info->max_allocated_vid + 1;
             }
+            // 第四个数字: 度索引是否可用. 旧的数据库中没有, 视为未建立
+            int degree_built = 0;
+            inf >> degree_built;
+            vertices_info->degree_built = (degree_built != 0);
             return Status::OK();
         }
 
         static
         Status WriteNumVertices(const std::string &dirname, const MetaNumVertices &vertices_info) {
             const std::string filename = FILENAME::num_vertices(DIRNAME::meta(dirname));
-            std::string data = fmt::format("{} {} {}\n",
+            std::string data = fmt::format("{} {} {} {}\n",
                     vertices_info.max_allocated_vid,
                     vertices_info.storage_capacity_vid,
-                    vertices_info.num_vertices);
+                    vertices_info.num_vertices,
+                    vertices_info.degree_built ? 1 : 0);
             return WriteStringToFile(Env::Default(), data, filename, /*should_sync*/true);
         }
 
@@ -0,0 +1,47 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_NEIGHBORBATCH_H
+#define STARKNOWLEDGEGRAPHDATABASE_NEIGHBORBATCH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "util/types.h"
+
+namespace skg {
+
+    /**
+     * @brief 批量邻居查询的结果, CSR 格式.
+     *
+     * 第 i 个查询节点的邻居为 neighbors[offsets[i], offsets[i + 1]),
+     * 对应边的权重, 类型存放在 weights, tags 的相同位置. offsets 的长度为查询节点数 + 1
+     */
+    struct NeighborBatch {
+        std::vector<uint64_t> offsets;
+        std::vector<vid_t> neighbors;
+        std::vector<EdgeWeight_t> weights;
+        std::vector<EdgeTag_t> tags;
+
+        void Clear() {
+            offsets.clear();
+            neighbors.clear();
+            weights.clear();
+            tags.clear();
+        }
+    };
+
+    /**
+     * @brief 批量查询时, 存储层返回的一条边. pos 为查询节点在有序去重后的批次中的下标
+     */
+    struct BatchNeighbor {
+        uint32_t pos;
+        vid_t neighbor;
+        EdgeWeight_t weight;
+        EdgeTag_t tag;
+
+        BatchNeighbor(uint32_t pos_, vid_t neighbor_, EdgeWeight_t weight_, EdgeTag_t tag_)
+                : pos(pos_), neighbor(neighbor_), weight(weight_), tag(tag_) {
+        }
+    };
+
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_NEIGHBORBATCH_H
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <iterator>
+
+#include "PartitionHandlerCache.h"
+#include "SubEdgePartition.h"
+
+namespace skg {
+
+    PartitionHandlerCache *PartitionHandlerCache::GetInstance() {
+        // 不析构, 避免进程退出时晚于它析构的 sub-partition 访问已销毁的实例
+        static PartitionHandlerCache *instance = new PartitionHandlerCache();
+        return instance;
+    }
+
+    PartitionHandlerCache::PartitionHandlerCache()
+            : m_mutex(), m_state_changed(), m_capacity(0), m_capacity_requested(false), m_lru(), m_index() {
+    }
+
+    void PartitionHandlerCache::RequestCapacity(size_t capacity) {
+        std::vector<SubEdgePartition *> victims;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_capacity_requested) {
+                m_capacity = capacity;
+                m_capacity_requested = true;
+            } else if (m_capacity != 0) {
+                // 多个 DB 共用同一个缓存, 取最大的上限, 避免后打开的 DB 调小其他 DB 的上限
+                m_capacity = capacity == 0 ? 0 : std::max(m_capacity, capacity);
+            }
+            victims = SelectVictimsUnlocked();
+        }
+        CloseVictims(victims);
+    }
+
+    size_t PartitionHandlerCache::GetCapacity() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_capacity;
+    }
+
+    bool PartitionHandlerCache::TryPinOpened(const SubEdgePartition *partition) {
+        // 与 SelectVictimsUnlocked 中 "先改状态, 再检查计数" 对应: 先增加计数, 再检查状态.
+        // 两边都是 seq_cst, 要么这里看到 CLOSING, 要么淘汰时看到计数不为 0
+        partition->m_handler_pins.fetch_add(1);
+        if (partition->m_handler_state.load() == OPENED) {
+            return true;
+        }
+        partition->m_handler_pins.fetch_sub(1, std::memory_order_release);
+        return false;
+    }
+
+    Status PartitionHandlerCache::Pin(const SubEdgePartition *partition) {
+        // 命中时不加锁, 只标记最近访问过
+        if (TryPinOpened(partition)) {
+            partition->m_handler_referenced.store(true, std::memory_order_relaxed);
+            return Status::OK();
+        }
+        SubEdgePartition *p = const_cast<SubEdgePartition *>(partition);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+            const uint8_t state = p->m_handler_state.load();
+            if (state == OPENED) {
+                // 持有锁时状态不会离开 OPENED
+                p->m_handler_pins.fetch_add(1);
+                p->m_handler_referenced.store(true, std::memory_order_relaxed);
+                return Status::OK();
+            }
+            if (state == CLOSED) { break; }
+            // 其他线程正在打开或关闭
+            m_state_changed.wait(lock);
+        }
+        p->m_handler_state.store(OPENING);
+        lock.unlock();
+
+        Status s = p->OpenHandlers();
+        if (!s.ok()) {
+            (void) p->CloseHandlers();
+        }
+
+        std::vector<SubEdgePartition *> victims;
+        lock.lock();
+        if (!s.ok()) {
+            p->m_handler_state.store(CLOSED);
+            m_state_changed.notify_all();
+            return s;
+        }
+        // 先增加计数, 刚打开的 partition 不会被淘汰
+        p->m_handler_pins.fetch_add(1);
+        p->m_handler_state.store(OPENED);
+        m_lru.push_front(p);
+        m_index[partition] = m_lru.begin();
+        victims = SelectVictimsUnlocked();
+        m_state_changed.notify_all();
+        lock.unlock();
+
+        CloseVictims(victims);
+        return Status::OK();
+    }
+
+    bool PartitionHandlerCache::PinIfOpened(const SubEdgePartition *partition) {
+        return TryPinOpened(partition);
+    }
+
+    void PartitionHandlerCache::Unpin(const SubEdgePartition *partition) {
+        partition->m_handler_pins.fetch_sub(1, std::memory_order_release);
+    }
+
+    void PartitionHandlerCache::Erase(const SubEdgePartition *partition) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_state_changed.wait(lock, [partition] {
+            const uint8_t state = partition->m_handler_state.load();
+            return state != OPENING && state != CLOSING;
+        });
+        auto iter = m_index.find(partition);
+        if (iter != m_index.end()) {
+            m_lru.erase(iter->second);
+            m_index.erase(iter);
+        }
+        partition->m_handler_state.store(CLOSED);
+    }
+
+    size_t PartitionHandlerCache::GetNumOpened() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_index.size();
+    }
+
+    std::vector<SubEdgePartition *> PartitionHandlerCache::SelectVictimsUnlocked() {
+        std::vector<SubEdgePartition *> victims;
+        if (m_capacity == 0) { return victims; }
+        auto iter = m_lru.end();
+        while (m_index.size() > m_capacity && iter != m_lru.begin()) {
+            auto cur = std::prev(iter);
+            SubEdgePartition *p = *cur;
+            // 最近访问过的移到头部, 再给一次机会
+            if (p->m_handler_referenced.exchange(false, std::memory_order_relaxed)) {
+                m_lru.splice(m_lru.begin(), m_lru, cur);
+                continue;
+            }
+            uint8_t expected = OPENED;
+            if (!p->m_handler_state.compare_exchange_strong(expected, CLOSING)) {
+                iter = cur;
+                continue;
+            }
+            if (p->m_handler_pins.load() != 0) {
+                // 正在被访问
+                p->m_handler_state.store(OPENED);
+                iter = cur;
+                continue;
+            }
+            m_index.erase(p);
+            iter = m_lru.erase(cur);
+            victims.push_back(p);
+        }
+        return victims;
+    }
+
+    void PartitionHandlerCache::CloseVictims(const std::vector<SubEdgePartition *> &victims) {
+        if (victims.empty()) { return; }
+        std::vector<bool> closed(victims.size(), false);
+        for (size_t i = 0; i < victims.size(); ++i) {
+            SubEdgePartition *p = victims[i];
+            // 关闭前把修改刷到磁盘, 重新打开时从磁盘读取
+            Status s = p->FlushHandlers(true);
+            if (!s.ok()) {
+                SKG_LOG_WARNING("Can NOT flush sub-partition: {}-{} before closing, {}",
+                                p->shard_id(), p->id(), s.ToString());
+                continue;
+            }
+            (void) p->CloseHandlers();
+            closed[i] = true;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < victims.size(); ++i) {
+            SubEdgePartition *p = victims[i];
+            if (closed[i]) {
+                p->m_handler_state.store(CLOSED);
+            } else {
+                // 刷盘失败, 保持打开, 放回 LRU 尾部
+                p->m_handler_state.store(OPENED);
+                m_lru.push_back(p);
+                m_index[p] = std::prev(m_lru.end());
+            }
+        }
+        m_state_changed.notify_all();
+    }
+
+}
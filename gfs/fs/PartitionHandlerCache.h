@@ -0,0 +1,101 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_PARTITIONHANDLERCACHE_H
+#define STARKNOWLEDGEGRAPHDATABASE_PARTITIONHANDLERCACHE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "util/status.h"
+
+namespace skg {
+
+    class SubEdgePartition;
+
+    /**
+     * @brief 延迟打开模式 (Options::lazy_open_partitions) 下, 句柄已打开的 sub-partition 的 LRU.
+     *
+     * sub-partition 在第一次被访问时才打开 edge-list, 索引, 属性列的句柄 (fd / mmap).
+     * 已打开的 sub-partition 数量超过上限 (max_open_partitions, 0 为不限制) 时,
+     * 把最久未访问的 sub-partition 刷盘后关闭. 正在被访问 (Pin 住) 的 sub-partition 不会被关闭.
+     * 缓存是进程内唯一的, 上限限制的是进程内所有 DB 打开的 sub-partition 总数;
+     * 各个 DB 打开时请求的上限取最大值 (任意一个 DB 请求不限制时即不限制), 不会被后打开的 DB 调小.
+     *
+     * 句柄已打开时 Pin 只修改 sub-partition 上的原子变量, 不加锁; LRU 顺序按 second-chance 近似,
+     * 淘汰时跳过最近被访问过的. 打开和刷盘关闭在锁外进行, 期间 sub-partition 处于 OPENING / CLOSING,
+     * 其他要打开它的线程等待状态变化.
+     */
+    class PartitionHandlerCache {
+    public:
+        static PartitionHandlerCache *GetInstance();
+
+        /**
+         * @brief DB 打开时请求的上限, 0 为不限制. 实际的上限为进程内所有请求中最大的一个
+         */
+        void RequestCapacity(size_t capacity);
+
+        size_t GetCapacity() const;
+
+        /**
+         * @brief 句柄未打开时先打开, 然后增加访问计数. 成功返回后, Unpin 之前句柄保持打开
+         */
+        Status Pin(const SubEdgePartition *partition);
+
+        /**
+         * @brief 仅当句柄已经打开时增加访问计数, 不改变 LRU 顺序
+         * @return 句柄是否已打开
+         */
+        bool PinIfOpened(const SubEdgePartition *partition);
+
+        void Unpin(const SubEdgePartition *partition);
+
+        /**
+         * @brief sub-partition 删除/析构前从 LRU 中移除, 不关闭句柄.
+         * 正在打开或关闭时等待其完成
+         */
+        void Erase(const SubEdgePartition *partition);
+
+        size_t GetNumOpened() const;
+
+    private:
+        // sub-partition 句柄的状态
+        enum HandlerState : uint8_t {
+            CLOSED = 0,
+            OPENING = 1,
+            OPENED = 2,
+            CLOSING = 3,
+        };
+
+        PartitionHandlerCache();
+
+        // 句柄已打开时增加访问计数, 否则不改变计数
+        static bool TryPinOpened(const SubEdgePartition *partition);
+
+        // 选出需要关闭的 sub-partition, 从 LRU 中移除并标记为 CLOSING. 调用时需持有 m_mutex
+        std::vector<SubEdgePartition *> SelectVictimsUnlocked();
+
+        // 在锁外刷盘并关闭 SelectVictimsUnlocked 选出的 sub-partition
+        void CloseVictims(const std::vector<SubEdgePartition *> &victims);
+
+        mutable std::mutex m_mutex;
+        // sub-partition 打开/关闭完成时通知
+        std::condition_variable m_state_changed;
+        // 0 为不限制
+        size_t m_capacity;
+        // 是否有 DB 请求过上限. 没有请求时不限制
+        bool m_capacity_requested;
+        // 头部为最近放入的
+        std::list<SubEdgePartition *> m_lru;
+        std::unordered_map<const SubEdgePartition *, std::list<SubEdgePartition *>::iterator> m_index;
+
+    public:
+        // no copying allow
+        PartitionHandlerCache(const PartitionHandlerCache &) = delete;
+        PartitionHandlerCache &operator=(const PartitionHandlerCache &) = delete;
+    };
+
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_PARTITIONHANDLERCACHE_H
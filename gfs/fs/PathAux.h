@@ -8,6 +8,8 @@
 #include <stdio.h>
 #include <string>
 
+#include "fs/EdgeFilter.h"
+
 namespace skg {
 
     class PathRequest {
@@ -39,6 +41,8 @@ namespace skg {
         int mseclimit;
         int nlimit;
         std::vector<std::string> label_constraint;
+        // 除 label_constraint 外, 下推到存储层扫描的边属性范围条件
+        EdgeFilter edge_filter;
 
         TraverseRequest();
     };
@@ -0,0 +1,129 @@
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "fmt/format.h"
+
+#include "PermutedIdEncoder.h"
+#include "VertexReordering.h"
+
+namespace skg {
+
+    namespace {
+        const uint32_t VERTEX_ORDER_MAGIC = 0x564f5244;  // "VORD"
+    }
+
+    PermutedIdEncoder::PermutedIdEncoder(const std::shared_ptr<IDEncoder> &base, std::vector<vid_t> new_to_old)
+            : m_base(base), m_new_to_old(std::move(new_to_old)) {
+        assert(m_base != nullptr);
+        VertexReordering::Inverse(m_new_to_old, &m_old_to_new);
+    }
+
+    Status PermutedIdEncoder::Load(const std::string &filename, std::vector<vid_t> *new_to_old) {
+        assert(new_to_old != nullptr);
+        FILE *f = fopen(filename.c_str(), "rb");
+        if (f == nullptr) {
+            return Status::IOError(fmt::format("Can NOT open vertex order: {}, error: {}({})",
+                                               filename, strerror(errno), errno));
+        }
+        bool ok = true;
+        uint32_t magic = 0;
+        uint64_t num_vertices = 0;
+        ok = ok && fread(&magic, sizeof(magic), 1, f) == 1 && magic == VERTEX_ORDER_MAGIC;
+        ok = ok && fread(&num_vertices, sizeof(num_vertices), 1, f) == 1;
+        if (ok) {
+            new_to_old->resize(num_vertices);
+            ok = num_vertices == 0
+                 || fread(new_to_old->data(), sizeof(vid_t), num_vertices, f) == num_vertices;
+        }
+        fclose(f);
+        if (ok) {
+            // 必须是 [0, num_vertices) 上的置换
+            std::vector<bool> seen(num_vertices, false);
+            for (const vid_t vid : *new_to_old) {
+                if (vid >= num_vertices || seen[vid]) {
+                    ok = false;
+                    break;
+                }
+                seen[vid] = true;
+            }
+        }
+        if (!ok) {
+            new_to_old->clear();
+            return Status::Corruption(fmt::format("vertex order: {} is corrupted", filename));
+        }
+        return Status::OK();
+    }
+
+    Status PermutedIdEncoder::Save(const std::string &filename, const std::vector<vid_t> &new_to_old) {
+        FILE *f = fopen(filename.c_str(), "wb");
+        if (f == nullptr) {
+            return Status::IOError(fmt::format("Can NOT create vertex order: {}, error: {}({})",
+                                               filename, strerror(errno), errno));
+        }
+        bool ok = true;
+        const uint64_t num_vertices = new_to_old.size();
+        ok = ok && fwrite(&VERTEX_ORDER_MAGIC, sizeof(VERTEX_ORDER_MAGIC), 1, f) == 1;
+        ok = ok && fwrite(&num_vertices, sizeof(num_vertices), 1, f) == 1;
+        ok = ok && (num_vertices == 0
+                    || fwrite(new_to_old.data(), sizeof(vid_t), num_vertices, f) == num_vertices);
+        ok = (fclose(f) == 0) && ok;
+        if (!ok) {
+            return Status::IOError(fmt::format("Fail to write vertex order: {}", filename));
+        }
+        return Status::OK();
+    }
+
+    Status PermutedIdEncoder::Put(const std::string &label, const std::string &vertex, vid_t vid) {
+        return m_base->Put(label, vertex, ToExternal(vid));
+    }
+
+    Status PermutedIdEncoder::PutBatch(
+            const std::vector<std::tuple<std::string, std::string, vid_t>> &batch) {
+        std::vector<std::tuple<std::string, std::string, vid_t>> external(batch);
+        for (auto &item : external) {
+            std::get<2>(item) = ToExternal(std::get<2>(item));
+        }
+        return m_base->PutBatch(external);
+    }
+
+    Status PermutedIdEncoder::GetIDByVertex(const std::string &label, const std::string &vertex, vid_t *vid) {
+        assert(vid != nullptr);
+        Status s = m_base->GetIDByVertex(label, vertex, vid);
+        if (s.ok()) {
+            *vid = ToInternal(*vid);
+        }
+        return s;
+    }
+
+    Status PermutedIdEncoder::GetIDByVertexBatch(
+            const std::vector<std::tuple<std::string, std::string>> &batch,
+            std::vector<vid_t> *vid_batch) {
+        assert(vid_batch != nullptr);
+        Status s = m_base->GetIDByVertexBatch(batch, vid_batch);
+        for (auto &vid : *vid_batch) {
+            vid = ToInternal(vid);
+        }
+        return s;
+    }
+
+    Status PermutedIdEncoder::GetVertexByID(const vid_t vid, std::string *label, std::string *vertex) {
+        return m_base->GetVertexByID(ToExternal(vid), label, vertex);
+    }
+
+    Status PermutedIdEncoder::GetVertexByIDBatch(
+            const std::vector<vid_t> &batch,
+            std::vector<std::tuple<std::string, std::string>> *vertex_batch) {
+        std::vector<vid_t> external(batch.size());
+        for (size_t i = 0; i < batch.size(); ++i) {
+            external[i] = ToExternal(batch[i]);
+        }
+        return m_base->GetVertexByIDBatch(external, vertex_batch);
+    }
+
+    Status PermutedIdEncoder::DeleteVertex(const std::string &label, const std::string &vertex, vid_t vid) {
+        return m_base->DeleteVertex(label, vertex, ToExternal(vid));
+    }
+
+}
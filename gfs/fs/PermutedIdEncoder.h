@@ -0,0 +1,83 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_PERMUTEDIDENCODER_H
+#define STARKNOWLEDGEGRAPHDATABASE_PERMUTEDIDENCODER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "IDEncoder.h"
+#include "util/types.h"
+
+namespace skg {
+
+    /**
+     * @brief 导入时重排过节点 id 的数据库所用的 IDEncoder.
+     *
+     * 内部的 base encoder 负责 string-id 与原 long-id 的转换, 本层再按置换
+     * 转换为存储中的 vid. 置换只覆盖导入时的 [0, size) 区间, 之后新增的节点 vid 不变.
+     */
+    class PermutedIdEncoder: public IDEncoder {
+    public:
+        PermutedIdEncoder(const std::shared_ptr<IDEncoder> &base, std::vector<vid_t> new_to_old);
+
+        /**
+         * @brief 读写置换文件. 文件格式: magic, 节点数, new_to_old 数组
+         */
+        static Status Load(const std::string &filename, std::vector<vid_t> *new_to_old);
+
+        static Status Save(const std::string &filename, const std::vector<vid_t> &new_to_old);
+
+        /**
+         * @brief string-id 与原 long-id 转换的 encoder
+         */
+        const std::shared_ptr<IDEncoder> &base() const {
+            return m_base;
+        }
+
+        vid_t ToInternal(vid_t vid) const {
+            return vid < m_old_to_new.size() ? m_old_to_new[vid] : vid;
+        }
+
+        vid_t ToExternal(vid_t vid) const {
+            return vid < m_new_to_old.size() ? m_new_to_old[vid] : vid;
+        }
+
+        Status Open(const std::string &dirname, OpenMode mode) override {
+            return m_base->Open(dirname, mode);
+        }
+
+        Status Close() override {
+            return m_base->Close();
+        }
+
+        Status Flush() override {
+            return m_base->Flush();
+        }
+
+        Status Put(const std::string &label, const std::string &vertex, vid_t vid) override;
+
+        Status PutBatch(
+                const std::vector<std::tuple<std::string, std::string, vid_t>> &batch) override;
+
+        Status GetIDByVertex(const std::string &label, const std::string &vertex, vid_t *vid) override;
+
+        Status GetIDByVertexBatch(
+                const std::vector<std::tuple<std::string, std::string>> &batch,
+                std::vector<vid_t> *vid_batch) override;
+
+        Status GetVertexByID(const vid_t vid, std::string *label, std::string *vertex) override;
+
+        Status GetVertexByIDBatch(
+                const std::vector<vid_t> &batch,
+                std::vector<std::tuple<std::string, std::string>> *vertex_batch) override;
+
+        Status DeleteVertex(const std::string &label, const std::string &vertex, vid_t vid) override;
+
+    private:
+        std::shared_ptr<IDEncoder> m_base;
+        std::vector<vid_t> m_new_to_old;
+        std::vector<vid_t> m_old_to_new;
+    };
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_PERMUTEDIDENCODER_H
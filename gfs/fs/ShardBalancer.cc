@@ -0,0 +1,43 @@
+#include <algorithm>
+
+#include "ShardBalancer.h"
+
+namespace skg {
+
+    ShardBalancer::ShardBalancer(const Options &options)
+            : m_sample_rate(std::max<uint32_t>(options.sample_rate, 1)),
+              m_sample_interval(std::max<uint32_t>(options.sample_interval, 1)),
+              m_rng(options.sample_seed),
+              m_buckets(), m_nsampled(0) {
+    }
+
+    void ShardBalancer::Sample(const vid_t *dsts, size_t n) {
+        std::uniform_int_distribution<uint32_t> dist(0, m_sample_rate - 1);
+        for (size_t i = 0; i < n; ++i) {
+            if (m_sample_rate > 1 && dist(m_rng) != 0) { continue; }
+            ++m_buckets[dsts[i] / m_sample_interval];
+            ++m_nsampled;
+        }
+    }
+
+    std::vector<vid_t> ShardBalancer::Split(size_t num_shards) const {
+        std::vector<vid_t> starts(1, 0);
+        if (num_shards <= 1 || m_nsampled == 0) { return starts; }
+        // 第 k 个区间在累计采样数达到 total * k / num_shards 时结束
+        uint64_t accumulated = 0;
+        size_t k = 1;
+        for (const auto &bucket : m_buckets) {
+            accumulated += bucket.second;
+            if (accumulated * num_shards < m_nsampled * k) { continue; }
+            const vid_t next_start = (bucket.first + 1) * m_sample_interval;
+            // 最后一个计数区间之后没有采样到的边, 不再划分
+            if (accumulated < m_nsampled && next_start > starts.back()) {
+                starts.push_back(next_start);
+            }
+            while (k < num_shards && accumulated * num_shards >= m_nsampled * k) { ++k; }
+            if (k >= num_shards) { break; }
+        }
+        return starts;
+    }
+
+}
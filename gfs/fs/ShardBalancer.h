@@ -0,0 +1,51 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_SHARDBALANCER_H
+#define STARKNOWLEDGEGRAPHDATABASE_SHARDBALANCER_H
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "util/types.h"
+#include "util/options.h"
+
+namespace skg {
+
+    /**
+     * @brief 按采样的入度统计划分 ShardTree 的区间, 使各个 ShardTree 的边数接近.
+     *
+     * 每 sample_rate 条边随机采样一条 (随机种子为 sample_seed),
+     * 采样边的 dst 按宽度为 sample_interval 的 vid 区间计数.
+     * 划分的边界总是落在计数区间的边界上, 单个计数区间内的热点节点不会被拆开.
+     */
+    class ShardBalancer {
+    public:
+        explicit ShardBalancer(const Options &options);
+
+        /**
+         * @brief 采样一批边的 dst
+         */
+        void Sample(const vid_t *dsts, size_t n);
+
+        uint64_t GetNumSampled() const {
+            return m_nsampled;
+        }
+
+        /**
+         * @brief 把采样覆盖的 vid 范围划分为至多 num_shards 个区间, 返回各区间的起点.
+         * 第一个区间从 0 开始; 采样不足以区分时返回的区间数可能少于 num_shards
+         */
+        std::vector<vid_t> Split(size_t num_shards) const;
+
+    private:
+        const uint32_t m_sample_rate;
+        const uint32_t m_sample_interval;
+        std::mt19937 m_rng;
+        // vid / sample_interval -> 采样的边数
+        std::map<vid_t, uint64_t> m_buckets;
+        uint64_t m_nsampled;
+    };
+
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_SHARDBALANCER_H
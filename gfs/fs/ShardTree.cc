@@ -83,6 +83,51 @@ namespace skg {
         return s;
     }
 
+    ShardTreePtr ShardTree::WithInterval(const interval_t &interval) {
+        ShardTreePtr tree = std::make_shared<ShardTree>(m_dirname, m_shard_id, interval, m_options);
+        tree->m_partitions = m_partitions;
+        tree->m_closed = false;
+        // partition 交给新对象刷盘
+        m_closed = true;
+        return tree;
+    }
+
+    Status ShardTree::MoveEdgesTo(vid_t pivot, ShardTree *upper) {
+        // MemTable 中的边先刷到磁盘, 之后只需处理磁盘数据
+        Status s = Flush();
+        if (!s.ok()) { return s; }
+        const interval_t upper_interval = upper->GetInterval();
+        // 先写入 upper 再从本树中去掉, 中途失败时边不会丢失
+        for (auto &to : *upper->m_partitions[0]) {
+            std::vector<MemoryEdge> moved;
+            for (const auto &partition : m_partitions) {
+                // partition 按 dst 划分区间
+                if (partition->GetInterval().second < pivot) { continue; }
+                for (auto &from : *partition) {
+                    if (!(from->label() == to->label())) { continue; }
+                    std::vector<MemoryEdge> edges;
+                    s = from->LoadAllEdges(&edges);
+                    if (!s.ok()) { return s; }
+                    for (auto &edge : edges) {
+                        if (edge.dst >= pivot) { moved.emplace_back(std::move(edge)); }
+                    }
+                }
+            }
+            if (moved.empty()) { continue; }
+            s = to->MergeEdgesAndFlush(std::move(moved), upper_interval);
+            if (!s.ok()) { return s; }
+        }
+        // FIXME 重写期间不加锁的查询可能读不到被移动的边, 同 compaction
+        for (const auto &partition : m_partitions) {
+            if (partition->GetInterval().second < pivot) { continue; }
+            for (auto &sub : *partition) {
+                s = sub->TruncateEdgesFrom(pivot);
+                if (!s.ok()) { return s; }
+            }
+        }
+        return s;
+    }
+
     size_t ShardTree::GetNumEdges() const {
         size_t numEdges = 0;
         for (const auto &partition : m_partitions) {
@@ -123,13 +168,15 @@ namespace skg {
         return s;
     }
 
-    Status ShardTree::AddEdge(/*const*/ EdgeRequest &request) {
+    Status ShardTree::AddEdge(/*const*/ EdgeRequest &request, bool *created) {
         request.SetCreateIfNotExist(true);// 如果边不存在, 则创建一条新的边
         if (request.IsCheckExist()) {// 检查边是否存在, 如果存在, 则转化为更新操作
-            return this->SetEdgeAttributes(request);
+            return this->SetEdgeAttributes(request, created);
         } else {
             // 不检查边是否存在, 直接插入到 shard-tree 顶部的 partition buff 中
-            return this->AddEdgeNotCheckExist(request);
+            Status s = this->AddEdgeNotCheckExist(request);
+            if (created != nullptr) { *created = s.ok(); }
+            return s;
         }
     }
 
@@ -138,7 +185,9 @@ namespace skg {
         metrics::GetInstance()->start_time("ShardTree.AddEdgeNotCheckExist",metric_duration_type::MILLISECONDS);
 
         // 不检查边是否存在, 直接插入到 shard-tree 顶部的 partition buff 中
-        m_interval.ExtendTo(request.m_dstVid);
+        if (request.m_dstVid > m_last.load(std::memory_order_relaxed)) {
+            m_last.store(request.m_dstVid, std::memory_order_release);
+        }
         Status s = m_partitions[0]->AddEdge(request);
         if (!s.ok()) { return s; }
 
@@ -168,7 +217,8 @@ namespace skg {
         return s;
     }
 
-    Status ShardTree::SetEdgeAttributes(/*const*/ EdgeRequest &request) {
+    Status ShardTree::SetEdgeAttributes(/*const*/ EdgeRequest &request, bool *created) {
+        if (created != nullptr) { *created = false; }
         Status s = Status::NotExist(); // 默认为找不到的错误状态
         // 尝试在 partition 中寻找边, 更新属性值
         metrics::GetInstance()->start_time("ShardTree.SetEdgeAttributes.find-and-update",metric_duration_type::MILLISECONDS);
@@ -197,6 +247,7 @@ namespace skg {
                           request.m_dstVertexLabel, request.m_dstVertex,
                           request.m_srcVid, request.m_dstVid);
             s = this->AddEdgeNotCheckExist(request);
+            if (created != nullptr) { *created = s.ok(); }
         }
         return s;
     }
@@ -229,12 +280,14 @@ namespace skg {
     */
 
     Status ShardTree::DeleteEdge(const EdgeRequest &request) {
-        Status s;
+        // 没有 partition 包含 dst 时也返回 NotExist, 调用方据此判断是否真的删除了边
+        Status s = Status::NotExist(fmt::format("edge: {}->{}.", request.m_srcVid, request.m_dstVid));
         // 尝试在 partition 中寻找边并删除
         for (size_t p = 0; p < m_partitions.size(); ++p) {
             if (m_partitions[p]->GetInterval().Contain(request.m_dstVid)) {
                 s = m_partitions[p]->DeleteEdge(request);
                 if (s.ok()) { // 已经找到边并删除
+                    s = DoReclaim(m_partitions[p]);
                     break;
                 } else if (!s.IsNotExist()) {
                     // 出错
@@ -275,6 +328,8 @@ namespace skg {
         for (const auto &partition : m_partitions) {
             s = partition->DeleteVertex(request);
             if (!s.ok()) { return s; }
+            s = DoReclaim(partition);
+            if (!s.ok()) { return s; }
         }
         return s;
     }
@@ -314,6 +369,39 @@ namespace skg {
     }
 
 
+    Status ShardTree::ScanEdgesFrom(const VertexRequest &request, bool in_edges,
+                                    EdgeScanPosition *pos, EdgesQueryResult *result, bool *finished) const {
+        Status s;
+        *finished = true;
+        for (; pos->partition < m_partitions.size(); pos->NextPartition()) {
+            const auto &partition = m_partitions[pos->partition];
+            // partition 的 interval 不包含 dst, 则 partition 一定不含其入边
+            if (in_edges && !partition->GetInterval().Contain(request.m_vid)) { continue; }
+            s = partition->ScanEdgesFrom(request, in_edges, pos, result, finished);
+            if (!s.ok() || !*finished) { return s; }
+        }
+        return s;
+    }
+
+    Status ShardTree::GetEdgesBatch(const vid_t *vids, size_t n, bool in_edges,
+                                    const EdgeFilter &filter, std::vector<BatchNeighbor> *edges) const {
+        Status s;
+        for (const auto &partition : m_partitions) {
+            size_t begin = 0, end = n;
+            if (in_edges) {
+                // 只有落在 partition 区间内的节点才可能有入边
+                const interval_t &interval = partition->GetInterval();
+                begin = std::lower_bound(vids, vids + n, interval.first) - vids;
+                end = std::upper_bound(vids + begin, vids + n, interval.second) - vids;
+                if (begin >= end) { continue; }
+            }
+            s = partition->GetEdgesBatch(vids + begin, end - begin, static_cast<uint32_t>(begin),
+                                         in_edges, filter, edges);
+            if (!s.ok()) { return s; }
+        }
+        return s;
+    }
+
     Status ShardTree::GetInVertices(const VertexRequest &request, VertexQueryResult *result) const {
         Status s;
         for (size_t p = 0; p < m_partitions.size(); ++p) {
@@ -363,14 +451,7 @@ namespace skg {
         if (!s.ok()) { return s; }
         pResult->SetResultMetadata(hAttributes);
 
-        do {
-            for (size_t p = 0; p < m_partitions.size(); ++p) {
-                if (m_partitions[p]->GetInterval().Contain(request.m_vid)) {
-                    s = m_partitions[p]->GetInDegree(request.m_vid, &degree);
-                    if (!s.ok()) { break; }
-                }
-            }
-        } while (false);
+        s = this->GetInDegree(request.m_vid, &degree);
         if (s.ok()) {
             // 设置 degree 到 Result 中
             ResultProperties properties(sizeof(int32_t));
@@ -380,6 +461,49 @@ namespace skg {
         return s;
     }
 
+    Status ShardTree::GetInDegree(vid_t vid, int *degree) const {
+        Status s;
+        for (size_t p = 0; p < m_partitions.size(); ++p) {
+            if (m_partitions[p]->GetInterval().Contain(vid)) {
+                s = m_partitions[p]->GetInDegree(vid, degree);
+                if (!s.ok()) { break; }
+            }
+        }
+        return s;
+    }
+
+    Status ShardTree::GetOutDegree(vid_t vid, int *degree) const {
+        Status s;
+        for (size_t p = 0; p < m_partitions.size(); ++p) {
+            s = m_partitions[p]->GetOutDegree(vid, degree);
+            if (!s.ok()) { return s; }
+        }
+        return s;
+    }
+
+    Status ShardTree::ScanInEdges(const interval_t &window, const std::set<std::string> &labels,
+                                  const EdgeVisitor &visitor) const {
+        Status s;
+        for (size_t p = 0; p < m_partitions.size(); ++p) {
+            const interval_t &interval = m_partitions[p]->GetInterval();
+            // partition 按 dst 划分区间, 与 window 不相交的不可能有 window 的入边
+            if (interval.second < window.first || window.second < interval.first) { continue; }
+            s = m_partitions[p]->ScanInEdges(window, labels, visitor);
+            if (!s.ok()) { return s; }
+        }
+        return s;
+    }
+
+    Status ShardTree::ScanOutEdges(const interval_t &window, const std::set<std::string> &labels,
+                                   const EdgeVisitor &visitor) const {
+        Status s;
+        for (size_t p = 0; p < m_partitions.size(); ++p) {
+            s = m_partitions[p]->ScanOutEdges(window, labels, visitor);
+            if (!s.ok()) { return s; }
+        }
+        return s;
+    }
+
     Status ShardTree::GetOutDegree(const VertexRequest &request, VertexQueryResult *pResult) const {
         pResult->Clear(); // 清空之前的数据
 
@@ -395,12 +519,8 @@ namespace skg {
         if (!s.ok()) { return s; }
         pResult->SetResultMetadata(hAttributes);
 
-        do {
-            for (size_t p = 0; p < m_partitions.size(); ++p) {
-                s = m_partitions[p]->GetOutDegree(request.m_vid, &degree);
-                if (!s.ok()) { return s; }
-            }
-        } while (false);
+        s = this->GetOutDegree(request.m_vid, &degree);
+        if (!s.ok()) { return s; }
         if (s.ok()) {
             // 设置 degree 到 Result 中
             ResultProperties properties(sizeof(int32_t));
@@ -555,6 +675,17 @@ namespace skg {
         return s;
     }
 
+    Status ShardTree::DoReclaim(const EdgePartitionPtr &partition) const {
+        Status s;
+        // 已删除的边占比过高的 sub-partition, 重写其磁盘数据
+        for (auto &sub: *partition.get()) {
+            TombstoneCompaction compaction(sub);
+            s = compaction.Run();
+            if (!s.ok()) { break; }
+        }
+        return s;
+    }
+
     Status ShardTree::ExportData(const std::string &outDir, std::shared_ptr<IDEncoder> encoder) {
         Status s;
         for (const auto &partition : m_partitions) {
@@ -1,8 +1,10 @@
 #ifndef STARKNOWLEDGEGRAPHDATABASE_SHARDTREE_H
 #define STARKNOWLEDGEGRAPHDATABASE_SHARDTREE_H
 
+#include <atomic>
 #include <fstream>
 #include <queue>
+#include <set>
 
 #include "util/status.h"
 #include "util/options.h"
@@ -42,7 +44,8 @@ namespace skg {
         ShardTree(const std::string &dirname,
                   uint32_t shard_id, const interval_t &interval,
                   const Options &options)
-                : m_dirname(dirname), m_shard_id(shard_id), m_interval(interval), m_options(options),
+                : m_dirname(dirname), m_shard_id(shard_id),
+                  m_first(interval.first), m_last(interval.second), m_options(options),
                   m_closed(true)  {
         }
 
@@ -76,8 +79,12 @@ namespace skg {
             return m_options;
         }
 
+        /**
+         * @brief ShardTree 负责的 dst 区间. 区间的起点不变, 只有末尾的 ShardTree 会随插入的边扩展终点;
+         * 其他的调整 (预先划分, 分裂) 通过 WithInterval 生成新的对象, 随 ShardTree 列表一起替换
+         */
         interval_t GetInterval() const {
-            return m_interval;
+            return interval_t(m_first, m_last.load(std::memory_order_acquire));
         }
 
         size_t GetNumEdges() const;
@@ -97,6 +104,30 @@ namespace skg {
 
         NumEdgesDetail GetNumEdgesDetail() const;
 
+        /**
+         * @brief ShardTree 估计大小(字节数)
+         */
+        size_t GetEstimateSize() const {
+            size_t size = 0;
+            for (const auto &p : m_partitions) {
+                size += p->GetEstimateSize();
+            }
+            return size;
+        }
+
+        /**
+         * @brief 生成负责 interval 的新 ShardTree 对象, 与本对象共享 partition.
+         * 之后只能通过新对象写入, 本对象只供持有旧列表的查询继续读取, 析构时不再刷盘.
+         * 调用方需持有写锁
+         */
+        ShardTreePtr WithInterval(const interval_t &interval);
+
+        /**
+         * @brief 把 dst >= pivot 的边移动到 upper 中 (upper 为新建的, 负责 [pivot, ...] 的 ShardTree).
+         * 先写入 upper, 再重写本树的 partition 去掉这些边. 调用方需持有写锁
+         */
+        Status MoveEdgesTo(vid_t pivot, ShardTree *upper);
+
     public:
 
         Status Flush();
@@ -109,8 +140,9 @@ namespace skg {
          *      -- true  -> 先检查边是否在图中, 如果存在, 则更新边的值.
          *                  相当于调用 SetEdgeAttr, 且设置了 `CreateIfNotExist`
          *      -- false -> 如果确认插入的边不存在于原来的图中, 直接插入到 MemTable 缓存中.
+         * @param created   返回是否插入了新的边 (false 表示更新了已有边的属性)
          */
-        Status AddEdge(/*const*/ EdgeRequest &request);
+        Status AddEdge(/*const*/ EdgeRequest &request, bool *created = nullptr);
 
         Status DeleteEdge(const EdgeRequest &request);
 
@@ -124,14 +156,34 @@ namespace skg {
          * request.IsCreateIfNotExist()
          *      -- true  -> 如果边不存在, 则尝试插入新的边并设置属性
          *      -- false -> 如果边不存在, 返回 NotExist
+         * @param created   返回是否插入了新的边
          */
-        Status SetEdgeAttributes(/*const*/ EdgeRequest &request);
+        Status SetEdgeAttributes(/*const*/ EdgeRequest &request, bool *created = nullptr);
 
         // 节点的增/删/查/改
         Status DeleteVertex(const VertexRequest &request) const;
         Status GetInEdges(const VertexRequest &request, EdgesQueryResult *result) const;
         Status GetOutEdges(const VertexRequest &request, EdgesQueryResult *result) const;
         Status GetBothEdges(const VertexRequest &request, EdgesQueryResult *result) const;
+
+        /**
+         * @brief 供 EdgeCursor 分批读取. 从 pos 记录的 partition 开始继续读取边, 直到 result 装满或读完本树
+         * @param finished  是否已经读完本树中的边
+         */
+        Status ScanEdgesFrom(const VertexRequest &request, bool in_edges,
+                             EdgeScanPosition *pos, EdgesQueryResult *result, bool *finished) const;
+
+        /**
+         * @brief 批量读取 vids (升序, 无重复) 的入边/出边, 追加到 edges. 边的 pos 为节点在 vids 中的下标
+         */
+        Status GetEdgesBatch(const vid_t *vids, size_t n, bool in_edges,
+                             const EdgeFilter &filter, std::vector<BatchNeighbor> *edges) const;
+        // 为多线程增加接口
+        static
+        Status MtiGetEdgesBatch(const ShardTreePtr &ptr, const vid_t *vids, size_t n, bool in_edges,
+                                const EdgeFilter *filter, std::vector<BatchNeighbor> *edges) {
+            return ptr->GetEdgesBatch(vids, n, in_edges, *filter, edges);
+        }
         // 为多线程增加接口
         static
         Status MtiGetOutE(const ShardTreePtr& ptr, const VertexRequest *request, EdgesQueryResult *result) {
@@ -164,6 +216,26 @@ namespace skg {
         Status GetInDegree(const VertexRequest &request, VertexQueryResult *result) const;
         Status GetOutDegree(const VertexRequest &request, VertexQueryResult *result) const;
 
+        /**
+         * @brief 扫描 partition 统计节点的度, 结果累加到 `*degree` 上
+         */
+        Status GetInDegree(vid_t vid, int *degree) const;
+        Status GetOutDegree(vid_t vid, int *degree) const;
+
+        /**
+         * @brief 计算引擎使用. 扫描树中 dst 落在 window 内的所有入边
+         * (只扫描区间与 window 相交的 partition; MemTable 中的边需要先 Flush)
+         */
+        Status ScanInEdges(const interval_t &window, const std::set<std::string> &labels,
+                           const EdgeVisitor &visitor) const;
+
+        /**
+         * @brief 计算引擎使用. 扫描树中 src 落在 window 内的所有出边
+         * (出边可能分布在每一个 partition 中, MemTable 中的边需要先 Flush)
+         */
+        Status ScanOutEdges(const interval_t &window, const std::set<std::string> &labels,
+                            const EdgeVisitor &visitor) const;
+
         Status CreateNewEdgeLabel(const EdgeLabel &label, EdgeTag_t tag, EdgeTag_t src_tag, EdgeTag_t dst_tag);
         Status CreateEdgeAttrCol(const EdgeLabel &label, const ColumnDescriptor &config);
         Status DeleteEdgeAttrCol(const EdgeLabel &label, const std::string &columnName);
@@ -188,24 +260,15 @@ namespace skg {
 
         Status DoFlush();
         Status DoCompaction();
-
-        /**
-         * @brief ShardTree 估计大小(字节数)
-         */
-        size_t GetEstimateSize() const {
-            size_t size = 0;
-            for (const auto &p : m_partitions) {
-                size += p->GetEstimateSize();
-            }
-            return size;
-        }
+        Status DoReclaim(const EdgePartitionPtr &partition) const;
 
     private:
         Status AddEdgeNotCheckExist(/*const*/ EdgeRequest &request);
 
         std::string m_dirname;
         uint32_t m_shard_id;
-        interval_t m_interval;
+        const vid_t m_first;
+        std::atomic<vid_t> m_last;
         const Options m_options;
         std::vector<EdgePartitionPtr> m_partitions;
         std::deque<EdgePartitionPtr> m_flush_queue;
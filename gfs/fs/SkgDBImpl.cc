@@ -1,4 +1,5 @@
 #include "SkgDBImpl.h"
+#include <cmath>
 #include <set>
 #include <string>
 #include <env/env.h>
@@ -6,6 +7,7 @@
 //#include "Temporal.h"
 #include "TraverseAction.h"
 #include "PathAction.h"
+#include "HetnetAction.h"
 //#include "TimePathAction.h"
 #include "util/ThreadPool.h"
 //#include "hetnet_action.h"
@@ -13,12 +15,18 @@
 //#include "file_reader_writer.h"
 #include "util/pathutils.h"
 #include "StringToLongIdEncoder.h"
+#include "PermutedIdEncoder.h"
+#include "ShardBalancer.h"
+#include "PartitionHandlerCache.h"
 
 namespace skg {
 
 Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     Status s;
     const std::string basedir = this->GetStorageDirname();
+    // 各阶段的耗时 (ms)
+    double id_encoder_ms = 0, vertex_columns_ms = 0, shard_trees_ms = 0;
+    metrics_entry phase = metrics::GetInstance()->start_time(metric_duration_type::MILLISECONDS);
 
     // 节点 string -> int 转换
     if (!PathUtils::FileExists(DIRNAME::id_mapping(basedir))) {
@@ -41,9 +49,21 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     s = this->m_id_encoder->Open(basedir);
     if (!s.ok()) { return s; }
 
+    // 导入时重排过节点 id
+    const std::string order_file = FILENAME::vertex_order(DIRNAME::meta(basedir));
+    if (PathUtils::FileExists(order_file)) {
+        std::vector<vid_t> new_to_old;
+        s = PermutedIdEncoder::Load(order_file, &new_to_old);
+        if (!s.ok()) { return s; }
+        this->m_id_encoder = std::make_shared<PermutedIdEncoder>(this->m_id_encoder, std::move(new_to_old));
+    }
+    phase.timer_stop(&id_encoder_ms);
+
     // 节点相关的操作句柄
+    phase.timer_start();
     s = VertexColumnList::Open(basedir, &this->m_vertex_columns);
     if (!s.ok()) { return s; }
+    phase.timer_stop(&vertex_columns_ms);
 
     bool isMigrated = false; // 对旧的生成的边属性文件兼容处理, 调整边属性的src-tag,dst-tag
     for (auto &prop: this->m_edge_attr) {
@@ -67,17 +87,18 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     // Shard-Tree 的操作句柄
+    phase.timer_start();
     {// 多线程打开 ShardTree
         // ShardTree <= 4 个时, tree options, mmap 加上预读
         Options tree_options = m_options;
         if (meta_shard_info.roots.size() <= 4) { tree_options.use_mmap_populate = true; }
-        // 先插入指针，然后利用线程池多线程并发打开 ShardTree
-        for (size_t i = 0; i < meta_shard_info.roots.size(); ++i) {
-            ShardTreePtr tree;
-            this->m_trees.emplace_back(tree);
+        if (m_options.lazy_open_partitions) {
+            // 句柄在第一次访问时才打开, 按 LRU 限制同时打开的数量. 上限是进程内所有 DB 共用的
+            PartitionHandlerCache::GetInstance()->RequestCapacity(m_options.max_open_partitions);
         }
-        const uint32_t open_threads = get_option_uint("open_threads", 8);
-        ThreadPool pool(open_threads);
+        // 先插入指针，然后利用线程池多线程并发打开 ShardTree, 全部打开后再发布
+        std::shared_ptr<ShardTreeList> trees = std::make_shared<ShardTreeList>(meta_shard_info.roots.size());
+        ThreadPool pool(m_options.open_threads);
         std::vector<std::future<Status>> open_status;
         for (size_t i = 0; i < meta_shard_info.roots.size(); ++i) {
             open_status.emplace_back(
@@ -85,14 +106,22 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
                                  basedir,
                                  meta_shard_info.roots[i].id,
                                  meta_shard_info.roots[i].interval,
-                                 tree_options, &this->m_trees[i])
+                                 tree_options, &(*trees)[i])
             );
         }
         for (auto &&status : open_status) {
             s = status.get();
             if (!s.ok()) { break; }
         }
+        std::atomic_store(&m_trees, std::shared_ptr<const ShardTreeList>(std::move(trees)));
     }
+    if (!s.ok()) { return s; }
+    phase.timer_stop(&shard_trees_ms);
+    SKG_LOG_INFO("opened db: {}, id-encoder: {:.1f}ms, vertex-columns: {:.1f}ms, "
+                 "{} shard-trees: {:.1f}ms ({} threads{})",
+                 m_name, id_encoder_ms, vertex_columns_ms,
+                 meta_shard_info.roots.size(), shard_trees_ms, m_options.open_threads,
+                 m_options.lazy_open_partitions ? ", lazy" : "");
     return s;
 }
 
@@ -132,13 +161,41 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     Status SkgDBImpl::RedoDeleteVertex(VertexRequest &req) {
+        const auto trees = LoadShardTrees();
         Status s;
+        // 度列可用时, 先找出关联的边, 删除后更新邻居的度
+        VertexQueryResult inVertices, outVertices;
+        if (m_vertex_columns->IsDegreeBuilt() && req.m_vid < m_vertex_columns->GetNumVertices()) {
+            for (size_t i = 0; i < trees->size(); ++i) {
+                if ((*trees)[i]->GetInterval().Contain(req.m_vid)) {
+                    s = (*trees)[i]->GetInVertices(req, &inVertices);
+                    if (!s.ok()) { return s; }
+                }
+                s = (*trees)[i]->GetOutVertices(req, &outVertices);
+                if (!s.ok()) { return s; }
+            }
+        }
+
         // 到所有shard中删除节点关联的边
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            s = m_trees[i]->DeleteVertex(req);
+        for (size_t i = 0; i < trees->size(); ++i) {
+            s = (*trees)[i]->DeleteVertex(req);
             if (!s.ok()) { return s; }
         }
 
+        // 节点可能出现在任意节点的邻居列表中, 清空整个缓存
+        if (m_adj_cache) { m_adj_cache->Clear(); }
+
+        while (inVertices.MoveNext()) {
+            m_vertex_columns->AddDegree(inVertices.GetVid(&s), req.m_vid, -1);
+        }
+        while (outVertices.MoveNext()) {
+            const vid_t dst = outVertices.GetVid(&s);
+            // 自环同时出现在入边和出边中, 已经在上面减过一次
+            if (dst == req.m_vid) { continue; }
+            m_vertex_columns->AddDegree(req.m_vid, dst, -1);
+        }
+        s = Status::OK();
+
         // 删除节点的属性
         s = m_vertex_columns->DeleteVertex(req);
         if (!s.ok()) { return s; }
@@ -181,6 +238,7 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
 #else
     Status SkgDBImpl::GetOutEdges(/* const */VertexRequest &req, EdgesQueryResult *pQueryResult) const {
 #endif
+        const auto trees = LoadShardTrees();
         assert(pQueryResult != nullptr);
         pQueryResult->Clear(); // 清空结果集, 防止结果集中存着之前的数据
 
@@ -195,9 +253,9 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
 //        metrics::GetInstance()->start_time("SkgDBImpl.GetInEdges.shards", metric_duration_type::MILLISECONDS);
         // in-edges, 仅存在于一个 ShardTree 中
         s = Status::NotExist(fmt::format("[{}:{}({})] not exist in shard tree", req.GetLabel(), req.GetVertex(), req.GetVid()));
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            if (m_trees[i]->GetInterval().Contain(req.m_vid)) { // 找到该区间的 ShardTree
-                s = m_trees[i]->GetInEdges(req, pQueryResult);
+        for (size_t i = 0; i < trees->size(); ++i) {
+            if ((*trees)[i]->GetInterval().Contain(req.m_vid)) { // 找到该区间的 ShardTree
+                s = (*trees)[i]->GetInEdges(req, pQueryResult);
                 break;
             }
         }
@@ -226,6 +284,7 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
 #else
     Status SkgDBImpl::GetInEdges(/* const */VertexRequest &req, EdgesQueryResult *pQueryResult) const {
 #endif
+        const auto trees = LoadShardTrees();
         assert(pQueryResult != nullptr);
         pQueryResult->Clear(); // 清空结果集, 防止结果集中存着之前的数据
 
@@ -240,17 +299,17 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
 //        metrics::GetInstance()->start_time("SkgDBImpl.GetOutEdges.shards", metric_duration_type::MILLISECONDS);
 #ifndef SKG_QUERY_USE_MT
         // out-edges, 可能存在于所有 ShardTree 中
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            s = m_trees[i]->GetOutEdges(req, pQueryResult);
+        for (size_t i = 0; i < trees->size(); ++i) {
+            s = (*trees)[i]->GetOutEdges(req, pQueryResult);
             if (!s.ok()) { return s; }
             if (s.IsOverLimit()) { break; } // 如果结果集超过大小了, 不再到其他 ShardTree 中获取数据
         }
         if (!s.ok()) { return s; }
 #else
         std::vector<std::future<Status>> thread_status;
-        for (size_t i = 0; i < m_trees.size(); ++i) {
+        for (size_t i = 0; i < trees->size(); ++i) {
             thread_status.emplace_back(
-                    m_query_pool.enqueue(ShardTree::MtiGetOutE, m_trees[i], &req, pQueryResult)
+                    m_query_pool.enqueue(ShardTree::MtiGetOutE, (*trees)[i], &req, pQueryResult)
             );
         }
         for (auto &&thread_statu : thread_status) {
@@ -273,6 +332,7 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     Status SkgDBImpl::GetBothEdges(VertexRequest &req, EdgesQueryResult *pQueryResult) const {
+        const auto trees = LoadShardTrees();
         assert(pQueryResult != nullptr);
         pQueryResult->Clear(); // 清空结果集, 防止结果集中存着之前的数据
 
@@ -286,8 +346,8 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
 
 //        metrics::GetInstance()->start_time("SkgDBImpl.GetOutEdges.shards", metric_duration_type::MILLISECONDS);
         // both-edges, 可能存在于所有 ShardTree 中
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            s = m_trees[i]->GetBothEdges(req, pQueryResult);
+        for (size_t i = 0; i < trees->size(); ++i) {
+            s = (*trees)[i]->GetBothEdges(req, pQueryResult);
             if (!s.ok()) { return s; }
             if (s.IsOverLimit()) { break; } // 如果结果集超过大小了, 不再到其他 ShardTree 中获取数据
         }
@@ -306,11 +366,159 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
         return s;
     }
 
+    Status SkgDBImpl::OpenEdgeCursor(VertexRequest &req, EdgeDirection direction,
+                                     const std::string &token, std::unique_ptr<EdgeCursor> *cursor,
+                                     size_t batch_size) const {
+        const auto trees = LoadShardTrees();
+        assert(cursor != nullptr);
+        cursor->reset();
+        Status s;
+        s = PrepareRequest(&req, m_vertex_columns, GetIDEncoder()); // 请求包中的 string-id 转换为 long-id
+        if (!s.ok()) { return s; }
+        // 结果集的 metadata, 每一批都相同
+        MetaHeterogeneousAttributes hAttributes;
+        s = m_edge_attr.MatchQueryMetadata(req.m_columns, &hAttributes);
+        if (!s.ok()) { return s; }
+
+#ifndef SKG_SRC_SPLIT_SHARD
+        const bool in_edges = (direction == EdgeDirection::IN);
+#else
+        const bool in_edges = (direction == EdgeDirection::OUT);
+#endif
+        std::unique_ptr<EdgeCursor> c(new EdgeCursor(
+                *trees, req, in_edges, batch_size, GetIDEncoder(), hAttributes));
+        if (!token.empty()) {
+            s = c->Seek(token);
+            if (!s.ok()) { return s; }
+        }
+        *cursor = std::move(c);
+        return s;
+    }
+
+    Status SkgDBImpl::GetInEdgesBatch(const vid_t *vids, size_t n, const EdgeFilter &filter,
+                                      NeighborBatch *result) const {
+#ifndef SKG_SRC_SPLIT_SHARD
+        return GetEdgesBatch(vids, n, true, filter, result);
+#else
+        return GetEdgesBatch(vids, n, false, filter, result);
+#endif
+    }
+
+    Status SkgDBImpl::GetOutEdgesBatch(const vid_t *vids, size_t n, const EdgeFilter &filter,
+                                       NeighborBatch *result) const {
+#ifndef SKG_SRC_SPLIT_SHARD
+        return GetEdgesBatch(vids, n, false, filter, result);
+#else
+        return GetEdgesBatch(vids, n, true, filter, result);
+#endif
+    }
+
+    Status SkgDBImpl::GetEdgesBatch(const vid_t *vids, size_t n, bool in_edges, const EdgeFilter &filter,
+                                    NeighborBatch *result) const {
+        const auto trees = LoadShardTrees();
+        assert(result != nullptr);
+        result->Clear();
+        result->offsets.assign(n + 1, 0);
+        if (n == 0) { return Status::OK(); }
+
+        // 排序去重, 所有 partition 的索引都按这个顺序查找
+        std::vector<vid_t> sorted(vids, vids + n);
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+        // 每个 ShardTree 负责的节点: out-edges 可能存在于所有 ShardTree 中, in-edges 仅存在于区间包含节点的 ShardTree 中
+        std::vector<std::pair<size_t, size_t>> ranges(trees->size(), std::make_pair(0, sorted.size()));
+        if (in_edges) {
+            for (size_t t = 0; t < trees->size(); ++t) {
+                const interval_t interval = (*trees)[t]->GetInterval();
+                ranges[t].first = std::lower_bound(sorted.begin(), sorted.end(), interval.first) - sorted.begin();
+                ranges[t].second = std::upper_bound(sorted.begin() + ranges[t].first, sorted.end(), interval.second) - sorted.begin();
+            }
+        }
+
+        Status s;
+        std::vector<std::vector<BatchNeighbor>> tree_edges(trees->size());
+#ifndef SKG_QUERY_USE_MT
+        for (size_t t = 0; t < trees->size(); ++t) {
+            if (ranges[t].first >= ranges[t].second) { continue; }
+            s = (*trees)[t]->GetEdgesBatch(sorted.data() + ranges[t].first, ranges[t].second - ranges[t].first,
+                                          in_edges, filter, &tree_edges[t]);
+            if (!s.ok()) { return s; }
+        }
+#else
+        std::vector<std::future<Status>> thread_status;
+        for (size_t t = 0; t < trees->size(); ++t) {
+            if (ranges[t].first >= ranges[t].second) { continue; }
+            thread_status.emplace_back(m_query_pool.enqueue(
+                    ShardTree::MtiGetEdgesBatch, (*trees)[t],
+                    sorted.data() + ranges[t].first, ranges[t].second - ranges[t].first,
+                    in_edges, &filter, &tree_edges[t]));
+        }
+        for (auto &&thread_statu : thread_status) {
+            Status ts = thread_statu.get();
+            if (s.ok() && !ts.ok()) { s = ts; }
+        }
+        if (!s.ok()) { return s; }
+#endif
+
+        // 按 ShardTree 的顺序把各棵树的结果计数排序到每个节点下
+        std::vector<uint64_t> sorted_offsets(sorted.size() + 1, 0);
+        for (size_t t = 0; t < trees->size(); ++t) {
+            for (const auto &edge : tree_edges[t]) {
+                ++sorted_offsets[ranges[t].first + edge.pos + 1];
+            }
+        }
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            sorted_offsets[i + 1] += sorted_offsets[i];
+        }
+        NeighborBatch merged;
+        const uint64_t num_edges = sorted_offsets.back();
+        merged.neighbors.resize(num_edges);
+        merged.weights.resize(num_edges);
+        merged.tags.resize(num_edges);
+        {
+            std::vector<uint64_t> cursor(sorted_offsets.begin(), sorted_offsets.end() - 1);
+            for (size_t t = 0; t < trees->size(); ++t) {
+                for (const auto &edge : tree_edges[t]) {
+                    const uint64_t k = cursor[ranges[t].first + edge.pos]++;
+                    merged.neighbors[k] = edge.neighbor;
+                    merged.weights[k] = edge.weight;
+                    merged.tags[k] = edge.tag;
+                }
+                std::vector<BatchNeighbor>().swap(tree_edges[t]);
+            }
+        }
+
+        // 请求的节点本来就有序且无重复时, 直接返回
+        if (sorted.size() == n && std::equal(sorted.begin(), sorted.end(), vids)) {
+            merged.offsets.swap(sorted_offsets);
+            std::swap(*result, merged);
+            return s;
+        }
+        // 按请求中节点的顺序展开
+        std::vector<size_t> slots(n);
+        for (size_t i = 0; i < n; ++i) {
+            slots[i] = std::lower_bound(sorted.begin(), sorted.end(), vids[i]) - sorted.begin();
+            result->offsets[i + 1] = result->offsets[i] + sorted_offsets[slots[i] + 1] - sorted_offsets[slots[i]];
+        }
+        result->neighbors.reserve(result->offsets.back());
+        result->weights.reserve(result->offsets.back());
+        result->tags.reserve(result->offsets.back());
+        for (size_t i = 0; i < n; ++i) {
+            const uint64_t begin = sorted_offsets[slots[i]], end = sorted_offsets[slots[i] + 1];
+            result->neighbors.insert(result->neighbors.end(), merged.neighbors.begin() + begin, merged.neighbors.begin() + end);
+            result->weights.insert(result->weights.end(), merged.weights.begin() + begin, merged.weights.begin() + end);
+            result->tags.insert(result->tags.end(), merged.tags.begin() + begin, merged.tags.begin() + end);
+        }
+        return s;
+    }
+
 #ifndef SKG_SRC_SPLIT_SHARD
     Status SkgDBImpl::GetInVertices(VertexRequest &req, VertexQueryResult *pQueryResult) const {
 #else
     Status SkgDBImpl::GetOutVertices(VertexRequest &req, VertexQueryResult *pQueryResult) const {
 #endif
+        const auto trees = LoadShardTrees();
         assert(pQueryResult != nullptr);
         Status s;
         s = PrepareRequest(&req, m_vertex_columns, GetIDEncoder());
@@ -319,20 +527,32 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
         VertexQueryResult inVertices;
         // 结果集大小限制
         inVertices.m_nlimit = req.GetLimit();
-        s = Status::NotExist(fmt::format("[{}:{}({})] not exist in shard tree",
-                req.GetLabel(), req.GetVertex(), req.GetVid()));
-        // in-vertices, 仅存在于一个 ShardTree 中
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            if (m_trees[i]->GetInterval().Contain(req.GetVid())) {
-                s = m_trees[i]->GetInVertices(req, &inVertices);
-                break;
+        // 没有过滤条件时, 先查邻居列表缓存
+        const bool useCache = m_adj_cache && req.GetEdgeFilter().empty();
+        if (useCache && m_adj_cache->Get(req.GetVid(), true, req.GetLimit(), &inVertices)) {
+            s = Status::OK();
+        } else {
+            const uint64_t epoch = useCache ? m_adj_cache->GetEpoch() : 0;
+            s = Status::NotExist(fmt::format("[{}:{}({})] not exist in shard tree",
+                    req.GetLabel(), req.GetVertex(), req.GetVid()));
+            // in-vertices, 仅存在于一个 ShardTree 中
+            for (size_t i = 0; i < trees->size(); ++i) {
+                if ((*trees)[i]->GetInterval().Contain(req.GetVid())) {
+                    s = (*trees)[i]->GetInVertices(req, &inVertices);
+                    break;
+                }
             }
-        }
-        if (!s.ok()) {
-            if (s.IsNotExist()) {// 不存在该节点的 in-vertices
-                return Status::OK();
+            if (!s.ok()) {
+                if (s.IsNotExist()) {// 不存在该节点的 in-vertices
+                    return Status::OK();
+                }
+                return s;
+            }
+            // 没有被 limit 截断时, 才是完整的邻居列表
+            if (useCache && (req.GetLimit() == IRequest::NO_LIMIT
+                             || static_cast<ssize_t>(inVertices.Size()) < req.GetLimit())) {
+                m_adj_cache->Put(req.GetVid(), true, epoch, inVertices);
             }
-            return s;
         }
 
         // in-vertices 为空集, 不需要再查询 result 的 metadata
@@ -376,6 +596,7 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
 #else
     Status SkgDBImpl::GetInVertices(VertexRequest &req, VertexQueryResult *pQueryResult) const {
 #endif
+        const auto trees = LoadShardTrees();
         assert(pQueryResult != nullptr);
         Status s;
         s = PrepareRequest(&req, m_vertex_columns, GetIDEncoder());
@@ -384,25 +605,37 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
 #ifndef SKG_QUERY_USE_MT
         VertexQueryResult outVertices;
         outVertices.m_nlimit = req.GetLimit();
-        // out-vertices, 可能存在于所有 ShardTree 中
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            s = m_trees[i]->GetOutVertices(req, &outVertices);
-            if (!s.ok()) { return s; }
-            if (s.IsOverLimit()) { break; } // 如果结果集超过大小了, 不再到其他 ShardTree 中>获取数据
+        // 没有过滤条件时, 先查邻居列表缓存
+        const bool useCache = m_adj_cache && req.GetEdgeFilter().empty();
+        if (useCache && m_adj_cache->Get(req.GetVid(), false, req.GetLimit(), &outVertices)) {
+            s = Status::OK();
+        } else {
+            const uint64_t epoch = useCache ? m_adj_cache->GetEpoch() : 0;
+            // out-vertices, 可能存在于所有 ShardTree 中
+            for (size_t i = 0; i < trees->size(); ++i) {
+                s = (*trees)[i]->GetOutVertices(req, &outVertices);
+                if (!s.ok()) { return s; }
+                if (s.IsOverLimit()) { break; } // 如果结果集超过大小了, 不再到其他 ShardTree 中>获取数据
+            }
+            // 没有被 limit 截断时, 才是完整的邻居列表
+            if (useCache && !s.IsOverLimit() && (req.GetLimit() == IRequest::NO_LIMIT
+                             || static_cast<ssize_t>(outVertices.Size()) < req.GetLimit())) {
+                m_adj_cache->Put(req.GetVid(), false, epoch, outVertices);
+            }
         }
 #else
 #if 0
         VertexQueryResult outVertices;
         outVertices.m_nlimit = req.GetLimit();
         {
-            std::vector<VertexQueryResult> results(m_trees.size());
+            std::vector<VertexQueryResult> results(trees->size());
             // out-vertices, 可能存在于所有 ShardTree 中
             static ::ThreadPool pool(get_option_uint("query_threads", 8));
             std::vector<std::future<Status>> thread_status;
-            for (size_t i = 0; i < m_trees.size(); ++i) {
+            for (size_t i = 0; i < trees->size(); ++i) {
                 results[i].m_nlimit = req.GetLimit();
                 thread_status.emplace_back(
-                        pool.enqueue(ShardTree::GetOutV, m_trees[i], &req, &results[i])
+                        pool.enqueue(ShardTree::GetOutV, (*trees)[i], &req, &results[i])
                 );
             }
             for (size_t i = 0; i < thread_status.size(); ++i) {
@@ -419,16 +652,28 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
 #else
         VertexQueryResult outVertices;
         outVertices.m_nlimit = req.GetLimit();
-        // out-vertices, 可能存在于所有 ShardTree 中
-        std::vector<std::future<Status>> thread_status;
-        for (const auto &tree : m_trees) {
-            thread_status.emplace_back(
-                    m_query_pool.enqueue(ShardTree::MtiGetOutV, tree, &req, &outVertices)
-            );
-        }
-        for (auto &&thread_statu : thread_status) {
-            s = thread_statu.get();
-            if (!s.ok()) { return s; }
+        // 没有过滤条件时, 先查邻居列表缓存
+        const bool useCache = m_adj_cache && req.GetEdgeFilter().empty();
+        if (useCache && m_adj_cache->Get(req.GetVid(), false, req.GetLimit(), &outVertices)) {
+            s = Status::OK();
+        } else {
+            const uint64_t epoch = useCache ? m_adj_cache->GetEpoch() : 0;
+            // out-vertices, 可能存在于所有 ShardTree 中
+            std::vector<std::future<Status>> thread_status;
+            for (const auto &tree : *trees) {
+                thread_status.emplace_back(
+                        m_query_pool.enqueue(ShardTree::MtiGetOutV, tree, &req, &outVertices)
+                );
+            }
+            for (auto &&thread_statu : thread_status) {
+                s = thread_statu.get();
+                if (!s.ok()) { return s; }
+            }
+            // 没有被 limit 截断时, 才是完整的邻居列表
+            if (useCache && (req.GetLimit() == IRequest::NO_LIMIT
+                             || static_cast<ssize_t>(outVertices.Size()) < req.GetLimit())) {
+                m_adj_cache->Put(req.GetVid(), false, epoch, outVertices);
+            }
         }
 #endif
 #endif
@@ -470,6 +715,7 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     Status SkgDBImpl::GetBothVertices(VertexRequest &req, VertexQueryResult *pQueryResult) const {
+        const auto trees = LoadShardTrees();
         assert(pQueryResult != nullptr);
         Status s;
         s = PrepareRequest(&req, m_vertex_columns, GetIDEncoder());
@@ -478,8 +724,8 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
         VertexQueryResult bothVertices;
         bothVertices.m_nlimit = req.GetLimit();
         // both-vertices, 可能存在于所有 ShardTree 中
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            s = m_trees[i]->GetBothVertices(req, &bothVertices);
+        for (size_t i = 0; i < trees->size(); ++i) {
+            s = (*trees)[i]->GetBothVertices(req, &bothVertices);
             if (!s.ok()) { return s; }
             if (s.IsOverLimit()) { break; } // 如果结果集超过大小了, 不再到其他 ShardTree 中获取数据
         }
@@ -544,15 +790,22 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     Status SkgDBImpl::RedoDeleteEdge(EdgeRequest &req) {
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            if (m_trees[i]->GetInterval().Contain(req.m_dstVid)) {
-                return m_trees[i]->DeleteEdge(req);
+        const auto trees = LoadShardTrees();
+        for (size_t i = 0; i < trees->size(); ++i) {
+            if ((*trees)[i]->GetInterval().Contain(req.m_dstVid)) {
+                Status s = (*trees)[i]->DeleteEdge(req);
+                if (s.ok()) {
+                    m_vertex_columns->AddDegree(req.m_srcVid, req.m_dstVid, -1);
+                    InvalidateAdjacency(req.m_srcVid, req.m_dstVid);
+                }
+                return s;
             }
         }
         return Status::NotExist();
     }
 
     Status SkgDBImpl::GetEdgeAttr(/* const */EdgeRequest &req, EdgesQueryResult *pQueryResult) {
+        const auto trees = LoadShardTrees();
         assert(pQueryResult != nullptr);
         pQueryResult->Clear(); // 清空结果集, 防止结果集中存着之前的数据
 
@@ -560,9 +813,9 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
         s = PrepareRequest(&req, m_vertex_columns, GetIDEncoder()); // 请求包中的 string-id 转换为 long-id
         if (!s.ok()) { return s; }
 
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            if (m_trees[i]->GetInterval().Contain(req.m_dstVid)) {
-                s = m_trees[i]->GetEdgeAttributes(req, pQueryResult);
+        for (size_t i = 0; i < trees->size(); ++i) {
+            if ((*trees)[i]->GetInterval().Contain(req.m_dstVid)) {
+                s = (*trees)[i]->GetEdgeAttributes(req, pQueryResult);
                 if (!s.ok()) { return s; }
 
                 // 组织回包数据. 结果集中, long-id 转换为 string-id
@@ -614,15 +867,24 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     Status SkgDBImpl::RedoAddEdge(/* const */ EdgeRequest &req) {
+        const auto trees = LoadShardTrees();
         Status s;
         // 写操作, 需要保证写入的节点id有足够的存储空间
         s = m_vertex_columns->UpdateMaxVertexID(std::max(req.m_srcVid, req.m_dstVid));
         if (!s.ok()) { return s; }
 
         //LogShardInfos();
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            if (m_trees[i]->GetInterval().Contain(req.m_dstVid) || i == m_trees.size() - 1) {
-                return m_trees[i]->AddEdge(req);  // TODO 添加边后, ShardTree产生分裂. 需要更新数据
+        for (size_t i = 0; i < trees->size(); ++i) {
+            if ((*trees)[i]->GetInterval().Contain(req.m_dstVid) || i == trees->size() - 1) {
+                bool created = false;
+                s = (*trees)[i]->AddEdge(req, &created);  // TODO 添加边后, ShardTree产生分裂. 需要更新数据
+                // 只有插入了新的边才更新度, 更新已有边的属性不改变度
+                if (s.ok() && created) {
+                    m_vertex_columns->AddDegree(req.m_srcVid, req.m_dstVid, 1);
+                    InvalidateAdjacency(req.m_srcVid, req.m_dstVid);
+                    s = MaybeSplitShard(i);
+                }
+                return s;
             }
         }
         //LogShardInfos();
@@ -630,6 +892,130 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
         return Status();
     }
 
+    Status SkgDBImpl::MaybeSplitShard(size_t index) {
+        if (m_options.shard_partition != Options::ShardPartition::BALANCED) { return Status::OK(); }
+        const auto trees = LoadShardTrees();
+        const ShardTreePtr &tree = (*trees)[index];
+        const size_t size = tree->GetEstimateSize();
+        if (size <= m_options.init_shard_size_mb() * MB_BYTES) { return Status::OK(); }
+        const auto retry = m_split_retry_sizes.find(tree->id());
+        if (retry != m_split_retry_sizes.end() && size < retry->second) { return Status::OK(); }
+        if (trees->size() >= MAX_SHARD_TREES) {
+            SKG_LOG_WARNING("shard-tree: {} is full, but the number of shard-trees reaches {}",
+                            tree->id(), MAX_SHARD_TREES);
+            m_split_retry_sizes[tree->id()] = size * 2;
+            return Status::OK();
+        }
+
+        // MemTable 中的边刷到磁盘后, 采样所有入边的 dst, 取边数的中位数作为分裂点
+        Status s = tree->Flush();
+        if (!s.ok()) { return s; }
+        const interval_t interval = tree->GetInterval();
+        std::vector<vid_t> dsts;
+        s = tree->ScanInEdges(interval, std::set<std::string>(), [&dsts](const PersistentEdge &edge) {
+            dsts.push_back(edge.dst);
+        });
+        if (!s.ok()) { return s; }
+        ShardBalancer balancer(m_options);
+        balancer.Sample(dsts.data(), dsts.size());
+        dsts.clear(); dsts.shrink_to_fit();
+        const std::vector<vid_t> starts = balancer.Split(2);
+        if (starts.size() < 2 || starts[1] <= interval.first || starts[1] > interval.second) {
+            // 边集中在少数节点上, 无法拆开
+            SKG_LOG_INFO("shard-tree: {} {} is full, size: {:.1f}MB, but can NOT be split",
+                         tree->id(), interval, 1.0 * size / MB_BYTES);
+            m_split_retry_sizes[tree->id()] = size * 2;
+            return Status::OK();
+        }
+        const vid_t pivot = starts[1];
+
+        uint32_t shard_id = MIN_SHARD_ID;
+        for (const auto &t : *trees) {
+            shard_id = std::max(shard_id, t->id() + 1);
+        }
+        SKG_LOG_INFO("shard-tree: {} {} is full, size: {:.1f}MB, move edges to {} into new shard-tree: {}",
+                     tree->id(), interval, 1.0 * size / MB_BYTES, pivot, shard_id);
+        ShardTreePtr upper;
+        s = CreateShardTree(shard_id, interval_t(pivot, interval.second), &upper);
+        if (!s.ok()) { return s; }
+        s = tree->MoveEdgesTo(pivot, upper.get());
+        if (!s.ok()) { return s; }
+
+        // 缩小后的区间与新的 ShardTree 在同一个列表中替换, 查询不会看到只更新了一半的划分
+        std::shared_ptr<ShardTreeList> new_trees = std::make_shared<ShardTreeList>(*trees);
+        (*new_trees)[index] = tree->WithInterval(interval_t(interval.first, pivot - 1));
+        new_trees->insert(new_trees->begin() + index + 1, std::move(upper));
+        m_split_retry_sizes.erase(tree->id());
+        return PublishShardTrees(std::move(new_trees));
+    }
+
+    Status SkgDBImpl::CreateShardTree(uint32_t shard_id, const interval_t &interval, ShardTreePtr *tree) {
+        Status s;
+        const std::string dir = GetStorageDirname();
+        // 新的 partition 从 db 目录中读取边属性, 先写入当前的配置
+        s = MetadataFileHandler::WriteEdgeAttrConf(dir, m_edge_attr);
+        if (!s.ok()) { return s; }
+        s = ShardTree::Create(dir, shard_id, MetaPartition(shard_id, interval), m_edge_attr);
+        if (!s.ok()) { return s; }
+        return ShardTree::Open(dir, shard_id, interval, m_options, tree);
+    }
+
+    Status SkgDBImpl::PublishShardTrees(std::shared_ptr<const ShardTreeList> trees) {
+        // 正在遍历旧列表的查询不受影响
+        std::atomic_store(&m_trees, std::move(trees));
+        return WriteShardInfo();
+    }
+
+    Status SkgDBImpl::WriteShardInfo() {
+        const auto trees = LoadShardTrees();
+        MetaShardInfo meta_shard_info;
+        for (auto &tree : *trees) {
+            meta_shard_info.roots.emplace_back(tree->id(), tree->GetInterval());
+        }
+        return MetadataFileHandler::WriteLSMIntervals(GetStorageDirname(), meta_shard_info);
+    }
+
+    Status SkgDBImpl::PresplitShards(const vid_t *dsts, size_t n) {
+        if (m_options.shard_partition != Options::ShardPartition::BALANCED || n == 0) { return Status::OK(); }
+        std::lock_guard<std::mutex> lock(m_write_lock);
+        const auto trees = LoadShardTrees();
+        if (GetNumEdges() != 0 || trees->size() != 1) {
+            return Status::InvalidArgument("shard-trees can only be pre-split before loading any edge");
+        }
+        // 按最宽的边估计每条边占用的空间, 与 SubEdgePartition::GetEstimateSize 一致
+        size_t bytes_per_edge = sizeof(PersistentEdge);
+        for (const auto &attributes : m_edge_attr) {
+            bytes_per_edge = std::max(bytes_per_edge, sizeof(PersistentEdge) + attributes.GetColumnsValueByteSize());
+        }
+        const double shard_bytes = std::max(1.0, static_cast<double>(m_options.init_shard_size_mb() * MB_BYTES));
+        const size_t num_shards = std::min(MAX_SHARD_TREES,
+                                           static_cast<size_t>(std::ceil(n * bytes_per_edge / shard_bytes)));
+        if (num_shards <= 1) { return Status::OK(); }
+
+        ShardBalancer balancer(m_options);
+        balancer.Sample(dsts, n);
+        const std::vector<vid_t> starts = balancer.Split(num_shards);
+        SKG_LOG_INFO("pre-split {} edges into {} shard-trees, {} edges sampled",
+                     n, starts.size(), balancer.GetNumSampled());
+        if (starts.size() <= 1) { return Status::OK(); }
+
+        Status s;
+        std::shared_ptr<ShardTreeList> new_trees = std::make_shared<ShardTreeList>();
+        new_trees->emplace_back();
+        uint32_t shard_id = trees->front()->id();
+        for (size_t i = 1; i < starts.size(); ++i) {
+            const vid_t last = (i + 1 < starts.size()) ? starts[i + 1] - 1 : starts[i];
+            ShardTreePtr tree;
+            s = CreateShardTree(++shard_id, interval_t(starts[i], last), &tree);
+            if (!s.ok()) { return s; }
+            new_trees->emplace_back(std::move(tree));
+        }
+        // 第一个 ShardTree 的区间调整后与新的 ShardTree 一起替换
+        const ShardTreePtr &front = trees->front();
+        new_trees->front() = front->WithInterval(interval_t(front->GetInterval().first, starts[1] - 1));
+        return PublishShardTrees(std::move(new_trees));
+    }
+
     Status SkgDBImpl::SetEdgeAttr(/* const */EdgeRequest &req) {
         // 加锁,  禁止其它写操作. TODO 在其他修改操作的地方尝试获取锁 TODO: rethink 加锁延后？
         // 使用 std::lock_guard 获取锁, 在析构时自动释放锁. http://zh.cppreference.com/w/cpp/thread/lock_guard
@@ -663,15 +1049,22 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     Status SkgDBImpl::RedoSetEdgeAttr(EdgeRequest &req) {
+        const auto trees = LoadShardTrees();
         Status s;
         // 写操作, 需要保证写入的节点id有足够的存储空间
         s = m_vertex_columns->UpdateMaxVertexID(std::max(req.m_srcVid, req.m_dstVid));
         if (!s.ok()) { return s; }
 
         //LogShardInfos();
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            if (m_trees[i]->GetInterval().Contain(req.m_dstVid) || i == m_trees.size() - 1) {
-                return m_trees[i]->SetEdgeAttributes(req);
+        for (size_t i = 0; i < trees->size(); ++i) {
+            if ((*trees)[i]->GetInterval().Contain(req.m_dstVid) || i == trees->size() - 1) {
+                bool created = false;
+                s = (*trees)[i]->SetEdgeAttributes(req, &created);
+                if (s.ok() && created) {
+                    m_vertex_columns->AddDegree(req.m_srcVid, req.m_dstVid, 1);
+                    InvalidateAdjacency(req.m_srcVid, req.m_dstVid);
+                }
+                return s;
             }
         }
         //LogShardInfos();
@@ -679,6 +1072,8 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
         return Status::NotExist();
     }
 
+    const size_t SkgDBImpl::MAX_SHARD_TREES;
+
     std::string SkgDBImpl::GetName() const {
         return m_name;
     }
@@ -693,18 +1088,45 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     size_t SkgDBImpl::GetNumEdges() const {
+        const auto trees = LoadShardTrees();
         size_t num_edges = 0;
-        for (const auto &tree : m_trees) {
+        for (const auto &tree : *trees) {
             num_edges += tree->GetNumEdges();
         }
         return num_edges;
     }
 
+    std::vector<size_t> SkgDBImpl::GetNumEdgesPerShard() const {
+        const auto trees = LoadShardTrees();
+        std::vector<size_t> num_edges;
+        num_edges.reserve(trees->size());
+        for (const auto &tree : *trees) {
+            num_edges.push_back(tree->GetNumEdges());
+        }
+        return num_edges;
+    }
+
     std::shared_ptr<IDEncoder> SkgDBImpl::GetIDEncoder() const 
     {
         return m_id_encoder;
     }
 
+    Status SkgDBImpl::SetVertexOrder(const std::vector<vid_t> &new_to_old) {
+        std::lock_guard<std::mutex> lock(m_write_lock);
+        if (GetNumEdges() != 0) {
+            return Status::InvalidArgument("vertex order can only be set before loading any edge");
+        }
+        if (std::dynamic_pointer_cast<PermutedIdEncoder>(m_id_encoder) != nullptr) {
+            return Status::InvalidArgument("vertex order is already set");
+        }
+        Status s = PermutedIdEncoder::Save(
+                FILENAME::vertex_order(DIRNAME::meta(GetStorageDirname())), new_to_old);
+        if (!s.ok()) { return s; }
+        m_id_encoder = std::make_shared<PermutedIdEncoder>(m_id_encoder, new_to_old);
+        SKG_LOG_INFO("vertex order of {} vertices is set.", new_to_old.size());
+        return s;
+    }
+
     Status SkgDBImpl::Flush() {
         // Flush 过程加锁, 禁止其他写操作
         // 使用 std::lock_guard 获取锁, 在析构时自动释放锁. http://zh.cppreference.com/w/cpp/thread/lock_guard
@@ -713,11 +1135,12 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     Status SkgDBImpl::FlushUnlocked() {
+        const auto trees = LoadShardTrees();
         Status s;
         LogShardInfos();
         // 边的数据
         metrics::GetInstance()->start_time("SkgDBImpl.FlushTree", metric_duration_type::MILLISECONDS);
-        for (auto &tree : m_trees) {
+        for (auto &tree : *trees) {
             s = tree->Flush();
             if (!s.ok()) { return s; }
         }
@@ -729,12 +1152,7 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
             if (!s.ok()) { return s; }
         }
         // shard tree 划分信息
-        MetaShardInfo meta_shard_info;
-        for (auto &tree : m_trees) {
-            meta_shard_info.roots.emplace_back(tree->id(), tree->GetInterval());
-        }
-        if (!s.ok()) { return s; }
-        s = MetadataFileHandler::WriteLSMIntervals(GetStorageDirname(), meta_shard_info);
+        s = WriteShardInfo();
         if (!s.ok()) { return s; }
         // 边属性列信息
         s = MetadataFileHandler::WriteEdgeAttrConf(GetStorageDirname(), m_edge_attr);
@@ -846,6 +1264,7 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
 
     Status SkgDBImpl::CreateNewEdgeLabel(
             const EdgeLabel &label) {
+        const auto trees = LoadShardTrees();
         if (label.edge_label.empty()) {
             return Status::InvalidArgument("edge label can NOT be empty!");
         }
@@ -885,7 +1304,7 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
         if (s.ok()) {
             // 更新各个 ShardTree 的边属性配置
             auto properties = m_edge_attr.GetAttributesByEdgeLabel(label);
-            for (const auto &tree: m_trees) {
+            for (const auto &tree: *trees) {
                 s = tree->CreateNewEdgeLabel(
                         label,
                         properties->label_tag, properties->src_tag, properties->dst_tag);
@@ -896,6 +1315,7 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     Status SkgDBImpl::CreateEdgeAttrCol(const EdgeLabel &label, ColumnDescriptor config) {
+        const auto trees = LoadShardTrees();
         Status s;
 #if 0
         if (req.IsWALEnabled()) {
@@ -928,8 +1348,8 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
 
         if (s.ok()) {
             // 到每个 ShardTree 中创建新的属性列
-            for (size_t i = 0; i < m_trees.size(); ++i) {
-                s = m_trees[i]->CreateEdgeAttrCol(label, config);
+            for (size_t i = 0; i < trees->size(); ++i) {
+                s = (*trees)[i]->CreateEdgeAttrCol(label, config);
                 if (!s.ok()) { return s; }
             }
         }
@@ -940,6 +1360,7 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     Status SkgDBImpl::DeleteEdgeAttrCol(const EdgeLabel &label, const std::string &columnName) {
+        const auto trees = LoadShardTrees();
         Status s;
 #if 0
         if (req.IsWALEnabled()) {
@@ -956,8 +1377,8 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
         }
 #endif
         // 到每个 ShardTree 中删除属性列
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            s = m_trees[i]->DeleteEdgeAttrCol(label, columnName);
+        for (size_t i = 0; i < trees->size(); ++i) {
+            s = (*trees)[i]->DeleteEdgeAttrCol(label, columnName);
             if (!s.ok()) { return s; }
         }
 
@@ -985,7 +1406,123 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     Status SkgDBImpl::GenDegreeFile() {
-        return Status::NotImplement();
+        // 扫描只读取磁盘上的边, 先把 MemTable 刷到磁盘, 重建期间禁止写操作
+        std::lock_guard<std::mutex> lock(m_write_lock);
+        const auto trees = LoadShardTrees();
+        Status s = this->FlushUnlocked();
+        if (!s.ok()) { return s; }
+
+        metrics::GetInstance()->start_time("SkgDBImpl.GenDegreeFile", metric_duration_type::MILLISECONDS);
+        s = m_vertex_columns->ResetDegrees();
+        if (!s.ok()) { return s; }
+        const interval_t all_vertices(0, m_vertex_columns->GetNumVertices() - 1);
+        const std::set<std::string> all_labels;
+        VertexColumnList *columns = m_vertex_columns.get();
+        const EdgeVisitor visitor = [columns](const PersistentEdge &edge) {
+            columns->AddDegree(edge.src, edge.dst, 1);
+        };
+        {// 每个 ShardTree 一个任务, 并发扫描所有出边
+            ThreadPool pool(std::max<size_t>(1, std::min<size_t>(m_options.query_threads, trees->size())));
+            std::vector<std::future<Status>> scan_status;
+            for (size_t i = 0; i < trees->size(); ++i) {
+                const ShardTree *tree = (*trees)[i].get();
+                scan_status.emplace_back(pool.enqueue([tree, &all_vertices, &all_labels, &visitor]() {
+                    return tree->ScanOutEdges(all_vertices, all_labels, visitor);
+                }));
+            }
+            for (auto &&status : scan_status) {
+                Status ts = status.get();
+                if (s.ok() && !ts.ok()) { s = ts; }
+            }
+        }
+        metrics::GetInstance()->stop_time("SkgDBImpl.GenDegreeFile");
+        if (!s.ok()) { return s; }
+
+        m_vertex_columns->SetDegreeBuilt(true);
+        return m_vertex_columns->Flush();
+    }
+
+    Status SkgDBImpl::GetDegrees(const vid_t *vids, size_t n, int32_t *in_degrees, int32_t *out_degrees) const {
+        const auto trees = LoadShardTrees();
+        Status s = m_vertex_columns->GetDegrees(vids, n, in_degrees, out_degrees);
+        if (!s.IsNotExist()) { return s; }
+
+        // 度列未建立, 逐个节点扫描 partition 统计
+        const vid_t num_vertices = m_vertex_columns->GetNumVertices();
+        for (size_t k = 0; k < n; ++k) {
+            int in_degree = 0, out_degree = 0;
+            if (vids[k] < num_vertices) {
+                for (size_t i = 0; i < trees->size(); ++i) {
+                    if (in_degrees != nullptr && (*trees)[i]->GetInterval().Contain(vids[k])) {
+                        s = (*trees)[i]->GetInDegree(vids[k], &in_degree);
+                        if (!s.ok()) { return s; }
+                    }
+                    if (out_degrees != nullptr) {
+                        s = (*trees)[i]->GetOutDegree(vids[k], &out_degree);
+                        if (!s.ok()) { return s; }
+                    }
+                }
+            }
+            if (in_degrees != nullptr) { in_degrees[k] = in_degree; }
+            if (out_degrees != nullptr) { out_degrees[k] = out_degree; }
+        }
+        return Status::OK();
+    }
+
+    Status SkgDBImpl::GetVertexAttrColumn(const std::string &label, const std::string &columnName,
+                                          ColumnType *type, std::string *filename) const {
+        return m_vertex_columns->GetVertexAttrColumn(label, columnName, type, filename);
+    }
+
+    Status SkgDBImpl::GatherVertexAttr(const std::string &label, const std::string &columnName,
+                                       const vid_t *vids, size_t n, void *out) const {
+        ColumnType type;
+        std::string filename;
+        Status s = m_vertex_columns->GetVertexAttrColumn(label, columnName, &type, &filename);
+        if (!s.ok()) { return s; }
+        const size_t value_size = (type == ColumnType::INT32 || type == ColumnType::FLOAT32) ? 4 : 8;
+        const VertexColumnList *columns = m_vertex_columns.get();
+        return ParallelForChunks(n, [&](size_t begin, size_t end) {
+            return columns->GatherVertexAttr(label, columnName, vids + begin, end - begin,
+                                             static_cast<char *>(out) + begin * value_size);
+        });
+    }
+
+    Status SkgDBImpl::GatherVertexAttrAsFloat(const std::string &label, const std::vector<std::string> &columnNames,
+                                              const vid_t *vids, size_t n, float *out) const {
+        Status s;
+        const size_t ncols = columnNames.size();
+        const VertexColumnList *columns = m_vertex_columns.get();
+        for (size_t c = 0; c < ncols; ++c) {
+            // 每一列写入 out 的第 c 列, 行之间相隔 ncols 个 float
+            s = ParallelForChunks(n, [&](size_t begin, size_t end) {
+                return columns->GatherVertexAttrAsFloat(label, columnNames[c], vids + begin, end - begin,
+                                                        ncols, out + begin * ncols + c);
+            });
+            if (!s.ok()) { return s; }
+        }
+        return s;
+    }
+
+    Status SkgDBImpl::ParallelForChunks(size_t n, const std::function<Status(size_t, size_t)> &fn) const {
+        // 每段至少 64K 个节点, 避免线程调度的开销超过拷贝本身
+        const size_t min_chunk = 64 * 1024;
+        const size_t nthreads = std::max<size_t>(1, m_options.query_threads);
+        if (n <= min_chunk || nthreads == 1) {
+            return fn(0, n);
+        }
+        const size_t chunk = std::max(min_chunk, (n + nthreads - 1) / nthreads);
+        std::vector<std::future<Status>> chunk_status;
+        for (size_t begin = 0; begin < n; begin += chunk) {
+            const size_t end = std::min(n, begin + chunk);
+            chunk_status.emplace_back(m_query_pool.enqueue(fn, begin, end));
+        }
+        Status s;
+        for (auto &&status : chunk_status) {
+            Status cs = status.get();
+            if (s.ok() && !cs.ok()) { s = cs; }
+        }
+        return s;
     }
 
     Status SkgDBImpl::PrepareRequest(VertexRequest *req, const std::shared_ptr<VertexColumnList> &lst, std::shared_ptr<IDEncoder> encoder) {
@@ -1079,7 +1616,11 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
         s = this->FlushUnlocked();
         if (!s.ok()) { return s; }
         SKG_LOG_INFO("Flush done. resetting handlers", "");
-        m_trees.clear();
+        if (m_adj_cache) {
+            m_adj_cache->ReportMetrics();
+            m_adj_cache->Clear();
+        }
+        std::atomic_store(&m_trees, std::make_shared<const ShardTreeList>());
         m_vertex_columns.reset();
         s = m_id_encoder->Close();
         if (!s.ok()) { return s; }
@@ -1090,6 +1631,7 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     }
 
     Status SkgDBImpl::ExportData(const std::string &out_dir) {
+        const auto trees = LoadShardTrees();
         Status s;
         s = Env::Default()->CreateDirIfMissing(out_dir);
         if (!s.ok()) { return s; }
@@ -1114,8 +1656,8 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
         s = m_vertex_columns->ExportData(out_dir, m_id_encoder);
         if (!s.ok()) { return s; }
         // 导出边信息
-        for (size_t i = 0; i < m_trees.size(); ++i) {
-            s = m_trees[i]->ExportData(out_dir, m_id_encoder);
+        for (size_t i = 0; i < trees->size(); ++i) {
+            s = (*trees)[i]->ExportData(out_dir, m_id_encoder);
             if (!s.ok()) { return s; }
         }
         return s;
@@ -1170,54 +1712,49 @@ Status SkgDBImpl::RecoverHandlers(const MetaShardInfo &meta_shard_info) {
     /*
      * engine
      */
-    /*Status SkgDBImpl::PageRank(const HetnetRequest& hn_req) const {
-        HetnetAction ha;
-        Status s;
-        std::string dbpath = GetStorageDirname();
-        std::string db_dir = PathUtils::os_path_dirname(dbpath);
-        HetnetRequest hr;
-        hr.set(hn_req);
-        hr.db_dir = db_dir;
-        //hr.db_dir = "/data/skg_db/db";
-        hr.db_name = GetName();
-	//fix this
-        //s = ha.async_pagerank(hr);
-        return s;
-    }*/
-        
-    /*Status SkgDBImpl::LPA(const HetnetRequest& hn_req) const {
-        HetnetAction ha;
-        Status s;
-        std::string dbpath = GetStorageDirname();
-        std::string db_dir = PathUtils::os_path_dirname(dbpath);
-        HetnetRequest hr;
-        hr.set(hn_req);
-        hr.db_dir = db_dir;
-        hr.db_name = GetName();
-	//fix this
-        //s = ha.async_LPA(hr);
+    Status SkgDBImpl::PageRank(const HetnetRequest& hn_req, HetnetResult *result) {
+        // 计算引擎只读取磁盘上的边, 先把 MemTable 刷到磁盘, 计算期间禁止写操作
+        std::lock_guard<std::mutex> lock(m_write_lock);
+        const auto trees = LoadShardTrees();
+        Status s = this->FlushUnlocked();
+        if (!s.ok()) { return s; }
+        HetnetAction ha(*trees, m_vertex_columns->GetNumVertices(), GetStorageDirname(), m_options.query_threads);
+        std::vector<vertex_value<float>> top;
+        s = ha.pagerank(hn_req, &result->niters, &top);
+        if (!s.ok()) { return s; }
+        result->top.clear();
+        std::string label, vertex;
+        for (const auto &vv : top) {
+            s = GetIDEncoder()->GetVertexByID(vv.vertex, &label, &vertex);
+            if (!s.ok()) { return s; }
+            result->top.emplace_back(label, vertex, vv.value);
+        }
         return s;
     }
-    */
-        
-    /*Status SkgDBImpl::FastUnfolding(const HetnetRequest& hn_req) const {
-        HetnetAction ha;
-        Status s;
-        std::string dbpath = GetStorageDirname();
-        std::string db_dir = PathUtils::os_path_dirname(dbpath);
-        HetnetRequest hr;
-        hr.set(hn_req);
-        hr.db_dir = db_dir;
-        hr.db_name = GetName();
-	//fix this
-        //s = ha.async_fastunfolding(hr);
+
+    Status SkgDBImpl::LPA(const HetnetRequest& hn_req, HetnetResult *result) {
+        std::lock_guard<std::mutex> lock(m_write_lock);
+        const auto trees = LoadShardTrees();
+        Status s = this->FlushUnlocked();
+        if (!s.ok()) { return s; }
+        HetnetAction ha(*trees, m_vertex_columns->GetNumVertices(), GetStorageDirname(), m_options.query_threads);
+        std::vector<vertex_value<uint32_t>> top;
+        s = ha.lpa(hn_req, &result->niters, &top);
+        if (!s.ok()) { return s; }
+        result->top.clear();
+        std::string label, vertex;
+        for (const auto &vv : top) {
+            s = GetIDEncoder()->GetVertexByID(vv.vertex, &label, &vertex);
+            if (!s.ok()) { return s; }
+            result->top.emplace_back(label, vertex, vv.value);
+        }
         return s;
     }
-    */
 
 
     void SkgDBImpl::LogShardInfos() const {
-        for (auto &tree : m_trees) {
+        const auto trees = LoadShardTrees();
+        for (auto &tree : *trees) {
             const ShardTree::NumEdgesDetail detail = tree->GetNumEdgesDetail();
             SKG_LOG_INFO("shard-id:{}, interval:{}, #edges:{}, #edges-in-mem:{}, #edges-in-disk:{}",
                          tree->id(),
@@ -3,9 +3,12 @@
 
 #include "fs/skgfs.h"
 
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 
 #include "ShardTree.h"
+#include "AdjacencyCache.h"
 #include "VertexColumnList.h"
 #include "util/internal_types.h"
 #include "metrics/metrics.hpp"
@@ -16,11 +19,15 @@
 namespace skg {
     class SkgDBImpl : public SkgDB {
     private:
+        typedef std::vector<ShardTreePtr> ShardTreeList;
+
         explicit SkgDBImpl(const std::string &name, const Options &options)
                 : m_closed(false),
                   m_name(name), m_options(options),
-                  m_trees(),
-                  m_query_pool(options.query_threads) {
+                  m_trees(std::make_shared<const ShardTreeList>()),
+                  m_query_pool(options.query_threads),
+                  m_adj_cache(options.hub_cache_mb == 0 ? nullptr : new AdjacencyCache(
+                          options.hub_cache_mb, options.hub_cache_min_degree, metrics::GetInstance())) {
         }
 
         Status Drop(const std::set<std::string> &ignore) override;
@@ -88,6 +95,16 @@ namespace skg {
          */
         Status GetBothEdges(/* const */VertexRequest &req, EdgesQueryResult *pQueryResult) const override;
 
+        Status OpenEdgeCursor(/* const */VertexRequest &req, EdgeDirection direction,
+                              const std::string &token, std::unique_ptr<EdgeCursor> *cursor,
+                              size_t batch_size = EdgeCursor::DEFAULT_BATCH_SIZE) const override;
+
+        Status GetInEdgesBatch(const vid_t *vids, size_t n, const EdgeFilter &filter,
+                               NeighborBatch *result) const override;
+
+        Status GetOutEdgesBatch(const vid_t *vids, size_t n, const EdgeFilter &filter,
+                                NeighborBatch *result) const override;
+
         /**
          * @brief 获取入边的节点
          * @param req
@@ -173,6 +190,11 @@ namespace skg {
          */
         size_t GetNumEdges() const override;
 
+        /**
+         * 各个 ShardTree 存储的边数
+         */
+        std::vector<size_t> GetNumEdgesPerShard() const override;
+
         /**
          * 所有更改刷到磁盘 (Flush过程中加锁, 阻止写操作)
          * shard-buffer的边
@@ -239,10 +261,25 @@ namespace skg {
         Status GetEdgeAttrNames(const EdgeLabel &label, std::vector<std::string> *names) const override;
 
         /**
-         * 生成节点的度文件
+         * 重建节点的出/入度列
          */
         Status GenDegreeFile() override;
 
+        Status GetDegrees(const vid_t *vids, size_t n, int32_t *in_degrees, int32_t *out_degrees) const override;
+
+        Status SetVertexOrder(const std::vector<vid_t> &new_to_old) override;
+
+        Status PresplitShards(const vid_t *dsts, size_t n) override;
+
+        Status GetVertexAttrColumn(const std::string &label, const std::string &columnName,
+                                   ColumnType *type, std::string *filename) const override;
+
+        Status GatherVertexAttr(const std::string &label, const std::string &columnName,
+                                const vid_t *vids, size_t n, void *out) const override;
+
+        Status GatherVertexAttrAsFloat(const std::string &label, const std::vector<std::string> &columnNames,
+                                       const vid_t *vids, size_t n, float *out) const override;
+
         /**
          * @brief 导出数据(including 节点/关系/Schema)
          * @param out_dir   导出的文件夹
@@ -296,20 +333,22 @@ namespace skg {
             std::vector<PathVertex> *visited) const override;
         /**
          * engine api
-        virtual
-        Status PageRank(const HetnetRequest& hn_req) const override;
-            
-        virtual
-        Status LPA(const HetnetRequest& hn_req) const override;
-            
-        virtual
-        Status FastUnfolding(const HetnetRequest& hn_req) const override;
          */
+        Status PageRank(const HetnetRequest& hn_req, HetnetResult *result) override;
+
+        Status LPA(const HetnetRequest& hn_req, HetnetResult *result) override;
 
     private:
 
         std::shared_ptr<IDEncoder> GetIDEncoder() const ;
 
+        /**
+         * @brief 取得当前 ShardTree 列表的快照. 持有快照期间新增的 ShardTree 不可见
+         */
+        std::shared_ptr<const ShardTreeList> LoadShardTrees() const {
+            return std::atomic_load(&m_trees);
+        }
+
         void LogShardInfos() const;
 
         Status BulkUpdateEdgesRange(
@@ -343,13 +382,58 @@ namespace skg {
         Status RedoDeleteEdge(/* const */ EdgeRequest &req);
         Status RedoDeleteVertex(/* const */ VertexRequest &req);
         Status RedoSetVertexAttr(/* const */ VertexRequest &req);
+
+        /**
+         * @brief 边 src -> dst 发生变化, 使两端节点的邻居列表缓存失效
+         */
+        void InvalidateAdjacency(vid_t src, vid_t dst) {
+            if (m_adj_cache) {
+                m_adj_cache->Invalidate(src);
+                m_adj_cache->Invalidate(dst);
+            }
+        }
+
+        /**
+         * @brief 新建一个负责 interval 的空 ShardTree, 不加入 m_trees
+         */
+        Status CreateShardTree(uint32_t shard_id, const interval_t &interval, ShardTreePtr *tree);
+
+        /**
+         * @brief 用 trees 整体替换 m_trees 并写入划分信息. 调用方需持有写锁
+         */
+        Status PublishShardTrees(std::shared_ptr<const ShardTreeList> trees);
+
+        /**
+         * @brief BALANCED 模式下, 第 index 个 ShardTree 超过 init_shard_size_mb 时,
+         * 按采样的入度在中位数处把区间一分为二, 上半区间的边移动到新的 ShardTree 中
+         */
+        Status MaybeSplitShard(size_t index);
+
+        Status WriteShardInfo();
+
+        /**
+         * @brief GetInEdgesBatch / GetOutEdgesBatch 的实现. in_edges 为存储层的方向
+         */
+        Status GetEdgesBatch(const vid_t *vids, size_t n, bool in_edges, const EdgeFilter &filter,
+                             NeighborBatch *result) const;
+
+        /**
+         * @brief 把 [0, n) 切成若干段, 在查询线程池中并发执行 fn(begin, end). n 较小时直接在当前线程执行
+         */
+        Status ParallelForChunks(size_t n, const std::function<Status(size_t, size_t)> &fn) const;
     private:
         friend class SkgDB;
+        // ShardTree 数量的上限, 超过后不再分裂
+        static const size_t MAX_SHARD_TREES = 1024;
         // 标示db打开/关闭状态
         std::atomic<bool> m_closed;
         std::string m_name;
         Options m_options;
-        std::vector<ShardTreePtr> m_trees;
+        // ShardTree 列表. 查询不加锁, 通过 LoadShardTrees 取得快照后遍历;
+        // 新增 ShardTree 或调整区间时 (持有 m_write_lock) 生成新的列表, 用 std::atomic_store 整体替换
+        std::shared_ptr<const ShardTreeList> m_trees;
+        // 采样后无法分裂的 ShardTree, 大小超过记录的值之后才再次尝试. 持有 m_write_lock 时访问
+        std::unordered_map<uint32_t, size_t> m_split_retry_sizes;
 
         MetaHeterogeneousAttributes m_edge_attr;
         std::shared_ptr<VertexColumnList> m_vertex_columns;
@@ -359,6 +443,8 @@ namespace skg {
         mutable ::ThreadPool m_query_pool;
 #endif
         std::mutex m_write_lock;
+        // 热点节点的邻居列表缓存, 为 nullptr 时不缓存
+        std::unique_ptr<AdjacencyCache> m_adj_cache;
 
         //Version m_version;
         // 恢复日志的写入句柄.
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <sstream>
 #include <ctime>
 #include "fmt/time.h"
@@ -138,8 +139,15 @@ namespace skg {
                     shard_id, partition_id,
                     interval, attributes, options);
         }
-        Status s = partition->OpenHandlers();
-        if (!s.ok()) { return s; }
+        Status s;
+        if (options.lazy_open_partitions) {
+            // 延迟到第一次访问时再打开句柄, 先按文件大小记录边数
+            partition->m_num_disk_edges = static_cast<idx_t>(
+                    PathUtils::getsize(partition->m_edge_list_f->filename()) / sizeof(PersistentEdge));
+        } else {
+            s = partition->OpenHandlers();
+            if (!s.ok()) { return s; }
+        }
         // open column handlers
         IEdgeColumnPartitionPtr fragment;
         for (const auto &column : attributes) {
@@ -152,6 +160,10 @@ namespace skg {
                     partition->GetInterval(), attributes.label_tag,
                     &fragment);
             if (!s.ok()) { return s; }
+            if (options.lazy_open_partitions) {
+                s = fragment->Close();
+                if (!s.ok()) { return s; }
+            }
             partition->m_columns.emplace_back(std::move(fragment));
         }
         partition->ReferByOptions(options);
@@ -166,10 +178,34 @@ namespace skg {
     SubEdgePartition::~SubEdgePartition() {
         // 数据刷到磁盘
         (void) this->FlushCache(true);
+        if (m_lazy_open) {
+            PartitionHandlerCache::GetInstance()->Erase(this);
+        }
+    }
+
+    SubEdgePartition::HandlersGuard::HandlersGuard(const SubEdgePartition *partition, bool open_if_closed)
+            : m_pinned(nullptr), m_status(), m_opened(true) {
+        if (!partition->m_lazy_open) { return; }
+        if (open_if_closed) {
+            m_status = PartitionHandlerCache::GetInstance()->Pin(partition);
+            m_opened = m_status.ok();
+        } else {
+            m_opened = PartitionHandlerCache::GetInstance()->PinIfOpened(partition);
+        }
+        if (m_opened) { m_pinned = partition; }
+    }
+
+    SubEdgePartition::HandlersGuard::~HandlersGuard() {
+        if (m_pinned != nullptr) {
+            PartitionHandlerCache::GetInstance()->Unpin(m_pinned);
+        }
     }
 
     Status SubEdgePartition::Drop() {
         Status s;
+        if (m_lazy_open) {
+            PartitionHandlerCache::GetInstance()->Erase(this);
+        }
         s = this->CloseHandlers();
         if (!s.ok()) { return s; }
         s = DropPartition(m_storage_dir, m_shard_id, m_partition_id, GetInterval(), m_attributes.label_tag);
@@ -187,29 +223,22 @@ namespace skg {
     }
 
     Status SubEdgePartition::DeleteVertex(const VertexRequest &request) {
-        Status s;
-        char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
-        // delete vertex's out-edges
-        idx_t idx = 0;
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
+        // 只记录被删除的节点, 读取时跳过其出边/入边, 重写磁盘数据时去掉
         auto idx_window = m_src_index_f->GetOutIdxRange(request.m_vid);
-        if (idx_window.first != INDEX_NOT_EXIST) {
-            for (idx = idx_window.first; idx < idx_window.second && idx < m_edge_list_f->num_edges(); ++idx) {
-                PersistentEdge *edge = m_edge_list_f->GetMutableEdge(idx, edgeBuf);
-                edge->SetDelete();
-                s = m_edge_list_f->Set(idx, edge);
-            }
+        const bool has_out_edges = idx_window.first != INDEX_NOT_EXIST;
+        const bool has_in_edges = m_dst_index_f->GetFirstInIndex(request.m_vid) != INDEX_NOT_EXIST;
+        if (!has_out_edges && !has_in_edges) {
+            return Status::OK();  // 磁盘中没有该节点的边
         }
-        // delete vertex's in-edges
-        idx = m_dst_index_f->GetFirstInIndex(request.m_vid);
-        if (idx != INDEX_NOT_EXIST) {
-            do {
-                PersistentEdge *edge = m_edge_list_f->GetMutableEdge(idx, edgeBuf);
-                edge->SetDelete();
-                s = m_edge_list_f->Set(idx, edge);
-                idx = edge->next();
-            } while (idx != INDEX_NOT_EXIST);
+        idx_t num_edges = has_out_edges ? idx_window.second - idx_window.first : 0;
+        // 入边分散在 dst 链上, 不逐条统计, 按平均入度估计. 回收前再按实际的已删除边数确认
+        if (has_in_edges) {
+            num_edges += std::max<idx_t>(1, GetNumEdgesInDisk() / std::max<idx_t>(1, m_dst_index_f->num_indices()));
         }
-        return s;
+        m_tombstones.DeleteVertex(request.m_vid, num_edges);
+        return Status::OK();
     }
 
     /**
@@ -218,21 +247,25 @@ namespace skg {
      * @param pQueryResult
      */
     Status SubEdgePartition::GetInEdges(const VertexRequest &req, EdgesQueryResult *pQueryResult) const {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
         char colData[SKG_MAX_EDGE_PROPERTIES_BYTES];
         PropertiesBitset_t bitset;
 //        metrics::GetInstance()->start_time("SubEdgePartition.GetInEdges", metric_duration_type::MILLISECONDS);
 //        metrics::GetInstance()->start_time("SubEdgePartition.GetInEdges.GetDstIdx", metric_duration_type::MILLISECONDS);
+        PartitionFilter filter;
+        if (!PrepareFilter(req.GetEdgeFilter(), &filter)) { return Status::OK(); }
         // TODO: LRU 对经常查询的边做缓存
         idx_t idx = m_dst_index_f->GetFirstInIndex(req.m_vid);
 //        metrics::GetInstance()->stop_time("SubEdgePartition.GetInEdges.GetDstIdx");
         Status s;
         while (idx != INDEX_NOT_EXIST) {
-            memset(colData, 0, SKG_MAX_EDGE_PROPERTIES_BYTES);
+            memset(colData, 0, m_attributes.GetColumnsValueByteSize());
 //            metrics::GetInstance()->start_time("SubEdgePartition.GetInEdges.GetEdge", metric_duration_type::MILLISECONDS);
             const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
 //            metrics::GetInstance()->stop_time("SubEdgePartition.GetInEdges.GetEdge");
-            if (!edge.deleted()) {  // 忽略被删除的边
+            if (!IsDead(edge) && MatchFilter(filter, edge, idx)) {  // 忽略被删除的边
                 // get edge data
 //                metrics::GetInstance()->start_time("SubEdgePartition.GetInEdges.GetEdgeProp", metric_duration_type::MILLISECONDS);
                 s = CollectProperties(edge, idx, req.m_columns, colData, &bitset);
@@ -261,9 +294,21 @@ namespace skg {
      * @param pQueryResult
      */
     Status SubEdgePartition::GetOutEdges(const VertexRequest &req, EdgesQueryResult *pQueryResult) const {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
         char colData[SKG_MAX_EDGE_PROPERTIES_BYTES];
         PropertiesBitset_t bitset;
+        PartitionFilter filter;
+        if (!PrepareFilter(req.GetEdgeFilter(), &filter)) { return Status::OK(); }
+        if (req.m_columns.empty()) {
+            std::vector<vid_t> dsts;
+            std::vector<EdgeWeight_t> weights;
+            ScanOutTopology(req.m_vid, filter, &dsts, &weights);
+            return pQueryResult->ReceiveEdges(
+                    req.m_vid, dsts.data(), weights.data(), dsts.size(),
+                    m_attributes.label_tag, m_attributes.GetColumnsValueByteSize());
+        }
         // TODO: LRU 对经常查询的边做缓存
 //        metrics::GetInstance()->start_time("SubEdgePartition.GetOutEdges", metric_duration_type::MILLISECONDS);
 //        metrics::GetInstance()->start_time("SubEdgePartition.GetOutEdges.GetSrcIdx",metric_duration_type::MILLISECONDS);
@@ -274,12 +319,16 @@ namespace skg {
             for (idx_t idx = idx_window.first;
                  idx < idx_window.second && idx < m_edge_list_f->num_edges();
                  ++idx) {
-                memset(colData, 0, SKG_MAX_EDGE_PROPERTIES_BYTES);
+                if (!filter.empty() && !m_zone_map.MayMatch(filter.bound, idx)) {
+                    idx = ZoneMap::BlockEnd(idx) - 1;  // 整个 block 都不满足过滤条件
+                    continue;
+                }
+                memset(colData, 0, m_attributes.GetColumnsValueByteSize());
                 bitset.Clear();
 //                metrics::GetInstance()->start_time("SubEdgePartition.GetOutEdges.GetEdge",metric_duration_type::MILLISECONDS);
                 const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
 //                metrics::GetInstance()->stop_time("SubEdgePartition.GetOutEdges.GetEdge");
-                if (!edge.deleted()) {  // 忽略被删除的边
+                if (!IsDead(edge) && MatchFilter(filter, edge, idx)) {  // 忽略被删除的边
                     // get edge data
 //                    metrics::GetInstance()->start_time("SubEdgePartition.GetOutEdges.GetEdgeProp",metric_duration_type::MILLISECONDS);
                     s = CollectProperties(edge, idx, req.m_columns, colData, &bitset);
@@ -303,20 +352,35 @@ namespace skg {
     }
 
     Status SubEdgePartition::GetBothEdges(const VertexRequest &req, EdgesQueryResult *result) const {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         Status s;
         char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
         char colData[SKG_MAX_EDGE_PROPERTIES_BYTES];
         PropertiesBitset_t bitset;
-        {// out-edges
+        PartitionFilter filter;
+        if (!PrepareFilter(req.GetEdgeFilter(), &filter)) { return s; }
+        if (req.m_columns.empty()) {// out-edges, 不取属性
+            std::vector<vid_t> dsts;
+            std::vector<EdgeWeight_t> weights;
+            ScanOutTopology(req.m_vid, filter, &dsts, &weights);
+            s = result->ReceiveEdges(
+                    req.m_vid, dsts.data(), weights.data(), dsts.size(),
+                    m_attributes.label_tag, m_attributes.GetColumnsValueByteSize());
+        } else {// out-edges
             auto idx_window = m_src_index_f->GetOutIdxRange(req.m_vid);
             if (idx_window.first != INDEX_NOT_EXIST) {  // 索引中找到src范围
                 for (idx_t idx = idx_window.first;
                      idx < idx_window.second && idx < m_edge_list_f->num_edges();
                      ++idx) {
-                    memset(colData, 0, SKG_MAX_EDGE_PROPERTIES_BYTES);
+                    if (!filter.empty() && !m_zone_map.MayMatch(filter.bound, idx)) {
+                        idx = ZoneMap::BlockEnd(idx) - 1;  // 整个 block 都不满足过滤条件
+                        continue;
+                    }
+                    memset(colData, 0, m_attributes.GetColumnsValueByteSize());
                     bitset.Clear();
                     const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
-                    if (!edge.deleted()) {  // 忽略被删除的边
+                    if (!IsDead(edge) && MatchFilter(filter, edge, idx)) {  // 忽略被删除的边
                         // get edge data
                         s = CollectProperties(edge, idx, req.m_columns, colData, &bitset);
                         if (!s.ok()) { return s; }
@@ -335,9 +399,9 @@ namespace skg {
         {// in-edges
             idx_t idx = m_dst_index_f->GetFirstInIndex(req.m_vid);
             while (idx != INDEX_NOT_EXIST) {
-                memset(colData, 0, SKG_MAX_EDGE_PROPERTIES_BYTES);
+                memset(colData, 0, m_attributes.GetColumnsValueByteSize());
                 const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
-                if (!edge.deleted()) {  // 忽略被删除的边
+                if (!IsDead(edge) && MatchFilter(filter, edge, idx)) {  // 忽略被删除的边
                     // get edge data
                     s = CollectProperties(edge, idx, req.m_columns, colData, &bitset);
                     if (!s.ok()) { return s; }
@@ -356,12 +420,172 @@ namespace skg {
         return s;
     }
 
+    Status SubEdgePartition::ScanEdgesFrom(const VertexRequest &req, bool in_edges,
+                                           EdgeScanPosition *pos, EdgesQueryResult *result, bool *finished) const {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
+        *finished = true;
+        PartitionFilter filter;
+        if (!PrepareFilter(req.GetEdgeFilter(), &filter)) { return Status::OK(); }
+        char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
+        char colData[SKG_MAX_EDGE_PROPERTIES_BYTES];
+        PropertiesBitset_t bitset;
+        pos->stage = EdgeScanPosition::SCAN_DISK;
+        Status s;
+        if (in_edges) {
+            // 入边在 dst 索引中以链表串联, 记录下一条边的位置
+            idx_t idx = pos->offset == 0 ? m_dst_index_f->GetFirstInIndex(req.m_vid) : pos->offset - 1;
+            while (idx != INDEX_NOT_EXIST && idx < m_edge_list_f->num_edges()) {
+                const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
+                if (!IsDead(edge) && MatchFilter(filter, edge, idx)) {  // 忽略被删除的边
+                    memset(colData, 0, m_attributes.GetColumnsValueByteSize());
+                    bitset.Clear();
+                    s = CollectProperties(edge, idx, req.m_columns, colData, &bitset);
+                    if (!s.ok()) { return s; }
+                    s = result->ReceiveEdge(
+                            edge.src, edge.dst,
+                            edge.weight, edge.tag,
+                            colData, m_attributes.GetColumnsValueByteSize(),
+                            bitset
+                    );
+                    if (s.IsOverLimit()) {  // 本批已满, 下次从这条边开始
+                        pos->offset = idx + 1;
+                        *finished = false;
+                        return Status::OK();
+                    }
+                }
+                idx = edge.next();
+            }
+            return Status::OK();
+        }
+
+        auto idx_window = m_src_index_f->GetOutIdxRange(req.m_vid);
+        if (idx_window.first == INDEX_NOT_EXIST) { return Status::OK(); }
+        for (idx_t idx = idx_window.first + pos->offset;
+             idx < idx_window.second && idx < m_edge_list_f->num_edges();
+             ++idx) {
+            if (!filter.empty() && !m_zone_map.MayMatch(filter.bound, idx)) {
+                idx = ZoneMap::BlockEnd(idx) - 1;  // 整个 block 都不满足过滤条件
+                continue;
+            }
+            const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
+            if (!IsDead(edge) && MatchFilter(filter, edge, idx)) {  // 忽略被删除的边
+                memset(colData, 0, m_attributes.GetColumnsValueByteSize());
+                bitset.Clear();
+                s = CollectProperties(edge, idx, req.m_columns, colData, &bitset);
+                if (!s.ok()) { return s; }
+                s = result->ReceiveEdge(
+                        edge.src, edge.dst,
+                        edge.weight, edge.tag,
+                        colData, m_attributes.GetColumnsValueByteSize(),
+                        bitset
+                );
+                if (s.IsOverLimit()) {  // 本批已满, 下次从这条边开始
+                    pos->offset = idx - idx_window.first;
+                    *finished = false;
+                    return Status::OK();
+                }
+            }
+        }
+        return Status::OK();
+    }
+
+    Status SubEdgePartition::GetEdgesBatch(const vid_t *vids, size_t n, uint32_t pos_base, bool in_edges,
+                                           const EdgeFilter &edge_filter, std::vector<BatchNeighbor> *edges) const {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
+        if (n == 0) { return Status::OK(); }
+        PartitionFilter filter;
+        if (!PrepareFilter(edge_filter, &filter)) { return Status::OK(); }
+        Status s;
+        std::string buf;
+        if (in_edges) {
+            // 入边是按 dst 串起来的链表. 所有节点的链表同步向前走, 每一步的读请求一起提交
+            std::vector<idx_t> cursors(n);
+            s = m_dst_index_f->GetFirstInIndexes(vids, n, cursors.data());
+            if (!s.ok()) { return s; }
+            std::vector<size_t> actives;
+            for (size_t i = 0; i < n; ++i) {
+                if (cursors[i] != INDEX_NOT_EXIST) { actives.push_back(i); }
+            }
+            std::vector<std::pair<idx_t, idx_t>> ranges;
+            std::vector<const PersistentEdge *> blocks;
+            while (!actives.empty()) {
+                ranges.resize(actives.size());
+                blocks.resize(actives.size());
+                for (size_t k = 0; k < actives.size(); ++k) {
+                    const idx_t idx = cursors[actives[k]];
+                    ranges[k] = std::make_pair(idx, idx + 1);
+                }
+                s = m_edge_list_f->GetImmutableEdgesMulti(ranges.data(), ranges.size(), &buf, blocks.data());
+                if (!s.ok()) { return s; }
+                size_t remains = 0;
+                for (size_t k = 0; k < actives.size(); ++k) {
+                    const size_t i = actives[k];
+                    const PersistentEdge &edge = *blocks[k];
+                    if (!IsDead(edge) && MatchFilter(filter, edge, cursors[i])) {  // 忽略被删除的边
+                        edges->emplace_back(pos_base + i, edge.src, edge.weight, edge.tag);
+                    }
+                    cursors[i] = edge.next();
+                    if (cursors[i] != INDEX_NOT_EXIST) { actives[remains++] = i; }
+                }
+                actives.resize(remains);
+            }
+            return Status::OK();
+        }
+
+        // 每段读取的边数
+        static const idx_t SCAN_BLOCK_EDGES = 4096;
+        // 一次提交的读请求的总边数, 限制 buf 的大小
+        static const idx_t SUBMIT_EDGES = 16 * SCAN_BLOCK_EDGES;
+        std::vector<std::pair<idx_t, idx_t>> windows(n);
+        s = m_src_index_f->GetOutIdxRanges(vids, n, windows.data());
+        if (!s.ok()) { return s; }
+        const idx_t num_edges = m_edge_list_f->num_edges();
+        // 先切出所有的段, 再按 SUBMIT_EDGES 分组一起读取
+        std::vector<std::pair<idx_t, idx_t>> ranges;
+        std::vector<size_t> owners;
+        for (size_t i = 0; i < n; ++i) {
+            if (windows[i].first == INDEX_NOT_EXIST) { continue; }
+            const idx_t end = std::min<idx_t>(windows[i].second, num_edges);
+            for (idx_t begin = windows[i].first; begin < end; begin += SCAN_BLOCK_EDGES) {
+                ranges.emplace_back(begin, std::min<idx_t>(begin + SCAN_BLOCK_EDGES, end));
+                owners.push_back(i);
+            }
+        }
+        std::vector<const PersistentEdge *> blocks(ranges.size());
+        for (size_t first = 0; first < ranges.size();) {
+            size_t last = first;
+            idx_t submitted = 0;
+            while (last < ranges.size() && (last == first || submitted + (ranges[last].second - ranges[last].first) <= SUBMIT_EDGES)) {
+                submitted += ranges[last].second - ranges[last].first;
+                ++last;
+            }
+            s = m_edge_list_f->GetImmutableEdgesMulti(&ranges[first], last - first, &buf, &blocks[first]);
+            if (!s.ok()) { return s; }
+            for (size_t r = first; r < last; ++r) {
+                const PersistentEdge *block = blocks[r];
+                for (idx_t k = 0; k < ranges[r].second - ranges[r].first; ++k) {
+                    const PersistentEdge &edge = block[k];
+                    if (IsDead(edge) || !MatchFilter(filter, edge, ranges[r].first + k)) { continue; }
+                    edges->emplace_back(pos_base + owners[r], edge.dst, edge.weight, edge.tag);
+                }
+            }
+            first = last;
+        }
+        return Status::OK();
+    }
+
     Status SubEdgePartition::GetInVertices(const VertexRequest &req, VertexQueryResult *result) const {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
+        PartitionFilter filter;
+        if (!PrepareFilter(req.GetEdgeFilter(), &filter)) { return Status::OK(); }
         idx_t idx = m_dst_index_f->GetFirstInIndex(req.m_vid);
         char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
         while (idx != INDEX_NOT_EXIST) {
             const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
-            if (!edge.deleted()) {  // 忽略被删除的边
+            if (!IsDead(edge) && MatchFilter(filter, edge, idx)) {  // 忽略被删除的边
                 // put to result
                 assert(req.m_vid == edge.dst);
                 assert(edge.tag == m_attributes.label_tag);
@@ -378,21 +602,14 @@ namespace skg {
     }
 
     Status SubEdgePartition::GetOutVertices(const VertexRequest &req, VertexQueryResult *result) const {
-        char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
-        // 索引中找到src范围
-        auto idx_window = m_src_index_f->GetOutIdxRange(req.m_vid);
-        for (idx_t idx = idx_window.first;
-             idx < idx_window.second && idx < m_edge_list_f->num_edges();
-             ++idx) {
-            const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
-            if (!edge.deleted()) {  // 忽略被删除的边
-                // put to result
-                assert(req.m_vid == edge.src);
-                assert(edge.tag == m_attributes.label_tag);
-                // label-tag-of-dst, dst-vid
-                result->Receive(m_attributes.dst_tag, edge.dst);
-            }
-        }
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
+        PartitionFilter filter;
+        if (!PrepareFilter(req.GetEdgeFilter(), &filter)) { return Status::OK(); }
+        std::vector<vid_t> dsts;
+        ScanOutTopology(req.m_vid, filter, &dsts, nullptr);
+        // label-tag-of-dst, dst-vid
+        result->Receive(m_attributes.dst_tag, dsts.data(), dsts.size());
         if (result->IsOverLimit()) {
             return Status::ResultSizeOverLimit(fmt::format("{}", result->m_nlimit));
         } else {
@@ -401,12 +618,16 @@ namespace skg {
     }
 
     Status SubEdgePartition::GetBothVertices(const VertexRequest &req, VertexQueryResult *result) const {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
+        PartitionFilter filter;
+        if (!PrepareFilter(req.GetEdgeFilter(), &filter)) { return Status::OK(); }
         {// in-vertices
             idx_t idx = m_dst_index_f->GetFirstInIndex(req.m_vid);
             while (idx != INDEX_NOT_EXIST) {
                 const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
-                if (!edge.deleted()) {  // 忽略被删除的边
+                if (!IsDead(edge) && MatchFilter(filter, edge, idx)) {  // 忽略被删除的边
                     // put to result
                     assert(req.m_vid == edge.dst);
                     assert(edge.tag == m_attributes.label_tag);
@@ -417,20 +638,10 @@ namespace skg {
             }
         }
         {// out-vertices
-            auto idx_window = m_src_index_f->GetOutIdxRange(req.m_vid);
-            // 索引中找到src范围
-            for (idx_t idx = idx_window.first;
-                 idx < idx_window.second && idx < m_edge_list_f->num_edges();
-                 ++idx) {
-                const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
-                if (!edge.deleted()) {  // 忽略被删除的边
-                    // put to result
-                    assert(req.m_vid == edge.src);
-                    assert(edge.tag == m_attributes.label_tag);
-                    // label-tag-of-dst, dst-vid
-                    result->Receive(m_attributes.dst_tag, edge.dst);
-                }
-            }
+            std::vector<vid_t> dsts;
+            ScanOutTopology(req.m_vid, filter, &dsts, nullptr);
+            // label-tag-of-dst, dst-vid
+            result->Receive(m_attributes.dst_tag, dsts.data(), dsts.size());
         }
         // 比如有两条边 1->2, 2->1, 查询 2 的 both vertices, vQueryResult 中有两个 1
         if (result->IsOverLimit()) {
@@ -440,19 +651,124 @@ namespace skg {
         }
     }
 
+    void SubEdgePartition::ScanOutTopology(
+            const vid_t src, const PartitionFilter &filter,
+            std::vector<vid_t> *dsts, std::vector<EdgeWeight_t> *weights) const {
+        // 每次读取的边数, 非 mmap 时一次 pread 读一整块
+        static const idx_t SCAN_BLOCK_EDGES = 4096;
+        dsts->clear();
+        if (weights != nullptr) { weights->clear(); }
+        // src 被删除时所有出边都已删除
+        if (m_tombstones.IsDeletedVertex(src)) { return; }
+        auto idx_window = m_src_index_f->GetOutIdxRange(src);
+        if (idx_window.first == INDEX_NOT_EXIST) { return; }
+        const idx_t end = std::min<idx_t>(idx_window.second, m_edge_list_f->num_edges());
+        if (idx_window.first >= end) { return; }
+        dsts->resize(end - idx_window.first);
+        if (weights != nullptr) { weights->resize(end - idx_window.first); }
+
+        std::string blockBuf;
+        size_t n = 0;
+        for (idx_t begin = idx_window.first; begin < end; begin += SCAN_BLOCK_EDGES) {
+            const idx_t blockEnd = std::min<idx_t>(begin + SCAN_BLOCK_EDGES, end);
+            const idx_t blockSize = blockEnd - begin;
+            const PersistentEdge *edges = m_edge_list_f->GetImmutableEdges(begin, blockEnd, &blockBuf);
+            vid_t *dstPtr = dsts->data() + n;
+            if (!filter.empty()) {
+                // 带过滤条件时逐条求值
+                size_t k = 0;
+                for (idx_t i = 0; i < blockSize; ++i) {
+                    if (edges[i].deleted() || !MatchFilter(filter, edges[i], begin + i)) { continue; }
+                    dstPtr[k] = edges[i].dst;
+                    if (weights != nullptr) { (*weights)[n + k] = edges[i].weight; }
+                    ++k;
+                }
+                n += k;
+            } else if (weights != nullptr) {
+                // 无分支地压缩掉打了删除标志的边: 总是写入, 只有未删除时才前移
+                EdgeWeight_t *weightPtr = weights->data() + n;
+                size_t k = 0;
+                for (idx_t i = 0; i < blockSize; ++i) {
+                    assert(edges[i].src == src);
+                    dstPtr[k] = edges[i].dst;
+                    weightPtr[k] = edges[i].weight;
+                    k += !edges[i].deleted();
+                }
+                n += k;
+            } else {
+                size_t k = 0;
+                for (idx_t i = 0; i < blockSize; ++i) {
+                    assert(edges[i].src == src);
+                    dstPtr[k] = edges[i].dst;
+                    k += !edges[i].deleted();
+                }
+                n += k;
+            }
+        }
+        // 有节点被删除时, 再按位图去掉 dst 被删除的边
+        if (m_tombstones.HasDeletedVertices()) {
+            size_t k = 0;
+            for (size_t i = 0; i < n; ++i) {
+                (*dsts)[k] = (*dsts)[i];
+                if (weights != nullptr) { (*weights)[k] = (*weights)[i]; }
+                k += !m_tombstones.IsDeletedVertex((*dsts)[i]);
+            }
+            n = k;
+        }
+        dsts->resize(n);
+        if (weights != nullptr) { weights->resize(n); }
+    }
+
+    bool SubEdgePartition::PrepareFilter(const EdgeFilter &edge_filter, PartitionFilter *filter) const {
+        filter->columns.clear();
+        if (!filter->bound.Bind(edge_filter, m_attributes)) { return false; }
+        if (filter->bound.empty()) { return true; }
+        // 整个 sub-partition 的取值范围与条件不相交
+        if (!m_zone_map.MayMatch(filter->bound)) { return false; }
+        for (const auto &term : filter->bound.terms()) {
+            IEdgeColumnPartitionPtr col;
+            if (term.column.columnType() != ColumnType::WEIGHT) {
+                // 没有该列的存储, 所有边的值都为 null
+                if (!GetPropertiesColumnHandler(term.column.colname(), &col).ok()) { return false; }
+            }
+            filter->columns.emplace_back(std::move(col));
+        }
+        return true;
+    }
+
+    bool SubEdgePartition::MatchFilter(const PartitionFilter &filter, const PersistentEdge &edge, const idx_t idx) const {
+        if (filter.empty()) { return true; }
+        if (!m_zone_map.MayMatch(filter.bound, idx)) { return false; }
+        return filter.bound.Match([&](size_t i, const ColumnDescriptor &col, double *value) -> bool {
+            if (col.columnType() == ColumnType::WEIGHT) {
+                *value = edge.weight;
+                return true;
+            }
+            if (!edge.IsPropertySet(col.id())) { return false; }
+            char buff[sizeof(int64_t)] = {'\0'};
+            if (!filter.columns[i]->Get(idx, buff).ok()) { return false; }
+            *value = BoundEdgeFilter::ToDouble(col.columnType(), buff);
+            return true;
+        });
+    }
+
     Status SubEdgePartition::GetInDegree(const vid_t dst, int *ans) const {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         Status s;
         char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
         idx_t idx = m_dst_index_f->GetFirstInIndex(dst);
         while (idx != INDEX_NOT_EXIST) {
             const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
-            if (!edge.deleted()) { ++(*ans); }
+            if (!IsDead(edge)) { ++(*ans); }
             idx = edge.next();
         }
         return s;
     }
 
     Status SubEdgePartition::GetOutDegree(const vid_t src, int *ans) const {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         Status s;
         char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
         auto idx_window = m_src_index_f->GetOutIdxRange(src);
@@ -460,18 +776,60 @@ namespace skg {
             for (idx_t idx = idx_window.first; idx < idx_window.second && idx < m_edge_list_f->num_edges(); idx++) {
                 const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
                 // 忽略被删除的边
-                if (!edge.deleted()) { ++(*ans); }
+                if (!IsDead(edge)) { ++(*ans); }
             }
         }
         return s;
     }
 
+    Status SubEdgePartition::ScanInEdges(const interval_t &window, const EdgeVisitor &visitor) const {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
+        char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
+        const idx_t num_edges = m_edge_list_f->num_edges();
+        for (idx_t idx = 0; idx < num_edges; ++idx) {
+            const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
+            // 忽略被删除的边
+            if (!IsDead(edge) && window.Contain(edge.dst)) {
+                visitor(edge);
+            }
+        }
+        return Status::OK();
+    }
+
+    Status SubEdgePartition::ScanOutEdges(const interval_t &window, const EdgeVisitor &visitor) const {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
+        char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
+        const idx_t num_edges = m_edge_list_f->num_edges();
+        // 边按 src 有序, 二分查找第一条 src >= window.first 的边
+        idx_t lo = 0, hi = num_edges;
+        while (lo < hi) {
+            const idx_t mid = lo + (hi - lo) / 2;
+            if (m_edge_list_f->GetImmutableEdge(mid, edgeBuf).src < window.first) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        for (idx_t idx = lo; idx < num_edges; ++idx) {
+            const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
+            if (edge.src > window.second) { break; }
+            if (!IsDead(edge)) {  // 忽略被删除的边
+                visitor(edge);
+            }
+        }
+        return Status::OK();
+    }
+
     Status SubEdgePartition::AddEdge(const EdgeRequest &request) {
         assert(false);
         return Status::InvalidArgument("Trying to insert edges to partition without memtable.");
     }
 
     Status SubEdgePartition::DeleteEdge(const EdgeRequest &req) {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         // check label 一致
         assert(req.GetLabel() == m_attributes.GetEdgeLabel());
 
@@ -484,10 +842,12 @@ namespace skg {
                  idx < idx_window.second && idx < m_edge_list_f->num_edges();
                  ++idx) {
                 PersistentEdge *pEdge = m_edge_list_f->GetMutableEdge(idx, edgeBuf);
-                if (pEdge->dst == req.m_dstVid) {
+                // 已经删除的边不再重复删除, 保证度索引的计数正确
+                if (pEdge->dst == req.m_dstVid && !IsDead(*pEdge)) {
                     assert(pEdge->src == req.m_srcVid); // 由于是从src索引范围中找到的, 正常情况下肯定一致。
                     pEdge->SetDelete();
                     s = m_edge_list_f->Set(idx, pEdge);
+                    if (s.ok()) { m_tombstones.DeleteEdge(); }
                     return s;
                 }
             }
@@ -497,6 +857,8 @@ namespace skg {
     }
 
     Status SubEdgePartition::GetEdgeAttributes(const EdgeRequest &req, EdgesQueryResult *result) {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         // check label 一致
         assert(req.GetLabel() == m_attributes.GetEdgeLabel());
 
@@ -525,6 +887,8 @@ namespace skg {
     }
 
     Status SubEdgePartition::SetEdgeAttributes(const EdgeRequest &req) {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         // check label 一致
         assert(req.GetLabel() == m_attributes.GetEdgeLabel());
 
@@ -554,6 +918,8 @@ namespace skg {
                 edge->weight = *reinterpret_cast<const EdgeWeight_t *>(req.m_coldata + req.m_columns[i].offset());
 #endif
                 s = m_edge_list_f->Set(idx, edge);
+                const ColumnDescriptor *desc = m_attributes.GetColumn(req.m_columns[i], false);
+                if (desc != nullptr) { m_zone_map.Update(desc->id(), idx, edge->weight); }
             } else if (req.m_columns[i].columnType() == ColumnType::TAG) {
                 // invalid. 不可修改边的类型
                 s = Status::InvalidArgument("Can NOT change edge's label");
@@ -582,6 +948,14 @@ namespace skg {
                 }
                 // 设置属性 bitset
                 edge->SetProperty(col->id());
+                // 按存储的类型读回新的值, 扩大 zone map 的范围
+                const ColumnDescriptor *desc = m_attributes.GetColumn(req.m_columns[i], false);
+                if (desc != nullptr && BoundEdgeFilter::IsRangeColumn(desc->columnType())) {
+                    char buff[sizeof(int64_t)] = {'\0'};
+                    if (col->Get(idx, buff).ok()) {
+                        m_zone_map.Update(desc->id(), idx, BoundEdgeFilter::ToDouble(desc->columnType(), buff));
+                    }
+                }
             }
         }
         metrics::GetInstance()->stop_time("SubEdgePartition.SetEdgeAttributes.disk.prop");
@@ -616,6 +990,13 @@ namespace skg {
     */
 
     Status SubEdgePartition::FlushCache(bool force) {
+        // 延迟打开模式下句柄未打开时, 数据已在关闭前刷到磁盘
+        HandlersGuard guard(this, false);
+        if (!guard.IsOpened()) { return Status::OK(); }
+        return FlushHandlers(force);
+    }
+
+    Status SubEdgePartition::FlushHandlers(bool force) {
         // 不是强制 flush, 且没有 flush 的需求, 则不做处理
         if (!force) {
             return Status::OK();
@@ -641,20 +1022,74 @@ namespace skg {
         }
         if (!s.ok()) { return s; }
 
+        // 修改属性值后扩大了的 zone map
+        if (m_zone_map.IsModified() && m_edge_list_f != nullptr) {
+            s = m_zone_map.Save(FILENAME::sub_partition_zone_map(m_edge_list_f->filename()));
+            if (!s.ok()) { return s; }
+        }
+        // 删除节点/边的记录
+        if (m_tombstones.IsModified() && m_edge_list_f != nullptr) {
+            s = m_tombstones.Save(FILENAME::sub_partition_tombstones(m_edge_list_f->filename()));
+            if (!s.ok()) { return s; }
+        }
         return s;
     }
+
+    bool SubEdgePartition::IsNeedReclaim() const {
+        if (m_edge_list_f == nullptr || m_options.tombstone_compaction_ratio <= 0) { return false; }
+        const idx_t num_edges = GetNumEdgesInDisk();
+        // 边数很少时重写的收益不大
+        if (num_edges < ZoneMap::BLOCK_EDGES) { return false; }
+        return m_tombstones.GetNumDeadEdges() >= m_options.tombstone_compaction_ratio * num_edges;
+    }
+
+    idx_t SubEdgePartition::CountDeadEdges() const {
+        idx_t num_dead = 0;
+        char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
+        for (idx_t i = 0; i < m_edge_list_f->num_edges(); ++i) {
+            num_dead += IsDead(m_edge_list_f->GetImmutableEdge(i, edgeBuf)) ? 1 : 0;
+        }
+        return num_dead;
+    }
+
+    Status SubEdgePartition::ReclaimDeadEdges() {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
+        // 删除节点时入边数是估计值, 重写前顺序扫描一遍得到实际的已删除边数
+        const idx_t num_dead = CountDeadEdges();
+        if (num_dead < m_options.tombstone_compaction_ratio * GetNumEdgesInDisk()) {
+            m_tombstones.SetNumDeadEdges(num_dead);
+            return Status::OK();
+        }
+        SKG_LOG_INFO("reclaiming sub-partition: {}-{} {}, {} of {} edges dead, {} vertices deleted",
+                     m_shard_id, m_partition_id, m_attributes.GetEdgeLabel().ToString(),
+                     num_dead, GetNumEdgesInDisk(),
+                     m_tombstones.GetNumDeletedVertices());
+        Status s = FlushCache(true);
+        if (!s.ok()) { return s; }
+        // 不合并新的边, 只重写磁盘上存活的边
+        return MergeEdgesAndFlush(std::vector<MemoryEdge>(), GetInterval());
+    }
 //sort the edges in buffered_edges to all edges from disk, including columns
     Status SubEdgePartition::MergeEdgesAndFlush(
             std::vector<MemoryEdge> &&buffered_edges,//&&for moved rvalue
             const interval_t &interval) {//interval is given
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         // assume exist edges on disk, read them
 //        metrics::GetInstance()->start_time("EdgePartition.MergeEdgesAndFlush.load");
-        std::vector<MemoryEdge> mergedEdges = this->LoadAllEdges();
+        std::vector<MemoryEdge> mergedEdges;
+        Status s = this->LoadAllEdges(&mergedEdges);
+        if (!s.ok()) { return s; }
         //SKG_LOG_DEBUG("load edges from disk done. size: {}", mergedEdges.size());
 //        metrics::GetInstance()->stop_time("EdgePartition.MergeEdgesAndFlush.load");
 
         // unload origin file readers
         this->CloseHandlers();
+        // 被删除的边在读取时已经去掉. 先删除删除信息文件再重写, 避免重写完成后、删除文件前崩溃,
+        // 残留的删除信息把之后重新添加的边隐藏掉
+        s = RemoveTombstones();
+        if (!s.ok()) { return s; }
 
         // merge buffered_edges and edges in disk partition
         // C++11, 使用 `move` 迭代器合并vector, 避免元素复制的开销
@@ -668,7 +1103,6 @@ namespace skg {
         //SKG_LOG_DEBUG("merge done. size: {}", mergedEdges.size());
 //        metrics::GetInstance()->stop_time("EdgePartition.MergeEdgesAndFlush.merge");
 
-        Status s;
         // 更新 interval 的区间
         m_interval.ExtendTo(interval.second);
 
@@ -705,7 +1139,7 @@ namespace skg {
                  idx < idx_window.second && idx < m_edge_list_f->num_edges();
                  ++idx) {
                 const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(idx, edgeBuf);
-                if (!edge.deleted()) {  // 忽略被删除的边
+                if (!IsDead(edge)) {  // 忽略被删除的边
                     if (edge.dst == dst) {
                         return idx;
                     }
@@ -719,6 +1153,7 @@ namespace skg {
         Status s;
         s = m_edge_list_f->Open();
         if (!s.ok()) { return s; }
+        m_num_disk_edges = m_edge_list_f->num_edges();
 //            SKG_LOG_DEBUG("Got {} edges for {}", m_edge_list_f->num_edges(), GetInterval());
         s = m_src_index_f->Open();
         if (!s.ok()) { return s; }
@@ -728,9 +1163,29 @@ namespace skg {
             s = m_columns[i]->Open();
             if (!s.ok()) { return s; }
         }
+        s = m_zone_map.Load(FILENAME::sub_partition_zone_map(m_edge_list_f->filename()));
+        if (!s.ok()) { return s; }
+        // 位图覆盖 dst 的区间以及 src 的范围. 边按 src 排序, 首尾两条边即为 src 的范围
+        vid_t first = m_interval.first, last = m_interval.second;
+        if (m_edge_list_f->num_edges() != 0) {
+            char edgeBuf[sizeof(PersistentEdge)] = {'\0'};
+            first = std::min(first, m_edge_list_f->GetImmutableEdge(0, edgeBuf).src);
+            last = std::max(last, m_edge_list_f->GetImmutableEdge(m_edge_list_f->num_edges() - 1, edgeBuf).src);
+        }
+        m_tombstones.Reset(first, last);
+        s = m_tombstones.Load(FILENAME::sub_partition_tombstones(m_edge_list_f->filename()));
         return s;
     }
 
+    Status SubEdgePartition::RemoveTombstones() {
+        m_tombstones.Clear();
+        const std::string tombstones_filename = FILENAME::sub_partition_tombstones(m_edge_list_f->filename());
+        if (PathUtils::FileExists(tombstones_filename)) {
+            return PathUtils::RemoveFile(tombstones_filename);
+        }
+        return Status::OK();
+    }
+
     Status SubEdgePartition::CloseHandlers() {
         Status s;
         m_edge_list_f->Close();
@@ -746,7 +1201,14 @@ namespace skg {
      * 从磁盘中读取所有的边 (忽略被打上删除标志的边)
      * @return
      */
-    std::vector<MemoryEdge> SubEdgePartition::LoadAllEdges() {
+    Status SubEdgePartition::LoadAllEdges(std::vector<MemoryEdge> *edges) {
+        assert(edges != nullptr);
+        edges->clear();
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) {
+            SKG_LOG_ERROR("Can NOT open sub-partition: {}-{}, {}", m_shard_id, m_partition_id, guard.status().ToString());
+            return guard.status();
+        }
         const size_t total_column_bytes = m_attributes.GetColumnsValueByteSize();
         std::vector<MemoryEdge> persistentEdges(m_edge_list_f->num_edges(), total_column_bytes);//vector size is num_edges(). what is total_column_bytes for?
         Bytes colData(total_column_bytes, 0);
@@ -757,17 +1219,17 @@ namespace skg {
             const PersistentEdge &edge = m_edge_list_f->GetImmutableEdge(i, edgeBuf);//reture record in this->m_mapped_edges, in fact edgeBuf is not used here
             Status s = CollectProperties(edge, i, m_attributes.GetColumns(), reinterpret_cast<char *>(colData.data()), &bitset);//return data by colData.data()
             if (!s.ok()) {
-                // TODO FIXME
                 SKG_LOG_ERROR("GetEdgeData failed! {}", s.ToString());
-                return persistentEdges;
+                return s;
             }
-            if (!edge.deleted()) {  // 忽略被删除的边
+            if (!IsDead(edge)) {  // 忽略被删除的边
                 // copy 拓扑数据 && 权重 && 类型 && 属性是否有值的 bitset
                 persistentEdges[actual_size++].CopyFrom(edge, colData);
             }
         }
         persistentEdges.resize(actual_size);
-        return persistentEdges;
+        edges->swap(persistentEdges);
+        return Status::OK();
     }
 
     Status SubEdgePartition::CollectProperties(
@@ -829,9 +1291,14 @@ namespace skg {
     }
 
     Status SubEdgePartition::TruncatePartition() {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         Status s;
         s = this->CloseHandlers();
         if (!s.ok()) { return s; }
+        // 同 MergeEdgesAndFlush, 先删除删除信息文件
+        s = RemoveTombstones();
+        if (!s.ok()) {return s;}
 
         s = PathUtils::TruncateFile(m_edge_list_f->filename(), 0);
         if (!s.ok()) {return s;}
@@ -839,11 +1306,41 @@ namespace skg {
         if (!s.ok()) {return s;}
         s = PathUtils::TruncateFile(m_dst_index_f->filename(), 0);
         if (!s.ok()) {return s;}
+        const std::string zone_map_filename = FILENAME::sub_partition_zone_map(m_edge_list_f->filename());
+        if (PathUtils::FileExists(zone_map_filename)) {
+            s = PathUtils::RemoveFile(zone_map_filename);
+            if (!s.ok()) {return s;}
+        }
+
+        return this->OpenHandlers();
+    }
 
+    Status SubEdgePartition::TruncateEdgesFrom(vid_t pivot) {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
+        std::vector<MemoryEdge> edges;
+        Status s = this->LoadAllEdges(&edges);
+        if (!s.ok()) { return s; }
+        const size_t num_edges = edges.size();
+        edges.erase(std::remove_if(edges.begin(), edges.end(),
+                                   [pivot](const MemoryEdge &edge) { return edge.dst >= pivot; }),
+                    edges.end());
+        if (edges.size() == num_edges) { return s; }
+        if (edges.empty()) { return this->TruncatePartition(); }
+
+        s = this->CloseHandlers();
+        if (!s.ok()) { return s; }
+        // 同 MergeEdgesAndFlush, 先删除删除信息文件
+        s = RemoveTombstones();
+        if (!s.ok()) { return s; }
+        s = SubEdgePartitionWriter::FlushEdges(std::move(edges), m_storage_dir, m_shard_id, m_partition_id, GetInterval(), m_attributes);
+        if (!s.ok()) { return s; }
         return this->OpenHandlers();
     }
 
     Status SubEdgePartition::CreateEdgeAttrCol(ColumnDescriptor descriptor) {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         Status s;
         // 嵌入存储的tag,weight，不需要创建
         if (descriptor.columnType() == ColumnType::TAG || descriptor.columnType() == ColumnType::WEIGHT) {
@@ -879,6 +1376,8 @@ namespace skg {
     }
 
     Status SubEdgePartition::ExportData(const std::string &outDir, std::shared_ptr<IDEncoder> encoder) {
+        HandlersGuard guard(this);
+        if (!guard.status().ok()) { return guard.status(); }
         Status s;
         EdgeLabel elabel = this->label();
         const std::string exported_filename = fmt::format(
@@ -1000,7 +1499,12 @@ SubEdgePartition::SubEdgePartition(
           m_interval(interval),
           m_options(options),
           m_num_max_shard_edges(1),
-          m_columns() {
+          m_columns(),
+          m_lazy_open(options.lazy_open_partitions),
+          m_num_disk_edges(0),
+          m_handler_pins(0),
+          m_handler_state(0),
+          m_handler_referenced(false) {
     if (m_options.use_mmap_read) {
         m_edge_list_f.reset(new EdgeListMmapReader(
                 prefix, shard_id, partition_id, interval, attributes.label_tag, m_options));
@@ -1,8 +1,10 @@
 #ifndef STARKNOWLEDGEGRAPHDATABASE_SUBEDGEPARTITION_H
 #define STARKNOWLEDGEGRAPHDATABASE_SUBEDGEPARTITION_H
 
+#include <atomic>
 #include <string>
 #include <stack>
+#include <functional>
 #include <sys/mman.h>
 #include "VertexRequest.h"
 #include "EdgesQueryResult.h"
@@ -25,6 +27,11 @@
 #include "fs/IEdgeColumnWriter.h"
 #include "fs/IEdgeColumnPartition.h"
 #include "fs/MetaAttributes.h"
+#include "fs/ZoneMap.h"
+#include "fs/Tombstones.h"
+#include "fs/PartitionHandlerCache.h"
+#include "fs/EdgeCursor.h"
+#include "fs/NeighborBatch.h"
 #include "fs/BlocksCacheManager.h"
 //#include "util/chifilenames.h"
 #include "util/pathutils.h"
@@ -41,6 +48,11 @@ namespace skg {
     class SubEdgePartition;
     using SubEdgePartitionPtr = std::shared_ptr<SubEdgePartition>;
 
+    /**
+     * @brief 顺序扫描边时的回调, 只会传入未被删除的边
+     */
+    using EdgeVisitor = std::function<void(const PersistentEdge &)>;
+
     class SubEdgePartition {
     public:
         enum class FlushCompactState {
@@ -119,7 +131,7 @@ namespace skg {
 
         virtual
         inline size_t GetNumEdges() const {
-            return m_edge_list_f->num_edges();
+            return GetNumEdgesInDisk();
         }
 
 
@@ -129,7 +141,8 @@ namespace skg {
         }
 
         size_t GetNumEdgesInDisk() const {
-            return m_edge_list_f->num_edges();
+            // 延迟打开时句柄可能未打开, 使用打开/重写时记录的边数
+            return m_num_disk_edges.load(std::memory_order_relaxed);
         }
 
         inline const EdgeLabel label() const {
@@ -169,6 +182,24 @@ namespace skg {
         virtual
         Status GetBothEdges(const VertexRequest &req, EdgesQueryResult *result) const;
 
+        /**
+         * @brief 从 pos->stage, pos->offset 处继续读取 req.m_vid 的入边(in_edges)/出边, 直到 result 装满或读完.
+         * 返回时 pos 更新为下一次读取的位置
+         * @param finished  是否已经读完该 sub-partition 中的边
+         */
+        virtual
+        Status ScanEdgesFrom(const VertexRequest &req, bool in_edges,
+                             EdgeScanPosition *pos, EdgesQueryResult *result, bool *finished) const;
+
+        /**
+         * @brief 批量读取 vids (升序, 无重复) 的入边(in_edges)/出边, 只取邻居, 权重和边类型, 追加到 edges.
+         * 整批节点在索引中只做一次有序的查找
+         * @param pos_base  vids[0] 在整个批次中的下标
+         */
+        virtual
+        Status GetEdgesBatch(const vid_t *vids, size_t n, uint32_t pos_base, bool in_edges,
+                             const EdgeFilter &filter, std::vector<BatchNeighbor> *edges) const;
+
         /**
          * @brief 获取入边的节点
          * @param req
@@ -196,6 +227,17 @@ namespace skg {
         virtual
         Status GetOutDegree(const vid_t src, int * ans) const;
 
+        /**
+         * @brief 顺序扫描 dst 落在 window 内的边. 供计算引擎一次性加载区间的入边
+         */
+        Status ScanInEdges(const interval_t &window, const EdgeVisitor &visitor) const;
+
+        /**
+         * @brief 扫描 src 落在 window 内的边.
+         * 边按 src 有序存储, 二分定位窗口起点后顺序读取, 相邻窗口在文件中也是相邻的
+         */
+        Status ScanOutEdges(const interval_t &window, const EdgeVisitor &visitor) const;
+
 
         // 边的增/删/查/改
 
@@ -247,6 +289,50 @@ namespace skg {
 
         Status CloseHandlers();
 
+        /**
+         * @brief 把 mmap 的修改, 属性列缓存, zone map 和删除信息刷到磁盘. 调用者需保证句柄已打开
+         */
+        Status FlushHandlers(bool force);
+
+        friend class PartitionHandlerCache;
+
+        /**
+         * @brief 访问磁盘句柄期间的守卫. 延迟打开模式下保证句柄已打开, 且在守卫析构前不会被关闭;
+         * 否则什么也不做.
+         */
+        class HandlersGuard {
+        public:
+            /**
+             * @param open_if_closed  句柄未打开时是否打开. 为 false 时只在句柄已打开时 Pin 住
+             */
+            explicit HandlersGuard(const SubEdgePartition *partition, bool open_if_closed = true);
+
+            ~HandlersGuard();
+
+            const Status &status() const {
+                return m_status;
+            }
+
+            bool IsOpened() const {
+                return m_opened;
+            }
+
+        private:
+            // Pin 住时非空
+            const SubEdgePartition *m_pinned;
+            Status m_status;
+            bool m_opened;
+
+        public:
+            HandlersGuard(const HandlersGuard &) = delete;
+            HandlersGuard &operator=(const HandlersGuard &) = delete;
+        };
+
+        /**
+         * @brief 磁盘数据被重写后, 清空删除信息并删除其文件
+         */
+        Status RemoveTombstones();
+
         Status CollectProperties(
                 const PersistentEdge &edge,
                 const idx_t idx,
@@ -254,6 +340,32 @@ namespace skg {
                 char *buff, PropertiesBitset_t *bitset) const;
 
         Status GetPropertiesColumnHandler(const std::string &colname, IEdgeColumnPartitionPtr *ptr) const ;
+
+        /**
+         * 绑定到本 sub-partition 的过滤条件, 以及各个范围条件对应的属性列 (权重为 nullptr)
+         */
+        struct PartitionFilter {
+            BoundEdgeFilter bound;
+            std::vector<IEdgeColumnPartitionPtr> columns;
+
+            bool empty() const {
+                return bound.empty();
+            }
+        };
+
+        /**
+         * @return false -- 本 sub-partition 中一定没有满足过滤条件的边, 可以整个跳过
+         */
+        bool PrepareFilter(const EdgeFilter &edge_filter, PartitionFilter *filter) const;
+
+        bool MatchFilter(const PartitionFilter &filter, const PersistentEdge &edge, const idx_t idx) const;
+
+        /**
+         * 不取属性时的出边扫描: 按块读取 src 的出边, 只取 dst/weight, 跳过被删除以及不满足过滤条件的边.
+         * weights 为 nullptr 时只取 dst
+         */
+        void ScanOutTopology(const vid_t src, const PartitionFilter &filter,
+                             std::vector<vid_t> *dsts, std::vector<EdgeWeight_t> *weights) const;
     public:
         virtual
         size_t GetEstimateSize() const;
@@ -261,6 +373,11 @@ namespace skg {
         // ==== FIXME 待独立出去 ==== //
         Status TruncatePartition();
 
+        /**
+         * @brief 重写磁盘数据, 只保留 dst < pivot 的边. ShardTree 分裂时使用
+         */
+        Status TruncateEdgesFrom(vid_t pivot);
+
         virtual
         bool IsNeedFlush() const {
             return false;
@@ -274,11 +391,31 @@ namespace skg {
         }
 
         /**
-         * 从磁盘中读取所有的边 (忽略被打上删除标志的边)
+         * @brief 磁盘数据中已删除的边 (估计值) 的比例达到 tombstone_compaction_ratio, 需要重写回收空间
+         */
+        bool IsNeedReclaim() const;
+
+        /**
+         * @brief 重写磁盘数据, 去掉已删除的边及其属性
+         */
+        Status ReclaimDeadEdges();
+
+        /**
+         * 磁盘数据中实际的已删除边数, 顺序扫描所有的边
+         */
+        idx_t CountDeadEdges() const;
+
+        /**
+         * 从磁盘中读取所有的边 (忽略被打上删除标志的边, 以及被删除节点的边)
+         * @param edges 读取的边. 失败时为空, 调用方不能据此清空磁盘数据
          * @return
          */
-        std::vector<MemoryEdge> LoadAllEdges();
+        Status LoadAllEdges(std::vector<MemoryEdge> *edges);
     protected:
+        bool IsDead(const PersistentEdge &edge) const {
+            return m_tombstones.IsDead(edge);
+        }
+
         const std::string m_storage_dir;
         uint32_t m_shard_id;
         uint32_t m_partition_id;
@@ -291,6 +428,19 @@ namespace skg {
         size_t m_num_max_shard_edges;
         // 属于该partition的边属性列
         std::vector<IEdgeColumnPartitionPtr> m_columns;
+        // 属性列的 min/max 统计, 用于过滤条件的剪枝
+        ZoneMap m_zone_map;
+        // 删除的节点, 已删除的边数
+        Tombstones m_tombstones;
+        // 第一次访问时才打开句柄, 由 PartitionHandlerCache 按 LRU 关闭
+        const bool m_lazy_open;
+        std::atomic<idx_t> m_num_disk_edges;
+        // 正在访问句柄的次数
+        mutable std::atomic<uint32_t> m_handler_pins;
+        // 句柄的状态 (PartitionHandlerCache::HandlerState), 只在持有 PartitionHandlerCache 的锁时修改
+        mutable std::atomic<uint8_t> m_handler_state;
+        // 上次淘汰检查之后是否被访问过
+        mutable std::atomic<bool> m_handler_referenced;
 
     public:
         // no copying allow
@@ -25,6 +25,38 @@ namespace skg {
         return SubEdgePartition::GetOutEdges(req, pQueryResult);
     }
 
+    Status SubEdgePartitionWithMemTable::ScanEdgesFrom(
+            const VertexRequest &req, bool in_edges,
+            EdgeScanPosition *pos, EdgesQueryResult *result, bool *finished) const {
+        if (pos->stage == EdgeScanPosition::SCAN_MEMTABLE) {
+            // MemTable 中的边数有上限, 整体读出后从 offset 处继续
+            EdgesQueryResult edges;
+            Status s = in_edges ? m_memTable->GetInEdges(req, &edges) : m_memTable->GetOutEdges(req, &edges);
+            if (!s.ok()) { return s; }
+            for (; pos->offset < edges.m_edges.size(); ++pos->offset) {
+                s = result->ReceiveEdge(edges.m_edges[pos->offset]);
+                if (s.IsOverLimit()) {
+                    *finished = false;
+                    return Status::OK();
+                }
+            }
+            // then get in disk
+            pos->stage = EdgeScanPosition::SCAN_DISK;
+            pos->offset = 0;
+        }
+        return SubEdgePartition::ScanEdgesFrom(req, in_edges, pos, result, finished);
+    }
+
+    Status SubEdgePartitionWithMemTable::GetEdgesBatch(
+            const vid_t *vids, size_t n, uint32_t pos_base, bool in_edges,
+            const EdgeFilter &filter, std::vector<BatchNeighbor> *edges) const {
+        // first get in memory
+        Status s = m_memTable->GetEdgesBatch(vids, n, pos_base, in_edges, filter, edges);
+        if (!s.ok()) { return s; }
+        // then get in disk
+        return SubEdgePartition::GetEdgesBatch(vids, n, pos_base, in_edges, filter, edges);
+    }
+
     Status SubEdgePartitionWithMemTable::GetBothEdges(const VertexRequest &req, EdgesQueryResult *result) const {
         // first get in memory
         Status s = m_memTable->GetBothEdges(req, result);
@@ -28,7 +28,7 @@ namespace skg {
         }
 
         inline size_t GetNumEdges() const override {
-            return m_edge_list_f->num_edges() + m_memTable->GetNumEdges();
+            return GetNumEdgesInDisk() + m_memTable->GetNumEdges();
         }
 
         size_t GetNumEdgesInMemory() const override {
@@ -58,6 +58,12 @@ namespace skg {
 
         Status GetBothEdges(const VertexRequest &req, EdgesQueryResult *result) const override;
 
+        Status ScanEdgesFrom(const VertexRequest &req, bool in_edges,
+                             EdgeScanPosition *pos, EdgesQueryResult *result, bool *finished) const override;
+
+        Status GetEdgesBatch(const vid_t *vids, size_t n, uint32_t pos_base, bool in_edges,
+                             const EdgeFilter &filter, std::vector<BatchNeighbor> *edges) const override;
+
         /**
          * @brief 获取入边的节点
          * @param req
@@ -5,9 +5,26 @@
 #include "fs/SubEdgePartitionWriter.h"
 
 #include "fs/IdxFileWriter.h"
+#include "fs/ZoneMap.h"
 
 namespace skg {
 
+    namespace {
+        /**
+         * 统计第 idx 条边在可比较的列上的值
+         */
+        void CollectZoneMap(const MemoryEdge &edge, idx_t idx, const MetaAttributes &attributes, ZoneMap *zone_map) {
+            for (const auto &col : attributes) {
+                if (col.columnType() == ColumnType::WEIGHT) {
+                    zone_map->Update(col.id(), idx, edge.weight);
+                } else if (BoundEdgeFilter::IsRangeColumn(col.columnType()) && edge.IsPropertySet(col.id())) {
+                    zone_map->Update(col.id(), idx, BoundEdgeFilter::ToDouble(
+                            col.columnType(), edge.GetColsData().data() + col.offset()));
+                }
+            }
+        }
+    }
+
     Status SubEdgePartitionWriter::FlushEdges(
             std::vector<MemoryEdge> &&buffered_edges,
             const std::string &storage_dir,
@@ -82,6 +99,8 @@ namespace skg {
         // src索引文件
         s = src_idx_f.Open();
         if (!s.ok()) { return s; }
+        ZoneMap zone_map;
+        zone_map.Reset(attributes, buffered_edges.size());
         vid_t curvid = 0;
         idx_t istart = 0;
         for (idx_t i = 0; i <= buffered_edges.size(); ++i) {
@@ -103,6 +122,7 @@ namespace skg {
                     if (!s.ok()) { return s; }
                     offset += col->value_size();
                 }
+                CollectZoneMap(edge, i, attributes, &zone_map);
             }
 
             if ((edge.src != curvid) || edge.IsStopper()) {
@@ -146,6 +166,8 @@ namespace skg {
             s = col->CreateSizeRecord();
             if (!s.ok()) { return s; }
         }
+        s = zone_map.Save(FILENAME::sub_partition_zone_map(edges_list_f.filename()));
+        if (!s.ok()) { return s; }
 
 //        metrics::GetInstance()->stop_time("SubEdgePartitionWriter.FlushEdges.create");
         return Status::OK();
@@ -230,6 +252,8 @@ namespace skg {
             if (!s.ok()) { return s; }
             edata_cols_f.emplace_back(std::move(writer));
         }
+        ZoneMap zone_map;
+        zone_map.Reset(attributes, edges_with_next_offset.size());
         vid_t cur_src = 0;
         for (idx_t i = 0; i < edges_with_next_offset.size(); ++i) {
             const MemoryEdge &cur_edge = *(edges_with_next_offset[i].first);
@@ -250,6 +274,7 @@ namespace skg {
                     if (!s.ok()) { return s; }
                     offset += col->value_size();
                 }
+                CollectZoneMap(cur_edge, i, attributes, &zone_map);
             }
         }
         // write edge data
@@ -259,6 +284,8 @@ namespace skg {
             s = col->CreateSizeRecord();
             if (!s.ok()) { return s; }
         }
+        s = zone_map.Save(FILENAME::sub_partition_zone_map(edge_list_f.filename()));
+        if (!s.ok()) { return s; }
 //        metrics::GetInstance()->stop_time("SubEdgePartitionWriter.FlushEdges.create");
         return s;
     }
@@ -0,0 +1,131 @@
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "Tombstones.h"
+#include "util/pathutils.h"
+
+namespace skg {
+
+    namespace {
+        // 文件格式: magic, 已删除边数, 删除的节点数, 删除的节点 id
+        const uint32_t TOMBSTONES_MAGIC = 0x544f4d42;  // "TOMB"
+    }
+
+    void Tombstones::Reset(vid_t first, vid_t last) {
+        delete[] m_bits.load(std::memory_order_relaxed);
+        m_bits.store(nullptr, std::memory_order_relaxed);
+        m_first = first;
+        m_num_bits = last >= first ? static_cast<uint64_t>(last - first) + 1 : 0;
+        m_num_vertices.store(0, std::memory_order_relaxed);
+        m_num_dead_edges.store(0, std::memory_order_relaxed);
+        m_modified.store(false, std::memory_order_relaxed);
+    }
+
+    void Tombstones::Clear() {
+        std::atomic<uint64_t> *bits = m_bits.load(std::memory_order_relaxed);
+        if (bits != nullptr) {
+            for (size_t i = 0; i < GetNumWords(); ++i) {
+                bits[i].store(0, std::memory_order_relaxed);
+            }
+        }
+        m_num_vertices.store(0, std::memory_order_release);
+        m_num_dead_edges.store(0, std::memory_order_relaxed);
+        m_modified.store(false, std::memory_order_relaxed);
+    }
+
+    bool Tombstones::Set(vid_t vid) {
+        if (vid < m_first || static_cast<uint64_t>(vid - m_first) >= m_num_bits) { return false; }
+        std::atomic<uint64_t> *bits = m_bits.load(std::memory_order_relaxed);
+        if (bits == nullptr) {
+            // 只有持有写锁的线程修改, 分配后再发布给查询
+            bits = new std::atomic<uint64_t>[GetNumWords()];
+            for (size_t i = 0; i < GetNumWords(); ++i) {
+                bits[i].store(0, std::memory_order_relaxed);
+            }
+            m_bits.store(bits, std::memory_order_release);
+        }
+        const uint64_t i = static_cast<uint64_t>(vid - m_first);
+        const uint64_t mask = uint64_t(1) << (i & 63);
+        if ((bits[i >> 6].fetch_or(mask, std::memory_order_release) & mask) != 0) { return false; }
+        m_num_vertices.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    void Tombstones::DeleteVertex(vid_t vid, idx_t num_edges) {
+        if (Set(vid)) {
+            m_num_dead_edges.fetch_add(num_edges, std::memory_order_relaxed);
+            m_modified.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    Status Tombstones::Load(const std::string &filename) {
+        this->Clear();
+        if (!PathUtils::FileExists(filename)) { return Status::OK(); }
+        FILE *f = fopen(filename.c_str(), "rb");
+        if (f == nullptr) {
+            return Status::IOError(fmt::format("Can NOT open tombstones: {}, error: {}({})",
+                                               filename, strerror(errno), errno));
+        }
+        bool ok = true;
+        uint32_t magic = 0;
+        uint64_t num_dead_edges = 0, num_vertices = 0;
+        ok = ok && fread(&magic, sizeof(magic), 1, f) == 1 && magic == TOMBSTONES_MAGIC;
+        ok = ok && fread(&num_dead_edges, sizeof(num_dead_edges), 1, f) == 1;
+        ok = ok && fread(&num_vertices, sizeof(num_vertices), 1, f) == 1;
+        std::vector<vid_t> vertices;
+        if (ok) {
+            vertices.resize(num_vertices);
+            ok = num_vertices == 0 || fread(vertices.data(), sizeof(vid_t), num_vertices, f) == num_vertices;
+        }
+        fclose(f);
+        if (!ok) {
+            // 与 zone map 不同, 忽略删除信息会让已删除的边重新可见
+            return Status::Corruption(fmt::format("tombstones: {} is corrupted", filename));
+        }
+        // 重写后范围外的节点在磁盘数据中已经没有边, 忽略
+        for (vid_t vid : vertices) {
+            (void) Set(vid);
+        }
+        m_num_dead_edges.store(static_cast<idx_t>(num_dead_edges), std::memory_order_relaxed);
+        m_modified.store(false, std::memory_order_relaxed);
+        return Status::OK();
+    }
+
+    Status Tombstones::Save(const std::string &filename) {
+        FILE *f = fopen(filename.c_str(), "wb");
+        if (f == nullptr) {
+            return Status::IOError(fmt::format("Can NOT create tombstones: {}, error: {}({})",
+                                               filename, strerror(errno), errno));
+        }
+        std::vector<vid_t> vertices;
+        const std::atomic<uint64_t> *bits = m_bits.load(std::memory_order_acquire);
+        if (bits != nullptr) {
+            for (size_t w = 0; w < GetNumWords(); ++w) {
+                uint64_t word = bits[w].load(std::memory_order_relaxed);
+                while (word != 0) {
+                    const int b = __builtin_ctzll(word);
+                    vertices.push_back(static_cast<vid_t>(m_first + w * 64 + b));
+                    word &= word - 1;
+                }
+            }
+        }
+        const uint64_t num_dead_edges = GetNumDeadEdges();
+        const uint64_t num_vertices = vertices.size();
+        bool ok = true;
+        ok = ok && fwrite(&TOMBSTONES_MAGIC, sizeof(TOMBSTONES_MAGIC), 1, f) == 1;
+        ok = ok && fwrite(&num_dead_edges, sizeof(num_dead_edges), 1, f) == 1;
+        ok = ok && fwrite(&num_vertices, sizeof(num_vertices), 1, f) == 1;
+        ok = ok && (num_vertices == 0 || fwrite(vertices.data(), sizeof(vid_t), num_vertices, f) == num_vertices);
+        ok = (fclose(f) == 0) && ok;
+        if (!ok) {
+            return Status::IOError(fmt::format("Fail to write tombstones: {}", filename));
+        }
+        m_modified.store(false, std::memory_order_relaxed);
+        return Status::OK();
+    }
+
+}
@@ -0,0 +1,136 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_TOMBSTONES_H
+#define STARKNOWLEDGEGRAPHDATABASE_TOMBSTONES_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "util/types.h"
+#include "util/status.h"
+#include "util/internal_types.h"
+
+namespace skg {
+
+    /**
+     * @brief sub-partition 磁盘数据中的删除信息.
+     *
+     * 删除节点时只在位图中标记被删除的节点 id, 不逐条修改边, 以其为端点的边在读取时视为已删除.
+     * 位图覆盖磁盘数据中出现的节点 id 范围 (dst 的区间与 src 的范围), 第一次删除节点时才分配.
+     * 删除由持有写锁的线程进行, 查询不加锁地读取, 位图和计数都是原子变量.
+     *
+     * 同时估计已删除的边数 (删除边的条数 + 删除节点时该节点的出边数与估计的入边数),
+     * 比例达到阈值时由 ShardTree 触发 TombstoneCompaction 重写 sub-partition, 回收空间.
+     * 磁盘数据重写 (MergeEdgesAndFlush / TruncatePartition) 时, 已删除的边不再写入, 删除信息在重写前清空.
+     */
+    class Tombstones {
+    public:
+        Tombstones()
+                : m_first(0), m_num_bits(0), m_bits(nullptr),
+                  m_num_vertices(0), m_num_dead_edges(0), m_modified(false) {}
+
+        ~Tombstones() {
+            delete[] m_bits.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief 设置可被删除的节点 id 范围 [first, last], 并清空删除信息.
+         * 在打开磁盘数据时调用, 调用时不能有并发的读取
+         */
+        void Reset(vid_t first, vid_t last);
+
+        bool IsDead(const PersistentEdge &edge) const {
+            if (edge.deleted()) { return true; }
+            const std::atomic<uint64_t> *bits = m_bits.load(std::memory_order_acquire);
+            return bits != nullptr && (Test(bits, edge.src) || Test(bits, edge.dst));
+        }
+
+        /**
+         * @brief 是否有被删除的节点. 没有时只需检查边上的删除标志
+         */
+        bool HasDeletedVertices() const {
+            return m_num_vertices.load(std::memory_order_acquire) != 0;
+        }
+
+        bool IsDeletedVertex(vid_t vid) const {
+            const std::atomic<uint64_t> *bits = m_bits.load(std::memory_order_acquire);
+            return bits != nullptr && Test(bits, vid);
+        }
+
+        /**
+         * @brief 删除节点. num_edges 为磁盘数据中该节点的边数 (估计值).
+         * 不在磁盘数据范围内的节点没有边, 忽略
+         */
+        void DeleteVertex(vid_t vid, idx_t num_edges);
+
+        void DeleteEdge() {
+            m_num_dead_edges.fetch_add(1, std::memory_order_relaxed);
+            m_modified.store(true, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief 估计的已删除边数
+         */
+        idx_t GetNumDeadEdges() const {
+            return m_num_dead_edges.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief 用实际统计的已删除边数替换估计值
+         */
+        void SetNumDeadEdges(idx_t num_dead_edges) {
+            m_num_dead_edges.store(num_dead_edges, std::memory_order_relaxed);
+            m_modified.store(true, std::memory_order_relaxed);
+        }
+
+        size_t GetNumDeletedVertices() const {
+            return m_num_vertices.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief 清空删除信息, 保留节点 id 范围
+         */
+        void Clear();
+
+        /**
+         * @brief 读取删除信息文件. 文件不存在时清空
+         */
+        Status Load(const std::string &filename);
+
+        Status Save(const std::string &filename);
+
+        bool IsModified() const {
+            return m_modified.load(std::memory_order_relaxed);
+        }
+
+    private:
+        bool Test(const std::atomic<uint64_t> *bits, vid_t vid) const {
+            // vid < m_first 时回绕成很大的值
+            const uint64_t i = static_cast<uint64_t>(vid - m_first);
+            return vid >= m_first && i < m_num_bits
+                   && (bits[i >> 6].load(std::memory_order_relaxed) & (uint64_t(1) << (i & 63))) != 0;
+        }
+
+        // 标记节点, 返回是否新标记. 位图未分配时分配
+        bool Set(vid_t vid);
+
+        size_t GetNumWords() const {
+            return (m_num_bits + 63) / 64;
+        }
+
+        // 位图覆盖的节点 id 范围 [m_first, m_first + m_num_bits), 只在 Reset 中修改
+        vid_t m_first;
+        uint64_t m_num_bits;
+        std::atomic<std::atomic<uint64_t> *> m_bits;
+        std::atomic<size_t> m_num_vertices;
+        std::atomic<idx_t> m_num_dead_edges;
+        std::atomic<bool> m_modified;
+
+    public:
+        // no copying allow
+        Tombstones(const Tombstones &) = delete;
+        Tombstones &operator=(const Tombstones &) = delete;
+    };
+
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_TOMBSTONES_H
@@ -13,10 +13,12 @@ TraverseAction::~TraverseAction() {
 }
 
 Status TraverseAction::get_neighbors(VertexQueryResult* vqr_ptr, std::string id,
-        std::string label, const std::vector<std::string> &qcols, char direction) {
+        std::string label, const std::vector<std::string> &qcols, char direction,
+        const EdgeFilter &filter) {
     VertexRequest vreq;
     vreq.SetVertex(label, id);
     vreq.SetQueryColumnNames(qcols);
+    vreq.SetEdgeFilter(filter);
     Status s;
     if (direction == 'i') {
         s = m_db->GetInVertices(vreq, vqr_ptr);
@@ -31,10 +33,12 @@ Status TraverseAction::get_neighbors(VertexQueryResult* vqr_ptr, std::string id,
 }
 
 Status TraverseAction::get_edges(EdgesQueryResult* eqr, std::string id, 
-        std::string label, const std::vector<std::string> &qcols, char direction) {
+        std::string label, const std::vector<std::string> &qcols, char direction,
+        const EdgeFilter &filter) {
     VertexRequest vreq;
     vreq.SetVertex(label, id); 
     vreq.SetQueryColumnNames(qcols);
+    vreq.SetEdgeFilter(filter);
     Status s;
     if (direction == 'i') {
         s = m_db->GetInEdges(vreq, eqr);
@@ -86,8 +90,11 @@ Status TraverseAction::k_neighbor(const TraverseRequest& traverse_req,
         traverse_req.qcols;
     const std::vector<std::string> label_cons = 
         traverse_req.label_constraint;
-    std::set<std::string> label_set;
-    label_set.insert(label_cons.begin(), label_cons.end());
+    // label 条件与属性范围条件一起下推到 sub-partition 扫描
+    EdgeFilter filter = traverse_req.edge_filter;
+    for (const auto &edge_label : label_cons) {
+        filter.AddLabel(edge_label);
+    }
     if (nlimit <= 0) 
         return Status::OK();
     std::vector<PathVertex> pv_level[2];
@@ -116,19 +123,13 @@ Status TraverseAction::k_neighbor(const TraverseRequest& traverse_req,
             EdgesQueryResult eqr;
             std::string cur_label = pv_level[cur][j].label;
             std::string cur_id = pv_level[cur][j].id;
-            s = this->get_edges(&eqr, cur_id, cur_label, qcols, direction);
+            s = this->get_edges(&eqr, cur_id, cur_label, qcols, direction, filter);
             if (!s.ok()) {
                 return s;
             }
 
             while (eqr.HasNext()) {
                 eqr.MoveNext(); 
-                if (label_set.size() > 0 &&
-                        label_set.find(eqr.GetLabel(&s)) ==
-                            label_set.end()) {
-                    continue;
-                }
-
                 std::string dst_id = eqr.GetDstVertex(&s);
                 std::string dst_label = eqr.GetDstVertexLabel(&s);
                 vattr_str = "";
@@ -165,8 +166,10 @@ Status TraverseAction::k_out(const TraverseRequest& traverse_req,
         traverse_req.qcols;
     const std::vector<std::string> label_cons = 
         traverse_req.label_constraint;
-    std::set<std::string> label_set;
-    label_set.insert(label_cons.begin(), label_cons.end());
+    EdgeFilter filter = traverse_req.edge_filter;
+    for (const auto &edge_label : label_cons) {
+        filter.AddLabel(edge_label);
+    }
     if (nlimit <= 0) 
         return Status::OK();
     std::vector<PathVertex> pv_level[2];
@@ -188,18 +191,13 @@ Status TraverseAction::k_out(const TraverseRequest& traverse_req,
             EdgesQueryResult eqr;
             std::string cur_label = pv_level[cur][j].label;
             std::string cur_id = pv_level[cur][j].id;
-            s = this->get_edges(&eqr, cur_id, cur_label, qcols, direction);
+            s = this->get_edges(&eqr, cur_id, cur_label, qcols, direction, filter);
             if (!s.ok()) {
                 return s;
             }
 
             while (eqr.HasNext()) {
                 eqr.MoveNext(); 
-                if (label_set.size() > 0 &&
-                        label_set.find(eqr.GetLabel(&s)) ==
-                            label_set.end()) {
-                    continue;
-                }
 	    //std::cout<<eqr.GetSrcVertexLabel(&s)<<":"<<eqr.GetSrcVertex(&s)<<std::endl;
 	    //std::cout<<eqr.GetDstVertexLabel(&s)<<":"<<eqr.GetDstVertex(&s)<<std::endl;
                 PathVertex pv;
@@ -243,8 +241,10 @@ Status TraverseAction::k_out_size(const TraverseRequest& traverse_req,
     char direction = traverse_req.direction;
     const std::vector<std::string> label_cons = 
         traverse_req.label_constraint;
-    std::set<std::string> label_set;
-    label_set.insert(label_cons.begin(), label_cons.end());
+    EdgeFilter filter = traverse_req.edge_filter;
+    for (const auto &edge_label : label_cons) {
+        filter.AddLabel(edge_label);
+    }
     std::vector<std::string> qcols; //need no set
     std::vector<PathVertex> pv_level[2];
     int n_reserve = 100000;
@@ -267,7 +267,7 @@ Status TraverseAction::k_out_size(const TraverseRequest& traverse_req,
             EdgesQueryResult eqr;
             std::string cur_label = pv_level[cur][j].label;
             std::string cur_id = pv_level[cur][j].id;
-            s = this->get_edges(&eqr, cur_id, cur_label, qcols, direction);
+            s = this->get_edges(&eqr, cur_id, cur_label, qcols, direction, filter);
             //*e_size += eqr.Size();
             if (!s.ok()) {
                 return s;
@@ -275,11 +275,6 @@ Status TraverseAction::k_out_size(const TraverseRequest& traverse_req,
 
             while (eqr.HasNext()) {
                 eqr.MoveNext(); 
-                if (label_set.size() > 0 &&
-                        label_set.find(eqr.GetLabel(&s)) ==
-                            label_set.end()) {
-                    continue;
-                }
                 *e_size = *e_size + 1;
                 PathVertex pv(eqr.GetDstVertexLabel(&s),eqr.GetDstVertex(&s));
                 if (visited.find(pv) != visited.end()) {
@@ -18,10 +18,12 @@ namespace skg {
         TraverseAction(const SkgDB* db);
         ~TraverseAction();
         Status get_neighbors(VertexQueryResult* vqr, std::string id,
-                std::string label, const std::vector<std::string>& qcols, char direction);
+                std::string label, const std::vector<std::string>& qcols, char direction,
+                const EdgeFilter &filter = EdgeFilter());
 
         Status get_edges(EdgesQueryResult* eqr, std::string id, 
-                std::string label, const std::vector<std::string> &qcols, char direction);
+                std::string label, const std::vector<std::string> &qcols, char direction,
+                const EdgeFilter &filter = EdgeFilter());
 
         Status get_vattr(VertexQueryResult* vqr_ptr, std::string id, 
             std::string label, const std::vector<std::string> &qcols);
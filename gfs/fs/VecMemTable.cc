@@ -14,12 +14,14 @@ namespace skg {
     }
 
     Status VecMemTable::GetInEdges(const VertexRequest &request, EdgesQueryResult *pQueryResult) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         // get in edges from memory buffer
         Status s;
         char colData[SKG_MAX_EDGE_PROPERTIES_BYTES];
         PropertiesBitset_t bitset;
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
-            if (request.m_vid == iter->dst) {
+            if (request.m_vid == iter->dst && MatchFilter(filter, *iter)) {
                 memset(colData, 0, SKG_MAX_EDGE_PROPERTIES_BYTES);
                 bitset.Clear();
                 CollectProperties(*iter, request.GetColumns(), colData, &bitset);
@@ -36,12 +38,14 @@ namespace skg {
     }
 
     Status VecMemTable::GetOutEdges(const VertexRequest &request, EdgesQueryResult *pQueryResult) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         // get out edges from memory buffer
         Status s;
         char colData[SKG_MAX_EDGE_PROPERTIES_BYTES];
         PropertiesBitset_t bitset;
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
-            if (request.m_vid == iter->src) {
+            if (request.m_vid == iter->src && MatchFilter(filter, *iter)) {
                 memset(colData, 0, SKG_MAX_EDGE_PROPERTIES_BYTES);
                 bitset.Clear();
                 CollectProperties(*iter, request.GetColumns(), colData, &bitset);
@@ -58,11 +62,13 @@ namespace skg {
     }
 
     Status VecMemTable::GetBothEdges(const VertexRequest &request, EdgesQueryResult *result) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         Status s;
         char colData[SKG_MAX_EDGE_PROPERTIES_BYTES];
         PropertiesBitset_t bitset;
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
-            if (request.m_vid == iter->dst || request.m_vid == iter->src) {
+            if ((request.m_vid == iter->dst || request.m_vid == iter->src) && MatchFilter(filter, *iter)) {
                 memset(colData, 0, SKG_MAX_EDGE_PROPERTIES_BYTES);
                 bitset.Clear();
                 CollectProperties(*iter, request.GetColumns(), colData, &bitset);
@@ -78,10 +84,27 @@ namespace skg {
         return s;
     }
 
+    Status VecMemTable::GetEdgesBatch(const vid_t *vids, size_t n, uint32_t pos_base, bool in_edges,
+                                      const EdgeFilter &filter, std::vector<BatchNeighbor> *edges) const {
+        BoundEdgeFilter bound;
+        if (n == 0 || !bound.Bind(filter, m_attributes)) { return Status::OK(); }
+        for (const auto &edge : m_buffered_edges) {
+            const vid_t key = in_edges ? edge.dst : edge.src;
+            if (key < vids[0] || key > vids[n - 1]) { continue; }
+            const vid_t *iter = std::lower_bound(vids, vids + n, key);
+            if (*iter != key || !MatchFilter(bound, edge)) { continue; }
+            edges->emplace_back(pos_base + static_cast<uint32_t>(iter - vids),
+                                in_edges ? edge.src : edge.dst, edge.weight, edge.tag);
+        }
+        return Status::OK();
+    }
+
     Status VecMemTable::GetInVertices(const VertexRequest &request, VertexQueryResult *result) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         // get in edges from memory buffer
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
-            if (request.m_vid == iter->dst) {
+            if (request.m_vid == iter->dst && MatchFilter(filter, *iter)) {
                 result->Receive(m_attributes.src_tag, iter->src);
             }
         }
@@ -93,8 +116,10 @@ namespace skg {
     }
 
     Status VecMemTable::GetOutVertices(const VertexRequest &request, VertexQueryResult *result) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
-            if (request.m_vid == iter->src) {
+            if (request.m_vid == iter->src && MatchFilter(filter, *iter)) {
                 result->Receive(m_attributes.dst_tag, iter->dst);
             }
         }
@@ -106,7 +131,10 @@ namespace skg {
     }
 
     Status VecMemTable::GetBothVertices(const VertexRequest &request, VertexQueryResult *result) const {
+        BoundEdgeFilter filter;
+        if (!filter.Bind(request.GetEdgeFilter(), m_attributes)) { return Status::OK(); }
         for (auto iter = m_buffered_edges.begin(); iter != m_buffered_edges.end(); ++iter) {
+            if (!MatchFilter(filter, *iter)) { continue; }
             if (request.m_vid == iter->src) {
                 result->Receive(m_attributes.dst_tag, iter->dst);
             } else if (request.m_vid == iter->dst) {
@@ -241,6 +269,21 @@ namespace skg {
         }
     }
 
+    bool VecMemTable::MatchFilter(const BoundEdgeFilter &filter, const MemoryEdge &edge) const {
+        if (filter.empty()) { return true; }
+        return filter.Match([&edge](size_t, const ColumnDescriptor &col, double *value) {
+            if (col.columnType() == ColumnType::WEIGHT) {
+                *value = edge.weight;
+                return true;
+            }
+            if (!edge.IsPropertySet(col.id())) { return false; }
+            char buff[sizeof(double)];
+            edge.GetData(col.offset(), col.value_size(), buff);
+            *value = BoundEdgeFilter::ToDouble(col.columnType(), buff);
+            return true;
+        });
+    }
+
     void VecMemTable::ReorderAttributesToEdge(const EdgeRequest &request, MemoryEdge *edge) const {
         // 把待修改的属性数据, 按照 MemTable 中属性列顺序修改相应的偏移量.
         for (const auto &col : request.GetColumns()) {
@@ -9,8 +9,53 @@
 #include "fs/SubEdgePartition.h"
 #include "fs/SubEdgePartitionWriter.h"
 #include "fs/SubEdgePartitionWithMemTable.h"
+#include "fs/IVertexColumnImpl.h"
 namespace skg {
 
+    namespace {
+        ColumnDescriptor DegreeColumnDescriptor(const char *name, int32_t id) {
+            ColumnDescriptor descriptor(name, ColumnType::INT32);
+            descriptor.SetColumnID(id);
+            return descriptor;
+        }
+
+        /**
+         * 打开节点的度列. 旧的数据库中没有度列, 创建全 0 的列, 通过 `*created` 返回
+         */
+        Status OpenDegreeColumn(const std::string &dir, const ColumnDescriptor &descriptor, vid_t capacity,
+                                bool *created, std::shared_ptr<FixedBytesVertexColumn> *column) {
+            Status s;
+            const std::string fname = FILENAME::vertex_attr_data(dir, SKG_GLOBAL_LABEL, descriptor.colname());
+            if (!PathUtils::FileExists(fname)) {
+                s = IVertexColumn::CreateWithCapacity(dir, SKG_GLOBAL_LABEL, descriptor, capacity);
+                if (!s.ok()) { return s; }
+                *created = true;
+            }
+            IVertexColumnPtr col = IVertexColumn::OpenColumn(dir, SKG_GLOBAL_LABEL, descriptor, &s);
+            if (!s.ok()) { return s; }
+            *column = std::dynamic_pointer_cast<FixedBytesVertexColumn>(col);
+            assert(*column != nullptr);
+            return s;
+        }
+
+        template <typename T>
+        void GatherValues(const char *data, vid_t max_vid, const vid_t *vids, size_t n, T *out) {
+            const T *values = reinterpret_cast<const T *>(data);
+            for (size_t i = 0; i < n; ++i) {
+                out[i] = vids[i] <= max_vid ? values[vids[i]] : T();
+            }
+        }
+
+        template <typename T>
+        void GatherValuesAsFloat(const char *data, vid_t max_vid, const vid_t *vids, size_t n,
+                                 size_t stride, float *out) {
+            const T *values = reinterpret_cast<const T *>(data);
+            for (size_t i = 0; i < n; ++i) {
+                out[i * stride] = vids[i] <= max_vid ? static_cast<float>(values[vids[i]]) : 0.0f;
+            }
+        }
+    }
+
     Status VertexColumnList::Create(const std::string &dir, const MetaHeterogeneousAttributes &hetAttributes, vid_t max_vertex_id) {
         Status s;
         s = PathUtils::CreateDirIfMissing(dir);
@@ -24,6 +69,8 @@ namespace skg {
             vertices_info.max_allocated_vid = 0;
             vertices_info.num_vertices = 0;
             vertices_info.storage_capacity_vid = GetNextStorageCapacity(0);
+            // 空图, 度列全为 0 即是正确的
+            vertices_info.degree_built = true;
         } else {
             vertices_info.max_allocated_vid = max_vertex_id;
             vertices_info.num_vertices = max_vertex_id + 1;
@@ -49,6 +96,18 @@ namespace skg {
             s = IVertexColumn::CreateWithCapacity(dir, SKG_GLOBAL_LABEL, descriptor, vertices_info.storage_capacity_vid);
             if (!s.ok()) { return s; }
         }
+        {// 节点的出/入度列
+            s = IVertexColumn::CreateWithCapacity(
+                    dir, SKG_GLOBAL_LABEL,
+                    DegreeColumnDescriptor(SKG_VERTEX_COLUMN_NAME_IN_DEGREE, ColumnDescriptor::ID_VERTICES_IN_DEGREE),
+                    vertices_info.storage_capacity_vid);
+            if (!s.ok()) { return s; }
+            s = IVertexColumn::CreateWithCapacity(
+                    dir, SKG_GLOBAL_LABEL,
+                    DegreeColumnDescriptor(SKG_VERTEX_COLUMN_NAME_OUT_DEGREE, ColumnDescriptor::ID_VERTICES_OUT_DEGREE),
+                    vertices_info.storage_capacity_vid);
+            if (!s.ok()) { return s; }
+        }
         // 属性列文件
         for (const auto &attributes: hetAttributes) {
             for (const auto &col: attributes) {
@@ -79,6 +138,7 @@ namespace skg {
             lst->m_storage_vertices = vertices_info.storage_capacity_vid;
             // 有效的节点个数
             lst->m_num_vertices = vertices_info.num_vertices;
+            lst->m_degree_built = vertices_info.degree_built;
             if (!s.ok()) { break; }
             {// 节点的 label-tag 列
                 IVertexColumnPtr column = IVertexColumn::OpenColumn(
@@ -107,6 +167,32 @@ namespace skg {
                                 std::make_pair(SKG_GLOBAL_LABEL_TAG, lst->m_bitset_column->name()),
                                 lst->m_bitset_column));
             }
+            {// 节点的出/入度列
+                bool created = false;
+                s = OpenDegreeColumn(
+                        lst->GetStorageDir(),
+                        DegreeColumnDescriptor(SKG_VERTEX_COLUMN_NAME_IN_DEGREE, ColumnDescriptor::ID_VERTICES_IN_DEGREE),
+                        lst->m_storage_vertices, &created, &lst->m_in_degree_column);
+                if (!s.ok()) { break; }
+                s = OpenDegreeColumn(
+                        lst->GetStorageDir(),
+                        DegreeColumnDescriptor(SKG_VERTEX_COLUMN_NAME_OUT_DEGREE, ColumnDescriptor::ID_VERTICES_OUT_DEGREE),
+                        lst->m_storage_vertices, &created, &lst->m_out_degree_column);
+                if (!s.ok()) { break; }
+                if (created) { lst->m_degree_built = false; }
+                if (!lst->m_degree_built) {
+                    SKG_LOG_INFO("degree columns of {} are not built, run GenDegreeFile to build them",
+                                 lst->GetStorageDir());
+                }
+                lst->m_vertex_columns.insert(
+                        std::make_pair(
+                                std::make_pair(SKG_GLOBAL_LABEL_TAG, lst->m_in_degree_column->name()),
+                                lst->m_in_degree_column));
+                lst->m_vertex_columns.insert(
+                        std::make_pair(
+                                std::make_pair(SKG_GLOBAL_LABEL_TAG, lst->m_out_degree_column->name()),
+                                lst->m_out_degree_column));
+            }
             // 异构点属性列的元数据
             s = MetadataFileHandler::ReadVertexAttrConf(lst->GetStorageDir(), &lst->m_vertex_attr);
             if (!s.ok()) { break; }
@@ -412,6 +498,7 @@ namespace skg {
         vertices_info.max_allocated_vid = m_max_vertices_id;
         vertices_info.storage_capacity_vid = m_storage_vertices;
         vertices_info.num_vertices = m_num_vertices;
+        vertices_info.degree_built = m_degree_built;
         s = MetadataFileHandler::WriteNumVertices(GetStorageDir(), vertices_info);
         if (!s.ok()) { return s; }
         // 节点属性
@@ -425,6 +512,121 @@ namespace skg {
         return s;
     }
 
+    void VertexColumnList::AddDegree(vid_t src, vid_t dst, int32_t delta) {
+        // 扩容会重新 mmap, 每次都重新取首地址
+        int32_t *out_degrees = reinterpret_cast<int32_t *>(m_out_degree_column->mutable_data());
+        int32_t *in_degrees = reinterpret_cast<int32_t *>(m_in_degree_column->mutable_data());
+        assert(src < m_out_degree_column->capacity() && dst < m_in_degree_column->capacity());
+        __sync_fetch_and_add(out_degrees + src, delta);
+        __sync_fetch_and_add(in_degrees + dst, delta);
+    }
+
+    Status VertexColumnList::ResetDegrees() {
+        m_degree_built = false;
+        memset(m_in_degree_column->mutable_data(), 0, m_in_degree_column->capacity() * sizeof(int32_t));
+        memset(m_out_degree_column->mutable_data(), 0, m_out_degree_column->capacity() * sizeof(int32_t));
+        return Status::OK();
+    }
+
+    Status VertexColumnList::GetDegrees(const vid_t *vids, size_t n, int32_t *in_degrees, int32_t *out_degrees) const {
+        if (!m_degree_built) {
+            return Status::NotExist("degree columns are not built, run GenDegreeFile first");
+        }
+        const vid_t max_vid = m_max_vertices_id;
+        const int32_t *in_data = reinterpret_cast<const int32_t *>(m_in_degree_column->data());
+        const int32_t *out_data = reinterpret_cast<const int32_t *>(m_out_degree_column->data());
+        for (size_t i = 0; i < n; ++i) {
+            const bool exist = vids[i] <= max_vid;
+            if (in_degrees != nullptr) { in_degrees[i] = exist ? in_data[vids[i]] : 0; }
+            if (out_degrees != nullptr) { out_degrees[i] = exist ? out_data[vids[i]] : 0; }
+        }
+        return Status::OK();
+    }
+
+    Status VertexColumnList::GetNumericColumn(const std::string &label, const std::string &columnName,
+                                              std::shared_ptr<FixedBytesVertexColumn> *column) const {
+        EdgeTag_t tag = 0;
+        Status s = this->GetLabelTag(label, &tag);
+        if (!s.ok()) { return s; }
+        const auto handle = m_vertex_columns.find(std::make_pair(tag, columnName));
+        if (handle == m_vertex_columns.end()) {
+            return Status::NotExist(fmt::format("vertex column of label,name: `{}',`{}' not exist.", label, columnName));
+        }
+        switch (handle->second->vertexColType()) {
+            case ColumnType::INT32:
+            case ColumnType::INT64:
+            case ColumnType::FLOAT32:
+            case ColumnType::FLOAT64:
+                break;
+            default:
+                return Status::InvalidArgument(fmt::format(
+                        "vertex column `{}' of label `{}' is not a numeric column", columnName, label));
+        }
+        *column = std::dynamic_pointer_cast<FixedBytesVertexColumn>(handle->second);
+        assert(*column != nullptr);
+        return s;
+    }
+
+    Status VertexColumnList::GetVertexAttrColumn(const std::string &label, const std::string &columnName,
+                                                 ColumnType *type, std::string *filename) const {
+        std::shared_ptr<FixedBytesVertexColumn> column;
+        Status s = this->GetNumericColumn(label, columnName, &column);
+        if (!s.ok()) { return s; }
+        *type = column->vertexColType();
+        *filename = column->filename();
+        return s;
+    }
+
+    Status VertexColumnList::GatherVertexAttr(const std::string &label, const std::string &columnName,
+                                              const vid_t *vids, size_t n, void *out) const {
+        std::shared_ptr<FixedBytesVertexColumn> column;
+        Status s = this->GetNumericColumn(label, columnName, &column);
+        if (!s.ok()) { return s; }
+        const vid_t max_vid = m_max_vertices_id;
+        switch (column->vertexColType()) {
+            case ColumnType::INT32:
+                GatherValues(column->data(), max_vid, vids, n, static_cast<int32_t *>(out));
+                break;
+            case ColumnType::INT64:
+                GatherValues(column->data(), max_vid, vids, n, static_cast<int64_t *>(out));
+                break;
+            case ColumnType::FLOAT32:
+                GatherValues(column->data(), max_vid, vids, n, static_cast<float *>(out));
+                break;
+            case ColumnType::FLOAT64:
+                GatherValues(column->data(), max_vid, vids, n, static_cast<double *>(out));
+                break;
+            default:
+                assert(false);
+        }
+        return s;
+    }
+
+    Status VertexColumnList::GatherVertexAttrAsFloat(const std::string &label, const std::string &columnName,
+                                                     const vid_t *vids, size_t n, size_t stride, float *out) const {
+        std::shared_ptr<FixedBytesVertexColumn> column;
+        Status s = this->GetNumericColumn(label, columnName, &column);
+        if (!s.ok()) { return s; }
+        const vid_t max_vid = m_max_vertices_id;
+        switch (column->vertexColType()) {
+            case ColumnType::INT32:
+                GatherValuesAsFloat<int32_t>(column->data(), max_vid, vids, n, stride, out);
+                break;
+            case ColumnType::INT64:
+                GatherValuesAsFloat<int64_t>(column->data(), max_vid, vids, n, stride, out);
+                break;
+            case ColumnType::FLOAT32:
+                GatherValuesAsFloat<float>(column->data(), max_vid, vids, n, stride, out);
+                break;
+            case ColumnType::FLOAT64:
+                GatherValuesAsFloat<double>(column->data(), max_vid, vids, n, stride, out);
+                break;
+            default:
+                assert(false);
+        }
+        return s;
+    }
+
     Status VertexColumnList::GetLabelTag(const std::string &label, EdgeTag_t *tag) const {
         const auto attributes = m_vertex_attr.GetAttributesByLabel(label);
         if (attributes == m_vertex_attr.end()) {
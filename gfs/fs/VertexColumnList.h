@@ -12,6 +12,7 @@
 #include "IVertexColumn.h"
 
 namespace skg {
+    class FixedBytesVertexColumn;
     class VertexColumnList;
     using VertexColumnListPtr = std::shared_ptr<VertexColumnList>;
 
@@ -28,7 +29,8 @@ namespace skg {
                   m_max_vertices_id(0),
                   m_storage_vertices(0),
                   m_vertex_attr(),
-                  m_vertex_columns()
+                  m_vertex_columns(),
+                  m_degree_built(false)
         {
         }
     public:
@@ -110,8 +112,69 @@ namespace skg {
         const MetaHeterogeneousAttributes &GetVerticesProperties() const {
             return m_vertex_attr;
         }
+
+        // ===== 节点的出/入度列 ===== //
+
+        /**
+         * @brief 度列中的数据是否可用. 旧的数据库需要先调用 SkgDB::GenDegreeFile 建立
+         */
+        inline
+        bool IsDegreeBuilt() const {
+            return m_degree_built;
+        }
+
+        inline
+        void SetDegreeBuilt(bool built) {
+            m_degree_built = built;
+        }
+
+        /**
+         * @brief 边 src->dst 增加(delta=1)或删除(delta=-1)后, 更新 src 的出度和 dst 的入度.
+         * 原子操作, 可以多线程调用. 调用前需要 UpdateMaxVertexID 保证存储空间
+         */
+        void AddDegree(vid_t src, vid_t dst, int32_t delta);
+
+        /**
+         * @brief 清空所有节点的度, 并标记为不可用
+         */
+        Status ResetDegrees();
+
+        /**
+         * @brief 批量读取节点的度. 超过最大节点id的节点, 度为 0
+         * @param vids          节点 id
+         * @param n             节点个数
+         * @param in_degrees    入度, 为 nullptr 时不读取
+         * @param out_degrees   出度, 为 nullptr 时不读取
+         */
+        Status GetDegrees(const vid_t *vids, size_t n, int32_t *in_degrees, int32_t *out_degrees) const;
+
+        // ===== 定长数值属性列的批量读取 ===== //
+
+        /**
+         * @brief 查询数值型(INT32/INT64/FLOAT32/FLOAT64)属性列的类型和存储文件.
+         * 文件按 vid 顺序存储定长的值, 可以直接 mmap 读取
+         */
+        Status GetVertexAttrColumn(const std::string &label, const std::string &columnName,
+                                   ColumnType *type, std::string *filename) const;
+
+        /**
+         * @brief 按 vids 批量读取数值属性列, 值按列的原始类型连续写入 out.
+         * 不检查 null bitset, 没有设置过的值为 0; 超过最大节点id的节点, 值为 0
+         */
+        Status GatherVertexAttr(const std::string &label, const std::string &columnName,
+                                const vid_t *vids, size_t n, void *out) const;
+
+        /**
+         * @brief 按 vids 批量读取数值属性列, 转换为 float 写入 out[i * stride]
+         */
+        Status GatherVertexAttrAsFloat(const std::string &label, const std::string &columnName,
+                                       const vid_t *vids, size_t n, size_t stride, float *out) const;
+
     private:
 
+        Status GetNumericColumn(const std::string &label, const std::string &columnName,
+                                std::shared_ptr<FixedBytesVertexColumn> *column) const;
+
         Status FillOneVertex(const MetaHeterogeneousAttributes &hetProp,
                              const EdgeTag_t tag,
                              const std::string &vertex, const vid_t vid,
@@ -134,6 +197,10 @@ namespace skg {
         MetaHeterogeneousAttributes m_vertex_attr;
         std::map<std::pair<EdgeTag_t, std::string>, IVertexColumnPtr> m_vertex_columns;
         IVertexColumnPtr m_bitset_column;
+        // 节点的出/入度, 同时也放在 m_vertex_columns 中, 随其他列一起扩容/Flush
+        std::shared_ptr<FixedBytesVertexColumn> m_in_degree_column;
+        std::shared_ptr<FixedBytesVertexColumn> m_out_degree_column;
+        bool m_degree_built;
 
     public:
         // no copy allow
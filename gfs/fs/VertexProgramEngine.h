@@ -0,0 +1,385 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_VERTEXPROGRAMENGINE_H
+#define STARKNOWLEDGEGRAPHDATABASE_VERTEXPROGRAMENGINE_H
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#include "util/status.h"
+#include "util/types.h"
+#include "util/pathutils.h"
+#include "util/skglogger.h"
+#include "util/ThreadPool.h"
+#include "util/ischeduler.hpp"
+#include "util/bitset_scheduler.hpp"
+#include "metrics/metrics.hpp"
+
+#include "ShardTree.h"
+#include "ColumnDescriptor.h"
+#include "IVertexColumnImpl.h"
+
+namespace skg {
+
+    /**
+     * @brief 计算引擎的中间结果存储在节点属性目录下, 使用独立的 label 与用户的节点属性区分
+     */
+    VARIABLE_IS_NOT_USED static const char *SKG_ENGINE_LABEL = "_engine";
+
+    /**
+     * @brief 按 vid 存储的定长节点值, 底层为 mmap 的 FixedBytesVertexColumn.
+     * 值不常驻内存, 由 page cache 管理, 因此节点数不受内存大小限制.
+     */
+    template <typename ValueType>
+    class MappedVertexValues {
+    public:
+        MappedVertexValues(const std::string &basefile, const std::string &name)
+                : m_column(basefile, SKG_ENGINE_LABEL,
+                           ColumnDescriptor(name, ColumnType::FIXED_BYTES)
+                                   .SetColumnID(0)
+                                   .SetFixedLength(sizeof(ValueType))),
+                  m_values(nullptr), m_num_vertices(0) {
+        }
+
+        ~MappedVertexValues() {
+            this->Close();
+        }
+
+        /**
+         * @brief 创建(或复用)存储文件并映射到内存
+         */
+        Status Open(vid_t num_vertices) {
+            Status s = PathUtils::CreateFileIfMissing(m_column.filename());
+            if (!s.ok()) { return s; }
+            s = PathUtils::TruncateFile(m_column.filename(), static_cast<off_t>(num_vertices) * sizeof(ValueType));
+            if (!s.ok()) { return s; }
+            s = m_column.Open();
+            if (!s.ok()) { return s; }
+            m_values = reinterpret_cast<ValueType *>(m_column.mutable_data());
+            m_num_vertices = num_vertices;
+            return s;
+        }
+
+        Status Flush() {
+            return m_column.Flush();
+        }
+
+        Status Close() {
+            m_values = nullptr;
+            m_num_vertices = 0;
+            return m_column.Close();
+        }
+
+        inline ValueType *data() {
+            return m_values;
+        }
+
+        inline const ValueType *data() const {
+            return m_values;
+        }
+
+        inline vid_t size() const {
+            return m_num_vertices;
+        }
+
+    private:
+        FixedBytesVertexColumn m_column;
+        ValueType *m_values;
+        vid_t m_num_vertices;
+
+    public:
+        // No copying allowed
+        MappedVertexValues(const MappedVertexValues &) = delete;
+        MappedVertexValues &operator=(const MappedVertexValues &) = delete;
+    };
+
+    /**
+     * @brief 当前窗口中一个节点的邻居. 指针只在一次 Update 调用内有效
+     */
+    struct VertexNeighbors {
+        vid_t vid;
+        const vid_t *in;
+        size_t num_in;
+        const vid_t *out;
+        size_t num_out;
+    };
+
+    struct VertexProgramContext {
+        int iteration;
+        int niters;
+        vid_t num_vertices;
+        // 选择性调度器, 不使用选择性调度时为 nullptr
+        ischeduler *scheduler;
+    };
+
+    /**
+     * @brief 节点为中心的计算程序 (GraphChi 的 update function)
+     */
+    template <typename VertexDataType>
+    class VertexProgram {
+    public:
+        virtual ~VertexProgram() = default;
+
+        virtual
+        Status BeforeIteration(const VertexProgramContext &ctx) { return Status::OK(); }
+
+        virtual
+        Status AfterIteration(const VertexProgramContext &ctx) { return Status::OK(); }
+
+        /**
+         * @brief 更新节点的值.
+         * 同一窗口内被调度的节点会被并行调用, 只允许写 values[vertex.vid];
+         * 读邻居的值时可能读到本轮或上一轮的值 (异步语义, 与 GraphChi 相同).
+         */
+        virtual
+        void Update(const VertexNeighbors &vertex, VertexDataType *values, const VertexProgramContext &ctx) = 0;
+    };
+
+    class VertexProgramOptions {
+    public:
+        VertexProgramOptions()
+                : niters(10), nthreads(8),
+                  membudget_edges(64 * 1024 * 1024),
+                  selective(true),
+                  labels() {
+        }
+
+        int niters;
+        size_t nthreads;
+        // 一个窗口内最多加载的边数, 超过则把 ShardTree 的区间拆成多个窗口
+        size_t membudget_edges;
+        // 使用 bitset_scheduler 只更新被调度的节点, 没有任务时提前结束
+        bool selective;
+        // 参与计算的边类型, 为空表示所有类型
+        std::set<std::string> labels;
+    };
+
+    /**
+     * @brief 基于 ShardTree 区间的 parallel-sliding-window 计算引擎.
+     *
+     * 每个 ShardTree 存储 dst 落在其区间内的所有边, 因此按树的区间(过大时再拆分)划分窗口:
+     *  - 入边: 只需顺序扫描该树中与窗口相交的 partition;
+     *  - 出边: 边在每个 partition 内按 src 有序, 窗口的出边是每个 partition 中连续的一段,
+     *         按窗口顺序处理时, 读取位置在各个 partition 中依次向后滑动.
+     * 窗口内的节点并行执行 Update. 节点值保存在 mmap 的节点列中.
+     * 引擎只读取磁盘上的边, 调用前需要先 Flush.
+     */
+    template <typename VertexDataType>
+    class VertexProgramEngine {
+    public:
+        VertexProgramEngine(const std::vector<ShardTreePtr> &trees, vid_t num_vertices,
+                            const std::string &basefile, const std::string &name,
+                            const VertexProgramOptions &options)
+                : m_trees(trees), m_num_vertices(num_vertices),
+                  m_values(basefile, name), m_options(options) {
+        }
+
+        Status Open() {
+            return m_values.Open(m_num_vertices);
+        }
+
+        Status Close() {
+            return m_values.Close();
+        }
+
+        inline vid_t num_vertices() const {
+            return m_num_vertices;
+        }
+
+        inline const VertexDataType *values() const {
+            return m_values.data();
+        }
+
+        /**
+         * @brief 执行计算, 直到达到迭代次数或没有被调度的节点
+         * @param niters_run    实际执行的迭代次数, 可为 nullptr
+         */
+        Status Run(VertexProgram<VertexDataType> *program, int *niters_run) {
+            Status s;
+            if (m_values.data() == nullptr) {
+                return Status::InvalidArgument("engine is not opened");
+            }
+            std::vector<Window> windows;
+            s = this->CollectWindows(&windows);
+            if (!s.ok()) { return s; }
+
+            // 不使用选择性调度时, 每轮更新所有节点
+            std::unique_ptr<ischeduler> scheduler;
+            if (m_options.selective) {
+                scheduler.reset(new bitset_scheduler(m_num_vertices));
+                scheduler->add_task_to_all();
+            }
+            ThreadPool pool(std::max<size_t>(1, m_options.nthreads));
+
+            VertexProgramContext ctx;
+            ctx.niters = m_options.niters;
+            ctx.num_vertices = m_num_vertices;
+            ctx.scheduler = scheduler.get();
+            int iter = 0;
+            for (; iter < m_options.niters; ++iter) {
+                if (scheduler != nullptr) {
+                    if (scheduler->num_tasks() == 0) { break; }  // 收敛
+                    scheduler->new_iteration(iter);
+                }
+                ctx.iteration = iter;
+                metrics::GetInstance()->start_time("VertexProgramEngine.Iteration", metric_duration_type::MILLISECONDS);
+                s = program->BeforeIteration(ctx);
+                if (!s.ok()) { return s; }
+                for (const auto &window : windows) {
+                    s = this->ExecuteWindow(window, program, ctx, &pool);
+                    if (!s.ok()) { return s; }
+                }
+                s = program->AfterIteration(ctx);
+                if (!s.ok()) { return s; }
+                metrics::GetInstance()->stop_time("VertexProgramEngine.Iteration");
+                SKG_LOG_DEBUG("vertex program iteration {} done.", iter);
+            }
+            if (niters_run != nullptr) { *niters_run = iter; }
+            return m_values.Flush();
+        }
+
+    private:
+        struct Window {
+            size_t tree;
+            interval_t interval;
+        };
+
+        /**
+         * @brief 按 ShardTree 的区间划分窗口. 边数超过 membudget_edges 的树均分为多个窗口
+         */
+        Status CollectWindows(std::vector<Window> *windows) const {
+            windows->clear();
+            if (m_num_vertices == 0 || m_trees.empty()) { return Status::OK(); }
+            std::vector<size_t> order(m_trees.size());
+            for (size_t i = 0; i < order.size(); ++i) { order[i] = i; }
+            std::sort(order.begin(), order.end(), [this](size_t l, size_t r) {
+                return m_trees[l]->GetInterval().first < m_trees[r]->GetInterval().first;
+            });
+            const vid_t last_vid = m_num_vertices - 1;
+            for (size_t k = 0; k < order.size(); ++k) {
+                const ShardTreePtr &tree = m_trees[order[k]];
+                // 相邻的树之间不留空隙; 超出区间的边写入最后一棵树, 因此最后一个窗口延伸到最大的 vid
+                vid_t first = (k == 0) ? 0 : tree->GetInterval().first;
+                vid_t last = (k + 1 == order.size()) ? last_vid : m_trees[order[k + 1]]->GetInterval().first - 1;
+                if (first > last_vid) { break; }
+                last = std::min(last, last_vid);
+                if (first > last) { continue; }
+
+                const size_t budget = std::max<size_t>(1, m_options.membudget_edges);
+                const size_t nwindows = std::max<size_t>(1, (tree->GetNumEdges() + budget - 1) / budget);
+                const size_t length = static_cast<size_t>(last - first) + 1;
+                const size_t step = (length + nwindows - 1) / nwindows;
+                for (size_t st = first; st <= last; st += step) {
+                    Window window;
+                    window.tree = order[k];
+                    window.interval = interval_t(static_cast<vid_t>(st),
+                                                 static_cast<vid_t>(std::min<size_t>(st + step - 1, last)));
+                    windows->push_back(window);
+                }
+            }
+            return Status::OK();
+        }
+
+        /**
+         * @brief 邻接表按窗口内的偏移 (vid - window.first) 分组, 与 CSR 相同
+         */
+        static
+        void BuildAdjacency(const interval_t &window,
+                            const std::vector<std::pair<vid_t, vid_t>> &edges,
+                            std::vector<size_t> *offsets, std::vector<vid_t> *neighbors) {
+            const size_t length = window.GetNumVertices();
+            offsets->assign(length + 1, 0);
+            for (const auto &edge : edges) {
+                ++(*offsets)[edge.first - window.first + 1];
+            }
+            for (size_t i = 0; i < length; ++i) {
+                (*offsets)[i + 1] += (*offsets)[i];
+            }
+            neighbors->resize(edges.size());
+            std::vector<size_t> cursor(offsets->begin(), offsets->end() - 1);
+            for (const auto &edge : edges) {
+                (*neighbors)[cursor[edge.first - window.first]++] = edge.second;
+            }
+        }
+
+        Status ExecuteWindow(const Window &window, VertexProgram<VertexDataType> *program,
+                             const VertexProgramContext &ctx, ThreadPool *pool) {
+            Status s;
+            const interval_t &interval = window.interval;
+            // 没有被调度的节点, 跳过整个窗口的 I/O
+            if (ctx.scheduler != nullptr) {
+                bool any_scheduled = false;
+                for (size_t v = interval.first; v <= interval.second && !any_scheduled; ++v) {
+                    any_scheduled = ctx.scheduler->is_scheduled(static_cast<vid_t>(v));
+                }
+                if (!any_scheduled) { return s; }
+            }
+
+            // 入边, (dst, src)
+            std::vector<std::pair<vid_t, vid_t>> in_edges;
+            s = m_trees[window.tree]->ScanInEdges(interval, m_options.labels, [&in_edges](const PersistentEdge &edge) {
+                in_edges.emplace_back(edge.dst, edge.src);
+            });
+            if (!s.ok()) { return s; }
+            // 出边, (src, dst). 分布在所有的树中
+            std::vector<std::pair<vid_t, vid_t>> out_edges;
+            for (const auto &tree : m_trees) {
+                s = tree->ScanOutEdges(interval, m_options.labels, [&out_edges](const PersistentEdge &edge) {
+                    out_edges.emplace_back(edge.src, edge.dst);
+                });
+                if (!s.ok()) { return s; }
+            }
+
+            std::vector<size_t> in_offsets, out_offsets;
+            std::vector<vid_t> in_neighbors, out_neighbors;
+            BuildAdjacency(interval, in_edges, &in_offsets, &in_neighbors);
+            BuildAdjacency(interval, out_edges, &out_offsets, &out_neighbors);
+            in_edges.clear(); in_edges.shrink_to_fit();
+            out_edges.clear(); out_edges.shrink_to_fit();
+
+            // 窗口内的节点分块, 并行执行 Update
+            VertexDataType *values = m_values.data();
+            const size_t length = interval.GetNumVertices();
+            const size_t nchunks = std::min(length, std::max<size_t>(1, m_options.nthreads) * 4);
+            const size_t chunk = (length + nchunks - 1) / nchunks;
+            std::vector<std::future<void>> futures;
+            for (size_t beg = 0; beg < length; beg += chunk) {
+                const size_t end = std::min(beg + chunk, length);
+                futures.emplace_back(pool->enqueue([&, beg, end]() {
+                    VertexNeighbors vertex;
+                    for (size_t i = beg; i < end; ++i) {
+                        vertex.vid = static_cast<vid_t>(interval.first + i);
+                        if (ctx.scheduler != nullptr && !ctx.scheduler->is_scheduled(vertex.vid)) { continue; }
+                        vertex.in = in_neighbors.data() + in_offsets[i];
+                        vertex.num_in = in_offsets[i + 1] - in_offsets[i];
+                        vertex.out = out_neighbors.data() + out_offsets[i];
+                        vertex.num_out = out_offsets[i + 1] - out_offsets[i];
+                        program->Update(vertex, values, ctx);
+                    }
+                }));
+            }
+            for (auto &f : futures) {
+                f.get();
+            }
+            return s;
+        }
+
+    private:
+        const std::vector<ShardTreePtr> m_trees;
+        const vid_t m_num_vertices;
+        MappedVertexValues<VertexDataType> m_values;
+        const VertexProgramOptions m_options;
+
+    public:
+        // No copying allowed
+        VertexProgramEngine(const VertexProgramEngine &) = delete;
+        VertexProgramEngine &operator=(const VertexProgramEngine &) = delete;
+    };
+
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_VERTEXPROGRAMENGINE_H
@@ -60,6 +60,17 @@ namespace skg {
         m_vertices.emplace_back(tag, vid, "", ResultProperties(0));
     }
 
+    void VertexQueryResult::Receive(EdgeTag_t tag, const vid_t *vids, size_t n) {
+        if (n == 0) { return; }
+#ifdef SKG_QUERY_USE_MT
+        std::lock_guard<std::mutex> lock(m_receive_lock);
+#endif
+        m_vertices.reserve(m_vertices.size() + n);
+        for (size_t i = 0; i < n; ++i) {
+            m_vertices.emplace_back(tag, vids[i], "", ResultProperties(0));
+        }
+    }
+
     bool VertexQueryResult::IsOverLimit() {
         return !(m_nlimit == IRequest::NO_LIMIT || m_nlimit < static_cast<ssize_t>(m_vertices.size()));
     }
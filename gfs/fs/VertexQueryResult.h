@@ -256,6 +256,9 @@ namespace skg {
 
         void Receive(EdgeTag_t tag, vid_t vid);
 
+        // 批量接收同一 label 的节点, 只加一次锁
+        void Receive(EdgeTag_t tag, const vid_t *vids, size_t n);
+
         bool IsOverLimit();
 
         Status SetResultMetadata(const MetaHeterogeneousAttributes &hetAttributes);
@@ -271,6 +274,7 @@ namespace skg {
         friend class MemTable;
         friend class VecMemTable;
         friend class HashMemTable;
+        friend class AdjacencyCache;
 
     };
 
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
+#include "VertexReordering.h"
+
+namespace skg {
+
+    void VertexReordering::ComputeOrder(Options::VertexOrder order, vid_t num_vertices,
+                                        const vid_t *src, const vid_t *dst, size_t num_edges,
+                                        std::vector<vid_t> *new_to_old) {
+        assert(new_to_old != nullptr);
+        new_to_old->clear();
+        if (order == Options::VertexOrder::NONE) {
+            new_to_old->resize(num_vertices);
+            std::iota(new_to_old->begin(), new_to_old->end(), 0);
+            return;
+        }
+
+        Adjacency adj;
+        BuildAdjacency(num_vertices, src, dst, num_edges, &adj);
+        switch (order) {
+            case Options::VertexOrder::DEGREE:
+                DegreeOrder(adj, num_vertices, new_to_old);
+                break;
+            case Options::VertexOrder::BFS:
+                BFSOrder(adj, num_vertices, false, new_to_old);
+                break;
+            case Options::VertexOrder::RCM:
+                BFSOrder(adj, num_vertices, true, new_to_old);
+                break;
+            case Options::VertexOrder::NONE:
+                break;
+        }
+        assert(new_to_old->size() == num_vertices);
+    }
+
+    void VertexReordering::Inverse(const std::vector<vid_t> &new_to_old, std::vector<vid_t> *old_to_new) {
+        assert(old_to_new != nullptr);
+        old_to_new->resize(new_to_old.size());
+        for (size_t i = 0; i < new_to_old.size(); ++i) {
+            (*old_to_new)[new_to_old[i]] = static_cast<vid_t>(i);
+        }
+    }
+
+    void VertexReordering::BuildAdjacency(vid_t num_vertices,
+                                          const vid_t *src, const vid_t *dst, size_t num_edges,
+                                          Adjacency *adj) {
+        adj->offsets.assign(static_cast<size_t>(num_vertices) + 1, 0);
+        for (size_t i = 0; i < num_edges; ++i) {
+            if (src[i] >= num_vertices || dst[i] >= num_vertices || src[i] == dst[i]) { continue; }
+            ++adj->offsets[src[i] + 1];
+            ++adj->offsets[dst[i] + 1];
+        }
+        for (size_t v = 0; v < num_vertices; ++v) {
+            adj->offsets[v + 1] += adj->offsets[v];
+        }
+        adj->neighbors.resize(adj->offsets[num_vertices]);
+        std::vector<uint64_t> pos(adj->offsets.begin(), adj->offsets.end() - 1);
+        for (size_t i = 0; i < num_edges; ++i) {
+            if (src[i] >= num_vertices || dst[i] >= num_vertices || src[i] == dst[i]) { continue; }
+            adj->neighbors[pos[src[i]]++] = dst[i];
+            adj->neighbors[pos[dst[i]]++] = src[i];
+        }
+    }
+
+    void VertexReordering::DegreeOrder(const Adjacency &adj, vid_t num_vertices, std::vector<vid_t> *new_to_old) {
+        new_to_old->resize(num_vertices);
+        std::iota(new_to_old->begin(), new_to_old->end(), 0);
+        std::stable_sort(new_to_old->begin(), new_to_old->end(), [&adj](vid_t a, vid_t b) {
+            return adj.Degree(a) > adj.Degree(b);
+        });
+    }
+
+    void VertexReordering::BFSOrder(const Adjacency &adj, vid_t num_vertices, bool rcm,
+                                    std::vector<vid_t> *new_to_old) {
+        // 每个连通分量的起点: BFS 取度最大的节点, RCM 取度最小的节点 (近似外围节点)
+        std::vector<vid_t> seeds(num_vertices);
+        std::iota(seeds.begin(), seeds.end(), 0);
+        std::stable_sort(seeds.begin(), seeds.end(), [&adj, rcm](vid_t a, vid_t b) {
+            return rcm ? adj.Degree(a) < adj.Degree(b) : adj.Degree(a) > adj.Degree(b);
+        });
+
+        new_to_old->reserve(num_vertices);
+        std::vector<bool> visited(num_vertices, false);
+        std::vector<vid_t> frontier;
+        for (const vid_t seed : seeds) {
+            if (visited[seed]) { continue; }
+            visited[seed] = true;
+            // new_to_old 本身作为 BFS 的队列
+            size_t head = new_to_old->size();
+            new_to_old->push_back(seed);
+            while (head < new_to_old->size()) {
+                const vid_t v = (*new_to_old)[head++];
+                frontier.clear();
+                for (uint64_t i = adj.offsets[v]; i < adj.offsets[v + 1]; ++i) {
+                    const vid_t u = adj.neighbors[i];
+                    if (visited[u]) { continue; }
+                    visited[u] = true;
+                    frontier.push_back(u);
+                }
+                if (rcm) {
+                    std::stable_sort(frontier.begin(), frontier.end(), [&adj](vid_t a, vid_t b) {
+                        return adj.Degree(a) < adj.Degree(b);
+                    });
+                }
+                new_to_old->insert(new_to_old->end(), frontier.begin(), frontier.end());
+            }
+        }
+        if (rcm) {
+            std::reverse(new_to_old->begin(), new_to_old->end());
+        }
+    }
+
+}
@@ -0,0 +1,57 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_VERTEXREORDERING_H
+#define STARKNOWLEDGEGRAPHDATABASE_VERTEXREORDERING_H
+
+#include <cstdint>
+#include <vector>
+
+#include "util/types.h"
+#include "util/options.h"
+
+namespace skg {
+
+    /**
+     * @brief 批量导入前重排节点 id, 提高邻居在 edgelist 页以及 ShardTree 区间上的局部性.
+     *
+     * 按无向图计算顺序 (出边与入边都视为邻居):
+     *   DEGREE: 按度从大到小, 热点节点集中在 vid 较小的区间;
+     *   BFS:    每个连通分量从度最大的节点开始广度优先遍历;
+     *   RCM:    Reverse Cuthill-McKee, 从度最小的节点开始, 邻居按度从小到大入队, 最后整体反转.
+     */
+    class VertexReordering {
+    public:
+        /**
+         * @brief 计算 [0, num_vertices) 上的置换. new_to_old[i] 为新 vid i 对应的原 vid.
+         * 端点不小于 num_vertices 的边被忽略. order 为 NONE 时返回恒等置换
+         */
+        static void ComputeOrder(Options::VertexOrder order, vid_t num_vertices,
+                                 const vid_t *src, const vid_t *dst, size_t num_edges,
+                                 std::vector<vid_t> *new_to_old);
+
+        /**
+         * @brief 由 new_to_old 得到 old_to_new
+         */
+        static void Inverse(const std::vector<vid_t> &new_to_old, std::vector<vid_t> *old_to_new);
+
+    private:
+        // 无向图的 CSR
+        struct Adjacency {
+            std::vector<uint64_t> offsets;
+            std::vector<vid_t> neighbors;
+
+            uint64_t Degree(vid_t v) const {
+                return offsets[v + 1] - offsets[v];
+            }
+        };
+
+        static void BuildAdjacency(vid_t num_vertices,
+                                   const vid_t *src, const vid_t *dst, size_t num_edges,
+                                   Adjacency *adj);
+
+        static void DegreeOrder(const Adjacency &adj, vid_t num_vertices, std::vector<vid_t> *new_to_old);
+
+        static void BFSOrder(const Adjacency &adj, vid_t num_vertices, bool rcm, std::vector<vid_t> *new_to_old);
+    };
+
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_VERTEXREORDERING_H
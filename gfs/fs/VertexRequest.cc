@@ -36,6 +36,7 @@ VertexRequest::VertexRequest(const std::string &label, const std::string &vertex
         m_label.clear();
         m_vid = 0;
         m_vertex.clear();
+        m_filter.Clear();
 #ifdef SKG_REQ_VAR_PROP
         m_prop.clear();
 #else
@@ -256,6 +257,7 @@ std::string VertexRequest::ToDebugString() const {
             m_vid = rhs.m_vid;
             std::swap(m_vertex, rhs.m_vertex);
             std::swap(m_columns, rhs.m_columns);
+            std::swap(m_filter, rhs.m_filter);
 #ifdef SKG_REQ_VAR_PROP
             std::swap(m_prop, rhs.m_prop);
 #else
@@ -280,6 +282,7 @@ std::string VertexRequest::ToDebugString() const {
             m_vid = rhs.m_vid;
             m_vertex = rhs.m_vertex;
             m_columns = rhs.m_columns;
+            m_filter = rhs.m_filter;
 #ifdef SKG_REQ_VAR_PROP
             m_prop = rhs.m_prop;
 #else
@@ -8,6 +8,7 @@
 #include "ColumnDescriptor.h"
 #include "IRequest.h"
 #include "ResultProperties.h"
+#include "EdgeFilter.h"
 
 namespace skg {
 
@@ -47,6 +48,13 @@ namespace skg {
          */
         Status SetQueryColumnNames(const std::vector<std::string> &columns) override ;
 
+        /**
+         * 查询边/邻居时, 设置边的过滤条件 (label, 属性值范围). 过滤在存储层扫描边时进行
+         */
+        void SetEdgeFilter(const EdgeFilter &filter) {
+            m_filter = filter;
+        }
+
         std::string ToDebugString() const;
     public:
         const std::vector<ColumnDescriptor> &GetColumns() const;
@@ -54,6 +62,9 @@ namespace skg {
         inline EdgeTag_t GetLabelTag() const {
             return m_labelTag;
         }
+        inline const EdgeFilter &GetEdgeFilter() const {
+            return m_filter;
+        }
         inline const std::string &GetVertex() const {
             return m_vertex;
         }
@@ -85,6 +96,8 @@ namespace skg {
         vid_t m_vid;
         std::string m_vertex;
         std::vector<ColumnDescriptor> m_columns;
+        // 查询边时的过滤条件
+        EdgeFilter m_filter;
 #ifdef SKG_REQ_VAR_PROP
         ResultProperties m_prop;
 #else
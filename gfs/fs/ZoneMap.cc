@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include "fmt/format.h"
+
+#include "ZoneMap.h"
+#include "MetaAttributes.h"
+#include "util/pathutils.h"
+#include "util/skglogger.h"
+
+namespace skg {
+
+    namespace {
+        // 文件格式: magic, 列数; 每列: 列id, block 数, partition 的 min/max, 各个 block 的 min/max
+        const uint32_t ZONE_MAP_MAGIC = 0x5a4d4150;  // "ZMAP"
+    }
+
+    ZoneMap::Zone::Zone()
+            : min(std::numeric_limits<double>::infinity()),
+              max(-std::numeric_limits<double>::infinity()) {
+    }
+
+    void ZoneMap::Reset(const MetaAttributes &attributes, idx_t num_edges) {
+        m_zones.clear();
+        const size_t num_blocks = (num_edges + BLOCK_EDGES - 1) / BLOCK_EDGES;
+        for (const auto &col : attributes) {
+            if (!BoundEdgeFilter::IsRangeColumn(col.columnType())) { continue; }
+            m_zones[col.id()].blocks.resize(num_blocks);
+        }
+        m_modified = true;
+    }
+
+    void ZoneMap::Update(int32_t column_id, idx_t idx, double value) {
+        auto iter = m_zones.find(column_id);
+        // 没有统计的列, 保持未知
+        if (iter == m_zones.end()) { return; }
+        iter->second.partition.Extend(value);
+        const size_t block = idx / BLOCK_EDGES;
+        if (block < iter->second.blocks.size()) {
+            iter->second.blocks[block].Extend(value);
+        }
+        m_modified = true;
+    }
+
+    bool ZoneMap::MayMatch(const BoundEdgeFilter &filter) const {
+        for (const auto &term : filter.terms()) {
+            auto iter = m_zones.find(term.column.id());
+            if (iter == m_zones.end()) { continue; }
+            if (!iter->second.partition.Intersect(term.lower, term.upper)) { return false; }
+        }
+        return true;
+    }
+
+    bool ZoneMap::MayMatch(const BoundEdgeFilter &filter, idx_t idx) const {
+        const size_t block = idx / BLOCK_EDGES;
+        for (const auto &term : filter.terms()) {
+            auto iter = m_zones.find(term.column.id());
+            if (iter == m_zones.end() || block >= iter->second.blocks.size()) { continue; }
+            if (!iter->second.blocks[block].Intersect(term.lower, term.upper)) { return false; }
+        }
+        return true;
+    }
+
+    Status ZoneMap::Load(const std::string &filename) {
+        this->Clear();
+        if (!PathUtils::FileExists(filename)) { return Status::OK(); }
+        FILE *f = fopen(filename.c_str(), "rb");
+        if (f == nullptr) {
+            return Status::IOError(fmt::format("Can NOT open zone map: {}, error: {}({})",
+                                               filename, strerror(errno), errno));
+        }
+        bool ok = true;
+        uint32_t magic = 0, num_columns = 0;
+        ok = ok && fread(&magic, sizeof(magic), 1, f) == 1 && magic == ZONE_MAP_MAGIC;
+        ok = ok && fread(&num_columns, sizeof(num_columns), 1, f) == 1;
+        for (uint32_t i = 0; ok && i < num_columns; ++i) {
+            int32_t column_id = 0;
+            uint64_t num_blocks = 0;
+            ok = ok && fread(&column_id, sizeof(column_id), 1, f) == 1;
+            ok = ok && fread(&num_blocks, sizeof(num_blocks), 1, f) == 1;
+            if (!ok) { break; }
+            ColumnZones &zones = m_zones[column_id];
+            zones.blocks.resize(num_blocks);
+            ok = ok && fread(&zones.partition, sizeof(Zone), 1, f) == 1;
+            ok = ok && (num_blocks == 0 || fread(zones.blocks.data(), sizeof(Zone), num_blocks, f) == num_blocks);
+        }
+        fclose(f);
+        if (!ok) {
+            // 统计信息损坏时不做剪枝, 不影响查询结果
+            SKG_LOG_WARNING("zone map: {} is corrupted, ignored.", filename);
+            this->Clear();
+        }
+        return Status::OK();
+    }
+
+    Status ZoneMap::Save(const std::string &filename) {
+        FILE *f = fopen(filename.c_str(), "wb");
+        if (f == nullptr) {
+            return Status::IOError(fmt::format("Can NOT create zone map: {}, error: {}({})",
+                                               filename, strerror(errno), errno));
+        }
+        bool ok = true;
+        const uint32_t num_columns = static_cast<uint32_t>(m_zones.size());
+        ok = ok && fwrite(&ZONE_MAP_MAGIC, sizeof(ZONE_MAP_MAGIC), 1, f) == 1;
+        ok = ok && fwrite(&num_columns, sizeof(num_columns), 1, f) == 1;
+        for (const auto &zones : m_zones) {
+            const uint64_t num_blocks = zones.second.blocks.size();
+            ok = ok && fwrite(&zones.first, sizeof(zones.first), 1, f) == 1;
+            ok = ok && fwrite(&num_blocks, sizeof(num_blocks), 1, f) == 1;
+            ok = ok && fwrite(&zones.second.partition, sizeof(Zone), 1, f) == 1;
+            ok = ok && (num_blocks == 0 || fwrite(zones.second.blocks.data(), sizeof(Zone), num_blocks, f) == num_blocks);
+        }
+        fclose(f);
+        if (!ok) {
+            return Status::IOError(fmt::format("Fail to write zone map: {}", filename));
+        }
+        m_modified = false;
+        return Status::OK();
+    }
+
+}
@@ -0,0 +1,101 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_ZONEMAP_H
+#define STARKNOWLEDGEGRAPHDATABASE_ZONEMAP_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "util/types.h"
+#include "util/status.h"
+#include "util/internal_types.h"
+#include "EdgeFilter.h"
+
+namespace skg {
+
+    class MetaAttributes;
+
+    /**
+     * @brief sub-partition 中数值/时间列(以及权重)的 min/max 统计.
+     *
+     * 每列记录整个 sub-partition 的取值范围, 以及按边在 elist 中的位置, 每 BLOCK_EDGES 条边一个 block 的取值范围.
+     * 查询带范围条件时, 取值范围不相交的 sub-partition / block 可直接跳过.
+     * 只统计非 null 的值. 没有记录的列(旧数据, 新增的列)视为可能满足任意条件.
+     * 删除边, 修改属性值只会扩大范围, 因此统计值总是实际取值范围的超集.
+     */
+    class ZoneMap {
+    public:
+        static const idx_t BLOCK_EDGES = 4096;
+
+        static inline idx_t BlockEnd(idx_t idx) {
+            return (idx / BLOCK_EDGES + 1) * BLOCK_EDGES;
+        }
+
+    public:
+        ZoneMap() : m_zones(), m_modified(false) {}
+
+        /**
+         * @brief 开始统计一个有 num_edges 条边的 sub-partition, 为 attributes 中可比较的列创建空的统计
+         */
+        void Reset(const MetaAttributes &attributes, idx_t num_edges);
+
+        void Clear() {
+            m_zones.clear();
+            m_modified = false;
+        }
+
+        /**
+         * @brief 第 idx 条边在列 column_id 上的值为 value
+         */
+        void Update(int32_t column_id, idx_t idx, double value);
+
+        /**
+         * @brief 整个 sub-partition 中是否可能有满足 filter 的边
+         */
+        bool MayMatch(const BoundEdgeFilter &filter) const;
+
+        /**
+         * @brief 第 idx 条边所在的 block 中是否可能有满足 filter 的边
+         */
+        bool MayMatch(const BoundEdgeFilter &filter, idx_t idx) const;
+
+        /**
+         * @brief 读取 zone map 文件. 文件不存在时清空统计 (所有条件都视为可能满足)
+         */
+        Status Load(const std::string &filename);
+
+        Status Save(const std::string &filename);
+
+        bool IsModified() const {
+            return m_modified;
+        }
+
+    private:
+        struct Zone {
+            double min;
+            double max;
+
+            Zone();
+
+            void Extend(double value) {
+                if (value < min) { min = value; }
+                if (value > max) { max = value; }
+            }
+
+            bool Intersect(double lower, double upper) const {
+                // min > max 表示没有非 null 的值
+                return min <= max && max >= lower && min <= upper;
+            }
+        };
+
+        struct ColumnZones {
+            Zone partition;
+            std::vector<Zone> blocks;
+        };
+
+        std::map<int32_t, ColumnZones> m_zones;
+        bool m_modified;
+    };
+
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_ZONEMAP_H
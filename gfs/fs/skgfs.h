@@ -8,6 +8,7 @@
 #include <set>
 #include <vector>
 #include <limits>
+#include <memory>
 
 #include "util/types.h"
 #include "util/options.h"
@@ -16,9 +17,11 @@
 #include "VertexRequest.h"
 #include "EdgeRequest.h"
 #include "EdgesQueryResult.h"
+#include "EdgeCursor.h"
+#include "NeighborBatch.h"
 #include "VertexQueryResult.h"
 #include "PathAux.h"
-//#include "HetnetAux.h"
+#include "HetnetAux.h"
 #include "IDEncoder.h"
 
 namespace skg {
@@ -162,6 +165,38 @@ namespace skg {
         virtual
         Status GetBothEdges(/* const */VertexRequest &req, EdgesQueryResult *pQueryResult) const = 0;
 
+        /**
+         * @brief 打开节点的入边/出边游标, 分批读取, 每批至多 batch_size 条.
+         * 不会一次性把所有边读入内存, 适用于度很大的节点
+         * @param req       节点, 查询的属性列以及过滤条件. limit 为所有批次合计的条数上限
+         * @param token     为空时从头读取; 否则为之前游标 GetToken() 的返回值, 从该位置继续读取
+         * @param cursor
+         * @param batch_size
+         */
+        virtual
+        Status OpenEdgeCursor(/* const */VertexRequest &req, EdgeDirection direction,
+                              const std::string &token, std::unique_ptr<EdgeCursor> *cursor,
+                              size_t batch_size = EdgeCursor::DEFAULT_BATCH_SIZE) const = 0;
+
+        /**
+         * @brief 批量查询节点的入边. 节点按 long-id 排序去重后, 每个 partition 的索引只做一次有序查找,
+         * 每个 ShardTree 一个查询任务
+         * @param vids      节点的 long-id, 可以重复
+         * @param n         节点个数
+         * @param filter    边类型以及属性范围的过滤条件
+         * @param result    CSR 格式, 第 i 个节点的邻居为 neighbors[offsets[i], offsets[i + 1])
+         */
+        virtual
+        Status GetInEdgesBatch(const vid_t *vids, size_t n, const EdgeFilter &filter,
+                               NeighborBatch *result) const = 0;
+
+        /**
+         * @brief 批量查询节点的出边, 参数同 GetInEdgesBatch
+         */
+        virtual
+        Status GetOutEdgesBatch(const vid_t *vids, size_t n, const EdgeFilter &filter,
+                                NeighborBatch *result) const = 0;
+
         /**
          * @brief 获取入顶点
          * @param req
@@ -258,6 +293,12 @@ namespace skg {
         virtual
         size_t GetNumEdges() const = 0;
 
+        /**
+         * 各个 ShardTree 存储的边数, 按区间顺序排列
+         */
+        virtual
+        std::vector<size_t> GetNumEdgesPerShard() const = 0;
+
         /**
          * 所有更改刷到磁盘
          * shard-buffer的边
@@ -347,12 +388,62 @@ namespace skg {
         Status GetEdgeAttrNames(const EdgeLabel &label, std::vector<std::string> *names) const = 0;
 
         /**
-         * Deprecated. use tools/dump_degree instead
-         * 生成节点的度文件
+         * @brief 重建节点的出/入度列. 先 Flush, 再多线程扫描所有 ShardTree.
+         * 建好之后, 度列随 AddEdge/DeleteEdge/DeleteVertex 增量维护
          */
         virtual
         Status GenDegreeFile() = 0;
 
+        /**
+         * @brief 批量查询节点的度. 度列未建立时, 退化为逐个扫描 partition 统计
+         * @param vids          节点的 long-id
+         * @param n             节点个数
+         * @param in_degrees    入度, 为 nullptr 时不查询
+         * @param out_degrees   出度, 为 nullptr 时不查询
+         */
+        virtual
+        Status GetDegrees(const vid_t *vids, size_t n, int32_t *in_degrees, int32_t *out_degrees) const = 0;
+
+        /**
+         * @brief 批量导入前设置节点 id 的重排. 只能在写入任何边之前调用.
+         * 置换记录在 meta 目录中, 之后 string-id/long-id 与存储中 vid 的转换都经过该置换
+         * @param new_to_old    new_to_old[i] 为存储中 vid i 对应的原 long-id, 参见 VertexReordering
+         */
+        virtual
+        Status SetVertexOrder(const std::vector<vid_t> &new_to_old) = 0;
+
+        /**
+         * @brief 批量导入前, 按采样的入度 (sample_rate/sample_interval) 把空的数据库划分为多个 ShardTree,
+         * 使各个 ShardTree 的边数接近. 只在 shard_partition == balanced 且还没有写入边时生效
+         * @param dsts  待导入边的 dst long-id
+         * @param n     边数
+         */
+        virtual
+        Status PresplitShards(const vid_t *dsts, size_t n) = 0;
+
+        /**
+         * @brief 查询数值型(INT32/INT64/FLOAT32/FLOAT64)节点属性列的类型和存储文件.
+         * 文件中按 long-id 顺序存放定长的值, 可以只读 mmap 后直接使用
+         */
+        virtual
+        Status GetVertexAttrColumn(const std::string &label, const std::string &columnName,
+                                   ColumnType *type, std::string *filename) const = 0;
+
+        /**
+         * @brief 按 long-id 批量读取一个数值属性列, 按列的原始类型连续写入 out (n 个值).
+         * 不区分 null, 没有设置过的值为 0
+         */
+        virtual
+        Status GatherVertexAttr(const std::string &label, const std::string &columnName,
+                                const vid_t *vids, size_t n, void *out) const = 0;
+
+        /**
+         * @brief 按 long-id 批量读取多个数值属性列, 转为 float 后按行写入 out, 即 [n, columnNames.size()]
+         */
+        virtual
+        Status GatherVertexAttrAsFloat(const std::string &label, const std::vector<std::string> &columnNames,
+                                       const vid_t *vids, size_t n, float *out) const = 0;
+
         /**
          * @brief 导出数据(including 节点/关系/Schema)
          * @param out_dir   导出的文件夹
@@ -418,17 +509,27 @@ namespace skg {
         virtual
         Status Kneighbor(const TraverseRequest& traverse_req, std::vector<PathVertex> *visited) const = 0;
 
+        /* =============================
+         *    Engine Computation
+         *       全图计算, 先 Flush 再在磁盘上的数据上运行,
+         *       计算期间阻塞写操作
+         * ============================= */
+
         /**
-         * engine api
-        virtual
-        Status PageRank(const HetnetRequest& hn_req) const = 0;
-            
-        virtual
-        Status LPA(const HetnetRequest& hn_req) const = 0;
-            
+         * PageRank
+         * @param hn_req
+         * @param result rank 最大的 ntop 个节点
+         */
         virtual
-        Status FastUnfolding(const HetnetRequest& hn_req) const = 0;
+        Status PageRank(const HetnetRequest& hn_req, HetnetResult *result) = 0;
+
+        /**
+         * 标签传播社区发现
+         * @param hn_req
+         * @param result 最大的 ntop 个社区, 以社区中的一个节点表示
          */
+        virtual
+        Status LPA(const HetnetRequest& hn_req, HetnetResult *result) = 0;
             
     public:
         // 禁止复制
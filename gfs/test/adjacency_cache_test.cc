@@ -0,0 +1,228 @@
+// 邻居列表缓存: 命中时返回与存储层相同的列表 (遵守 limit), 超出内存预算时按 LRU 淘汰,
+// 度较小的节点多次未命中后才缓存, 查询期间有写入时放弃写入缓存;
+// 通过 SkgDB 查询时, AddEdge / DeleteEdge / DeleteVertex 之后不会读到旧的邻居列表.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "fs/AdjacencyCache.h"
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    // 度为 kHubDegree 的列表约占 400KB, 1MB 的缓存可以放下两个, 放不下三个
+    const size_t kBudgetMB = 1;
+    const vid_t kHubDegree = 100000;
+    const size_t kMinDegree = 1000;
+    const vid_t kHub = 0;
+    // 出边较少的节点
+    const vid_t kSmall = 1;
+    const vid_t kSmallDegree = 5;
+
+    VertexRequest Request(vid_t vid) {
+        VertexRequest req;
+        req.SetVertex(kVertexLabel, std::to_string(vid));
+        return req;
+    }
+
+    std::vector<vid_t> Vids(VertexQueryResult *result) {
+        std::vector<vid_t> vids;
+        Status s;
+        while (result->MoveNext()) {
+            vids.push_back(result->GetVid(&s));
+            SKG_TEST_OK(s);
+        }
+        return vids;
+    }
+
+    bool Get(AdjacencyCache *cache, vid_t vid, bool in_edges, ssize_t limit, std::vector<vid_t> *vids) {
+        VertexQueryResult result;
+        if (!cache->Get(vid, in_edges, limit, &result)) { return false; }
+        *vids = Vids(&result);
+        return true;
+    }
+
+    bool Contains(AdjacencyCache *cache, vid_t vid, bool in_edges) {
+        VertexQueryResult result;
+        return cache->Get(vid, in_edges, IRequest::NO_LIMIT, &result);
+    }
+
+    /**
+     * @brief 直接测试 AdjacencyCache. 缓存的列表取自数据库的查询结果, 同一个列表可以放在不同的 key 下
+     */
+    void TestCache(SkgDB *db) {
+        VertexQueryResult hub, small;
+        VertexRequest req = Request(kHub);
+        SKG_TEST_OK(db->GetOutVertices(req, &hub));
+        req = Request(kSmall);
+        SKG_TEST_OK(db->GetOutVertices(req, &small));
+        SKG_TEST_CHECK(hub.Size() == kHubDegree);
+        SKG_TEST_CHECK(small.Size() == kSmallDegree);
+        const std::vector<vid_t> hub_vids = Vids(&hub);
+        const std::vector<vid_t> small_vids = Vids(&small);
+
+        AdjacencyCache cache(kBudgetMB, kMinDegree, nullptr);
+
+        // 度不小于 kMinDegree, 第一次即缓存; 两个方向分开缓存
+        std::vector<vid_t> vids;
+        SKG_TEST_CHECK(!Get(&cache, kHub, false, IRequest::NO_LIMIT, &vids));
+        cache.Put(kHub, false, cache.GetEpoch(), hub);
+        SKG_TEST_CHECK(Get(&cache, kHub, false, IRequest::NO_LIMIT, &vids));
+        SKG_TEST_CHECK(vids == hub_vids);
+        SKG_TEST_CHECK(!Contains(&cache, kHub, true));
+        // limit 截取列表的前缀
+        SKG_TEST_CHECK(Get(&cache, kHub, false, 10, &vids));
+        SKG_TEST_CHECK(vids == std::vector<vid_t>(hub_vids.begin(), hub_vids.begin() + 10));
+        SKG_TEST_CHECK(Get(&cache, kHub, false, 0, &vids));
+        SKG_TEST_CHECK(vids.empty());
+
+        // LRU: 放入第二个列表后访问第一个, 第三个列表淘汰最久未使用的第二个
+        cache.Put(100, false, cache.GetEpoch(), hub);
+        SKG_TEST_CHECK(Contains(&cache, 100, false));
+        SKG_TEST_CHECK(Contains(&cache, kHub, false));
+        cache.Put(101, false, cache.GetEpoch(), hub);
+        SKG_TEST_CHECK(!Contains(&cache, 100, false));
+        SKG_TEST_CHECK(Contains(&cache, kHub, false) && Contains(&cache, 101, false));
+        // 重复放入同一个 key 不会占用两份内存
+        cache.Put(kHub, false, cache.GetEpoch(), hub);
+        SKG_TEST_CHECK(Contains(&cache, kHub, false) && Contains(&cache, 101, false));
+
+        // 度较小的节点, 第 ADMIT_AFTER_MISSES 次放入时才缓存
+        for (uint32_t i = 1; i < AdjacencyCache::ADMIT_AFTER_MISSES; ++i) {
+            cache.Put(kSmall, false, cache.GetEpoch(), small);
+            SKG_TEST_CHECK(!Contains(&cache, kSmall, false));
+        }
+        cache.Put(kSmall, false, cache.GetEpoch(), small);
+        SKG_TEST_CHECK(Get(&cache, kSmall, false, IRequest::NO_LIMIT, &vids));
+        SKG_TEST_CHECK(vids == small_vids);
+        // 未命中次数按方向分开统计
+        cache.Put(kSmall, true, cache.GetEpoch(), small);
+        SKG_TEST_CHECK(!Contains(&cache, kSmall, true));
+
+        // 查询前取得的版本在查询期间被写入改变, 放弃写入缓存; 重新查询后可以缓存
+        uint64_t epoch = cache.GetEpoch();
+        cache.Invalidate(12345);
+        cache.Put(200, false, epoch, hub);
+        SKG_TEST_CHECK(!Contains(&cache, 200, false));
+        epoch = cache.GetEpoch();
+        cache.Put(200, false, epoch, hub);
+        SKG_TEST_CHECK(Contains(&cache, 200, false));
+        epoch = cache.GetEpoch();
+        cache.Clear();
+        cache.Put(201, false, epoch, hub);
+        SKG_TEST_CHECK(!Contains(&cache, 201, false));
+
+        // Invalidate 删除节点两个方向的缓存, 不影响其他节点
+        cache.Put(kHub, false, cache.GetEpoch(), hub);
+        cache.Put(kHub, true, cache.GetEpoch(), small);
+        cache.Put(300, true, cache.GetEpoch(), small);
+        for (uint32_t i = 1; i < AdjacencyCache::ADMIT_AFTER_MISSES; ++i) {
+            cache.Put(kHub, true, cache.GetEpoch(), small);
+            cache.Put(300, true, cache.GetEpoch(), small);
+        }
+        SKG_TEST_CHECK(Contains(&cache, kHub, false) && Contains(&cache, kHub, true) && Contains(&cache, 300, true));
+        cache.Invalidate(kHub);
+        SKG_TEST_CHECK(!Contains(&cache, kHub, false) && !Contains(&cache, kHub, true));
+        SKG_TEST_CHECK(Contains(&cache, 300, true));
+        cache.Clear();
+        SKG_TEST_CHECK(!Contains(&cache, 300, true));
+    }
+
+    std::vector<vid_t> QueryVertices(SkgDB *db, vid_t vid, bool out) {
+        VertexRequest req = Request(vid);
+        VertexQueryResult result;
+        SKG_TEST_OK(out ? db->GetOutVertices(req, &result) : db->GetInVertices(req, &result));
+        std::vector<vid_t> vids = Vids(&result);
+        std::sort(vids.begin(), vids.end());
+        return vids;
+    }
+
+    double NumHits() {
+        return metrics::GetInstance()->get("AdjacencyCache.hit").value;
+    }
+
+    // 度较小的节点多次未命中之后才缓存, 之后的查询命中缓存; 每次的结果都与 expected 一致
+    void CheckCached(SkgDB *db, vid_t vid, bool out, const std::vector<vid_t> &expected) {
+        for (uint32_t i = 0; i < AdjacencyCache::ADMIT_AFTER_MISSES; ++i) {
+            SKG_TEST_CHECK(QueryVertices(db, vid, out) == expected);
+        }
+        const double hits = NumHits();
+        SKG_TEST_CHECK(QueryVertices(db, vid, out) == expected);
+        SKG_TEST_CHECK(NumHits() == hits + 1);
+    }
+
+    /**
+     * @brief 通过 SkgDB 查询: 写入边或删除节点之后, 缓存的旧列表不再返回
+     */
+    void TestInvalidation(SkgDB *db) {
+        // kHub 的出边与 dst 的入边都被缓存
+        std::vector<vid_t> out(kHubDegree);
+        for (vid_t i = 0; i < kHubDegree; ++i) {
+            out[i] = kHubDegree + i;
+        }
+        const vid_t dst = out[7];
+        CheckCached(db, kHub, true, out);
+        CheckCached(db, dst, false, std::vector<vid_t>({kHub}));
+
+        // AddEdge 使两端的缓存失效
+        const vid_t added = 3 * kHubDegree;
+        AddEdge(db, std::to_string(kHub), std::to_string(added));
+        out.push_back(added);
+        CheckCached(db, kHub, true, out);
+        CheckCached(db, added, false, std::vector<vid_t>({kHub}));
+
+        // DeleteEdge
+        SKG_TEST_OK(DeleteEdge(db, std::to_string(kHub), std::to_string(added)));
+        out.pop_back();
+        CheckCached(db, kHub, true, out);
+        SKG_TEST_CHECK(QueryVertices(db, added, false).empty());
+
+        // DeleteVertex: 被删除的节点出现在 kHub 的邻居列表中
+        DeleteVertex(db, std::to_string(dst));
+        out.erase(std::find(out.begin(), out.end(), dst));
+        CheckCached(db, kHub, true, out);
+
+        // 有过滤条件的查询不使用缓存
+        VertexRequest req = Request(kHub);
+        EdgeFilter filter;
+        filter.AddLabel(kEdgeLabel);
+        req.SetEdgeFilter(filter);
+        VertexQueryResult result;
+        const double hits = NumHits();
+        SKG_TEST_OK(db->GetOutVertices(req, &result));
+        SKG_TEST_CHECK(result.Size() == out.size());
+        SKG_TEST_CHECK(NumHits() == hits);
+    }
+
+    void TestAdjacencyCache() {
+        const std::string name = "adjacency_cache";
+        Options options = DefaultOptions();
+        options.hub_cache_mb = kBudgetMB;
+        options.hub_cache_min_degree = kMinDegree;
+        SkgDB *db = CreateDB(name, options);
+        for (vid_t i = 0; i < kHubDegree; ++i) {
+            AddEdge(db, std::to_string(kHub), std::to_string(kHubDegree + i));
+        }
+        for (vid_t i = 0; i < kSmallDegree; ++i) {
+            AddEdge(db, std::to_string(kSmall), std::to_string(2 + i));
+        }
+
+        TestCache(db);
+        db = ReopenDB(db, name, options);
+        TestInvalidation(db);
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestAdjacencyCache();
+    printf("adjacency_cache_test passed\n");
+    return EXIT_SUCCESS;
+}
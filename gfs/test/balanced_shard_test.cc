@@ -0,0 +1,93 @@
+// BALANCED 划分: 倾斜的入度下, ShardTree 超过 init_shard_size_mb 后在入度中位数处分裂,
+// 各个 ShardTree 的边数接近; 分裂后边不丢失、不重复, 重新打开后划分不变.
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    const int kNumVertices = 3000;
+    const int kNumHot = 20;
+    const int kNumSpread = 10;
+
+    std::string Hot(int i) {
+        return "h" + std::to_string(i);
+    }
+
+    // src 的出边: 所有热点节点, 以及 kNumSpread 个分散的节点
+    std::set<std::string> ExpectedOut(int src) {
+        std::set<std::string> dsts;
+        for (int i = 0; i < kNumHot; ++i) {
+            dsts.insert(Hot(i));
+        }
+        for (int j = 0; j < kNumSpread; ++j) {
+            const int dst = (src * 7 + j * 131 + 1) % kNumVertices;
+            if (dst != src) { dsts.insert(std::to_string(dst)); }
+        }
+        return dsts;
+    }
+
+    void CheckShards(SkgDB *db, size_t num_edges) {
+        const std::vector<size_t> per_shard = db->GetNumEdgesPerShard();
+        SKG_TEST_CHECK(per_shard.size() > 1);
+        SKG_TEST_CHECK(std::accumulate(per_shard.begin(), per_shard.end(), size_t(0)) == num_edges);
+        SKG_TEST_CHECK(db->GetNumEdges() == num_edges);
+        // 热点节点的入边占大多数, 仍然不会集中在一个 ShardTree 中
+        const size_t max_edges = *std::max_element(per_shard.begin(), per_shard.end());
+        const size_t min_edges = *std::min_element(per_shard.begin(), per_shard.end());
+        SKG_TEST_CHECK(min_edges > 0);
+        SKG_TEST_CHECK(max_edges * 4 <= num_edges * 3);
+    }
+
+    void CheckNeighbors(SkgDB *db) {
+        for (int src = 0; src < kNumVertices; src += 97) {
+            SKG_TEST_CHECK(Neighbors(db, std::to_string(src), true) == ExpectedOut(src));
+        }
+        for (int i = 0; i < kNumHot; i += 7) {
+            SKG_TEST_CHECK(Neighbors(db, Hot(i), false).size() == static_cast<size_t>(kNumVertices));
+        }
+    }
+
+    void TestSplitSkewedLoad() {
+        const std::string name = "balanced_shard";
+        Options options = DefaultOptions();
+        options.shard_partition = Options::ShardPartition::BALANCED;
+        // ShardTree 超过 1MB 时分裂, 按单个节点统计入度
+        options.shard_size_mb = 1;
+        options.shard_init_per = 1.0f;
+        options.sample_rate = 1;
+        options.sample_interval = 1;
+        SkgDB *db = CreateDB(name, options);
+
+        size_t num_edges = 0;
+        for (int src = 0; src < kNumVertices; ++src) {
+            for (const auto &dst : ExpectedOut(src)) {
+                AddEdge(db, std::to_string(src), dst);
+                ++num_edges;
+            }
+        }
+        CheckShards(db, num_edges);
+        CheckNeighbors(db);
+
+        db = ReopenDB(db, name, options);
+        CheckShards(db, num_edges);
+        CheckNeighbors(db);
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestSplitSkewedLoad();
+    printf("balanced_shard_test passed\n");
+    return EXIT_SUCCESS;
+}
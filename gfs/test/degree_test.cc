@@ -0,0 +1,89 @@
+// 度列的增量维护: 只有真的删除了边才减少度, 重复删除或删除不存在的边不改变度;
+// 删除节点时减少其邻居的度.
+
+#include <vector>
+
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    vid_t GetVid(SkgDB *db, const std::string &vertex) {
+        vid_t vid = 0;
+        SKG_TEST_OK(db->GetIDEncoder()->GetIDByVertex(kVertexLabel, vertex, &vid));
+        return vid;
+    }
+
+    // 依次检查节点 "0", "1", ... 的入度和出度
+    void CheckDegrees(SkgDB *db, const std::vector<int32_t> &in, const std::vector<int32_t> &out) {
+        std::vector<vid_t> vids;
+        for (size_t i = 0; i < in.size(); ++i) {
+            vids.push_back(GetVid(db, std::to_string(i)));
+        }
+        std::vector<int32_t> in_degrees(vids.size()), out_degrees(vids.size());
+        SKG_TEST_OK(db->GetDegrees(vids.data(), vids.size(), in_degrees.data(), out_degrees.data()));
+        SKG_TEST_CHECK(in_degrees == in);
+        SKG_TEST_CHECK(out_degrees == out);
+    }
+
+    void TestDeleteEdge() {
+        const std::string name = "degree_delete_edge";
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+        AddEdge(db, "0", "1");
+        AddEdge(db, "0", "2");
+        AddEdge(db, "1", "2");
+        AddEdge(db, "2", "0");
+        SKG_TEST_OK(db->GenDegreeFile());
+        CheckDegrees(db, {1, 1, 2}, {2, 1, 1});
+
+        // 不存在的边
+        SKG_TEST_CHECK(DeleteEdge(db, "1", "0").IsNotExist());
+        CheckDegrees(db, {1, 1, 2}, {2, 1, 1});
+
+        // 在 MemTable 中的边, 第二次删除时已不存在
+        SKG_TEST_OK(DeleteEdge(db, "0", "1"));
+        SKG_TEST_CHECK(DeleteEdge(db, "0", "1").IsNotExist());
+        CheckDegrees(db, {1, 0, 2}, {1, 1, 1});
+
+        // 刷到磁盘后, 已打删除标记的边不再重复计数
+        db = ReopenDB(db, name, options);
+        SKG_TEST_OK(DeleteEdge(db, "1", "2"));
+        SKG_TEST_CHECK(DeleteEdge(db, "1", "2").IsNotExist());
+        CheckDegrees(db, {1, 0, 1}, {1, 0, 1});
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+    void TestDeleteVertex() {
+        const std::string name = "degree_delete_vertex";
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+        AddEdge(db, "0", "1");
+        AddEdge(db, "0", "2");
+        AddEdge(db, "1", "2");
+        AddEdge(db, "2", "0");
+        AddEdge(db, "3", "0");
+        SKG_TEST_OK(db->GenDegreeFile());
+        CheckDegrees(db, {2, 1, 2, 0}, {2, 1, 1, 1});
+
+        DeleteVertex(db, "2");
+        CheckDegrees(db, {1, 1}, {1, 0});
+        SKG_TEST_CHECK(Neighbors(db, "0", true) == std::set<std::string>({"1"}));
+        SKG_TEST_CHECK(Neighbors(db, "0", false) == std::set<std::string>({"3"}));
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestDeleteEdge();
+    TestDeleteVertex();
+    printf("degree_test passed\n");
+    return EXIT_SUCCESS;
+}
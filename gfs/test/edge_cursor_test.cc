@@ -0,0 +1,186 @@
+// 边游标分页: 度很大的节点的边分布在多个 ShardTree 的 MemTable 和磁盘上, 以很小的批次读取,
+// 每一页在新的游标中从 token 继续; 结果与 GetOutEdges / GetInEdges 完全一致, 遵守 limit,
+// 格式错误或属于其他节点 / 方向的 token 被拒绝.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    typedef std::vector<std::pair<std::string, std::string>> EdgeList;
+
+    const int kNumVertices = 3000;
+    const size_t kBatchSize = 7;
+    // 出边指向所有节点的 kHub, 以及所有节点都指向它的 kSink
+    const char *const kHub = "0";
+    const std::string kSink = std::to_string(kNumVertices - 1);
+
+    VertexRequest Request(const std::string &vertex, ssize_t limit) {
+        VertexRequest req;
+        req.SetVertex(kVertexLabel, vertex);
+        req.SetLimit(limit);
+        return req;
+    }
+
+    void AppendEdges(EdgesQueryResult *result, EdgeList *edges) {
+        Status s;
+        while (result->MoveNext()) {
+            const std::string src = result->GetSrcVertex(&s);
+            SKG_TEST_OK(s);
+            const std::string dst = result->GetDstVertex(&s);
+            SKG_TEST_OK(s);
+            edges->emplace_back(src, dst);
+        }
+    }
+
+    EdgeList Sorted(EdgeList edges) {
+        std::sort(edges.begin(), edges.end());
+        return edges;
+    }
+
+    EdgeList QueryEdges(SkgDB *db, const std::string &vertex, EdgeDirection direction) {
+        VertexRequest req = Request(vertex, IRequest::NO_LIMIT);
+        EdgesQueryResult result;
+        SKG_TEST_OK(direction == EdgeDirection::OUT ? db->GetOutEdges(req, &result) : db->GetInEdges(req, &result));
+        EdgeList edges;
+        AppendEdges(&result, &edges);
+        return Sorted(edges);
+    }
+
+    /**
+     * @brief 每一页打开一个新的游标, 从上一页的 token 继续读取一批
+     */
+    EdgeList PageEdges(SkgDB *db, const std::string &vertex, EdgeDirection direction, ssize_t limit) {
+        EdgeList edges;
+        std::string token;
+        for (;;) {
+            VertexRequest req = Request(vertex, limit);
+            std::unique_ptr<EdgeCursor> cursor;
+            SKG_TEST_OK(db->OpenEdgeCursor(req, direction, token, &cursor, kBatchSize));
+            // token 中带有已经返回的边数
+            SKG_TEST_CHECK(cursor->GetNumReceived() == edges.size());
+            EdgesQueryResult batch;
+            SKG_TEST_OK(cursor->Next(&batch));
+            SKG_TEST_CHECK(batch.Size() <= kBatchSize);
+            AppendEdges(&batch, &edges);
+            SKG_TEST_CHECK(cursor->GetNumReceived() == edges.size());
+            if (cursor->Done()) { break; }
+            token = cursor->GetToken();
+        }
+        return edges;
+    }
+
+    /**
+     * @brief 一个游标读完所有批次
+     */
+    EdgeList CursorEdges(SkgDB *db, const std::string &vertex, EdgeDirection direction) {
+        VertexRequest req = Request(vertex, IRequest::NO_LIMIT);
+        std::unique_ptr<EdgeCursor> cursor;
+        SKG_TEST_OK(db->OpenEdgeCursor(req, direction, "", &cursor, kBatchSize));
+        EdgeList edges;
+        EdgesQueryResult batch;
+        while (!cursor->Done()) {
+            SKG_TEST_OK(cursor->Next(&batch));
+            SKG_TEST_CHECK(batch.Size() <= kBatchSize);
+            AppendEdges(&batch, &edges);
+        }
+        // 读完后不再返回边
+        SKG_TEST_OK(cursor->Next(&batch));
+        SKG_TEST_CHECK(batch.Size() == 0);
+        return edges;
+    }
+
+    void CheckPaging(SkgDB *db, const std::string &vertex, EdgeDirection direction, size_t degree) {
+        const EdgeList expected = QueryEdges(db, vertex, direction);
+        SKG_TEST_CHECK(expected.size() == degree);
+        // 排序后比较, 重复返回的边也会被发现
+        SKG_TEST_CHECK(Sorted(PageEdges(db, vertex, direction, IRequest::NO_LIMIT)) == expected);
+        SKG_TEST_CHECK(Sorted(CursorEdges(db, vertex, direction)) == expected);
+
+        // limit 是所有页合计的上限, 不是 batch 大小的整数倍
+        const EdgeList limited = Sorted(PageEdges(db, vertex, direction, 100));
+        SKG_TEST_CHECK(limited.size() == 100);
+        SKG_TEST_CHECK(std::adjacent_find(limited.begin(), limited.end()) == limited.end());
+        SKG_TEST_CHECK(std::includes(expected.begin(), expected.end(), limited.begin(), limited.end()));
+    }
+
+    void CheckTokens(SkgDB *db) {
+        VertexRequest req = Request(kHub, IRequest::NO_LIMIT);
+        std::unique_ptr<EdgeCursor> cursor;
+        SKG_TEST_OK(db->OpenEdgeCursor(req, EdgeDirection::OUT, "", &cursor, kBatchSize));
+        EdgesQueryResult batch;
+        SKG_TEST_OK(cursor->Next(&batch));
+        const std::string token = cursor->GetToken();
+
+        // 格式错误
+        for (const std::string &bad : {std::string("garbage"), std::string("1:2:3"), token.substr(0, token.size() / 2)}) {
+            req = Request(kHub, IRequest::NO_LIMIT);
+            SKG_TEST_CHECK(db->OpenEdgeCursor(req, EdgeDirection::OUT, bad, &cursor, kBatchSize).IsInvalidArgument());
+            SKG_TEST_CHECK(cursor == nullptr);
+        }
+        // 其他节点
+        req = Request(kSink, IRequest::NO_LIMIT);
+        SKG_TEST_CHECK(db->OpenEdgeCursor(req, EdgeDirection::OUT, token, &cursor, kBatchSize).IsInvalidArgument());
+        SKG_TEST_CHECK(cursor == nullptr);
+        // 同一个节点的另一个方向
+        req = Request(kHub, IRequest::NO_LIMIT);
+        SKG_TEST_CHECK(db->OpenEdgeCursor(req, EdgeDirection::IN, token, &cursor, kBatchSize).IsInvalidArgument());
+        SKG_TEST_CHECK(cursor == nullptr);
+    }
+
+    void TestPaging() {
+        const std::string name = "edge_cursor";
+        Options options = DefaultOptions();
+        // 预先按 dst 把数据库划分为多个 ShardTree, kHub 的出边分布在所有 ShardTree 中
+        options.shard_partition = Options::ShardPartition::BALANCED;
+        options.shard_size_mb = 1;
+        options.shard_init_per = 1.0f;
+        options.sample_rate = 1;
+        options.sample_interval = 1;
+        SkgDB *db = CreateDB(name, options);
+        std::vector<vid_t> dsts;
+        for (int i = 0; i < 300000; ++i) {
+            dsts.push_back(i % kNumVertices);
+        }
+        SKG_TEST_OK(db->PresplitShards(dsts.data(), dsts.size()));
+        SKG_TEST_CHECK(db->GetNumEdgesPerShard().size() > 1);
+
+        // 一半的边在磁盘上, 另一半在 MemTable 中
+        const int half = kNumVertices / 2;
+        for (int v = 1; v < kNumVertices - 1; ++v) {
+            if (v == half) { db = ReopenDB(db, name, options); }
+            AddEdge(db, kHub, std::to_string(v));
+            AddEdge(db, std::to_string(v), kSink);
+        }
+        const size_t degree = kNumVertices - 2;
+
+        CheckPaging(db, kHub, EdgeDirection::OUT, degree);
+        CheckPaging(db, kSink, EdgeDirection::IN, degree);
+        CheckTokens(db);
+
+        // 全部在磁盘上
+        db = ReopenDB(db, name, options);
+        SKG_TEST_CHECK(db->GetNumEdgesPerShard().size() > 1);
+        CheckPaging(db, kHub, EdgeDirection::OUT, degree);
+        CheckPaging(db, kSink, EdgeDirection::IN, degree);
+        CheckTokens(db);
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestPaging();
+    printf("edge_cursor_test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+// 批量查询邻居: GetOutEdgesBatch / GetInEdgesBatch 返回的 CSR 与逐个节点的 GetOutVertices / GetInVertices 一致.
+// 请求的节点乱序, 有重复, 有没有边的节点和不存在的节点; 边分布在多个 ShardTree 的 MemTable 和磁盘上.
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    const vid_t kNumVertices = 200;
+    const char *const kOtherLabel = "e2";
+    // 不存在的节点
+    const vid_t kMissing = 100000;
+
+    // src 的出边的 dst, v % 5 == 0 的节点没有出边
+    std::vector<vid_t> OutDsts(vid_t src) {
+        std::vector<vid_t> dsts;
+        for (vid_t k = 0; k < src % 5; ++k) {
+            const vid_t dst = (src * 7 + k * 13 + 1) % kNumVertices;
+            if (dst != src && std::find(dsts.begin(), dsts.end(), dst) == dsts.end()) { dsts.push_back(dst); }
+        }
+        return dsts;
+    }
+
+    void AddLabeledEdge(SkgDB *db, const std::string &label, vid_t src, vid_t dst) {
+        EdgeRequest req;
+        req.DisableWAL();
+        req.SetEdge(label, kVertexLabel, std::to_string(src), kVertexLabel, std::to_string(dst));
+        SKG_TEST_OK(db->AddEdge(req));
+    }
+
+    std::vector<vid_t> QueryVertices(SkgDB *db, vid_t vid, bool out, const EdgeFilter &filter) {
+        VertexRequest req;
+        req.SetVertex(kVertexLabel, std::to_string(vid));
+        req.SetEdgeFilter(filter);
+        VertexQueryResult result;
+        SKG_TEST_OK(out ? db->GetOutVertices(req, &result) : db->GetInVertices(req, &result));
+        std::vector<vid_t> vids;
+        Status s;
+        while (result.MoveNext()) {
+            vids.push_back(result.GetVid(&s));
+            SKG_TEST_OK(s);
+        }
+        std::sort(vids.begin(), vids.end());
+        return vids;
+    }
+
+    void CheckBatch(SkgDB *db, const std::vector<vid_t> &vids, bool out, const EdgeFilter &filter,
+                    const std::map<vid_t, std::vector<vid_t>> &expected) {
+        NeighborBatch batch;
+        SKG_TEST_OK(out ? db->GetOutEdgesBatch(vids.data(), vids.size(), filter, &batch)
+                        : db->GetInEdgesBatch(vids.data(), vids.size(), filter, &batch));
+        SKG_TEST_CHECK(batch.offsets.size() == vids.size() + 1);
+        SKG_TEST_CHECK(batch.offsets.front() == 0);
+        SKG_TEST_CHECK(batch.neighbors.size() == batch.offsets.back());
+        SKG_TEST_CHECK(batch.weights.size() == batch.neighbors.size());
+        SKG_TEST_CHECK(batch.tags.size() == batch.neighbors.size());
+        for (size_t i = 0; i < vids.size(); ++i) {
+            SKG_TEST_CHECK(batch.offsets[i] <= batch.offsets[i + 1]);
+            std::vector<vid_t> row(batch.neighbors.begin() + batch.offsets[i],
+                                   batch.neighbors.begin() + batch.offsets[i + 1]);
+            std::sort(row.begin(), row.end());
+            auto iter = expected.find(vids[i]);
+            SKG_TEST_CHECK(row == (iter == expected.end() ? std::vector<vid_t>() : iter->second));
+            if (vids[i] < kNumVertices) {
+                SKG_TEST_CHECK(row == QueryVertices(db, vids[i], out, filter));
+            }
+        }
+    }
+
+    void CheckAll(SkgDB *db, const std::vector<vid_t> &vids,
+                  const std::map<vid_t, std::vector<vid_t>> expected[2][2]) {
+        EdgeFilter only_other;
+        only_other.AddLabel(kOtherLabel);
+        for (int out = 0; out < 2; ++out) {
+            CheckBatch(db, vids, out != 0, EdgeFilter(), expected[out][0]);
+            CheckBatch(db, vids, out != 0, only_other, expected[out][1]);
+        }
+        // 有序无重复的请求
+        std::vector<vid_t> sorted(vids);
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        CheckBatch(db, sorted, true, EdgeFilter(), expected[1][0]);
+        CheckBatch(db, sorted, false, EdgeFilter(), expected[0][0]);
+        // 空的请求
+        NeighborBatch batch;
+        SKG_TEST_OK(db->GetOutEdgesBatch(vids.data(), 0, EdgeFilter(), &batch));
+        SKG_TEST_CHECK(batch.offsets.size() == 1 && batch.neighbors.empty());
+    }
+
+    void TestEdgesBatch() {
+        const std::string name = "edges_batch";
+        Options options = DefaultOptions();
+        // 按 dst 划分为多个 ShardTree, 出边分布在多个 ShardTree 中
+        options.shard_partition = Options::ShardPartition::BALANCED;
+        options.shard_size_mb = 1;
+        options.shard_init_per = 1.0f;
+        options.sample_rate = 1;
+        options.sample_interval = 1;
+        SkgDB *db = CreateDB(name, options);
+        SKG_TEST_OK(db->CreateNewEdgeLabel(kOtherLabel, kVertexLabel, kVertexLabel));
+        std::vector<vid_t> dsts;
+        for (vid_t i = 0; i < 300000; ++i) {
+            dsts.push_back(i % kNumVertices);
+        }
+        SKG_TEST_OK(db->PresplitShards(dsts.data(), dsts.size()));
+        SKG_TEST_CHECK(db->GetNumEdgesPerShard().size() > 1);
+
+        // expected[out][only_other][vid]: 按 long-id 排序的邻居
+        std::map<vid_t, std::vector<vid_t>> expected[2][2];
+        for (vid_t src = 0; src < kNumVertices; ++src) {
+            // 前一半的边写到磁盘上, 后一半留在 MemTable 中
+            if (src == kNumVertices / 2) { db = ReopenDB(db, name, options); }
+            for (vid_t dst : OutDsts(src)) {
+                AddEdge(db, std::to_string(src), std::to_string(dst));
+                expected[1][0][src].push_back(dst);
+                expected[0][0][dst].push_back(src);
+            }
+            // 每 3 个节点一条另一种类型的边, 与 kEdgeLabel 的边可能重合
+            if (src % 3 == 0) {
+                const vid_t dst = (src + 1) % kNumVertices;
+                AddLabeledEdge(db, kOtherLabel, src, dst);
+                for (int only_other = 0; only_other < 2; ++only_other) {
+                    expected[1][only_other][src].push_back(dst);
+                    expected[0][only_other][dst].push_back(src);
+                }
+            }
+        }
+        for (auto &by_out : expected) {
+            for (auto &by_label : by_out) {
+                for (auto &row : by_label) {
+                    std::sort(row.second.begin(), row.second.end());
+                }
+            }
+        }
+
+        // 乱序, 重复, 没有出边 (0, 5, 10) 以及不存在的节点
+        const std::vector<vid_t> vids = {150, 3, 3, 0, 199, 5, kMissing, 42, 3, 10, 1, 150, 98, 101};
+        CheckAll(db, vids, expected);
+
+        db = ReopenDB(db, name, options);
+        CheckAll(db, vids, expected);
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestEdgesBatch();
+    printf("edges_batch_test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+// 计算引擎 (VertexProgramEngine) 的测试: 按窗口扫描入边/出边得到的 PageRank 与直接在边表上
+// 迭代的结果一致, 删除的边不参与计算; LPA 的社区不跨越连通分量.
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    typedef std::vector<std::pair<int, int>> EdgeList;
+
+    std::map<std::string, double> ReferencePageRank(int n, const EdgeList &edges, double damping) {
+        std::vector<int> outdeg(n, 0);
+        for (const auto &e : edges) { ++outdeg[e.first]; }
+        std::vector<double> rank(n, 1.0), next(n);
+        for (int iter = 0; iter < 200; ++iter) {
+            std::fill(next.begin(), next.end(), 0.0);
+            for (const auto &e : edges) { next[e.second] += rank[e.first] / outdeg[e.first]; }
+            for (int v = 0; v < n; ++v) { rank[v] = (1 - damping) + damping * next[v]; }
+        }
+        std::map<std::string, double> ranks;
+        for (int v = 0; v < n; ++v) { ranks[std::to_string(v)] = rank[v]; }
+        return ranks;
+    }
+
+    void CheckPageRank(SkgDB *db, int n, const EdgeList &edges) {
+        HetnetRequest req;
+        req.niters = 100;
+        req.tolerance = 1e-7;
+        req.ntop = n;
+        HetnetResult result;
+        SKG_TEST_OK(db->PageRank(req, &result));
+        const auto expected = ReferencePageRank(n, edges, req.damping);
+        SKG_TEST_CHECK(result.top.size() == static_cast<size_t>(n));
+        for (size_t i = 0; i < result.top.size(); ++i) {
+            const HetnetVertex &v = result.top[i];
+            SKG_TEST_CHECK(expected.count(v.id) == 1);
+            SKG_TEST_CHECK(std::fabs(v.value - expected.at(v.id)) < 1e-3);
+            // 按 rank 从大到小
+            SKG_TEST_CHECK(i == 0 || result.top[i - 1].value >= v.value);
+        }
+    }
+
+    void TestPageRank() {
+        const std::string name = "engine_pagerank";
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+        const int n = 12;
+        EdgeList edges;
+        for (int v = 0; v < n; ++v) {
+            edges.emplace_back(v, (v + 1) % n);
+            edges.emplace_back(v, (v * 5 + 3) % n);
+            if (v % 3 == 0) { edges.emplace_back(v, 0); }
+        }
+        // 去掉自环和重复的边
+        EdgeList unique_edges;
+        for (const auto &e : edges) {
+            if (e.first == e.second) { continue; }
+            if (std::find(unique_edges.begin(), unique_edges.end(), e) != unique_edges.end()) { continue; }
+            unique_edges.push_back(e);
+            AddEdge(db, std::to_string(e.first), std::to_string(e.second));
+        }
+        CheckPageRank(db, n, unique_edges);
+
+        // 删除的边不再参与计算
+        const auto removed = unique_edges.back();
+        unique_edges.pop_back();
+        SKG_TEST_OK(DeleteEdge(db, std::to_string(removed.first), std::to_string(removed.second)));
+        CheckPageRank(db, n, unique_edges);
+
+        // 重新打开后从磁盘扫描, 结果不变
+        db = ReopenDB(db, name, options);
+        CheckPageRank(db, n, unique_edges);
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+    void TestLPA() {
+        const std::string name = "engine_lpa";
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+        // 两个不相连的 4-团
+        for (int base : {0, 4}) {
+            for (int u = base; u < base + 4; ++u) {
+                for (int v = base; v < base + 4; ++v) {
+                    if (u != v) { AddEdge(db, std::to_string(u), std::to_string(v)); }
+                }
+            }
+        }
+        HetnetRequest req;
+        req.niters = 20;
+        req.ntop = 8;
+        HetnetResult result;
+        SKG_TEST_OK(db->LPA(req, &result));
+        double total = 0;
+        for (const auto &v : result.top) {
+            SKG_TEST_CHECK(v.value <= 4);
+            total += v.value;
+        }
+        SKG_TEST_CHECK(total == 8);
+        SKG_TEST_CHECK(result.top[0].value == 4 && result.top[1].value == 4);
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestPageRank();
+    TestLPA();
+    printf("engine_test passed\n");
+    return EXIT_SUCCESS;
+}
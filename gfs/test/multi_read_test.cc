@@ -0,0 +1,234 @@
+// PosixRandomAccessFile::MultiRead: io_uring 路径与线程池回退路径读到的数据与逐个 pread 一致.
+// 覆盖文件末尾之后的读, 跨越文件末尾的读, 超过一批 (256 个) 的请求, 文件中间的短读,
+// 以及 io_uring_enter 失败时撤回未提交的请求; 内核不支持 io_uring 时只测试回退路径.
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "env/io_posix.h"
+#include "test_util.h"
+#include "util/sync_point.h"
+
+using namespace skg;
+
+namespace {
+
+    const char *const kFileName = "multi_read_test.data";
+    // 不是块大小的整数倍
+    const uint64_t kFileSize = (1 << 20) + 123;
+    const size_t kMaxLen = 8192;
+
+    char Byte(uint64_t offset) {
+        return static_cast<char>((offset * 131 + offset / 4096) & 0xff);
+    }
+
+    void WriteTestFile() {
+        std::string content(kFileSize, '\0');
+        for (uint64_t i = 0; i < kFileSize; ++i) {
+            content[i] = Byte(i);
+        }
+        FILE *f = fopen(kFileName, "wb");
+        SKG_TEST_CHECK(f != nullptr);
+        SKG_TEST_CHECK(fwrite(content.data(), 1, content.size(), f) == content.size());
+        fclose(f);
+    }
+
+    /**
+     * @brief num_reqs 个请求, 每个请求有自己的 scratch.
+     * 每 10 个请求中有一个从文件末尾之后开始, 一个跨越文件末尾, 其余落在文件中的随机位置
+     */
+    struct Requests {
+        std::vector<ReadRequest> reqs;
+        std::vector<char> buffer;
+
+        explicit Requests(size_t num_reqs) : reqs(num_reqs), buffer(num_reqs * kMaxLen) {
+            for (size_t i = 0; i < num_reqs; ++i) {
+                ReadRequest &req = reqs[i];
+                req.len = 1 + (i * 37) % kMaxLen;
+                if (i % 10 == 0) {
+                    req.offset = kFileSize + i;
+                } else if (i % 10 == 1) {
+                    req.offset = kFileSize - req.len / 2;
+                } else {
+                    req.offset = (i * 7919 * 13) % kFileSize;
+                }
+                req.scratch = buffer.data() + i * kMaxLen;
+                req.status = Status::Corruption("not read");
+            }
+        }
+    };
+
+    // 用 pread 读取一个请求, 与 MultiRead 的结果比较
+    void CheckRequest(const RandomAccessFile *file, const ReadRequest &req) {
+        SKG_TEST_OK(req.status);
+        SKG_TEST_CHECK(req.result.data() == req.scratch);
+        const size_t expected = req.offset >= kFileSize ? 0 : std::min<uint64_t>(req.len, kFileSize - req.offset);
+        SKG_TEST_CHECK(req.result.size() == expected);
+        std::vector<char> scratch(req.len);
+        Slice result;
+        SKG_TEST_OK(file->Read(req.offset, req.len, &result, scratch.data()));
+        SKG_TEST_CHECK(result.size() == expected);
+        SKG_TEST_CHECK(memcmp(result.data(), req.result.data(), expected) == 0);
+        for (size_t j = 0; j < expected; ++j) {
+            SKG_TEST_CHECK(req.result[j] == Byte(req.offset + j));
+        }
+    }
+
+    void CheckAll(RandomAccessFile *file, size_t num_reqs) {
+        Requests r(num_reqs);
+        SKG_TEST_OK(file->MultiRead(r.reqs.data(), r.reqs.size()));
+        for (const ReadRequest &req : r.reqs) {
+            CheckRequest(file, req);
+        }
+    }
+
+    std::unique_ptr<RandomAccessFile> OpenFile() {
+        unique_ptr<RandomAccessFile> file;
+        SKG_TEST_OK(Env::Default()->NewRandomAccessFile(kFileName, &file, EnvOptions()));
+        return std::unique_ptr<RandomAccessFile>(file.release());
+    }
+
+    /**
+     * @brief use_io_uring 为 false 时强制走线程池回退路径.
+     * 返回是否通过 io_uring 提交了请求 (没有编译 io_uring 或内核不支持时为 false)
+     */
+    bool TestReads(RandomAccessFile *file, bool use_io_uring) {
+        SyncPoint *sp = SyncPoint::GetInstance();
+        size_t num_enters = 0;
+        sp->SetCallBack("PosixRandomAccessFile::MultiRead:UseIOUring",
+                        [use_io_uring](void *arg) { *static_cast<bool *>(arg) = use_io_uring; });
+        sp->SetCallBack("IOUring::ReadBatch:ToSubmit", [&num_enters](void *) { ++num_enters; });
+        sp->EnableProcessing();
+        // 不超过 2 个请求时在调用线程中读取; 257 与 600 个请求分为多批
+        for (size_t num_reqs : {0, 1, 2, 3, 17, 255, 256, 257, 600}) {
+            CheckAll(file, num_reqs);
+        }
+        sp->DisableProcessing();
+        sp->ClearAllCallBacks();
+        if (!use_io_uring) { SKG_TEST_CHECK(num_enters == 0); }
+        return num_enters > 0;
+    }
+
+    // io_uring 在文件中间返回短读, 剩余部分由 pread 补齐
+    void TestShortReads(RandomAccessFile *file) {
+        SyncPoint *sp = SyncPoint::GetInstance();
+        size_t num_short = 0;
+        sp->SetCallBack("PosixRandomAccessFile::MultiRead:IOUringResult", [&num_short](void *arg) {
+            int *res = static_cast<int *>(arg);
+            if (res[0] > 1) {
+                res[0] /= 2;
+                ++num_short;
+            }
+        });
+        sp->EnableProcessing();
+        CheckAll(file, 600);
+        sp->DisableProcessing();
+        sp->ClearAllCallBacks();
+        // 每一批的第一个请求都在文件中间 (第 0 个请求除外)
+        SKG_TEST_CHECK(num_short >= 2);
+    }
+
+    /**
+     * @brief 第一次 io_uring_enter 失败: 没有请求被内核取走, 整个 MultiRead 退回到 pread
+     */
+    void TestSubmitFailure(RandomAccessFile *file) {
+        SyncPoint *sp = SyncPoint::GetInstance();
+        size_t num_calls = 0;
+        sp->SetCallBack("IOUring::ReadBatch:InjectError", [&num_calls](void *arg) {
+            if (num_calls++ == 0) { *static_cast<int *>(arg) = EIO; }
+        });
+        sp->EnableProcessing();
+        CheckAll(file, 600);
+        sp->DisableProcessing();
+        sp->ClearAllCallBacks();
+        SKG_TEST_CHECK(num_calls == 1);
+        // 撤回后 io_uring 仍然可用
+        CheckAll(file, 600);
+    }
+
+    /**
+     * @brief 第一批每次最多提交 100 个请求, 第二次 io_uring_enter 失败:
+     * 已经提交的请求正常完成, 撤回的请求返回错误, 后续的批次不受影响
+     */
+    void TestPartialSubmitFailure(RandomAccessFile *file) {
+        SyncPoint *sp = SyncPoint::GetInstance();
+        size_t num_calls = 0;
+        sp->SetCallBack("IOUring::ReadBatch:ToSubmit",
+                        [](void *arg) { unsigned *n = static_cast<unsigned *>(arg); *n = std::min(*n, 100u); });
+        sp->SetCallBack("IOUring::ReadBatch:InjectError", [&num_calls](void *arg) {
+            if (num_calls++ == 1) { *static_cast<int *>(arg) = EIO; }
+        });
+        sp->EnableProcessing();
+        Requests r(600);
+        SKG_TEST_OK(file->MultiRead(r.reqs.data(), r.reqs.size()));
+        sp->DisableProcessing();
+        sp->ClearAllCallBacks();
+
+        // 第一批 [0, 256): 前 submitted 个请求已经提交, 其余被撤回
+        size_t submitted = 0;
+        while (submitted < 256 && r.reqs[submitted].status.ok()) {
+            CheckRequest(file, r.reqs[submitted]);
+            ++submitted;
+        }
+        SKG_TEST_CHECK(submitted > 0 && submitted <= 100);
+        for (size_t i = submitted; i < 256; ++i) {
+            SKG_TEST_CHECK(r.reqs[i].status.code() == Status::Code::IO_ERROR);
+            SKG_TEST_CHECK(r.reqs[i].result.size() == 0);
+        }
+        for (size_t i = 256; i < r.reqs.size(); ++i) {
+            CheckRequest(file, r.reqs[i]);
+        }
+        // 撤回后 sq 的 tail 与内核一致, 下一次读取正常
+        CheckAll(file, 600);
+    }
+
+    /**
+     * @brief 只写打开的 fd 上每个请求都读取失败, 两条路径都返回错误而不是空的结果
+     */
+    void TestReadErrors(bool use_io_uring) {
+        const int fd = open(kFileName, O_WRONLY);
+        SKG_TEST_CHECK(fd >= 0);
+        PosixRandomAccessFile file(kFileName, fd, EnvOptions());
+        SyncPoint *sp = SyncPoint::GetInstance();
+        sp->SetCallBack("PosixRandomAccessFile::MultiRead:UseIOUring",
+                        [use_io_uring](void *arg) { *static_cast<bool *>(arg) = use_io_uring; });
+        sp->EnableProcessing();
+        for (size_t num_reqs : {2, 300}) {
+            Requests r(num_reqs);
+            SKG_TEST_OK(file.MultiRead(r.reqs.data(), r.reqs.size()));
+            for (const ReadRequest &req : r.reqs) {
+                SKG_TEST_CHECK(req.status.code() == Status::Code::IO_ERROR);
+                SKG_TEST_CHECK(req.result.size() == 0);
+            }
+        }
+        sp->DisableProcessing();
+        sp->ClearAllCallBacks();
+    }
+
+}
+
+int main(int argc, char **argv) {
+    WriteTestFile();
+    std::unique_ptr<RandomAccessFile> file = OpenFile();
+    TestReads(file.get(), false);
+    TestReadErrors(false);
+    if (TestReads(file.get(), true)) {
+        TestShortReads(file.get());
+        TestSubmitFailure(file.get());
+        TestPartialSubmitFailure(file.get());
+        TestReadErrors(true);
+    } else {
+        printf("io_uring unavailable, only the thread pool fallback is tested\n");
+    }
+    file.reset();
+    SKG_TEST_OK(Env::Default()->DeleteFile(kFileName));
+    printf("multi_read_test passed\n");
+    return EXIT_SUCCESS;
+}
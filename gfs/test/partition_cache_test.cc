@@ -0,0 +1,123 @@
+// 延迟打开 sub-partition: 同时打开的数量受上限限制, 被关闭的 sub-partition 再次访问时重新打开,
+// 读到的边与关闭前一致, 关闭前的修改已经刷到磁盘.
+
+#include <string>
+#include <vector>
+
+#include "fs/PartitionHandlerCache.h"
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    const std::vector<std::string> kLabels = {"e0", "e1", "e2"};
+
+    void AddLabeledEdge(SkgDB *db, const std::string &label, const std::string &src, const std::string &dst) {
+        EdgeRequest req;
+        req.DisableWAL();
+        req.SetEdge(label, kVertexLabel, src, kVertexLabel, dst);
+        SKG_TEST_OK(db->AddEdge(req));
+    }
+
+    Status DeleteLabeledEdge(SkgDB *db, const std::string &label, const std::string &src, const std::string &dst) {
+        EdgeRequest req;
+        req.DisableWAL();
+        req.SetEdge(label, kVertexLabel, src, kVertexLabel, dst);
+        return db->DeleteEdge(req);
+    }
+
+    void TestOpenEvictReopen() {
+        const std::string name = "partition_cache";
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+        // 每种边各自存放在不同的 sub-partition 中
+        for (size_t i = 0; i < kLabels.size(); ++i) {
+            SKG_TEST_OK(db->CreateNewEdgeLabel(kLabels[i], kVertexLabel, kVertexLabel));
+            AddLabeledEdge(db, kLabels[i], "0", std::to_string(i + 1));
+            AddLabeledEdge(db, kLabels[i], std::to_string(i + 1), "0");
+        }
+        const size_t num_edges = db->GetNumEdges();
+
+        // 每次查询依次访问所有 sub-partition, 上限为 1 时每次访问都会关闭前一个
+        options.lazy_open_partitions = true;
+        options.max_open_partitions = 1;
+        db = ReopenDB(db, name, options);
+        SKG_TEST_CHECK(db->GetNumEdges() == num_edges);
+        for (int round = 0; round < 3; ++round) {
+            SKG_TEST_CHECK(Neighbors(db, "0", true) == std::set<std::string>({"1", "2", "3"}));
+            SKG_TEST_CHECK(Neighbors(db, "0", false) == std::set<std::string>({"1", "2", "3"}));
+            SKG_TEST_CHECK(PartitionHandlerCache::GetInstance()->GetNumOpened() <= 1);
+        }
+
+        // 修改后被关闭的 sub-partition, 重新打开时读到修改后的数据
+        SKG_TEST_OK(DeleteLabeledEdge(db, "e1", "0", "2"));
+        SKG_TEST_CHECK(Neighbors(db, "0", true) == std::set<std::string>({"1", "3"}));
+        SKG_TEST_CHECK(Neighbors(db, "2", false).empty());
+        SKG_TEST_CHECK(Neighbors(db, "0", true) == std::set<std::string>({"1", "3"}));
+
+        db = ReopenDB(db, name, options);
+        SKG_TEST_CHECK(Neighbors(db, "0", true) == std::set<std::string>({"1", "3"}));
+        SKG_TEST_CHECK(Neighbors(db, "0", false) == std::set<std::string>({"1", "2", "3"}));
+        SKG_TEST_CHECK(PartitionHandlerCache::GetInstance()->GetNumOpened() <= 1);
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+    /**
+     * @brief 上限是进程内共用的: 两个 DB 请求的上限不同时取较大的, 后打开的 DB 不会调小上限
+     */
+    void TestSharedCapacity() {
+        const std::string small_name = "partition_cache_small";
+        const std::string large_name = "partition_cache_large";
+        Options options = DefaultOptions();
+        SkgDB *small = CreateDB(small_name, options);
+        SkgDB *large = CreateDB(large_name, options);
+        for (const std::string &label : kLabels) {
+            SKG_TEST_OK(small->CreateNewEdgeLabel(label, kVertexLabel, kVertexLabel));
+            SKG_TEST_OK(large->CreateNewEdgeLabel(label, kVertexLabel, kVertexLabel));
+            AddLabeledEdge(small, label, "0", "1");
+            AddLabeledEdge(large, label, "0", "1");
+        }
+
+        options.lazy_open_partitions = true;
+        Options small_options = options;
+        small_options.max_open_partitions = 2;
+        Options large_options = options;
+        large_options.max_open_partitions = 4;
+        large = ReopenDB(large, large_name, large_options);
+        SKG_TEST_CHECK(PartitionHandlerCache::GetInstance()->GetCapacity() == 4);
+        small = ReopenDB(small, small_name, small_options);
+        SKG_TEST_CHECK(PartitionHandlerCache::GetInstance()->GetCapacity() == 4);
+
+        // 两个 DB 的 sub-partition 共用上限
+        for (int round = 0; round < 3; ++round) {
+            SKG_TEST_CHECK(Neighbors(small, "0", true) == std::set<std::string>({"1"}));
+            SKG_TEST_CHECK(Neighbors(large, "0", true) == std::set<std::string>({"1"}));
+            SKG_TEST_CHECK(PartitionHandlerCache::GetInstance()->GetNumOpened() <= 4);
+        }
+
+        // 请求不限制时不再限制
+        options.max_open_partitions = 0;
+        large = ReopenDB(large, large_name, options);
+        SKG_TEST_CHECK(PartitionHandlerCache::GetInstance()->GetCapacity() == 0);
+        small = ReopenDB(small, small_name, small_options);
+        SKG_TEST_CHECK(PartitionHandlerCache::GetInstance()->GetCapacity() == 0);
+
+        SKG_TEST_OK(small->Drop());
+        delete small;
+        SKG_TEST_OK(large->Drop());
+        delete large;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestOpenEvictReopen();
+    // 会调大进程内共用的上限, 放在最后
+    TestSharedCapacity();
+    printf("partition_cache_test passed\n");
+    return EXIT_SUCCESS;
+}
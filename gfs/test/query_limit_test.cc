@@ -0,0 +1,47 @@
+// 结果集大小限制: 不取属性时按批接收边, 超过上限的部分被截断.
+
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    size_t NumOutEdges(SkgDB *db, const std::string &vertex, ssize_t limit) {
+        VertexRequest req;
+        req.SetVertex(kVertexLabel, vertex);
+        req.SetLimit(limit);
+        EdgesQueryResult result;
+        SKG_TEST_OK(db->GetOutEdges(req, &result));
+        return result.Size();
+    }
+
+    void TestOutEdgesLimit() {
+        const std::string name = "query_limit";
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+        for (int v = 1; v <= 10; ++v) {
+            AddEdge(db, "0", std::to_string(v));
+        }
+        // 边在 MemTable 中
+        SKG_TEST_CHECK(NumOutEdges(db, "0", IRequest::NO_LIMIT) == 10);
+        SKG_TEST_CHECK(NumOutEdges(db, "0", 3) == 3);
+
+        // 边在磁盘上, 一次批量接收
+        db = ReopenDB(db, name, options);
+        SKG_TEST_CHECK(NumOutEdges(db, "0", IRequest::NO_LIMIT) == 10);
+        SKG_TEST_CHECK(NumOutEdges(db, "0", 3) == 3);
+        SKG_TEST_CHECK(NumOutEdges(db, "0", 10) == 10);
+        SKG_TEST_CHECK(NumOutEdges(db, "0", 20) == 10);
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestOutEdgesLimit();
+    printf("query_limit_test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+// 节点 id 重排: 重排后存储中的 vid 改变, 但按 string-id 看到的邻居 (边查询与 k 跳遍历) 与不重排时一致,
+// 重新打开后置换仍然生效.
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "fs/VertexReordering.h"
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    typedef std::vector<std::pair<vid_t, vid_t>> EdgeList;
+
+    const vid_t kNumVertices = 40;
+
+    EdgeList MakeEdges() {
+        EdgeList edges;
+        for (vid_t v = 0; v < kNumVertices; ++v) {
+            edges.emplace_back(v, (v * 7 + 3) % kNumVertices);
+            edges.emplace_back(v, (v * 13 + 11) % kNumVertices);
+            if (v % 4 == 0) { edges.emplace_back(v, 1); }
+        }
+        EdgeList unique_edges;
+        for (const auto &e : edges) {
+            if (e.first == e.second) { continue; }
+            if (std::find(unique_edges.begin(), unique_edges.end(), e) != unique_edges.end()) { continue; }
+            unique_edges.push_back(e);
+        }
+        return unique_edges;
+    }
+
+    SkgDB *LoadDB(const std::string &name, const Options &options, Options::VertexOrder order, const EdgeList &edges) {
+        SkgDB *db = CreateDB(name, options);
+        if (order != Options::VertexOrder::NONE) {
+            std::vector<vid_t> src, dst, new_to_old;
+            for (const auto &e : edges) {
+                src.push_back(e.first);
+                dst.push_back(e.second);
+            }
+            VertexReordering::ComputeOrder(order, kNumVertices, src.data(), dst.data(), edges.size(), &new_to_old);
+            SKG_TEST_OK(db->SetVertexOrder(new_to_old));
+        }
+        for (const auto &e : edges) {
+            AddEdge(db, std::to_string(e.first), std::to_string(e.second));
+        }
+        return db;
+    }
+
+    // k 跳遍历到的节点的 string-id
+    std::set<std::string> KHop(SkgDB *db, const std::string &vertex, int k, bool out) {
+        TraverseRequest req;
+        req.id = vertex;
+        req.label = kVertexLabel;
+        req.k = k;
+        req.direction = out ? 'o' : 'i';
+        std::vector<PVpair> pairs;
+        SKG_TEST_OK(db->Kout(req, &pairs));
+        std::set<std::string> visited;
+        for (const auto &pair : pairs) {
+            visited.insert(out ? pair.second.id : pair.first.id);
+        }
+        return visited;
+    }
+
+    typedef std::map<std::string, std::vector<std::set<std::string>>> NeighborMap;
+
+    NeighborMap CollectNeighbors(SkgDB *db) {
+        NeighborMap neighbors;
+        for (vid_t v = 0; v < kNumVertices; ++v) {
+            const std::string vertex = std::to_string(v);
+            neighbors[vertex] = {
+                    Neighbors(db, vertex, true), Neighbors(db, vertex, false),
+                    KHop(db, vertex, 2, true), KHop(db, vertex, 2, false)};
+        }
+        return neighbors;
+    }
+
+    // 至少有一个节点的存储 vid 与原 id 不同, 保证置换确实生效
+    bool IsPermuted(SkgDB *db) {
+        for (vid_t v = 0; v < kNumVertices; ++v) {
+            vid_t vid = 0;
+            SKG_TEST_OK(db->GetIDEncoder()->GetIDByVertex(kVertexLabel, std::to_string(v), &vid));
+            if (vid != v) { return true; }
+        }
+        return false;
+    }
+
+    void TestNeighborsUnchanged() {
+        const EdgeList edges = MakeEdges();
+        Options options = DefaultOptions();
+        SkgDB *plain = LoadDB("reorder_plain", options, Options::VertexOrder::NONE, edges);
+        const NeighborMap expected = CollectNeighbors(plain);
+        SKG_TEST_OK(plain->Drop());
+        delete plain;
+
+        for (Options::VertexOrder order : {Options::VertexOrder::DEGREE,
+                                           Options::VertexOrder::BFS,
+                                           Options::VertexOrder::RCM}) {
+            const std::string name = "reorder_" + std::to_string(static_cast<int>(order));
+            SkgDB *db = LoadDB(name, options, order, edges);
+            SKG_TEST_CHECK(IsPermuted(db));
+            SKG_TEST_CHECK(CollectNeighbors(db) == expected);
+
+            // 从磁盘读取, 置换从 meta 目录恢复
+            db = ReopenDB(db, name, options);
+            SKG_TEST_CHECK(IsPermuted(db));
+            SKG_TEST_CHECK(CollectNeighbors(db) == expected);
+            SKG_TEST_OK(db->Drop());
+            delete db;
+        }
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestNeighborsUnchanged();
+    printf("reorder_test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,109 @@
+#ifndef STARKNOWLEDGEGRAPHDATABASE_TEST_UTIL_H
+#define STARKNOWLEDGEGRAPHDATABASE_TEST_UTIL_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <string>
+
+#include "env/env.h"
+#include "fs/skgfs.h"
+
+// 测试程序共用的断言和建库函数. 断言失败时打印位置并以 EXIT_FAILURE 退出
+
+#define SKG_TEST_CHECK(cond)                                                        \
+    do {                                                                            \
+        if (!(cond)) {                                                              \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(EXIT_FAILURE);                                                     \
+        }                                                                           \
+    } while (0)
+
+#define SKG_TEST_OK(expr)                                                           \
+    do {                                                                            \
+        skg::Status _s = (expr);                                                    \
+        if (!_s.ok()) {                                                             \
+            fprintf(stderr, "%s:%d: %s: %s\n", __FILE__, __LINE__, #expr,           \
+                    _s.ToString().c_str());                                         \
+            exit(EXIT_FAILURE);                                                     \
+        }                                                                           \
+    } while (0)
+
+namespace skg {
+namespace test {
+
+    const char *const kVertexLabel = "v";
+    const char *const kEdgeLabel = "e";
+
+    inline Options DefaultOptions() {
+        Options options;
+        options.LoadOptions();
+        options.default_db_dir = "./db";
+        return options;
+    }
+
+    /**
+     * @brief 删除同名的旧数据后建库并打开, 建好节点类型 kVertexLabel 和边类型 kEdgeLabel
+     */
+    inline SkgDB *CreateDB(const std::string &name, const Options &options) {
+        const std::string dir = options.GetDBDir(name);
+        if (Env::Default()->FileExists(dir).ok()) {
+            SKG_TEST_OK(Env::Default()->DeleteDir(dir, true));
+        }
+        SKG_TEST_OK(SkgDB::Create(name, options));
+        SkgDB *db = nullptr;
+        SKG_TEST_OK(SkgDB::Open(name, options, &db));
+        SKG_TEST_OK(db->CreateNewVertexLabel(kVertexLabel));
+        SKG_TEST_OK(db->CreateNewEdgeLabel(kEdgeLabel, kVertexLabel, kVertexLabel));
+        return db;
+    }
+
+    inline SkgDB *ReopenDB(SkgDB *db, const std::string &name, const Options &options) {
+        SKG_TEST_OK(db->Close());
+        delete db;
+        db = nullptr;
+        SKG_TEST_OK(SkgDB::Open(name, options, &db));
+        return db;
+    }
+
+    inline void AddEdge(SkgDB *db, const std::string &src, const std::string &dst) {
+        EdgeRequest req;
+        req.DisableWAL();
+        req.SetEdge(kEdgeLabel, kVertexLabel, src, kVertexLabel, dst);
+        SKG_TEST_OK(db->AddEdge(req));
+    }
+
+    inline Status DeleteEdge(SkgDB *db, const std::string &src, const std::string &dst) {
+        EdgeRequest req;
+        req.DisableWAL();
+        req.SetEdge(kEdgeLabel, kVertexLabel, src, kVertexLabel, dst);
+        return db->DeleteEdge(req);
+    }
+
+    inline void DeleteVertex(SkgDB *db, const std::string &vertex) {
+        VertexRequest req;
+        req.SetVertex(kVertexLabel, vertex);
+        SKG_TEST_OK(db->DeleteVertex(req));
+    }
+
+    /**
+     * @brief 节点的出边 (out = true) 或入边的另一端, 按 string-id 去重
+     */
+    inline std::set<std::string> Neighbors(SkgDB *db, const std::string &vertex, bool out) {
+        VertexRequest req;
+        req.SetVertex(kVertexLabel, vertex);
+        EdgesQueryResult result;
+        SKG_TEST_OK(out ? db->GetOutEdges(req, &result) : db->GetInEdges(req, &result));
+        std::set<std::string> neighbors;
+        Status s;
+        while (result.MoveNext()) {
+            neighbors.insert(out ? result.GetDstVertex(&s) : result.GetSrcVertex(&s));
+            SKG_TEST_OK(s);
+        }
+        return neighbors;
+    }
+
+}
+}
+
+#endif //STARKNOWLEDGEGRAPHDATABASE_TEST_UTIL_H
@@ -0,0 +1,96 @@
+// 删除信息 (tombstones): 删除节点后其出边/入边不可见, 重新打开后仍然生效; 重写磁盘数据后删除信息被清空,
+// 重新添加的边可见; 只有入边的节点被删除时也按入边数触发回收.
+
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    // 数据目录下删除信息文件的个数
+    size_t CountTombstoneFiles(const std::string &dir) {
+        static const std::string suffix = ".tombstones";
+        std::vector<std::string> children;
+        if (!Env::Default()->GetChildren(dir, &children).ok()) { return 0; }
+        size_t n = 0;
+        for (const auto &child : children) {
+            if (child.size() > suffix.size()
+                && child.compare(child.size() - suffix.size(), suffix.size(), suffix) == 0) {
+                ++n;
+            } else {
+                n += CountTombstoneFiles(dir + "/" + child);
+            }
+        }
+        return n;
+    }
+
+    void TestDeleteVertexAndReopen() {
+        const std::string name = "tombstone_reopen";
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+        AddEdge(db, "0", "1");
+        AddEdge(db, "1", "2");
+        AddEdge(db, "2", "0");
+        AddEdge(db, "0", "2");
+        // 边在磁盘上, 删除节点只记录删除信息
+        db = ReopenDB(db, name, options);
+        DeleteVertex(db, "1");
+        SKG_TEST_CHECK(Neighbors(db, "0", true) == std::set<std::string>({"2"}));
+        SKG_TEST_CHECK(Neighbors(db, "2", false) == std::set<std::string>({"0"}));
+
+        // 删除信息从文件恢复
+        db = ReopenDB(db, name, options);
+        SKG_TEST_CHECK(CountTombstoneFiles(options.GetDBDir(name)) > 0);
+        SKG_TEST_CHECK(Neighbors(db, "0", true) == std::set<std::string>({"2"}));
+        SKG_TEST_CHECK(Neighbors(db, "2", false) == std::set<std::string>({"0"}));
+
+        // 重新添加的边在 MemTable 和刷盘后都可见
+        AddEdge(db, "0", "1");
+        SKG_TEST_CHECK(Neighbors(db, "0", true) == std::set<std::string>({"1", "2"}));
+        db = ReopenDB(db, name, options);
+        SKG_TEST_CHECK(Neighbors(db, "0", true) == std::set<std::string>({"1", "2"}));
+        SKG_TEST_CHECK(Neighbors(db, "1", false) == std::set<std::string>({"0"}));
+        SKG_TEST_CHECK(Neighbors(db, "1", true).empty());
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+    void TestReclaimInEdges() {
+        const std::string name = "tombstone_reclaim";
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+        // "hub" 只有入边, 且边数超过回收的下限
+        const int num_sources = 5000;
+        for (int v = 0; v < num_sources; ++v) {
+            AddEdge(db, std::to_string(v), "hub");
+        }
+        AddEdge(db, "0", "1");
+        db = ReopenDB(db, name, options);
+
+        // 入边计入已删除的边数, 达到比例后立即重写, 不再留下删除信息
+        DeleteVertex(db, "hub");
+        SKG_TEST_CHECK(Neighbors(db, "0", true) == std::set<std::string>({"1"}));
+        SKG_TEST_CHECK(Neighbors(db, "1", true).empty());
+        db = ReopenDB(db, name, options);
+        SKG_TEST_CHECK(CountTombstoneFiles(options.GetDBDir(name)) == 0);
+        SKG_TEST_CHECK(Neighbors(db, "0", true) == std::set<std::string>({"1"}));
+        SKG_TEST_CHECK(Neighbors(db, std::to_string(num_sources - 1), true).empty());
+        SKG_TEST_CHECK(Neighbors(db, "1", false) == std::set<std::string>({"0"}));
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestDeleteVertexAndReopen();
+    TestReclaimInEdges();
+    printf("tombstone_test passed\n");
+    return EXIT_SUCCESS;
+}
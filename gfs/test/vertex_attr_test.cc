@@ -0,0 +1,138 @@
+// 数值型节点属性的批量读取: 各种列类型按原类型读取, 多列按行转为 float, 超出范围的节点读到 0;
+// 列文件按 long-id 存放, 只读 mmap 后与批量读取的结果一致.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    const vid_t kNumVertices = 10;
+    // 不在数据库中的节点
+    const vid_t kOutOfRange = 100000;
+
+    const std::vector<std::pair<std::string, ColumnType>> kColumns = {
+            {"a_int32", ColumnType::INT32},
+            {"a_int64", ColumnType::INT64},
+            {"a_float32", ColumnType::FLOAT32},
+            {"a_float64", ColumnType::FLOAT64},
+    };
+
+    // 第 j 列节点 v 的值
+    double Value(vid_t v, size_t j) {
+        return v * 10.0 + j;
+    }
+
+    void SetValues(SkgDB *db) {
+        for (const auto &column : kColumns) {
+            SKG_TEST_OK(db->CreateVertexAttrCol(kVertexLabel, ColumnDescriptor(column.first, column.second)));
+        }
+        for (vid_t v = 0; v < kNumVertices; ++v) {
+            VertexRequest req;
+            req.SetVertex(kVertexLabel, std::to_string(v));
+            SKG_TEST_OK(req.SetInt32("a_int32", static_cast<int32_t>(Value(v, 0))));
+            SKG_TEST_OK(req.SetInt64("a_int64", static_cast<int64_t>(Value(v, 1))));
+            SKG_TEST_OK(req.SetFloat("a_float32", static_cast<float>(Value(v, 2))));
+            SKG_TEST_OK(req.SetDouble("a_float64", Value(v, 3)));
+            SKG_TEST_OK(db->SetVertexAttr(req));
+        }
+    }
+
+    template <typename T>
+    void CheckGather(SkgDB *db, size_t j, const std::vector<vid_t> &vids) {
+        std::vector<T> values(vids.size(), T(-1));
+        SKG_TEST_OK(db->GatherVertexAttr(kVertexLabel, kColumns[j].first, vids.data(), vids.size(), values.data()));
+        for (size_t i = 0; i < vids.size(); ++i) {
+            const T expected = vids[i] < kNumVertices ? static_cast<T>(Value(vids[i], j)) : T();
+            SKG_TEST_CHECK(values[i] == expected);
+        }
+    }
+
+    // 只读 mmap 列文件, 按 long-id 读取
+    template <typename T>
+    void CheckColumnFile(SkgDB *db, size_t j) {
+        ColumnType type;
+        std::string filename;
+        SKG_TEST_OK(db->GetVertexAttrColumn(kVertexLabel, kColumns[j].first, &type, &filename));
+        SKG_TEST_CHECK(type == kColumns[j].second);
+        const size_t size = kNumVertices * sizeof(T);
+        const int fd = open(filename.c_str(), O_RDONLY);
+        SKG_TEST_CHECK(fd >= 0);
+        struct stat st;
+        SKG_TEST_CHECK(fstat(fd, &st) == 0);
+        SKG_TEST_CHECK(static_cast<size_t>(st.st_size) >= size);
+        void *addr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        SKG_TEST_CHECK(addr != MAP_FAILED);
+        const T *values = static_cast<const T *>(addr);
+        for (vid_t v = 0; v < kNumVertices; ++v) {
+            SKG_TEST_CHECK(values[v] == static_cast<T>(Value(v, j)));
+        }
+        munmap(addr, size);
+    }
+
+    void CheckAll(SkgDB *db) {
+        // 乱序, 重复, 超出范围的节点
+        const std::vector<vid_t> vids = {9, 0, 3, 3, kOutOfRange, 5};
+        CheckGather<int32_t>(db, 0, vids);
+        CheckGather<int64_t>(db, 1, vids);
+        CheckGather<float>(db, 2, vids);
+        CheckGather<double>(db, 3, vids);
+        CheckColumnFile<int32_t>(db, 0);
+        CheckColumnFile<int64_t>(db, 1);
+        CheckColumnFile<float>(db, 2);
+        CheckColumnFile<double>(db, 3);
+
+        // 多列按行写入 [n, d]
+        std::vector<std::string> names;
+        for (const auto &column : kColumns) {
+            names.push_back(column.first);
+        }
+        const size_t d = names.size();
+        std::vector<float> feats(vids.size() * d, -1.0f);
+        SKG_TEST_OK(db->GatherVertexAttrAsFloat(kVertexLabel, names, vids.data(), vids.size(), feats.data()));
+        for (size_t i = 0; i < vids.size(); ++i) {
+            for (size_t j = 0; j < d; ++j) {
+                const float expected = vids[i] < kNumVertices ? static_cast<float>(Value(vids[i], j)) : 0.0f;
+                SKG_TEST_CHECK(feats[i * d + j] == expected);
+            }
+        }
+
+        // 不存在的列
+        float value;
+        SKG_TEST_CHECK(!db->GatherVertexAttr(kVertexLabel, "no_such_column", vids.data(), 1, &value).ok());
+    }
+
+    void TestGatherVertexAttr() {
+        const std::string name = "vertex_attr";
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+        for (vid_t v = 0; v + 1 < kNumVertices; ++v) {
+            AddEdge(db, std::to_string(v), std::to_string(v + 1));
+        }
+        SetValues(db);
+        CheckAll(db);
+
+        db = ReopenDB(db, name, options);
+        CheckAll(db);
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestGatherVertexAttr();
+    printf("vertex_attr_test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,210 @@
+// 节点 id 重排的性能对比: 同一个随机图分别按 none/degree/bfs/rcm 重排后导入, 刷盘后重新打开,
+// 测量从一批起点出发的 k 跳扩展 (批量出边查询) 与 k 跳遍历 (Kout) 的耗时和缓存未命中数.
+// 缓存未命中数通过 perf_event_open 读取 PERF_COUNT_HW_CACHE_MISSES, 没有权限
+// (perf_event_paranoid) 或硬件计数器不可用 (如部分虚拟机) 时显示 n/a.
+//
+// 用法: ./vertex_order_bench [节点数] [每个节点的平均出度] [跳数]
+// 不属于 make check, 需单独构建: make vertex_order_bench
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "fs/VertexReordering.h"
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    const size_t kNumSources = 64;
+
+    struct Graph {
+        vid_t num_vertices;
+        std::vector<vid_t> src;
+        std::vector<vid_t> dst;
+    };
+
+    // 目标节点按幂律分布, 前面的节点是热点, 且与原 id 的局部性无关
+    Graph MakeGraph(vid_t num_vertices, size_t avg_degree) {
+        Graph g;
+        g.num_vertices = num_vertices;
+        std::mt19937_64 rng(2024);
+        std::uniform_int_distribution<vid_t> uniform(0, num_vertices - 1);
+        std::uniform_real_distribution<double> real(0, 1);
+        std::unordered_set<uint64_t> seen;
+        for (vid_t u = 0; u < num_vertices; ++u) {
+            for (size_t i = 0; i < avg_degree; ++i) {
+                const vid_t v = real(rng) < 0.5
+                                ? static_cast<vid_t>(num_vertices * real(rng) * real(rng) * real(rng))
+                                : uniform(rng);
+                if (u == v || !seen.insert((static_cast<uint64_t>(u) << 32) | v).second) { continue; }
+                g.src.push_back(u);
+                g.dst.push_back(v);
+            }
+        }
+        return g;
+    }
+
+    double ElapsedMs(uint64_t start_us) {
+        return (Env::Default()->NowMicros() - start_us) / 1000.0;
+    }
+
+    /**
+     * @brief 用户态的缓存未命中数: 调用线程, 以及计数器打开之后它创建的线程 (DB 的查询线程池等).
+     * 子线程的计数在线程退出时才累加到这里, 因此在关闭 DB 之后读取
+     */
+    class CacheMissCounter {
+    public:
+        CacheMissCounter() : m_fd(-1) {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            m_fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+
+        ~CacheMissCounter() {
+            if (m_fd >= 0) { close(m_fd); }
+        }
+
+        // 对已经继承的子线程的计数器同样生效
+        void Enable() {
+            if (m_fd >= 0) { ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0); }
+        }
+
+        void Disable() {
+            if (m_fd >= 0) { ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0); }
+        }
+
+        std::string Read() const {
+            uint64_t value = 0;
+            if (m_fd < 0 || read(m_fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+                return "n/a";
+            }
+            return std::to_string(value);
+        }
+
+    private:
+        int m_fd;
+
+    public:
+        // no copying allow
+        CacheMissCounter(const CacheMissCounter &) = delete;
+        CacheMissCounter &operator=(const CacheMissCounter &) = delete;
+    };
+
+    SkgDB *OpenDB(const std::string &name, const Options &options) {
+        SkgDB *db = nullptr;
+        SKG_TEST_OK(SkgDB::Open(name, options, &db));
+        return db;
+    }
+
+    void CloseDB(SkgDB *db) {
+        SKG_TEST_OK(db->Close());
+        delete db;
+    }
+
+    void Run(const Graph &g, Options::VertexOrder order, const char *order_name, int hops) {
+        const std::string name = std::string("vertex_order_bench_") + order_name;
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+
+        uint64_t start = Env::Default()->NowMicros();
+        std::vector<vid_t> new_to_old;
+        VertexReordering::ComputeOrder(order, g.num_vertices, g.src.data(), g.dst.data(), g.src.size(), &new_to_old);
+        const double order_ms = ElapsedMs(start);
+        if (order != Options::VertexOrder::NONE) {
+            SKG_TEST_OK(db->SetVertexOrder(new_to_old));
+        }
+        start = Env::Default()->NowMicros();
+        for (size_t i = 0; i < g.src.size(); ++i) {
+            AddEdge(db, std::to_string(g.src[i]), std::to_string(g.dst[i]));
+        }
+        const double load_ms = ElapsedMs(start);
+        // 从磁盘读取, 不受 MemTable 影响. 每个阶段在打开计数器之后重新打开 DB,
+        // 查询线程继承计数器, 关闭 DB 时线程退出, 计数累加到计数器上
+        CloseDB(db);
+        CacheMissCounter batch_misses;
+        db = OpenDB(name, options);
+
+        // 起点取相同的原 id, 查询前转换为存储中的 vid
+        std::vector<vid_t> sources;
+        for (size_t i = 0; i < kNumSources; ++i) {
+            vid_t vid = 0;
+            SKG_TEST_OK(db->GetIDEncoder()->GetIDByVertex(
+                    kVertexLabel, std::to_string(i * g.num_vertices / kNumSources), &vid));
+            sources.push_back(vid);
+        }
+
+        batch_misses.Enable();
+        start = Env::Default()->NowMicros();
+        std::vector<vid_t> frontier = sources;
+        std::unordered_set<vid_t> visited(frontier.begin(), frontier.end());
+        for (int hop = 0; hop < hops && !frontier.empty(); ++hop) {
+            std::sort(frontier.begin(), frontier.end());
+            NeighborBatch batch;
+            SKG_TEST_OK(db->GetOutEdgesBatch(frontier.data(), frontier.size(), EdgeFilter(), &batch));
+            frontier.clear();
+            for (vid_t v : batch.neighbors) {
+                if (visited.insert(v).second) { frontier.push_back(v); }
+            }
+        }
+        const double batch_ms = ElapsedMs(start);
+        batch_misses.Disable();
+        CloseDB(db);
+
+        CacheMissCounter kout_misses;
+        db = OpenDB(name, options);
+        kout_misses.Enable();
+        start = Env::Default()->NowMicros();
+        size_t num_pairs = 0;
+        for (size_t i = 0; i < kNumSources; ++i) {
+            TraverseRequest req;
+            req.id = std::to_string(i * g.num_vertices / kNumSources);
+            req.label = kVertexLabel;
+            req.k = hops;
+            req.direction = 'o';
+            std::vector<PVpair> pairs;
+            SKG_TEST_OK(db->Kout(req, &pairs));
+            num_pairs += pairs.size();
+        }
+        const double kout_ms = ElapsedMs(start);
+        kout_misses.Disable();
+        SKG_TEST_OK(db->Drop());
+        delete db;
+
+        printf("%-8s order %8.1f ms  load %10.1f ms  batch %d-hop %8.1f ms (%zu vertices, %s misses)"
+               "  kout %8.1f ms (%zu edges, %s misses)\n",
+               order_name, order_ms, load_ms, hops, batch_ms, visited.size(), batch_misses.Read().c_str(),
+               kout_ms, num_pairs, kout_misses.Read().c_str());
+    }
+
+}
+
+int main(int argc, char **argv) {
+    const vid_t num_vertices = argc > 1 ? static_cast<vid_t>(atoll(argv[1])) : 100000;
+    const size_t avg_degree = argc > 2 ? static_cast<size_t>(atoll(argv[2])) : 8;
+    const int hops = argc > 3 ? atoi(argv[3]) : 2;
+    const Graph g = MakeGraph(num_vertices, avg_degree);
+    printf("%u vertices, %zu edges\n", static_cast<unsigned>(g.num_vertices), g.src.size());
+    Run(g, Options::VertexOrder::NONE, "none", hops);
+    Run(g, Options::VertexOrder::DEGREE, "degree", hops);
+    Run(g, Options::VertexOrder::BFS, "bfs", hops);
+    Run(g, Options::VertexOrder::RCM, "rcm", hops);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,270 @@
+// 边过滤条件下推到扫描: 按 label 跳过 sub-partition, 按 zone map 跳过 sub-partition 和 block;
+// MemTable 与磁盘上的边过滤结果一致, 修改属性值后 zone map 随之扩大, zone map 缺失或损坏时不剪枝.
+
+#include <ftw.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "fs/MetaAttributes.h"
+#include "fs/ZoneMap.h"
+#include "test_util.h"
+
+using namespace skg;
+using namespace skg::test;
+
+namespace {
+
+    const char *const kColumn = "ts";
+    // 所有边都指向 kHub, 入边存放在同一个 sub-partition 中, 按 src 排序
+    const char *const kHub = "100000";
+    // 两个完整的 block 加一个不满的 block
+    const int kNumEdges = 2 * ZoneMap::BLOCK_EDGES + 100;
+    // 边写到磁盘后修改属性值的边, 新的值超出磁盘上统计的取值范围
+    const int kUpdatedSrc = 7;
+    const int64_t kUpdatedValue = 1000000;
+
+    EdgeLabel Label(const std::string &edge_label) {
+        return EdgeLabel(edge_label, kVertexLabel, kVertexLabel);
+    }
+
+    void AddValuedEdge(SkgDB *db, const std::string &label, int src, int64_t value) {
+        EdgeRequest req;
+        req.DisableWAL();
+        req.SetEdge(label, kVertexLabel, std::to_string(src), kVertexLabel, kHub);
+        SKG_TEST_OK(req.SetInt64(kColumn, value));
+        SKG_TEST_OK(db->AddEdge(req));
+    }
+
+    EdgeFilter RangeFilter(double lower, double upper) {
+        EdgeFilter filter;
+        filter.AddRange(kColumn, lower, upper);
+        return filter;
+    }
+
+    // 满足过滤条件的 kHub 的入边的 src
+    std::set<int> InSources(SkgDB *db, const EdgeFilter &filter) {
+        VertexRequest req;
+        req.SetVertex(kVertexLabel, kHub);
+        req.SetEdgeFilter(filter);
+        EdgesQueryResult result;
+        SKG_TEST_OK(db->GetInEdges(req, &result));
+        std::set<int> srcs;
+        Status s;
+        while (result.MoveNext()) {
+            srcs.insert(std::stoi(result.GetSrcVertex(&s)));
+            SKG_TEST_OK(s);
+        }
+        return srcs;
+    }
+
+    int64_t Value(int src, bool updated) {
+        return updated && src == kUpdatedSrc ? kUpdatedValue : src;
+    }
+
+    // 取值落在 [lower, upper] 中的 src
+    std::set<int> ExpectedSources(int64_t lower, int64_t upper, bool updated) {
+        std::set<int> srcs;
+        for (int src = 0; src < kNumEdges; ++src) {
+            const int64_t value = Value(src, updated);
+            if (value >= lower && value <= upper) { srcs.insert(src); }
+        }
+        return srcs;
+    }
+
+    void CheckRanges(SkgDB *db, bool updated) {
+        SKG_TEST_CHECK(InSources(db, EdgeFilter()).size() == static_cast<size_t>(kNumEdges));
+        SKG_TEST_CHECK(InSources(db, RangeFilter(100, 5000)) == ExpectedSources(100, 5000, updated));
+        SKG_TEST_CHECK(InSources(db, RangeFilter(-10, -1)).empty());
+        SKG_TEST_CHECK(InSources(db, RangeFilter(kUpdatedValue, kUpdatedValue)) ==
+                       ExpectedSources(kUpdatedValue, kUpdatedValue, updated));
+        SKG_TEST_CHECK(InSources(db, RangeFilter(kUpdatedSrc, kUpdatedSrc)) ==
+                       ExpectedSources(kUpdatedSrc, kUpdatedSrc, updated));
+        // 不存在的列, 所有边的值都为 null
+        EdgeFilter no_column;
+        no_column.AddRange("no_such_column", 0, kNumEdges);
+        SKG_TEST_CHECK(InSources(db, no_column).empty());
+    }
+
+    std::vector<std::string> *g_zone_map_files = nullptr;
+
+    int CollectZoneMapFile(const char *path, const struct stat *, int type, struct FTW *) {
+        const std::string filename(path);
+        const std::string suffix(".zonemap");
+        if (type == FTW_F && filename.size() > suffix.size()
+            && filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            g_zone_map_files->push_back(filename);
+        }
+        return 0;
+    }
+
+    std::vector<std::string> ZoneMapFiles(const Options &options, const std::string &name) {
+        std::vector<std::string> files;
+        g_zone_map_files = &files;
+        SKG_TEST_CHECK(nftw(options.GetDBDir(name).c_str(), CollectZoneMapFile, 16, FTW_PHYS) == 0);
+        g_zone_map_files = nullptr;
+        return files;
+    }
+
+    /**
+     * @brief 用伪造的 zone map 替换磁盘上的统计: 第 i 条边 (即 src 为 i 的边) 记为 value(i).
+     * 伪造的统计与实际的值不符, 查询结果的变化说明扫描确实按统计跳过了 sub-partition / block
+     */
+    template <typename ValueFn>
+    void WriteZoneMap(const std::string &filename, int32_t column_id, ValueFn value) {
+        // 与数据库中的列有相同的 id
+        MetaAttributes attributes(Label(kEdgeLabel));
+        SKG_TEST_OK(attributes.AddColumn(ColumnDescriptor(kColumn, ColumnType::INT64)));
+        const ColumnDescriptor *col = attributes.GetColumn(ColumnDescriptor(kColumn, ColumnType::NONE), false);
+        SKG_TEST_CHECK(col != nullptr && col->id() == column_id);
+
+        ZoneMap zone_map;
+        zone_map.Reset(attributes, kNumEdges);
+        for (int i = 0; i < kNumEdges; ++i) {
+            zone_map.Update(col->id(), i, value(i));
+        }
+        SKG_TEST_OK(zone_map.Save(filename));
+    }
+
+    void WriteFile(const std::string &filename, const std::string &content) {
+        FILE *f = fopen(filename.c_str(), "wb");
+        SKG_TEST_CHECK(f != nullptr);
+        SKG_TEST_CHECK(fwrite(content.data(), 1, content.size(), f) == content.size());
+        fclose(f);
+    }
+
+    void CloseDB(SkgDB *db) {
+        SKG_TEST_OK(db->Close());
+        delete db;
+    }
+
+    SkgDB *OpenDB(const std::string &name, const Options &options) {
+        SkgDB *db = nullptr;
+        SKG_TEST_OK(SkgDB::Open(name, options, &db));
+        return db;
+    }
+
+    void TestRangeFilter() {
+        const std::string name = "zonemap";
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+        SKG_TEST_OK(db->CreateEdgeAttrCol(Label(kEdgeLabel), ColumnDescriptor(kColumn, ColumnType::INT64)));
+        for (int src = 0; src < kNumEdges; ++src) {
+            AddValuedEdge(db, kEdgeLabel, src, src);
+        }
+        std::vector<ColumnDescriptor> configs;
+        SKG_TEST_OK(db->GetEdgeAttrs(Label(kEdgeLabel), &configs));
+        SKG_TEST_CHECK(configs.size() == 1);
+        const int32_t column_id = configs[0].id();
+
+        // 边在 MemTable 中, 与磁盘上的边按同样的条件过滤
+        CheckRanges(db, false);
+        db = ReopenDB(db, name, options);
+        CheckRanges(db, false);
+
+        // 修改磁盘上的边, 新的值超出了写入时统计的范围; zone map 随之扩大, 关闭时保存
+        EdgeRequest update;
+        update.DisableWAL();
+        update.SetEdge(kEdgeLabel, kVertexLabel, std::to_string(kUpdatedSrc), kVertexLabel, kHub);
+        SKG_TEST_OK(update.SetInt64(kColumn, kUpdatedValue));
+        SKG_TEST_OK(db->SetEdgeAttr(update));
+        CheckRanges(db, true);
+        db = ReopenDB(db, name, options);
+        CheckRanges(db, true);
+        CloseDB(db);
+
+        const std::vector<std::string> files = ZoneMapFiles(options, name);
+        SKG_TEST_CHECK(files.size() == 1);
+
+        // 第二个 block 的统计与查询条件不相交, 整个 block 被跳过
+        const int block = ZoneMap::BLOCK_EDGES;
+        WriteZoneMap(files[0], column_id, [block](int i) -> double {
+            return i >= block && i < 2 * block ? -2.0 : static_cast<double>(Value(i, true));
+        });
+        db = OpenDB(name, options);
+        std::set<int> expected = ExpectedSources(0, kUpdatedValue, true);
+        for (int i = block; i < 2 * block; ++i) {
+            expected.erase(i);
+        }
+        SKG_TEST_CHECK(InSources(db, RangeFilter(0, kUpdatedValue)) == expected);
+        // 没有范围条件时不使用统计
+        SKG_TEST_CHECK(InSources(db, EdgeFilter()).size() == static_cast<size_t>(kNumEdges));
+        CloseDB(db);
+
+        // 整个 sub-partition 的统计与查询条件不相交, 被跳过
+        WriteZoneMap(files[0], column_id, [](int) -> double { return -2.0; });
+        db = OpenDB(name, options);
+        SKG_TEST_CHECK(InSources(db, RangeFilter(0, kUpdatedValue)).empty());
+        SKG_TEST_CHECK(InSources(db, EdgeFilter()).size() == static_cast<size_t>(kNumEdges));
+        CloseDB(db);
+
+        // zone map 损坏: 视为没有统计, 不剪枝
+        WriteFile(files[0], "not a zone map");
+        db = OpenDB(name, options);
+        CheckRanges(db, true);
+        CloseDB(db);
+        WriteFile(files[0], "");
+        db = OpenDB(name, options);
+        CheckRanges(db, true);
+        CloseDB(db);
+
+        // zone map 缺失: 同样不剪枝
+        SKG_TEST_OK(Env::Default()->DeleteFile(files[0]));
+        db = OpenDB(name, options);
+        CheckRanges(db, true);
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+    void TestLabelFilter() {
+        const std::string name = "zonemap_label";
+        Options options = DefaultOptions();
+        SkgDB *db = CreateDB(name, options);
+        const std::string other = "e_other";
+        SKG_TEST_OK(db->CreateNewEdgeLabel(other, kVertexLabel, kVertexLabel));
+        SKG_TEST_OK(db->CreateEdgeAttrCol(Label(kEdgeLabel), ColumnDescriptor(kColumn, ColumnType::INT64)));
+        SKG_TEST_OK(db->CreateEdgeAttrCol(Label(other), ColumnDescriptor(kColumn, ColumnType::INT64)));
+        for (int src = 0; src < 10; ++src) {
+            AddValuedEdge(db, kEdgeLabel, src, src);
+            AddValuedEdge(db, other, src + 10, src);
+        }
+
+        for (int round = 0; round < 2; ++round) {
+            EdgeFilter filter;
+            filter.AddLabel(kEdgeLabel);
+            SKG_TEST_CHECK(InSources(db, filter) == std::set<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+            filter.AddRange(kColumn, 3, 4);
+            SKG_TEST_CHECK(InSources(db, filter) == std::set<int>({3, 4}));
+
+            filter.Clear();
+            filter.AddLabel(other);
+            filter.AddRange(kColumn, 3, 4);
+            SKG_TEST_CHECK(InSources(db, filter) == std::set<int>({13, 14}));
+
+            // 多个 label 之间为 OR
+            filter.AddLabel(kEdgeLabel);
+            SKG_TEST_CHECK(InSources(db, filter) == std::set<int>({3, 4, 13, 14}));
+
+            // 不存在的 label
+            filter.Clear();
+            filter.AddLabel("no_such_label");
+            SKG_TEST_CHECK(InSources(db, filter).empty());
+
+            // 第二轮: 边在磁盘上
+            db = ReopenDB(db, name, options);
+        }
+
+        SKG_TEST_OK(db->Drop());
+        delete db;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    TestRangeFilter();
+    TestLabelFilter();
+    printf("zonemap_test passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+/**
+ * @section DESCRIPTION
+ *
+ * Selective scheduler backed by two bitsets, one for the current iteration
+ * and one for the next. Adding a task is a single atomic bit-or, so the
+ * update functions can schedule their neighbors in parallel.
+ */
+
+#ifndef DEF_GRAPHCHI_BITSET_SCHEDULER
+#define DEF_GRAPHCHI_BITSET_SCHEDULER
+
+#include <algorithm>
+#include <cstring>
+
+#include "util/ischeduler.hpp"
+#include "util/dense_bitset.hpp"
+
+namespace skg {
+
+    class bitset_scheduler : public ischeduler {
+    private:
+        dense_bitset *curiteration_bitset;
+        dense_bitset *nextiteration_bitset;
+        vid_t nvertices;
+    public:
+        explicit
+        bitset_scheduler(vid_t nvertices_)
+                : curiteration_bitset(new dense_bitset(nvertices_)),
+                  nextiteration_bitset(new dense_bitset(nvertices_)),
+                  nvertices(nvertices_) {
+        }
+
+        virtual ~bitset_scheduler() {
+            delete curiteration_bitset;
+            delete nextiteration_bitset;
+        }
+
+        inline virtual void add_task(vid_t vid, bool also_this_iteration=false) {
+            nextiteration_bitset->set_bit(vid);
+            if (also_this_iteration) {
+                curiteration_bitset->set_bit(vid);
+            }
+        }
+
+        virtual void add_task_to_all() {
+            nextiteration_bitset->setall();
+        }
+
+        inline virtual bool is_scheduled(vid_t vertex) {
+            return curiteration_bitset->get(vertex);
+        }
+
+        virtual size_t num_tasks() {
+            size_t n = 0;
+            for (vid_t i = 0; i < nvertices; ++i) {
+                n += nextiteration_bitset->get(i) ? 1 : 0;
+            }
+            return n;
+        }
+
+        /**
+         * 进入新的一轮迭代: 上一轮调度的任务成为本轮的任务
+         */
+        virtual void new_iteration(int iteration) {
+            std::swap(curiteration_bitset, nextiteration_bitset);
+            nextiteration_bitset->clear();
+        }
+
+        virtual void remove_tasks(vid_t fromvertex, vid_t tovertex) {
+            nextiteration_bitset->clear_bits(fromvertex, tovertex);
+        }
+
+        virtual void clear() {
+            curiteration_bitset->clear();
+            nextiteration_bitset->clear();
+        }
+    };
+
+}
+
+#endif
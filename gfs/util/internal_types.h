@@ -83,6 +83,8 @@ namespace skg {
     VARIABLE_IS_NOT_USED const static char* SKG_LABEL = "label";
     VARIABLE_IS_NOT_USED static const char *SKG_VERTEX_COLUMN_NAME_TAG = "vtag";
     VARIABLE_IS_NOT_USED static const char *SKG_VERTEX_COLUMN_NAME_DEGREE = "degree";
+    VARIABLE_IS_NOT_USED static const char *SKG_VERTEX_COLUMN_NAME_IN_DEGREE = "indegree";
+    VARIABLE_IS_NOT_USED static const char *SKG_VERTEX_COLUMN_NAME_OUT_DEGREE = "outdegree";
     VARIABLE_IS_NOT_USED static const char *SKG_EMPTY_COLUMN= "SKG_EMPTY_COLUMN";
     VARIABLE_IS_NOT_USED static const char *SKG_VERTEX_COLUMN_NAME_BITSET = "bitset";
 
@@ -76,6 +76,24 @@ namespace skg {
         use_elias_gamma_compress = get_option_uint("use_elias_gamma_index", 0) != 0;
 
         query_threads = get_option_uint("query_threads", 8);
+        hub_cache_mb = static_cast<size_t>(get_option_int("hub_cache_mb", 64));
+        hub_cache_min_degree = static_cast<size_t>(get_option_int("hub_cache_min_degree", 1024));
+        std::string order = get_option_string("vertex_order", "none");
+        if (order == "degree") {
+            vertex_order = VertexOrder::DEGREE;
+        } else if (order == "bfs") {
+            vertex_order = VertexOrder::BFS;
+        } else if (order == "rcm") {
+            vertex_order = VertexOrder::RCM;
+        } else {
+            vertex_order = VertexOrder::NONE;
+        }
+        shard_partition = get_option_string("shard_partition", "range") == "balanced"
+                          ? ShardPartition::BALANCED : ShardPartition::RANGE;
+        tombstone_compaction_ratio = get_option_float("tombstone_compaction_ratio", 0.3f);
+        open_threads = std::max<uint32_t>(get_option_uint("open_threads", 8), 1);
+        lazy_open_partitions = get_option_uint("lazy_open_partitions", 0) != 0;
+        max_open_partitions = get_option_uint("max_open_partitions", 0);
         master_mt_thread_pool_num = get_option_uint("master_mt_thread_pool_num",128);
         // 建表的文件夹
         default_db_dir = std::string {get_option_string("db_dir", "db/")};
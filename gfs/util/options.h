@@ -41,6 +41,14 @@ public:
           use_elias_gamma_compress(false),
 	master_mt_thread_pool_num(100),
           query_threads(8),
+          hub_cache_mb(64),
+          hub_cache_min_degree(1024),
+          vertex_order(VertexOrder::NONE),
+          shard_partition(ShardPartition::RANGE),
+          tombstone_compaction_ratio(0.3),
+          open_threads(8),
+          lazy_open_partitions(false),
+          max_open_partitions(0),
         default_db_dir("./db") {
     }
 public:
@@ -129,6 +137,38 @@ public:
     int master_mt_thread_pool_num;
     uint32_t query_threads;
 
+    // 热点节点邻居列表缓存的大小, 为 0 时不缓存
+    size_t hub_cache_mb;
+    // 度不小于该值的节点, 第一次查询邻居即缓存
+    size_t hub_cache_min_degree;
+
+    // 批量导入时重排节点 id 的方式, 使相邻的节点在 vid 上也相邻
+    enum class VertexOrder {
+        NONE,
+        DEGREE, // 按度从大到小
+        BFS,    // 按广度优先遍历的顺序
+        RCM,    // Reverse Cuthill-McKee
+    };
+    VertexOrder vertex_order;
+
+    // ShardTree 的区间划分方式
+    enum class ShardPartition {
+        RANGE,    // 只有一个 ShardTree, 区间随插入的 dst 增长
+        BALANCED, // 批量导入时按采样的入度预先划分区间; ShardTree 超过 init_shard_size_mb 时在入度的中位数处分裂, 上半区间的边移到新的 ShardTree
+    };
+    ShardPartition shard_partition;
+
+    // sub-partition 中已删除的边占比达到该值时, 重写 sub-partition 回收空间. 不大于 0 时不回收
+    double tombstone_compaction_ratio;
+
+    // 打开 DB 时并发打开 ShardTree 的线程数
+    uint32_t open_threads;
+    // sub-partition 第一次被访问时才打开文件句柄
+    bool lazy_open_partitions;
+    // lazy_open_partitions 时, 同时打开句柄的 sub-partition 数量上限, 超过时按 LRU 关闭. 0 为不限制.
+    // 上限是进程内所有 DB 共用的, 多个 DB 的取值不同时取最大值
+    uint32_t max_open_partitions;
+
     // 指定 Write-Ahead logs(WAL)的存储路径
     // 如果为空, 则在 "`GetDBDir()`/journal/" 目录下.
     // 如果非空, 则会存储在制定的文件夹下.
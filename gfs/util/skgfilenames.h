@@ -181,6 +181,13 @@ namespace skg {
             return fmt::format("{}/journal", meta_dirname);
         }
 
+        /**
+         * @brief 导入时重排节点得到的 vid 置换
+         */
+        static std::string VARIABLE_IS_NOT_USED vertex_order(const std::string &meta_dirname) {
+            return fmt::format("{}/vertex.order", meta_dirname);
+        }
+
         /**
          * Vertex status file
          * 图计算引擎, 用于迭代的节点状态.
@@ -242,6 +249,18 @@ namespace skg {
             return fmt::format("{}.src.idx", elist_filename);
         }
 
+        // 跟随 sub-partition 的属性列 min/max 统计 (zone map)
+        static std::string VARIABLE_IS_NOT_USED sub_partition_zone_map(
+                const std::string &elist_filename) {
+            return fmt::format("{}.zonemap", elist_filename);
+        }
+
+        // 跟随 sub-partition 的删除信息 (删除的节点, 已删除的边数)
+        static std::string VARIABLE_IS_NOT_USED sub_partition_tombstones(
+                const std::string &elist_filename) {
+            return fmt::format("{}.tombstones", elist_filename);
+        }
+
         // 跟随 sub-partition 的边属性列文件
         static VARIABLE_IS_NOT_USED std::string sub_partition_edge_column(
                 const std::string &dirname, 
@@ -23,7 +23,7 @@
  *
  * @section DESCRIPTION
  *
- * Tools for listing the TOP K values from a verte data file.
+ * Tools for listing the TOP K values from the vertex values.
  */
 
 #ifndef DEF_GRAPHCHI_TOPLIST
@@ -31,17 +31,14 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstdlib>
 #include <errno.h>
 #include <assert.h>
 
-#include "fs/stripedio.hpp"
+#include "util/types.h"
 #include "util/skglogger.h"
 #include "util/merge.hpp"
-#include "util/ioutil.hpp"
 #include "util/qsort.hpp"
-//#include "util/chifilenames.h"
-#include "fs/vertex_data.h"
-#include "fs/Metadata.hpp"
 
 namespace skg {
   
@@ -59,102 +56,81 @@ namespace skg {
     }
      
     /**
-      * Reads the vertex data file and returns top N values.
-      * Vertex value type must be given as a template parameter.
-      * This method has been implemented in a manner to consume very little
-      * memory, i.e the whole file is not loaded into memory (unless ntop = nvertices).
-      * @param basefilename name of the graph
-      * @param ntop number of top values to return (if ntop is smaller than the total number of vertices, returns all in sorted order)
+      * Scans the vertex values and returns top N values.
+      * The values are usually a mmapped vertex column (see FixedBytesVertexColumn),
+      * which is read window by window, so only the top list and one window of
+      * candidates are kept in memory.
+      * @param values vertex values, indexed by vertex id
+      * @param nvertices number of vertices in values
+      * @param ntop number of top values to return (if ntop is larger than the number of vertices, returns all in sorted order)
       * @param from first vertex to include (default, 0)
       * @param to last vertex to include (default, all)
       * @return a vector of top ntop values  
      */
     template <typename VertexDataType>
-    std::vector<vertex_value<VertexDataType> > get_top_vertices(std::string basefilename, int ntop, vid_t from=0, vid_t to=0) {
+    std::vector<vertex_value<VertexDataType> > get_top_vertices(const VertexDataType *values, vid_t nvertices,
+                                                                int ntop, vid_t from=0, vid_t to=0) {
         typedef vertex_value<VertexDataType> vv_t;
-        
-        /* Initialize striped IO manager */
-        metrics m("toplist");
-        stripedio * iomgr = new stripedio(m);
-        
-        /* Initialize the vertex-data reader */
-        vid_t readwindow = 1024 * 1024;
-        ///size_t numvertices = get_num_vertices(basefilename);
-        MetaNumVertices vertices_info;
-        MetadataFileHandler::ReadNumVertices(basefilename, &vertices_info);
-        vertex_data_store<VertexDataType> * vertexdata =
-        new vertex_data_store<VertexDataType>(basefilename, vertices_info.max_allocated_vid, iomgr);
-           
-        if ((size_t)ntop > vertices_info.max_allocated_vid) {
-            ntop = (int)vertices_info.max_allocated_vid;
+
+        std::vector<vv_t> ret;
+        if (nvertices == 0 || ntop <= 0) {
+            return ret;
+        }
+        if (to == 0 || to >= nvertices) {
+            to = nvertices - 1;
+        }
+        if (from > to) {
+            return ret;
+        }
+        if ((size_t)ntop > (size_t)(to - from) + 1) {
+            ntop = (int)(to - from) + 1;
         }
                 
         /* Initialize buffer */
-        vv_t * buffer_idxs = (vv_t*) calloc(readwindow, sizeof(vv_t));
-        vv_t * topbuf = (vv_t*) calloc(ntop, sizeof(vv_t));
-        vv_t * mergearr = (vv_t*) calloc(ntop * 2, sizeof(vv_t));
+        const vid_t readwindow = 1024 * 1024;
+        std::vector<vv_t> buffer_idxs;
+        buffer_idxs.reserve(std::min<size_t>(readwindow, (size_t)(to - from) + 1));
+        std::vector<vv_t> topbuf(ntop);
+        std::vector<vv_t> mergearr(ntop * 2);
+        int ntopbuf = 0;
         
         /* Iterate the vertex values and maintain the top-list */
-        size_t idx = 0;
-        vid_t st = 0;
-        vid_t en = vertices_info.max_allocated_vid - 1;
+        for (size_t st = from; st <= to; st += readwindow) {
+            const size_t en = std::min<size_t>(st + readwindow - 1, to);
 
-        int count = 0;
-        while(st <= vertices_info.max_allocated_vid - 1) {
-            en = st + readwindow - 1;
-            if (en >= vertices_info.max_allocated_vid - 1) en = vertices_info.max_allocated_vid - 1;
-            
-            /* Load the vertex values */
-            vertexdata->load(st, en);
-            
-            int nt = en - st + 1;
-            int k = 0;
-            VertexDataType minima = VertexDataType();
-            if (count > 0) {
-                minima = topbuf[ntop - 1].value; // Minimum value that should be even considered
-            }
-            for(int j=0; j < nt; j++) {
-                VertexDataType& val = *vertexdata->vertex_data_ptr(j + st);
-                if (count == 0 || (val > minima)) {
-                    buffer_idxs[k] = vv_t((vid_t)idx + from, val);
-                    k++;
+            buffer_idxs.clear();
+            for (size_t v = st; v <= en; v++) {
+                const VertexDataType &val = values[v];
+                /* Minimum value that should be even considered */
+                if (ntopbuf < ntop || val > topbuf[ntopbuf - 1].value) {
+                    buffer_idxs.push_back(vv_t((vid_t)v, val));
                 }
-                idx++;
             }
-            nt = k; /* How many were actually included */
+            const int nt = std::min(ntop, (int)buffer_idxs.size()); /* How many were actually included */
+            if (nt == 0) {
+                continue;
+            }
             
             /* Sort buffer-idxs */
-            quickSort(buffer_idxs, nt, vertex_value_greater<VertexDataType>);
+            quickSort(buffer_idxs.data(), (int)buffer_idxs.size(), vertex_value_greater<VertexDataType>);
             
             /* Merge the top with the current top */
-            if (count == 0) {
+            if (ntopbuf == 0) {
                 /* Nothing to merge, just copy */
-                memcpy(topbuf, buffer_idxs, ntop * sizeof(vv_t));
+                std::copy(buffer_idxs.begin(), buffer_idxs.begin() + nt, topbuf.begin());
+                ntopbuf = nt;
             } else {
                 // void merge(ET* S1, int l1, ET* S2, int l2, ET* R, F f) {
-                merge<vv_t>(topbuf, ntop, buffer_idxs, std::min(ntop, nt), mergearr,  vertex_value_greater<VertexDataType>);
-                memcpy(topbuf, mergearr, ntop * sizeof(vv_t));
+                merge<vv_t>(topbuf.data(), ntopbuf, buffer_idxs.data(), nt, mergearr.data(), vertex_value_greater<VertexDataType>);
+                ntopbuf = std::min(ntop, ntopbuf + nt);
+                std::copy(mergearr.begin(), mergearr.begin() + ntopbuf, topbuf.begin());
             }
-            
-            count++;
-            st += readwindow;
         }
                    
         /* Return */
-        std::vector< vv_t > ret;
-        for(int i=0; i < ntop; i++) {
-            ret.push_back(topbuf[i]);
-        }
-        free(buffer_idxs);
-        free(mergearr);
-        free(topbuf);
-
-        delete vertexdata;
-        delete iomgr;
-
+        ret.assign(topbuf.begin(), topbuf.begin() + ntopbuf);
         return ret;
     }
-
     
 };
 
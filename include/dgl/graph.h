@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <cstdint>
+#include <memory>
 #include <utility>
 #include <tuple>
 #include "runtime/ndarray.h"
@@ -22,8 +23,70 @@ typedef dgl::runtime::NDArray IntArray;
 
 class Graph;
 class GraphOp;
+class ImmutableGraph;
 struct Subgraph;
 
+/*!
+ * \brief A vector whose storage is shared by its copies until one of them is
+ *        modified (copy-on-write).
+ *
+ * Const access never copies. Non-const access first makes the storage private
+ * to this object by copying all of it, once per copy of the object; later
+ * writes find the storage private and do not copy again.
+ *
+ * \note Single-writer ownership. Whether the storage is shared is decided by
+ *       shared_ptr::use_count(), which is not synchronized with copies made by
+ *       other threads. All the copies sharing one storage (e.g. a Graph and its
+ *       Reverse()) must therefore be copied and mutated by a single thread, or
+ *       under a lock held by the caller. Concurrent const access is safe.
+ */
+template<typename T>
+class CowVector {
+ public:
+  typedef typename std::vector<T>::iterator iterator;
+  typedef typename std::vector<T>::const_iterator const_iterator;
+
+  CowVector() : data_(std::make_shared<std::vector<T>>()) {}
+
+  /*! \brief copies share the storage; moves are copies for the same reason */
+  CowVector(const CowVector& other) = default;
+
+  /*! \brief copies share the storage */
+  CowVector& operator=(const CowVector& other) = default;
+
+  size_t size() const { return data_->size(); }
+  bool empty() const { return data_->empty(); }
+
+  const T& operator[](size_t i) const { return (*data_)[i]; }
+  T& operator[](size_t i) { return (*Mutable())[i]; }
+
+  const T* data() const { return data_->data(); }
+  T* data() { return Mutable()->data(); }
+
+  const_iterator begin() const { return data_->cbegin(); }
+  const_iterator end() const { return data_->cend(); }
+  iterator begin() { return Mutable()->begin(); }
+  iterator end() { return Mutable()->end(); }
+
+  void resize(size_t n) { Mutable()->resize(n); }
+  void reserve(size_t n) { Mutable()->reserve(n); }
+  void push_back(const T& val) { Mutable()->push_back(val); }
+
+  /*! \brief drop the contents; the shared storage is released, not copied */
+  void clear() { data_ = std::make_shared<std::vector<T>>(); }
+
+ private:
+  /*! \return the storage, copied first if it is shared */
+  std::vector<T>* Mutable() {
+    if (data_.use_count() != 1) {
+      data_ = std::make_shared<std::vector<T>>(*data_);
+    }
+    return data_.get();
+  }
+
+  std::shared_ptr<std::vector<T>> data_;
+};
+
 /*!
  * \brief Base dgl graph index class.
  *
@@ -66,6 +129,7 @@ class Graph {
     read_only_ = other.read_only_;
     is_multigraph_ = other.is_multigraph_;
     num_edges_ = other.num_edges_;
+    edge_index_ = other.edge_index_;
     other.Clear();
   }
 #endif  // _MSC_VER
@@ -108,6 +172,7 @@ class Graph {
     all_edges_dst_.clear();
     read_only_ = false;
     num_edges_ = 0;
+    edge_index_.reset();
   }
 
   /*!
@@ -139,14 +204,18 @@ class Graph {
   /*! \return true if the given edge is in the graph.*/
   bool HasEdgeBetween(dgl_id_t src, dgl_id_t dst) const;
 
-  /*! \return a 0-1 array indicating whether the given edges are in the graph.*/
+  /*!
+   * \return a 0-1 array indicating whether the given edges are in the graph.
+   * \note This builds the edge membership index if it does not exist.
+   */
   BoolArray HasEdgesBetween(IdArray src_ids, IdArray dst_ids) const;
 
   /*!
    * \brief Find the predecessors of a vertex.
    * \param vid The vertex id.
    * \param radius The radius of the neighborhood. Default is immediate neighbor (radius=1).
-   * \return the predecessor id array.
+   *        Vertices reachable within radius hops are returned.
+   * \return the predecessor id array, sorted by vertex id.
    */
   IdArray Predecessors(dgl_id_t vid, uint64_t radius = 1) const;
 
@@ -154,7 +223,8 @@ class Graph {
    * \brief Find the successors of a vertex.
    * \param vid The vertex id.
    * \param radius The radius of the neighborhood. Default is immediate neighbor (radius=1).
-   * \return the successor id array.
+   *        Vertices reachable within radius hops are returned.
+   * \return the successor id array, sorted by vertex id.
    */
   IdArray Successors(dgl_id_t vid, uint64_t radius = 1) const;
 
@@ -175,6 +245,7 @@ class Graph {
    *       If duplicate pairs exist, the returned edge IDs will also duplicate.
    *       The order of returned edge IDs will follow the order of src-dst pairs
    *       first, and ties are broken by the order of edge ID.
+   *       This builds the edge membership index if it does not exist.
    * \return EdgeArray containing all edges between all pairs.
    */
   EdgeArray EdgeIds(IdArray src, IdArray dst) const;
@@ -268,6 +339,48 @@ class Graph {
    */
   DegreeArray OutDegrees(IdArray vids) const;
 
+  /*!
+   * \brief Scalar queries that can be run in batch, see BatchQuery.
+   *
+   * The values are part of the C API and must not be changed.
+   */
+  enum QueryOp : int64_t {
+    /*! \brief 1 if vertex arg0 is in the graph, 0 otherwise */
+    kQueryHasVertex = 0,
+    /*! \brief 1 if there is an edge from arg0 to arg1, 0 otherwise */
+    kQueryHasEdgeBetween = 1,
+    /*! \brief in degree of vertex arg0 */
+    kQueryInDegree = 2,
+    /*! \brief out degree of vertex arg0 */
+    kQueryOutDegree = 3,
+    /*! \brief smallest id of the edges from arg0 to arg1, -1 if there is none */
+    kQueryEdgeId = 4,
+    /*! \brief number of edges from arg0 to arg1 */
+    kQueryNumEdgesBetween = 5,
+    /*! \brief source of edge arg0 */
+    kQueryEdgeSrc = 6,
+    /*! \brief destination of edge arg0 */
+    kQueryEdgeDst = 7,
+    /*! \brief number of query ops */
+    kNumQueryOps = 8
+  };
+
+  /*!
+   * \brief Run many scalar queries in one call.
+   *
+   * Query i is ops[i] applied on arg0[i] and arg1[i]; its result is written
+   * into out[i]. Queries of different kinds can be mixed. This avoids the
+   * per-call overhead of the C API when many scalar queries are issued.
+   *
+   * \note All the queries are validated before any of them runs. The edge
+   *       membership index is built if any query needs it.
+   * \param ops The query op of every query, see QueryOp.
+   * \param arg0 The first argument of every query.
+   * \param arg1 The second argument of every query; ignored by unary queries.
+   * \param out The preallocated result array, same length as ops.
+   */
+  void BatchQuery(IdArray ops, IdArray arg0, IdArray arg1, IdArray out) const;
+
   /*!
    * \brief Construct the induced subgraph of the given vertices.
    *
@@ -308,6 +421,10 @@ class Graph {
    * \brief Return a new graph with all the edges reversed.
    *
    * The returned graph preserves the vertex and edge index in the original graph.
+   * It shares the adjacency storage with the original graph, with the in and out
+   * roles swapped, so this is O(1). The storage is copied only when either graph
+   * is mutated afterwards; the first mutation copies the whole adjacency of the
+   * mutated graph. Both graphs are owned by the same writer, see CowVector.
    *
    * \return the reversed graph
    */
@@ -351,6 +468,7 @@ class Graph {
 
  protected:
   friend class GraphOp;
+  friend class ImmutableGraph;
   /*! \brief Internal edge list type */
   struct EdgeList {
     /*! \brief successor vertex list */
@@ -358,17 +476,36 @@ class Graph {
     /*! \brief predecessor vertex list */
     std::vector<dgl_id_t> edge_id;
   };
-  typedef std::vector<EdgeList> AdjacencyList;
+  typedef CowVector<EdgeList> AdjacencyList;
+
+  /*!
+   * \brief Edge membership index.
+   *
+   * A copy of the out-adjacency where every row is sorted by (successor, edge id),
+   * so all the edges between two vertices form one contiguous run found by binary
+   * search.
+   */
+  struct EdgeIndex;
 
-  /*! \brief adjacency list using vector storage */
+  /*!
+   * \brief Return the edge membership index, building it if it does not exist.
+   * \note The index is shared by the copies of the graph and dropped on mutation.
+   */
+  std::shared_ptr<const EdgeIndex> GetEdgeIndex() const;
+
+  /*!
+   * \brief adjacency list using vector storage
+   * \note The storage of the adjacency and edge lists is shared by the copies
+   *       and the reverse of this graph, see CowVector.
+   */
   AdjacencyList adjlist_;
   /*! \brief reverse adjacency list using vector storage */
   AdjacencyList reverse_adjlist_;
 
   /*! \brief all edges' src endpoints in their edge id order */
-  std::vector<dgl_id_t> all_edges_src_;
+  CowVector<dgl_id_t> all_edges_src_;
   /*! \brief all edges' dst endpoints in their edge id order */
-  std::vector<dgl_id_t> all_edges_dst_;
+  CowVector<dgl_id_t> all_edges_dst_;
 
   /*! \brief read only flag */
   bool read_only_ = false;
@@ -380,6 +517,8 @@ class Graph {
   bool is_multigraph_ = false;
   /*! \brief number of edges */
   uint64_t num_edges_ = 0;
+  /*! \brief lazily built edge membership index; null until first needed */
+  mutable std::shared_ptr<const EdgeIndex> edge_index_;
 };
 
 /*! \brief Subgraph data structure */
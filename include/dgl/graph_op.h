@@ -8,6 +8,7 @@
 
 #include <vector>
 #include "graph.h"
+#include "immutable_graph.h"
 
 namespace dgl {
 
@@ -26,6 +27,17 @@ class GraphOp {
    */
   static Graph LineGraph(const Graph* graph, bool backtracking);
 
+  /*!
+   * \brief Return the line graph of an immutable graph.
+   *
+   * Same as above, but the CSR structures of the line graph are filled directly.
+   *
+   * \param graph The input graph.
+   * \param backtracking Whether the backtracking edges are included or not
+   * \return the line graph
+   */
+  static ImmutableGraph LineGraph(const ImmutableGraph* graph, bool backtracking);
+
   /*!
    * \brief Return a disjoint union of the input graphs.
    *
@@ -40,6 +52,17 @@ class GraphOp {
    */
   static Graph DisjointUnion(std::vector<const Graph*> graphs);
 
+  /*!
+   * \brief Return a disjoint union of the input immutable graphs.
+   *
+   * Same as above. The CSR arrays are allocated once and the segments of each
+   * graph are copied and relabeled in parallel.
+   *
+   * \param graphs A list of input graphs to be unioned.
+   * \return the disjoint union of the graphs
+   */
+  static ImmutableGraph DisjointUnion(std::vector<const ImmutableGraph*> graphs);
+
   /*!
    * \brief Partition the graph into several subgraphs.
    *
@@ -66,6 +89,19 @@ class GraphOp {
    */
   static std::vector<Graph> DisjointPartitionBySizes(const Graph* graph, IdArray sizes);
 
+  /*!
+   * \brief Partition the immutable graph into several subgraphs.
+   *
+   * Same as above. This additionally requires the edges of each partition to
+   * have contiguous ids, which holds for graphs built by DisjointUnion.
+   *
+   * \param graph The graph to be partitioned.
+   * \param sizes The number of partitions.
+   * \return a list of partitioned graphs
+   */
+  static std::vector<ImmutableGraph> DisjointPartitionBySizes(
+      const ImmutableGraph* graph, IdArray sizes);
+
   /*!
    * \brief Map vids in the parent graph to the vids in the subgraph.
    *
@@ -0,0 +1,248 @@
+/*!
+ *  Copyright (c) 2018 by Contributors
+ * \file dgl/immutable_graph.h
+ * \brief DGL immutable graph index class.
+ */
+#ifndef DGL_IMMUTABLE_GRAPH_H_
+#define DGL_IMMUTABLE_GRAPH_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include "graph.h"
+
+namespace dgl {
+
+/*!
+ * \brief DGL immutable graph index class.
+ *
+ * The graph is stored as two compressed sparse row structures: one for the
+ * out-edges (CSR) and one for the in-edges (CSC). All the storage is held in
+ * NDArrays so it can either be allocated in memory or mapped from a file.
+ *
+ * Within each row, the neighbors are sorted by their vertex ids (ties broken by
+ * the edge id), which allows membership queries by binary search.
+ *
+ * The two structures are shared through shared_ptr, so copying an immutable
+ * graph never copies the edges.
+ */
+class ImmutableGraph {
+ public:
+  /*! \brief Compressed sparse row storage of one direction of the adjacency. */
+  struct CSR {
+    /*! \brief row offsets; has num_vertices + 1 elements */
+    IdArray indptr;
+    /*! \brief neighbor ids of every row, concatenated */
+    IdArray indices;
+    /*! \brief edge ids aligned with indices */
+    IdArray edge_ids;
+
+    /*! \return the number of rows */
+    int64_t NumVertices() const {
+      return indptr->shape[0] - 1;
+    }
+
+    /*! \return the number of stored edges */
+    int64_t NumEdges() const {
+      return indices->shape[0];
+    }
+
+    /*! \return the number of neighbors of the given row */
+    int64_t GetDegree(dgl_id_t vid) const {
+      const int64_t* indptr_data = static_cast<int64_t*>(indptr->data);
+      return indptr_data[vid + 1] - indptr_data[vid];
+    }
+  };
+  typedef std::shared_ptr<CSR> CSRPtr;
+
+  /*!
+   * \brief Construct an immutable graph from its in-CSR and out-CSR.
+   * \param in_csr The in-edge structure, rows are the destinations.
+   * \param out_csr The out-edge structure, rows are the sources.
+   * \param multigraph Whether the graph is a multigraph.
+   */
+  ImmutableGraph(CSRPtr in_csr, CSRPtr out_csr, bool multigraph)
+    : in_csr_(in_csr), out_csr_(out_csr), is_multigraph_(multigraph) {
+    CHECK(in_csr_ && out_csr_) << "Both the in-CSR and the out-CSR are required.";
+    CHECK_EQ(in_csr_->NumVertices(), out_csr_->NumVertices());
+    CHECK_EQ(in_csr_->NumEdges(), out_csr_->NumEdges());
+  }
+
+  /*! \brief default copy constructor */
+  ImmutableGraph(const ImmutableGraph& other) = default;
+
+  /*! \brief default assign constructor */
+  ImmutableGraph& operator=(const ImmutableGraph& other) = default;
+
+  /*! \brief default destructor */
+  ~ImmutableGraph() = default;
+
+  /*!
+   * \brief Build the immutable form of a mutable graph.
+   * \param graph The mutable graph.
+   * \return the immutable graph, with the vertex and edge ids preserved.
+   */
+  static ImmutableGraph FromGraph(const Graph& graph);
+
+  /*!
+   * \brief Copy the immutable graph into a mutable graph.
+   *
+   * The adjacency is built in bulk, so this is much cheaper than adding the
+   * edges one by one. Vertex and edge ids are preserved.
+   *
+   * \return the mutable graph
+   */
+  Graph ToGraph() const;
+
+  /*!
+   * \brief Save the graph into a binary file.
+   *
+   * The file holds a fixed-size header (magic number, format version, flags,
+   * number of vertices and edges, checksum) followed by the out-CSR and in-CSR
+   * arrays, each aligned to kAllocAlignment so it can be mapped in place.
+   *
+   * \param filename The file to write.
+   */
+  void Save(const std::string& filename) const;
+
+  /*!
+   * \brief Load a graph saved by Save.
+   *
+   * The file is mapped read-only and shared, and the arrays are wrapped as
+   * NDArrays in place. Several processes loading the same file share the page
+   * cache. The mapping is kept alive as long as any of the arrays is referenced.
+   * The sizes in the header are checked against the size of the file, so a
+   * truncated or corrupt header fails instead of mapping out of bounds.
+   *
+   * \param filename The file to read.
+   * \param verify Whether to verify the checksum. This touches every page of the file.
+   * \return the loaded graph
+   */
+  static ImmutableGraph Load(const std::string& filename, bool verify = false);
+
+  /*! \return whether the graph is a multigraph */
+  bool IsMultigraph() const {
+    return is_multigraph_;
+  }
+
+  /*! \return the number of vertices in the graph.*/
+  uint64_t NumVertices() const {
+    return out_csr_->NumVertices();
+  }
+
+  /*! \return the number of edges in the graph.*/
+  uint64_t NumEdges() const {
+    return out_csr_->NumEdges();
+  }
+
+  /*! \return true if the given vertex is in the graph.*/
+  bool HasVertex(dgl_id_t vid) const {
+    return vid < NumVertices();
+  }
+
+  /*! \return true if the given edge is in the graph.*/
+  bool HasEdgeBetween(dgl_id_t src, dgl_id_t dst) const;
+
+  /*! \return a 0-1 array indicating whether the given edges are in the graph.*/
+  BoolArray HasEdgesBetween(IdArray src_ids, IdArray dst_ids) const;
+
+  /*!
+   * \brief Find the predecessors of a vertex.
+   *
+   * Vertices reachable within radius hops are returned, sorted by id. For
+   * radius 1, the result is a view into the CSR storage whenever the row has
+   * no parallel edges, so it must not be written to.
+   *
+   * \param vid The vertex id.
+   * \param radius The radius of the neighborhood.
+   * \return the predecessor id array.
+   */
+  IdArray Predecessors(dgl_id_t vid, uint64_t radius = 1) const;
+
+  /*!
+   * \brief Find the successors of a vertex.
+   *
+   * Vertices reachable within radius hops are returned, sorted by id. For
+   * radius 1, the result is a view into the CSR storage whenever the row has
+   * no parallel edges, so it must not be written to.
+   *
+   * \param vid The vertex id.
+   * \param radius The radius of the neighborhood.
+   * \return the successor id array.
+   */
+  IdArray Successors(dgl_id_t vid, uint64_t radius = 1) const;
+
+  /*!
+   * \brief Get the in edges of the vertex.
+   * \param vid The vertex id.
+   * \return the edges
+   */
+  Graph::EdgeArray InEdges(dgl_id_t vid) const;
+
+  /*!
+   * \brief Get the out edges of the vertex.
+   * \param vid The vertex id.
+   * \return the edges
+   */
+  Graph::EdgeArray OutEdges(dgl_id_t vid) const;
+
+  /*!
+   * \brief Get all the edges in the graph.
+   * \note The edges are returned sorted by their src and dst ids. The arrays
+   *  are fresh copies and never alias the (possibly mapped) CSR storage.
+   * \return the id arrays of the two endpoints of the edges.
+   */
+  Graph::EdgeArray Edges() const;
+
+  /*! \return the in degree of the given vertex. */
+  uint64_t InDegree(dgl_id_t vid) const {
+    CHECK(HasVertex(vid)) << "invalid vertex: " << vid;
+    return in_csr_->GetDegree(vid);
+  }
+
+  /*! \return the out degree of the given vertex. */
+  uint64_t OutDegree(dgl_id_t vid) const {
+    CHECK(HasVertex(vid)) << "invalid vertex: " << vid;
+    return out_csr_->GetDegree(vid);
+  }
+
+  /*! \return the in degrees of the given vertices. */
+  DegreeArray InDegrees(IdArray vids) const;
+
+  /*! \return the out degrees of the given vertices. */
+  DegreeArray OutDegrees(IdArray vids) const;
+
+  /*!
+   * \brief Return a new graph with all the edges reversed.
+   *
+   * The two CSR structures are shared with this graph with their roles swapped,
+   * so this is O(1).
+   *
+   * \return the reversed graph
+   */
+  ImmutableGraph Reverse() const {
+    return ImmutableGraph(out_csr_, in_csr_, is_multigraph_);
+  }
+
+  /*! \return the in-edge structure; rows are the destination vertices. */
+  const CSR& GetInCSR() const {
+    return *in_csr_;
+  }
+
+  /*! \return the out-edge structure; rows are the source vertices. */
+  const CSR& GetOutCSR() const {
+    return *out_csr_;
+  }
+
+ protected:
+  /*! \brief in-edge structure */
+  CSRPtr in_csr_;
+  /*! \brief out-edge structure */
+  CSRPtr out_csr_;
+  /*! \brief Whether if this is a multigraph. */
+  bool is_multigraph_ = false;
+};
+
+}  // namespace dgl
+
+#endif  // DGL_IMMUTABLE_GRAPH_H_
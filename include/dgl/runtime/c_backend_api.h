@@ -108,6 +108,51 @@ DGL_DLL int DGLBackendParallelLaunch(FDGLParallelLambda flambda,
                                      void* cdata,
                                      int num_task);
 
+/*!
+ * \brief The callback function to execute one chunk of a parallel loop
+ * \param begin The first index of the chunk.
+ * \param end One past the last index of the chunk.
+ * \param cdata The supporting closure data.
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+typedef int (*FDGLParallelForLambda)(int64_t begin, int64_t end, void* cdata);
+/*!
+ * \brief Backend function for running a parallel loop with dynamic scheduling.
+ *
+ *  The range is first split evenly among the workers. Each worker runs its
+ *  part in chunks of grain_size indices, then steals chunks from the parts of
+ *  the other workers, trying the workers on its own NUMA node first. This
+ *  balances loops whose per-index cost is skewed.
+ *
+ *  When called from inside a parallel job, the loop runs on the calling thread.
+ *
+ * \param begin The first index.
+ * \param end One past the last index.
+ * \param grain_size Number of indices per chunk; 0 picks one automatically.
+ * \param flambda The function to run on every chunk.
+ * \param cdata The closure data.
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+DGL_DLL int DGLBackendParallelFor(int64_t begin,
+                                  int64_t end,
+                                  int64_t grain_size,
+                                  FDGLParallelForLambda flambda,
+                                  void* cdata);
+/*!
+ * \brief Zero a buffer in parallel, so its pages are first touched, and hence
+ *  placed, on the NUMA node of the worker that touches them.
+ *
+ *  The pages are split evenly among the workers in the same way as the
+ *  initial split of DGLBackendParallelFor. A buffer touched this way is local
+ *  to the workers that will read it if it is later processed by a parallel
+ *  loop over a proportional range. Called from inside a worker, or when the
+ *  pool has a single worker, the buffer is zeroed by the calling thread.
+ *
+ * \param data The buffer, usually freshly allocated.
+ * \param nbytes The size of the buffer in bytes.
+ * \return 0 when no error is thrown, -1 when failure happens
+ */
+DGL_DLL int DGLBackendParallelFirstTouch(void* data, uint64_t nbytes);
 /*!
  * \brief BSP barrrier between parallel threads
  * \param task_id the task id of the function.
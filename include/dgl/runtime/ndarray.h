@@ -139,6 +139,11 @@ class NDArray {
   DGL_DLL DLManagedTensor* ToDLPack() const;
   /*!
    * \brief Create an empty NDArray.
+   *
+   *  The content is uninitialized, except that large CPU arrays come zeroed:
+   *  they are first touched in parallel by the OpenMP team so that their pages
+   *  are spread over the NUMA nodes of the threads running the kernels.
+   *
    * \param shape The shape of the new array.
    * \param dtype The data type of the new array.
    * \param ctx The context of the Array.
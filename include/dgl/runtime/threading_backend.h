@@ -47,6 +47,11 @@ class ThreadGroup {
   enum AffinityMode : int {
     kBig = 1,
     kLittle = -1,
+    /*!
+     * \brief Spread the workers round-robin over the NUMA nodes and bind each
+     *        one to all the cores of its node.
+     */
+    kNuma = 2,
   };
 
   /*!
@@ -63,6 +68,20 @@ class ThreadGroup {
    */
   int Configure(AffinityMode mode, int nthreads, bool exclude_worker0);
 
+  /*! \return the number of NUMA nodes of the system; 1 if unknown */
+  int NumNumaNodes() const;
+
+  /*!
+   * \brief Return the NUMA node a worker runs on.
+   *
+   * Only meaningful in the kNuma mode; in the other modes this is the node
+   * of the core the worker is bound to, or 0 if unknown.
+   *
+   * \param worker_id The worker id; 0 is the main thread if it is a worker.
+   * \return the NUMA node
+   */
+  int WorkerNumaNode(int worker_id) const;
+
  private:
   Impl* impl_;
 };
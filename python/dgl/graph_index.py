@@ -7,6 +7,7 @@ import scipy
 
 from ._ffi.base import c_array
 from ._ffi.function import _init_api
+from ._ffi.ndarray import numpyasarray, _make_array
 from .base import DGLError, is_all
 from . import backend as F
 from . import utils
@@ -14,6 +15,16 @@ from .immutable_graph_index import create_immutable_graph_index
 
 GraphIndexHandle = ctypes.c_void_p
 
+# Query ops of GraphIndex.batch_query; must match Graph::QueryOp.
+QUERY_HAS_NODE = 0
+QUERY_HAS_EDGE_BETWEEN = 1
+QUERY_IN_DEGREE = 2
+QUERY_OUT_DEGREE = 3
+QUERY_EDGE_ID = 4
+QUERY_NUM_EDGES_BETWEEN = 5
+QUERY_EDGE_SRC = 6
+QUERY_EDGE_DST = 7
+
 class GraphIndex(object):
     """Graph index object.
 
@@ -429,6 +440,52 @@ class GraphIndex(object):
         v_array = v.todgltensor()
         return utils.toindex(_CAPI_DGLGraphOutDegrees(self._handle, v_array))
 
+    def batch_query(self, ops, arg0, arg1, out=None):
+        """Run many scalar queries in one call.
+
+        Query i applies ops[i] on arg0[i] and arg1[i]. The ops are the
+        QUERY_* constants of this module and can be mixed freely:
+
+        * QUERY_HAS_NODE: 1 if node arg0 exists, 0 otherwise.
+        * QUERY_HAS_EDGE_BETWEEN: 1 if there is an edge arg0 -> arg1, 0 otherwise.
+        * QUERY_IN_DEGREE, QUERY_OUT_DEGREE: the degree of node arg0.
+        * QUERY_EDGE_ID: the smallest id of the edges arg0 -> arg1, -1 if none.
+        * QUERY_NUM_EDGES_BETWEEN: the number of edges arg0 -> arg1.
+        * QUERY_EDGE_SRC, QUERY_EDGE_DST: an endpoint of edge arg0.
+
+        Unary queries ignore arg1. This is much faster than calling the scalar
+        methods one by one.
+
+        Parameters
+        ----------
+        ops : utils.Index
+            The query ops.
+        arg0 : utils.Index
+            The first argument of every query.
+        arg1 : utils.Index
+            The second argument of every query.
+        out : numpy.ndarray, optional
+            Preallocated C-contiguous 1D int64 array of len(ops) elements.
+            The results are written into it in place. It is allocated if not given.
+
+        Returns
+        -------
+        utils.Index
+            The results.
+        """
+        if out is None:
+            out = np.empty(len(ops), dtype=np.int64)
+        elif not (isinstance(out, np.ndarray) and out.dtype == np.int64 and out.ndim == 1
+                  and out.flags['C_CONTIGUOUS'] and len(out) == len(ops)):
+            raise DGLError('out must be a C-contiguous 1D int64 numpy array'
+                           ' of %d elements.' % len(ops))
+        # Pass a view of out, so that the results land in its memory.
+        out_arr, out_shape = numpyasarray(out)
+        out_view = _make_array(ctypes.pointer(out_arr), True)
+        _CAPI_DGLGraphBatchQuery(self._handle, ops.todgltensor(), arg0.todgltensor(),
+                                 arg1.todgltensor(), out_view)
+        return utils.toindex(out)
+
     def node_subgraph(self, v):
         """Return the induced node subgraph.
 
@@ -714,6 +771,33 @@ class GraphIndex(object):
         handle = _CAPI_DGLGraphLineGraph(self._handle, backtracking)
         return GraphIndex(handle)
 
+    def reverse(self):
+        """Return the reverse of this graph.
+
+        The reversed graph keeps the node and edge ids. It shares the storage
+        with this graph until either of them is mutated.
+
+        Returns
+        -------
+        GraphIndex
+            The reversed graph.
+        """
+        handle = _CAPI_DGLGraphReverse(self._handle)
+        return GraphIndex(handle)
+
+    def save(self, filename):
+        """Save the graph index into a binary file.
+
+        The file stores the CSR and CSC arrays of the graph and can be
+        loaded back with ``load_graph_index``.
+
+        Parameters
+        ----------
+        filename : str
+            The file to write.
+        """
+        _CAPI_DGLGraphSave(self._handle, filename)
+
     def __getstate__(self):
         src, dst, _ = self.edges()
         n_nodes = self.number_of_nodes()
@@ -796,6 +880,410 @@ class SubgraphIndex(GraphIndex):
         raise NotImplementedError(
                 "SubgraphIndex unpickling is not supported yet.")
 
+class CSRGraphIndex(object):
+    """Read-only graph index backed by the CSR and CSC arrays of a C++ ImmutableGraph.
+
+    It is what ``load_graph_index`` returns: the arrays stay memory-mapped
+    from the file and nothing is copied. Use ``to_mutable`` to get a
+    GraphIndex that supports mutation and the full query interface.
+
+    Parameters
+    ----------
+    handle : GraphIndexHandle
+        Handler of the ImmutableGraph
+    """
+    def __init__(self, handle):
+        self._handle = handle
+        self._cache = {}
+
+    def __del__(self):
+        """Free this graph index object."""
+        _CAPI_DGLImmutableGraphFree(self._handle)
+
+    def add_nodes(self, num):
+        """Add nodes. Disabled because CSRGraphIndex is read-only."""
+        raise RuntimeError('Readonly graph. Mutation is not allowed.')
+
+    def add_edge(self, u, v):
+        """Add edges. Disabled because CSRGraphIndex is read-only."""
+        raise RuntimeError('Readonly graph. Mutation is not allowed.')
+
+    def add_edges(self, u, v):
+        """Add edges. Disabled because CSRGraphIndex is read-only."""
+        raise RuntimeError('Readonly graph. Mutation is not allowed.')
+
+    def clear(self):
+        """Clear the graph. Disabled because CSRGraphIndex is read-only."""
+        raise RuntimeError('Readonly graph. Mutation is not allowed.')
+
+    def is_multigraph(self):
+        """Return whether the graph is a multigraph
+
+        Returns
+        -------
+        bool
+            True if it is a multigraph, False otherwise.
+        """
+        return bool(_CAPI_DGLImmutableGraphIsMultigraph(self._handle))
+
+    def is_readonly(self):
+        """Indicate whether the graph index is read-only.
+
+        Returns
+        -------
+        bool
+            Always True.
+        """
+        return True
+
+    def number_of_nodes(self):
+        """Return the number of nodes.
+
+        Returns
+        -------
+        int
+            The number of nodes
+        """
+        return _CAPI_DGLImmutableGraphNumVertices(self._handle)
+
+    def number_of_edges(self):
+        """Return the number of edges.
+
+        Returns
+        -------
+        int
+            The number of edges
+        """
+        return _CAPI_DGLImmutableGraphNumEdges(self._handle)
+
+    def has_node(self, vid):
+        """Return true if the node exists.
+
+        Parameters
+        ----------
+        vid : int
+            The nodes
+
+        Returns
+        -------
+        bool
+            True if the node exists
+        """
+        return 0 <= vid < self.number_of_nodes()
+
+    def has_nodes(self, vids):
+        """Return true if the nodes exist.
+
+        Parameters
+        ----------
+        vid : utils.Index
+            The nodes
+
+        Returns
+        -------
+        utils.Index
+            0-1 array indicating existence
+        """
+        vids = vids.tonumpy()
+        return utils.toindex(((vids >= 0) & (vids < self.number_of_nodes())).astype(np.int64))
+
+    def has_edge_between(self, u, v):
+        """Return true if the edge exists.
+
+        Parameters
+        ----------
+        u : int
+            The src node.
+        v : int
+            The dst node.
+
+        Returns
+        -------
+        bool
+            True if the edge exists, False otherwise
+        """
+        return bool(_CAPI_DGLImmutableGraphHasEdgeBetween(self._handle, u, v))
+
+    def has_edges_between(self, u, v):
+        """Return true if the edge exists.
+
+        Parameters
+        ----------
+        u : utils.Index
+            The src nodes.
+        v : utils.Index
+            The dst nodes.
+
+        Returns
+        -------
+        utils.Index
+            0-1 array indicating existence
+        """
+        u_array = u.todgltensor()
+        v_array = v.todgltensor()
+        return utils.toindex(_CAPI_DGLImmutableGraphHasEdgesBetween(
+            self._handle, u_array, v_array))
+
+    def predecessors(self, v, radius=1):
+        """Return the predecessors of the node.
+
+        Parameters
+        ----------
+        v : int
+            The node.
+        radius : int, optional
+            The radius of the neighborhood.
+
+        Returns
+        -------
+        utils.Index
+            Array of predecessors
+        """
+        return utils.toindex(_CAPI_DGLImmutableGraphPredecessors(self._handle, v, radius))
+
+    def successors(self, v, radius=1):
+        """Return the successors of the node.
+
+        Parameters
+        ----------
+        v : int
+            The node.
+        radius : int, optional
+            The radius of the neighborhood.
+
+        Returns
+        -------
+        utils.Index
+            Array of successors
+        """
+        return utils.toindex(_CAPI_DGLImmutableGraphSuccessors(self._handle, v, radius))
+
+    def edge_id(self, u, v):
+        """Return the id array of all edges between u and v.
+
+        Parameters
+        ----------
+        u : int
+            The src node.
+        v : int
+            The dst node.
+
+        Returns
+        -------
+        utils.Index
+            The edge id array, in increasing order.
+        """
+        _, dst, eid = self.out_edges(utils.toindex([u]))
+        eid = eid.tonumpy()[dst.tonumpy() == v]
+        return utils.toindex(np.sort(eid))
+
+    def _neighbor_edges(self, capi, v):
+        """Concatenate the edges of every node in v returned by the capi."""
+        srcs, dsts, eids = [], [], []
+        for vid in v.tonumpy():
+            edge_array = capi(self._handle, int(vid))
+            srcs.append(edge_array(0).asnumpy())
+            dsts.append(edge_array(1).asnumpy())
+            eids.append(edge_array(2).asnumpy())
+        if len(srcs) == 1:
+            return utils.toindex(srcs[0]), utils.toindex(dsts[0]), utils.toindex(eids[0])
+        empty = np.zeros((0,), dtype=np.int64)
+        src = np.concatenate(srcs) if srcs else empty
+        dst = np.concatenate(dsts) if dsts else empty
+        eid = np.concatenate(eids) if eids else empty
+        return utils.toindex(src), utils.toindex(dst), utils.toindex(eid)
+
+    def in_edges(self, v):
+        """Return the in edges of the node(s).
+
+        Parameters
+        ----------
+        v : utils.Index
+            The node(s).
+
+        Returns
+        -------
+        utils.Index
+            The src nodes.
+        utils.Index
+            The dst nodes.
+        utils.Index
+            The edge ids.
+        """
+        return self._neighbor_edges(_CAPI_DGLImmutableGraphInEdges, v)
+
+    def out_edges(self, v):
+        """Return the out edges of the node(s).
+
+        Parameters
+        ----------
+        v : utils.Index
+            The node(s).
+
+        Returns
+        -------
+        utils.Index
+            The src nodes.
+        utils.Index
+            The dst nodes.
+        utils.Index
+            The edge ids.
+        """
+        return self._neighbor_edges(_CAPI_DGLImmutableGraphOutEdges, v)
+
+    def edges(self, sorted=False):
+        """Return all the edges
+
+        The edges always come out sorted by their src and dst ids, which is
+        the order of the CSR arrays.
+
+        Parameters
+        ----------
+        sorted : bool
+            Ignored; kept for compatibility with GraphIndex.
+
+        Returns
+        -------
+        utils.Index
+            The src nodes.
+        utils.Index
+            The dst nodes.
+        utils.Index
+            The edge ids.
+        """
+        if 'edges' not in self._cache:
+            edge_array = _CAPI_DGLImmutableGraphEdges(self._handle)
+            src = utils.toindex(edge_array(0))
+            dst = utils.toindex(edge_array(1))
+            eid = utils.toindex(edge_array(2))
+            self._cache['edges'] = (src, dst, eid)
+        return self._cache['edges']
+
+    def in_degree(self, v):
+        """Return the in degree of the node.
+
+        Parameters
+        ----------
+        v : int
+            The node.
+
+        Returns
+        -------
+        int
+            The in degree.
+        """
+        return _CAPI_DGLImmutableGraphInDegree(self._handle, v)
+
+    def in_degrees(self, v):
+        """Return the in degrees of the nodes.
+
+        Parameters
+        ----------
+        v : utils.Index
+            The nodes.
+
+        Returns
+        -------
+        int
+            The in degree array.
+        """
+        v_array = v.todgltensor()
+        return utils.toindex(_CAPI_DGLImmutableGraphInDegrees(self._handle, v_array))
+
+    def out_degree(self, v):
+        """Return the out degree of the node.
+
+        Parameters
+        ----------
+        v : int
+            The node.
+
+        Returns
+        -------
+        int
+            The out degree.
+        """
+        return _CAPI_DGLImmutableGraphOutDegree(self._handle, v)
+
+    def out_degrees(self, v):
+        """Return the out degrees of the nodes.
+
+        Parameters
+        ----------
+        v : utils.Index
+            The nodes.
+
+        Returns
+        -------
+        int
+            The out degree array.
+        """
+        v_array = v.todgltensor()
+        return utils.toindex(_CAPI_DGLImmutableGraphOutDegrees(self._handle, v_array))
+
+    def line_graph(self, backtracking=True):
+        """Return the line graph of this graph.
+
+        The CSR arrays of the line graph are built directly, without going
+        through a mutable graph.
+
+        Parameters
+        ----------
+        backtracking : bool, optional (default=True)
+          Whether (i, j) ~ (j, i) in L(G).
+          (i, j) ~ (j, i) is the behavior of networkx.line_graph.
+
+        Returns
+        -------
+        CSRGraphIndex
+            The line graph of this graph.
+        """
+        handle = _CAPI_DGLImmutableGraphLineGraph(self._handle, backtracking)
+        return CSRGraphIndex(handle)
+
+    def reverse(self):
+        """Return the reverse of this graph.
+
+        The reversed graph shares the CSR and CSC arrays with this graph.
+
+        Returns
+        -------
+        CSRGraphIndex
+            The reversed graph.
+        """
+        handle = _CAPI_DGLImmutableGraphReverse(self._handle)
+        return CSRGraphIndex(handle)
+
+    def save(self, filename):
+        """Save the graph index into a binary file.
+
+        Parameters
+        ----------
+        filename : str
+            The file to write.
+        """
+        _CAPI_DGLImmutableGraphSave(self._handle, filename)
+
+    def to_mutable(self):
+        """Copy the graph into a mutable GraphIndex.
+
+        Vertex and edge ids are preserved.
+
+        Returns
+        -------
+        GraphIndex
+            The mutable copy.
+        """
+        return GraphIndex(_CAPI_DGLImmutableGraphToGraph(self._handle))
+
+    def __getstate__(self):
+        raise NotImplementedError(
+                "CSRGraphIndex pickling is not supported yet.")
+
+    def __setstate__(self, state):
+        raise NotImplementedError(
+                "CSRGraphIndex unpickling is not supported yet.")
+
 def map_to_subgraph_nid(subgraph, parent_nids):
     """Map parent node Ids to the subgraph node Ids.
 
@@ -824,16 +1312,26 @@ def disjoint_union(graphs):
     they have 5, 6, 7 nodes respectively. Then node#2 of g2 will become node#7
     in the result graph. Edge ids are re-assigned similarly.
 
+    If all the input graphs are CSRGraphIndex, the union is built directly on
+    their CSR arrays and is a CSRGraphIndex too.
+
     Parameters
     ----------
-    graphs : iterable of GraphIndex
+    graphs : iterable of GraphIndex or CSRGraphIndex
         The input graphs
 
     Returns
     -------
-    GraphIndex
+    GraphIndex or CSRGraphIndex
         The disjoint union
     """
+    graphs = list(graphs)
+    if len(graphs) > 0 and all(isinstance(gr, CSRGraphIndex) for gr in graphs):
+        inputs = c_array(GraphIndexHandle, [gr._handle for gr in graphs])
+        inputs = ctypes.cast(inputs, ctypes.c_void_p)
+        handle = _CAPI_DGLImmutableDisjointUnion(inputs, len(graphs))
+        return CSRGraphIndex(handle)
+    graphs = [gr.to_mutable() if isinstance(gr, CSRGraphIndex) else gr for gr in graphs]
     inputs = c_array(GraphIndexHandle, [gr._handle for gr in graphs])
     inputs = ctypes.cast(inputs, ctypes.c_void_p)
     handle = _CAPI_DGLDisjointUnion(inputs, len(graphs))
@@ -847,18 +1345,35 @@ def disjoint_partition(graph, num_or_size_splits):
     divides the number of nodes in the graph. If the a size list is given,
     the sum of the given sizes is equal.
 
+    A CSRGraphIndex is partitioned directly on its CSR arrays. This requires
+    the edges of each partition to have contiguous ids, which holds for
+    graphs built by ``disjoint_union``.
+
     Parameters
     ----------
-    graph : GraphIndex
+    graph : GraphIndex or CSRGraphIndex
         The graph to be partitioned
     num_or_size_splits : int or utils.Index
         The partition number of size splits
 
     Returns
     -------
-    list of GraphIndex
+    list of GraphIndex or list of CSRGraphIndex
         The partitioned graphs
     """
+    if isinstance(graph, CSRGraphIndex):
+        if isinstance(num_or_size_splits, utils.Index):
+            sizes = num_or_size_splits
+        else:
+            num = int(num_or_size_splits)
+            num_nodes = graph.number_of_nodes()
+            if num <= 0 or num_nodes % num != 0:
+                raise DGLError('Cannot evenly partition %d nodes into %d graphs.'
+                               % (num_nodes, num))
+            sizes = utils.toindex(np.full((num,), num_nodes // num, dtype=np.int64))
+        rst = _CAPI_DGLImmutableDisjointPartitionBySizes(graph._handle, sizes.todgltensor())
+        return [CSRGraphIndex(ctypes.cast(int(val), ctypes.c_void_p))
+                for val in rst.asnumpy()]
     if isinstance(num_or_size_splits, utils.Index):
         rst = _CAPI_DGLDisjointPartitionBySizes(
                 graph._handle,
@@ -873,6 +1388,32 @@ def disjoint_partition(graph, num_or_size_splits):
         graphs.append(GraphIndex(handle))
     return graphs
 
+def load_graph_index(filename, verify=False, readonly=True):
+    """Load a graph index saved by ``GraphIndex.save``.
+
+    The file is memory-mapped, so loading the same file from several
+    processes shares the page cache. Vertex and edge ids are preserved.
+
+    Parameters
+    ----------
+    filename : str
+        The file to read.
+    verify : bool, optional
+        Whether to verify the checksum stored in the file (default is False)
+    readonly : bool, optional
+        If True (default), return a CSRGraphIndex over the mapped arrays without
+        copying. Otherwise copy the graph into a mutable GraphIndex.
+
+    Returns
+    -------
+    CSRGraphIndex or GraphIndex
+        The loaded graph index
+    """
+    gi = CSRGraphIndex(_CAPI_DGLGraphLoad(filename, verify))
+    if readonly:
+        return gi
+    return gi.to_mutable()
+
 def create_graph_index(graph_data=None, multigraph=False, readonly=False):
     """Create a graph index object.
 
@@ -883,7 +1424,7 @@ def create_graph_index(graph_data=None, multigraph=False, readonly=False):
     multigraph : bool, optional
         Whether the graph is multigraph (default is False)
     """
-    if isinstance(graph_data, GraphIndex):
+    if isinstance(graph_data, (GraphIndex, CSRGraphIndex)):
         return graph_data
 
     if readonly and graph_data is not None:
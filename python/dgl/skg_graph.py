@@ -10,6 +10,7 @@ from ._ffi.function import _init_api
 from .base import DGLError, is_all
 from . import backend as F
 from . import utils
+from . import ndarray as nd
 from .immutable_graph_index import create_immutable_graph_index
 
 GraphIndexHandle = ctypes.c_void_p
@@ -209,7 +210,7 @@ class SkgGraph(object):
         utils.Index
             Array of predecessors
         """
-        return utils.toindex(_CAPI_DGLGraphPredecessors(self._handle, v, radius))
+        return utils.toindex(_CAPI_SKGGraphPredecessors(self._handle, v, radius))
 
     def successors(self, v, radius=1):
         """Return the successors of the node.
@@ -226,7 +227,7 @@ class SkgGraph(object):
         utils.Index
             Array of successors
         """
-        return utils.toindex(_CAPI_DGLGraphSuccessors(self._handle, v, radius))
+        return utils.toindex(_CAPI_SKGGraphSuccessors(self._handle, v, radius))
 
     def edge_id(self, u, v):
         """Return the id array of all edges between u and v.
@@ -393,7 +394,7 @@ class SkgGraph(object):
         int
             The in degree.
         """
-        return _CAPI_DGLGraphInDegree(self._handle, v)
+        return int(self.in_degrees(utils.toindex([v])).tonumpy()[0])
 
     def in_degrees(self, v):
         """Return the in degrees of the nodes.
@@ -409,7 +410,7 @@ class SkgGraph(object):
             The in degree array.
         """
         v_array = v.todgltensor()
-        return utils.toindex(_CAPI_DGLGraphInDegrees(self._handle, v_array))
+        return utils.toindex(_CAPI_SKGGraphInDegrees(self._handle, v_array))
 
     def out_degree(self, v):
         """Return the out degree of the node.
@@ -424,7 +425,7 @@ class SkgGraph(object):
         int
             The out degree.
         """
-        return _CAPI_DGLGraphOutDegree(self._handle, v)
+        return int(self.out_degrees(utils.toindex([v])).tonumpy()[0])
 
     def out_degrees(self, v):
         """Return the out degrees of the nodes.
@@ -440,7 +441,72 @@ class SkgGraph(object):
             The out degree array.
         """
         v_array = v.todgltensor()
-        return utils.toindex(_CAPI_DGLGraphOutDegrees(self._handle, v_array))
+        return utils.toindex(_CAPI_SKGGraphOutDegrees(self._handle, v_array))
+
+    def set_node_attr(self, column, v, values):
+        """Set one numeric node attribute column for some nodes.
+
+        The column is created if it does not exist, with the type of values.
+
+        Parameters
+        ----------
+        column : str
+            The attribute column name.
+        v : utils.Index
+            The nodes.
+        values : numpy.ndarray
+            The values, one per node, of type int32, int64, float32 or float64.
+        """
+        values = nd.array(np.ascontiguousarray(values))
+        _CAPI_SKGGraphSetVertexAttr(self._handle, column, v.todgltensor(), values)
+
+    def node_attr(self, column, v=None):
+        """Return one numeric node attribute column.
+
+        Parameters
+        ----------
+        column : str
+            The attribute column name.
+        v : utils.Index, optional
+            The nodes. If not given, the whole column is returned as a
+            read-only view of the storage, indexed by node id, without copying.
+
+        Returns
+        -------
+        Tensor
+            The attribute values, in the type of the column.
+        """
+        if v is None:
+            nd = _CAPI_SKGGraphVertexAttrView(self._handle, column)
+        else:
+            nd = _CAPI_SKGGraphGetVertexAttr(self._handle, column, v.todgltensor())
+        return F.zerocopy_from_dlpack(nd.to_dlpack())
+
+    def node_attrs(self, columns, v):
+        """Return several numeric node attribute columns as one feature tensor.
+
+        Parameters
+        ----------
+        columns : list of str
+            The attribute column names, one per feature dimension.
+        v : utils.Index
+            The nodes.
+
+        Returns
+        -------
+        Tensor
+            A float32 tensor of shape (len(v), len(columns)).
+        """
+        nd = _CAPI_SKGGraphGetVertexAttrs(self._handle, ','.join(columns), v.todgltensor())
+        return F.zerocopy_from_dlpack(nd.to_dlpack())
+
+    def gen_degree_index(self):
+        """Rebuild the persistent degree columns of the database.
+
+        Only needed for a database created without them; the columns are kept
+        up to date on every edge update afterwards.
+        """
+        _CAPI_SKGGraphGenDegreeIndex(self._handle)
 
     def node_subgraph(self, v):
         """Return the induced node subgraph.
@@ -5,15 +5,88 @@
  */
 #include <dgl/graph.h>
 #include <algorithm>
+#include <atomic>
 #include <unordered_map>
-#include <set>
 #include <functional>
-#include <tuple>
 #include "../c_api_common.h"
+#include "./radix_sort.h"
+#include "./traversal.h"
 
 namespace dgl {
+struct Graph::EdgeIndex {
+  /*! \brief row offsets; has num_vertices + 1 elements */
+  std::vector<uint64_t> indptr;
+  /*! \brief successors of every row, sorted */
+  std::vector<dgl_id_t> succ;
+  /*! \brief edge ids aligned with succ */
+  std::vector<dgl_id_t> edge_id;
+
+  /*! \return the positions [begin, end) of the edges from src to dst */
+  std::pair<uint64_t, uint64_t> FindRange(dgl_id_t src, dgl_id_t dst) const;
+};
+
+namespace {
+// Branchless lower bound; the loop has a fixed trip count for a given length
+// and the comparison compiles to a conditional move.
+inline const dgl_id_t* LowerBound(const dgl_id_t* first, uint64_t len, dgl_id_t val) {
+  while (len > 1) {
+    const uint64_t half = len / 2;
+    first = (first[half] < val) ? first + half : first;
+    len -= half;
+  }
+  return first + (len == 1 && *first < val);
+}
+}  // namespace
+
+std::pair<uint64_t, uint64_t> Graph::EdgeIndex::FindRange(dgl_id_t src, dgl_id_t dst) const {
+  const dgl_id_t* row = succ.data() + indptr[src];
+  const uint64_t len = indptr[src + 1] - indptr[src];
+  const uint64_t beg = LowerBound(row, len, dst) - row;
+  uint64_t end = beg;
+  while (end < len && row[end] == dst) {
+    ++end;
+  }
+  return std::make_pair(indptr[src] + beg, indptr[src] + end);
+}
+
+// O(E*log(k)), built once and reused until the next mutation
+std::shared_ptr<const Graph::EdgeIndex> Graph::GetEdgeIndex() const {
+  std::shared_ptr<const EdgeIndex> index = std::atomic_load(&edge_index_);
+  if (index) {
+    return index;
+  }
+  const int64_t num_vertices = NumVertices();
+  std::shared_ptr<EdgeIndex> rst = std::make_shared<EdgeIndex>();
+  rst->indptr.resize(num_vertices + 1);
+  rst->indptr[0] = 0;
+  for (int64_t v = 0; v < num_vertices; ++v) {
+    rst->indptr[v + 1] = rst->indptr[v] + adjlist_[v].succ.size();
+  }
+  rst->succ.resize(num_edges_);
+  rst->edge_id.resize(num_edges_);
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (int64_t v = 0; v < num_vertices; ++v) {
+    const auto& elist = adjlist_[v];
+    std::vector<std::pair<dgl_id_t, dgl_id_t>> row(elist.succ.size());
+    for (size_t i = 0; i < row.size(); ++i) {
+      row[i] = std::make_pair(elist.succ[i], elist.edge_id[i]);
+    }
+    std::sort(row.begin(), row.end());
+    const uint64_t off = rst->indptr[v];
+    for (size_t i = 0; i < row.size(); ++i) {
+      rst->succ[off + i] = row[i].first;
+      rst->edge_id[off + i] = row[i].second;
+    }
+  }
+  // Concurrent builders produce the same index, so the last store wins.
+  index = rst;
+  std::atomic_store(&edge_index_, index);
+  return index;
+}
+
 void Graph::AddVertices(uint64_t num_vertices) {
   CHECK(!read_only_) << "Graph is read-only. Mutations are not allowed.";
+  edge_index_.reset();
   adjlist_.resize(adjlist_.size() + num_vertices);
   reverse_adjlist_.resize(reverse_adjlist_.size() + num_vertices);
 }
@@ -24,6 +97,7 @@ void Graph::AddEdge(dgl_id_t src, dgl_id_t dst) {
     << "Invalid vertices: src=" << src << " dst=" << dst;
 
   dgl_id_t eid = num_edges_++;
+  edge_index_.reset();
 
   adjlist_[src].succ.push_back(dst);
   adjlist_[src].edge_id.push_back(eid);
@@ -74,88 +148,79 @@ BoolArray Graph::HasVertices(IdArray vids) const {
   return rst;
 }
 
-// O(E)
+// O(log(k)) if the edge index exists, O(k) otherwise
 bool Graph::HasEdgeBetween(dgl_id_t src, dgl_id_t dst) const {
   if (!HasVertex(src) || !HasVertex(dst)) return false;
+  std::shared_ptr<const EdgeIndex> index = std::atomic_load(&edge_index_);
+  if (index) {
+    const auto range = index->FindRange(src, dst);
+    return range.first != range.second;
+  }
   const auto& succ = adjlist_[src].succ;
   return std::find(succ.begin(), succ.end(), dst) != succ.end();
 }
 
-// O(E*k) pretty slow
+// O(n*log(k)) after building the edge index
 BoolArray Graph::HasEdgesBetween(IdArray src_ids, IdArray dst_ids) const {
   CHECK(IsValidIdArray(src_ids)) << "Invalid src id array.";
   CHECK(IsValidIdArray(dst_ids)) << "Invalid dst id array.";
   const auto srclen = src_ids->shape[0];
   const auto dstlen = dst_ids->shape[0];
+  CHECK((srclen == dstlen) || (srclen == 1) || (dstlen == 1))
+    << "Invalid src and dst id array.";
   const auto rstlen = std::max(srclen, dstlen);
+  const int64_t src_stride = (srclen == 1) ? 0 : 1;
+  const int64_t dst_stride = (dstlen == 1) ? 0 : 1;
   BoolArray rst = BoolArray::Empty({rstlen}, src_ids->dtype, src_ids->ctx);
   int64_t* rst_data = static_cast<int64_t*>(rst->data);
   const int64_t* src_data = static_cast<int64_t*>(src_ids->data);
   const int64_t* dst_data = static_cast<int64_t*>(dst_ids->data);
-  if (srclen == 1) {
-    // one-many
-    for (int64_t i = 0; i < dstlen; ++i) {
-      rst_data[i] = HasEdgeBetween(src_data[0], dst_data[i])? 1 : 0;
-    }
-  } else if (dstlen == 1) {
-    // many-one
-    for (int64_t i = 0; i < srclen; ++i) {
-      rst_data[i] = HasEdgeBetween(src_data[i], dst_data[0])? 1 : 0;
-    }
-  } else {
-    // many-many
-    CHECK(srclen == dstlen) << "Invalid src and dst id array.";
-    for (int64_t i = 0; i < srclen; ++i) {
-      rst_data[i] = HasEdgeBetween(src_data[i], dst_data[i])? 1 : 0;
+  const std::shared_ptr<const EdgeIndex> index = GetEdgeIndex();
+#pragma omp parallel for if (rstlen > 1024)
+  for (int64_t i = 0; i < rstlen; ++i) {
+    const dgl_id_t src = src_data[i * src_stride], dst = dst_data[i * dst_stride];
+    if (!HasVertex(src) || !HasVertex(dst)) {
+      rst_data[i] = 0;
+    } else {
+      const auto range = index->FindRange(src, dst);
+      rst_data[i] = (range.first != range.second)? 1 : 0;
     }
   }
   return rst;
 }
 
-// The data is copy-out; support zero-copy?
 IdArray Graph::Predecessors(dgl_id_t vid, uint64_t radius) const {
   CHECK(HasVertex(vid)) << "invalid vertex: " << vid;
   CHECK(radius >= 1) << "invalid radius: " << radius;
-  std::set<dgl_id_t> vset;
-
-  for (auto& it : reverse_adjlist_[vid].succ)
-    vset.insert(it);
-
-  const int64_t len = vset.size();
-  IdArray rst = IdArray::Empty({len}, DLDataType{kDLInt, 64, 1}, DLContext{kDLCPU, 0});
-  int64_t* rst_data = static_cast<int64_t*>(rst->data);
-
-  std::copy(vset.begin(), vset.end(), rst_data);
-  return rst;
+  const auto vset = traverse::KHopNeighbors(NumVertices(), vid, radius,
+      [this] (dgl_id_t v) -> const std::vector<dgl_id_t>& { return reverse_adjlist_[v].succ; });
+  return CopyVectorToNDArray(vset);
 }
 
-// The data is copy-out; support zero-copy?
 IdArray Graph::Successors(dgl_id_t vid, uint64_t radius) const {
   CHECK(HasVertex(vid)) << "invalid vertex: " << vid;
   CHECK(radius >= 1) << "invalid radius: " << radius;
-  std::set<dgl_id_t> vset;
-
-  for (auto& it : adjlist_[vid].succ)
-    vset.insert(it);
-
-  const int64_t len = vset.size();
-  IdArray rst = IdArray::Empty({len}, DLDataType{kDLInt, 64, 1}, DLContext{kDLCPU, 0});
-  int64_t* rst_data = static_cast<int64_t*>(rst->data);
-
-  std::copy(vset.begin(), vset.end(), rst_data);
-  return rst;
+  const auto vset = traverse::KHopNeighbors(NumVertices(), vid, radius,
+      [this] (dgl_id_t v) -> const std::vector<dgl_id_t>& { return adjlist_[v].succ; });
+  return CopyVectorToNDArray(vset);
 }
 
-// O(E)
+// O(log(k)) if the edge index exists, O(k) otherwise
 IdArray Graph::EdgeId(dgl_id_t src, dgl_id_t dst) const {
   CHECK(HasVertex(src) && HasVertex(dst)) << "invalid edge: " << src << " -> " << dst;
 
-  const auto& succ = adjlist_[src].succ;
   std::vector<dgl_id_t> edgelist;
-
-  for (size_t i = 0; i < succ.size(); ++i) {
-    if (succ[i] == dst)
-      edgelist.push_back(adjlist_[src].edge_id[i]);
+  std::shared_ptr<const EdgeIndex> index = std::atomic_load(&edge_index_);
+  if (index) {
+    const auto range = index->FindRange(src, dst);
+    edgelist.assign(index->edge_id.begin() + range.first,
+                    index->edge_id.begin() + range.second);
+  } else {
+    const auto& succ = adjlist_[src].succ;
+    for (size_t i = 0; i < succ.size(); ++i) {
+      if (succ[i] == dst)
+        edgelist.push_back(adjlist_[src].edge_id[i]);
+    }
   }
 
   // FIXME: signed?  Also it seems that we are using int64_t everywhere...
@@ -169,39 +234,41 @@ IdArray Graph::EdgeId(dgl_id_t src, dgl_id_t dst) const {
   return rst;
 }
 
-// O(E*k) pretty slow
+// O(n*log(k)) after building the edge index
 Graph::EdgeArray Graph::EdgeIds(IdArray src_ids, IdArray dst_ids) const {
   CHECK(IsValidIdArray(src_ids)) << "Invalid src id array.";
   CHECK(IsValidIdArray(dst_ids)) << "Invalid dst id array.";
   const auto srclen = src_ids->shape[0];
   const auto dstlen = dst_ids->shape[0];
-  int64_t i, j;
 
   CHECK((srclen == dstlen) || (srclen == 1) || (dstlen == 1))
     << "Invalid src and dst id array.";
 
+  const int64_t len = std::max(srclen, dstlen);
   const int64_t src_stride = (srclen == 1 && dstlen != 1) ? 0 : 1;
   const int64_t dst_stride = (dstlen == 1 && srclen != 1) ? 0 : 1;
   const int64_t* src_data = static_cast<int64_t*>(src_ids->data);
   const int64_t* dst_data = static_cast<int64_t*>(dst_ids->data);
+  const std::shared_ptr<const EdgeIndex> index = GetEdgeIndex();
 
-  std::vector<dgl_id_t> src, dst, eid;
-
-  for (i = 0, j = 0; i < srclen && j < dstlen; i += src_stride, j += dst_stride) {
-    const dgl_id_t src_id = src_data[i], dst_id = dst_data[j];
+  for (int64_t i = 0; i < len; ++i) {
+    const dgl_id_t src_id = src_data[i * src_stride], dst_id = dst_data[i * dst_stride];
     CHECK(HasVertex(src_id) && HasVertex(dst_id)) <<
         "invalid edge: " << src_id << " -> " << dst_id;
-    const auto& succ = adjlist_[src_id].succ;
-    for (size_t k = 0; k < succ.size(); ++k) {
-      if (succ[k] == dst_id) {
-        src.push_back(src_id);
-        dst.push_back(dst_id);
-        eid.push_back(adjlist_[src_id].edge_id[k]);
-      }
-    }
   }
 
-  int64_t rstlen = src.size();
+  // First pass finds the run of every pair, second pass copies them out.
+  std::vector<std::pair<uint64_t, uint64_t>> ranges(len);
+#pragma omp parallel for if (len > 1024)
+  for (int64_t i = 0; i < len; ++i) {
+    ranges[i] = index->FindRange(src_data[i * src_stride], dst_data[i * dst_stride]);
+  }
+  std::vector<int64_t> offsets(len + 1, 0);
+  for (int64_t i = 0; i < len; ++i) {
+    offsets[i + 1] = offsets[i] + (ranges[i].second - ranges[i].first);
+  }
+
+  int64_t rstlen = offsets[len];
   IdArray rst_src = IdArray::Empty({rstlen}, src_ids->dtype, src_ids->ctx);
   IdArray rst_dst = IdArray::Empty({rstlen}, src_ids->dtype, src_ids->ctx);
   IdArray rst_eid = IdArray::Empty({rstlen}, src_ids->dtype, src_ids->ctx);
@@ -209,13 +276,106 @@ Graph::EdgeArray Graph::EdgeIds(IdArray src_ids, IdArray dst_ids) const {
   int64_t* rst_dst_data = static_cast<int64_t*>(rst_dst->data);
   int64_t* rst_eid_data = static_cast<int64_t*>(rst_eid->data);
 
-  std::copy(src.begin(), src.end(), rst_src_data);
-  std::copy(dst.begin(), dst.end(), rst_dst_data);
-  std::copy(eid.begin(), eid.end(), rst_eid_data);
+#pragma omp parallel for if (len > 1024)
+  for (int64_t i = 0; i < len; ++i) {
+    const int64_t off = offsets[i], cnt = offsets[i + 1] - offsets[i];
+    std::fill(rst_src_data + off, rst_src_data + off + cnt, src_data[i * src_stride]);
+    std::fill(rst_dst_data + off, rst_dst_data + off + cnt, dst_data[i * dst_stride]);
+    std::copy(index->edge_id.begin() + ranges[i].first,
+              index->edge_id.begin() + ranges[i].second, rst_eid_data + off);
+  }
 
   return EdgeArray{rst_src, rst_dst, rst_eid};
 }
 
+void Graph::BatchQuery(IdArray ops, IdArray arg0, IdArray arg1, IdArray out) const {
+  CHECK(IsValidIdArray(ops)) << "Invalid query op array.";
+  CHECK(IsValidIdArray(arg0)) << "Invalid query argument array.";
+  CHECK(IsValidIdArray(arg1)) << "Invalid query argument array.";
+  CHECK(IsValidIdArray(out)) << "Invalid query result array.";
+  const int64_t len = ops->shape[0];
+  CHECK_EQ(arg0->shape[0], len) << "Query argument array has a wrong length.";
+  CHECK_EQ(arg1->shape[0], len) << "Query argument array has a wrong length.";
+  CHECK_EQ(out->shape[0], len) << "Query result array has a wrong length.";
+  const int64_t* ops_data = static_cast<int64_t*>(ops->data);
+  const int64_t* arg0_data = static_cast<int64_t*>(arg0->data);
+  const int64_t* arg1_data = static_cast<int64_t*>(arg1->data);
+  int64_t* out_data = static_cast<int64_t*>(out->data);
+
+  bool need_index = false;
+  for (int64_t i = 0; i < len; ++i) {
+    const int64_t op = ops_data[i];
+    const dgl_id_t a0 = arg0_data[i], a1 = arg1_data[i];
+    switch (op) {
+      case kQueryHasVertex:
+        break;
+      case kQueryHasEdgeBetween:
+        need_index = true;
+        break;
+      case kQueryInDegree:
+      case kQueryOutDegree:
+        CHECK(HasVertex(a0)) << "invalid vertex: " << a0;
+        break;
+      case kQueryEdgeId:
+      case kQueryNumEdgesBetween:
+        CHECK(HasVertex(a0) && HasVertex(a1)) << "invalid edge: " << a0 << " -> " << a1;
+        need_index = true;
+        break;
+      case kQueryEdgeSrc:
+      case kQueryEdgeDst:
+        CHECK_LT(a0, num_edges_) << "invalid edge id: " << a0;
+        break;
+      default:
+        LOG(FATAL) << "invalid query op: " << op;
+    }
+  }
+  std::shared_ptr<const EdgeIndex> index;
+  if (need_index) {
+    index = GetEdgeIndex();
+  }
+
+#pragma omp parallel for if (len > 1024)
+  for (int64_t i = 0; i < len; ++i) {
+    const dgl_id_t a0 = arg0_data[i], a1 = arg1_data[i];
+    switch (ops_data[i]) {
+      case kQueryHasVertex:
+        out_data[i] = HasVertex(a0)? 1 : 0;
+        break;
+      case kQueryHasEdgeBetween:
+        if (!HasVertex(a0) || !HasVertex(a1)) {
+          out_data[i] = 0;
+        } else {
+          const auto range = index->FindRange(a0, a1);
+          out_data[i] = (range.first != range.second)? 1 : 0;
+        }
+        break;
+      case kQueryInDegree:
+        out_data[i] = reverse_adjlist_[a0].succ.size();
+        break;
+      case kQueryOutDegree:
+        out_data[i] = adjlist_[a0].succ.size();
+        break;
+      case kQueryEdgeId: {
+        // runs are sorted by edge id, so the first one is the smallest
+        const auto range = index->FindRange(a0, a1);
+        out_data[i] = (range.first != range.second)? index->edge_id[range.first] : -1;
+        break;
+      }
+      case kQueryNumEdgesBetween: {
+        const auto range = index->FindRange(a0, a1);
+        out_data[i] = range.second - range.first;
+        break;
+      }
+      case kQueryEdgeSrc:
+        out_data[i] = all_edges_src_[a0];
+        break;
+      case kQueryEdgeDst:
+        out_data[i] = all_edges_dst_[a0];
+        break;
+    }
+  }
+}
+
 Graph::EdgeArray Graph::FindEdges(IdArray eids) const {
   int64_t len = eids->shape[0];
 
@@ -340,27 +500,43 @@ Graph::EdgeArray Graph::Edges(bool sorted) const {
   IdArray eid = IdArray::Empty({len}, DLDataType{kDLInt, 64, 1}, DLContext{kDLCPU, 0});
 
   if (sorted) {
-    typedef std::tuple<int64_t, int64_t, int64_t> Tuple;
-    std::vector<Tuple> tuples;
-    tuples.reserve(len);
-    for (uint64_t eid = 0; eid < num_edges_; ++eid) {
-      tuples.emplace_back(all_edges_src_[eid], all_edges_dst_[eid], eid);
-    }
-    // sort according to src and dst ids
-    std::sort(tuples.begin(), tuples.end(),
-        [] (const Tuple& t1, const Tuple& t2) {
-          return std::get<0>(t1) < std::get<0>(t2)
-            || (std::get<0>(t1) == std::get<0>(t2) && std::get<1>(t1) < std::get<1>(t2));
-        });
-
-    // make return arrays
     int64_t* src_ptr = static_cast<int64_t*>(src->data);
     int64_t* dst_ptr = static_cast<int64_t*>(dst->data);
     int64_t* eid_ptr = static_cast<int64_t*>(eid->data);
-    for (size_t i = 0; i < tuples.size(); ++i) {
-      src_ptr[i] = std::get<0>(tuples[i]);
-      dst_ptr[i] = std::get<1>(tuples[i]);
-      eid_ptr[i] = std::get<2>(tuples[i]);
+    const int vid_bits = NumKeyBits(NumVertices() > 0 ? NumVertices() - 1 : 0);
+    if (2 * vid_bits <= 64) {
+      // Sort (src, dst) packed into one key; the eids follow as values.
+      std::vector<uint64_t> keys(len);
+#pragma omp parallel for
+      for (int64_t i = 0; i < len; ++i) {
+        keys[i] = (all_edges_src_[i] << vid_bits) | all_edges_dst_[i];
+        eid_ptr[i] = i;
+      }
+      ParallelRadixSortPairs(keys.data(), eid_ptr, len, 2 * vid_bits);
+      const uint64_t dst_mask = (1ULL << vid_bits) - 1;
+#pragma omp parallel for
+      for (int64_t i = 0; i < len; ++i) {
+        src_ptr[i] = keys[i] >> vid_bits;
+        dst_ptr[i] = keys[i] & dst_mask;
+      }
+    } else {
+      // The ids do not fit in one key; sort by dst, then stably by src.
+      std::vector<uint64_t> keys(all_edges_dst_.begin(), all_edges_dst_.end());
+#pragma omp parallel for
+      for (int64_t i = 0; i < len; ++i) {
+        eid_ptr[i] = i;
+      }
+      ParallelRadixSortPairs(keys.data(), eid_ptr, len, vid_bits);
+#pragma omp parallel for
+      for (int64_t i = 0; i < len; ++i) {
+        keys[i] = all_edges_src_[eid_ptr[i]];
+      }
+      ParallelRadixSortPairs(keys.data(), eid_ptr, len, vid_bits);
+#pragma omp parallel for
+      for (int64_t i = 0; i < len; ++i) {
+        src_ptr[i] = all_edges_src_[eid_ptr[i]];
+        dst_ptr[i] = all_edges_dst_[eid_ptr[i]];
+      }
     }
   } else {
     int64_t* src_ptr = static_cast<int64_t*>(src->data);
@@ -469,9 +645,16 @@ Subgraph Graph::EdgeSubgraph(IdArray eids) const {
   return rst;
 }
 
+// O(1)
 Graph Graph::Reverse() const {
-  LOG(FATAL) << "not implemented";
-  return *this;
+  Graph rg(is_multigraph_);
+  rg.adjlist_ = reverse_adjlist_;
+  rg.reverse_adjlist_ = adjlist_;
+  rg.all_edges_src_ = all_edges_dst_;
+  rg.all_edges_dst_ = all_edges_src_;
+  rg.read_only_ = read_only_;
+  rg.num_edges_ = num_edges_;
+  return rg;
 }
 
 }  // namespace dgl
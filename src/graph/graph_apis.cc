@@ -5,6 +5,7 @@
  */
 #include <dgl/graph.h>
 #include <dgl/graph_op.h>
+#include <dgl/immutable_graph.h>
 #include "../c_api_common.h"
 #include "graph/skg_graph.h"
 
@@ -54,6 +55,11 @@ PackedFunc ConvertSubgraphToPackedFunc(const Subgraph& sg) {
   return PackedFunc(body);
 }
 
+// Convert CSR structure to PackedFunc.
+PackedFunc ConvertCSRToPackedFunc(const ImmutableGraph::CSR& csr) {
+  return ConvertNDArrayVectorToPackedFunc({csr.indptr, csr.indices, csr.edge_ids});
+}
+
 }  // namespace
 
 DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLGraphCreate")
@@ -122,6 +128,77 @@ DGL_REGISTER_GLOBAL("skg_graph._CAPI_SKGGraphPrNbrInfo")
     gptr->PrNbrInfo(vstr,vlabel,hop);
   });
 
+DGL_REGISTER_GLOBAL("skg_graph._CAPI_SKGGraphGenDegreeIndex")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    SkgGraph* gptr = static_cast<SkgGraph*>(args[0]);
+    gptr->GenDegreeIndex();
+  });
+
+DGL_REGISTER_GLOBAL("skg_graph._CAPI_SKGGraphPredecessors")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    SkgGraph* gptr = static_cast<SkgGraph*>(args[0]);
+    const dgl_id_t vid = args[1];
+    const int radius = args[2];
+    *rv = CopyVectorToNDArray(gptr->Predecessors(std::to_string(vid).c_str(), radius));
+  });
+
+DGL_REGISTER_GLOBAL("skg_graph._CAPI_SKGGraphSuccessors")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    SkgGraph* gptr = static_cast<SkgGraph*>(args[0]);
+    const dgl_id_t vid = args[1];
+    const int radius = args[2];
+    *rv = CopyVectorToNDArray(gptr->Successors(std::to_string(vid).c_str(), radius));
+  });
+
+DGL_REGISTER_GLOBAL("skg_graph._CAPI_SKGGraphInDegrees")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    SkgGraph* gptr = static_cast<SkgGraph*>(args[0]);
+    const IdArray vids = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[1]));
+    *rv = gptr->InDegrees(vids);
+  });
+
+DGL_REGISTER_GLOBAL("skg_graph._CAPI_SKGGraphOutDegrees")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    SkgGraph* gptr = static_cast<SkgGraph*>(args[0]);
+    const IdArray vids = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[1]));
+    *rv = gptr->OutDegrees(vids);
+  });
+
+DGL_REGISTER_GLOBAL("skg_graph._CAPI_SKGGraphSetVertexAttr")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    SkgGraph* gptr = static_cast<SkgGraph*>(args[0]);
+    const std::string column = args[1];
+    const IdArray vids = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[2]));
+    const NDArray values = NDArray::FromDLPack(CreateTmpDLManagedTensor(args[3]));
+    gptr->SetVertexAttr(column, vids, values);
+  });
+
+DGL_REGISTER_GLOBAL("skg_graph._CAPI_SKGGraphGetVertexAttr")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    SkgGraph* gptr = static_cast<SkgGraph*>(args[0]);
+    const std::string column = args[1];
+    const IdArray vids = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[2]));
+    *rv = gptr->GetVertexAttr(column, vids);
+  });
+
+DGL_REGISTER_GLOBAL("skg_graph._CAPI_SKGGraphGetVertexAttrs")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    SkgGraph* gptr = static_cast<SkgGraph*>(args[0]);
+    const std::string joined = args[1];
+    const IdArray vids = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[2]));
+    // the column names are passed as one comma-separated string
+    std::vector<std::string> columns;
+    StringUtils::split(joined, ',', columns);
+    *rv = gptr->GetVertexAttrs(columns, vids);
+  });
+
+DGL_REGISTER_GLOBAL("skg_graph._CAPI_SKGGraphVertexAttrView")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    SkgGraph* gptr = static_cast<SkgGraph*>(args[0]);
+    const std::string column = args[1];
+    *rv = gptr->VertexAttrView(column);
+  });
+
 DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLGraphFree")
 .set_body([] (DGLArgs args, DGLRetValue* rv) {
     GraphHandle ghandle = args[0];
@@ -316,6 +393,17 @@ DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLGraphEdges")
     *rv = ConvertEdgeArrayToPackedFunc(gptr->Edges(sorted));
   });
 
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLGraphBatchQuery")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ghandle = args[0];
+    const Graph* gptr = static_cast<Graph*>(ghandle);
+    const IdArray ops = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[1]));
+    const IdArray arg0 = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[2]));
+    const IdArray arg1 = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[3]));
+    IdArray out = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[4]));
+    gptr->BatchQuery(ops, arg0, arg1, out);
+  });
+
 DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLGraphInDegree")
 .set_body([] (DGLArgs args, DGLRetValue* rv) {
     GraphHandle ghandle = args[0];
@@ -416,6 +504,38 @@ DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLDisjointPartitionBySizes")
     *rv = ptr_array;
   });
 
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableDisjointUnion")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    void* list = args[0];
+    GraphHandle* inhandles = static_cast<GraphHandle*>(list);
+    int list_size = args[1];
+    std::vector<const ImmutableGraph*> graphs;
+    for (int i = 0; i < list_size; ++i) {
+      const ImmutableGraph* gr = static_cast<const ImmutableGraph*>(inhandles[i]);
+      graphs.push_back(gr);
+    }
+    ImmutableGraph* igptr = new ImmutableGraph(GraphOp::DisjointUnion(std::move(graphs)));
+    GraphHandle ighandle = igptr;
+    *rv = ighandle;
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableDisjointPartitionBySizes")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const IdArray sizes = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[1]));
+    std::vector<ImmutableGraph>&& rst = GraphOp::DisjointPartitionBySizes(igptr, sizes);
+    // return the pointer array as an integer array
+    const int64_t len = rst.size();
+    NDArray ptr_array = NDArray::Empty({len}, DLDataType{kDLInt, 64, 1}, DLContext{kDLCPU, 0});
+    int64_t* ptr_array_data = static_cast<int64_t*>(ptr_array->data);
+    for (size_t i = 0; i < rst.size(); ++i) {
+      ImmutableGraph* ptr = new ImmutableGraph(std::move(rst[i]));
+      ptr_array_data[i] = reinterpret_cast<std::intptr_t>(ptr);
+    }
+    *rv = ptr_array;
+  });
+
 DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLGraphLineGraph")
 .set_body([] (DGLArgs args, DGLRetValue* rv) {
     GraphHandle ghandle = args[0];
@@ -427,4 +547,195 @@ DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLGraphLineGraph")
     *rv = lghandle;
   });
 
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphLineGraph")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    bool backtracking = args[1];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    ImmutableGraph* lgptr = new ImmutableGraph(GraphOp::LineGraph(igptr, backtracking));
+    GraphHandle lghandle = lgptr;
+    *rv = lghandle;
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLGraphReverse")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ghandle = args[0];
+    const Graph* gptr = static_cast<Graph*>(ghandle);
+    Graph* rgptr = new Graph();
+    *rgptr = gptr->Reverse();
+    GraphHandle rghandle = rgptr;
+    *rv = rghandle;
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLGraphSave")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ghandle = args[0];
+    const Graph* gptr = static_cast<Graph*>(ghandle);
+    const std::string filename = args[1];
+    ImmutableGraph::FromGraph(*gptr).Save(filename);
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLGraphLoad")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    const std::string filename = args[0];
+    const bool verify = args[1];
+    ImmutableGraph* igptr = new ImmutableGraph(ImmutableGraph::Load(filename, verify));
+    GraphHandle ighandle = igptr;
+    *rv = ighandle;
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphFree")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    delete igptr;
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphToGraph")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    Graph* gptr = new Graph();
+    *gptr = igptr->ToGraph();
+    GraphHandle ghandle = gptr;
+    *rv = ghandle;
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphSave")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const std::string filename = args[1];
+    igptr->Save(filename);
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphIsMultigraph")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    *rv = igptr->IsMultigraph();
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphNumVertices")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    *rv = static_cast<int64_t>(igptr->NumVertices());
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphNumEdges")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    *rv = static_cast<int64_t>(igptr->NumEdges());
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphHasEdgeBetween")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const dgl_id_t src = args[1];
+    const dgl_id_t dst = args[2];
+    *rv = igptr->HasEdgeBetween(src, dst);
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphHasEdgesBetween")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const IdArray src = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[1]));
+    const IdArray dst = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[2]));
+    *rv = igptr->HasEdgesBetween(src, dst);
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphPredecessors")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const dgl_id_t vid = args[1];
+    const uint64_t radius = args[2];
+    *rv = igptr->Predecessors(vid, radius);
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphSuccessors")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const dgl_id_t vid = args[1];
+    const uint64_t radius = args[2];
+    *rv = igptr->Successors(vid, radius);
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphInEdges")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const dgl_id_t vid = args[1];
+    *rv = ConvertEdgeArrayToPackedFunc(igptr->InEdges(vid));
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphOutEdges")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const dgl_id_t vid = args[1];
+    *rv = ConvertEdgeArrayToPackedFunc(igptr->OutEdges(vid));
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphEdges")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    *rv = ConvertEdgeArrayToPackedFunc(igptr->Edges());
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphInDegree")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const dgl_id_t vid = args[1];
+    *rv = static_cast<int64_t>(igptr->InDegree(vid));
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphInDegrees")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const IdArray vids = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[1]));
+    *rv = igptr->InDegrees(vids);
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphOutDegree")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const dgl_id_t vid = args[1];
+    *rv = static_cast<int64_t>(igptr->OutDegree(vid));
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphOutDegrees")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const IdArray vids = IdArray::FromDLPack(CreateTmpDLManagedTensor(args[1]));
+    *rv = igptr->OutDegrees(vids);
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphReverse")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    ImmutableGraph* rigptr = new ImmutableGraph(igptr->Reverse());
+    GraphHandle righandle = rigptr;
+    *rv = righandle;
+  });
+
+DGL_REGISTER_GLOBAL("graph_index._CAPI_DGLImmutableGraphGetCSR")
+.set_body([] (DGLArgs args, DGLRetValue* rv) {
+    GraphHandle ighandle = args[0];
+    const ImmutableGraph* igptr = static_cast<ImmutableGraph*>(ighandle);
+    const bool transpose = args[1];
+    *rv = ConvertCSRToPackedFunc(transpose ? igptr->GetInCSR() : igptr->GetOutCSR());
+  });
+
 }  // namespace dgl
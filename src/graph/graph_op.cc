@@ -4,7 +4,12 @@
  * \brief Graph operation implementation
  */
 #include <dgl/graph_op.h>
+#include <dgl/runtime/c_backend_api.h>
 #include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace dgl {
 namespace {
@@ -12,37 +17,307 @@ inline bool IsValidIdArray(const IdArray& arr) {
   return arr->ctx.device_type == kDLCPU && arr->ndim == 1
     && arr->dtype.code == kDLInt && arr->dtype.bits == 64;
 }
+
+inline IdArray NewIdArray(int64_t len) {
+  return IdArray::Empty({len}, DLDataType{kDLInt, 64, 1}, DLContext{kDLCPU, 0});
+}
+
+// Copy an id segment while adding a constant offset. Ids are unsigned, so
+// subtracting is done by passing the two's complement of the offset.
+// The loop is kept trivial so that it is vectorized.
+template<typename IdType>
+inline void CopyWithOffset(const IdType* src, int64_t len, IdType offset, IdType* dst) {
+#pragma omp simd
+  for (int64_t i = 0; i < len; ++i) {
+    dst[i] = src[i] + offset;
+  }
+}
+
+// Copy one adjacency row, relabeling both the vertex and the edge ids.
+template<typename EdgeList>
+inline void CopyEdgeListWithOffset(const EdgeList& src, dgl_id_t voff, dgl_id_t eoff,
+                                   EdgeList* dst) {
+  const int64_t len = src.succ.size();
+  dst->succ.resize(len);
+  dst->edge_id.resize(len);
+  CopyWithOffset(src.succ.data(), len, voff, dst->succ.data());
+  CopyWithOffset(src.edge_id.data(), len, eoff, dst->edge_id.data());
+}
+
+// Concatenate the CSRs of several graphs, relabeling rows, neighbors and edges.
+ImmutableGraph::CSRPtr UnionCSR(const std::vector<const ImmutableGraph::CSR*>& csrs,
+                                const std::vector<dgl_id_t>& vertex_offsets,
+                                const std::vector<dgl_id_t>& edge_offsets) {
+  const int64_t num_graphs = csrs.size();
+  const int64_t num_vertices = vertex_offsets[num_graphs];
+  const int64_t num_edges = edge_offsets[num_graphs];
+  ImmutableGraph::CSRPtr rst = std::make_shared<ImmutableGraph::CSR>();
+  rst->indptr = NewIdArray(num_vertices + 1);
+  rst->indices = NewIdArray(num_edges);
+  rst->edge_ids = NewIdArray(num_edges);
+  int64_t* indptr_data = static_cast<int64_t*>(rst->indptr->data);
+  int64_t* indices_data = static_cast<int64_t*>(rst->indices->data);
+  int64_t* eid_data = static_cast<int64_t*>(rst->edge_ids->data);
+  indptr_data[num_vertices] = num_edges;
+#pragma omp parallel for schedule(dynamic, 16)
+  for (int64_t i = 0; i < num_graphs; ++i) {
+    const ImmutableGraph::CSR& csr = *csrs[i];
+    const int64_t voff = vertex_offsets[i], eoff = edge_offsets[i];
+    CopyWithOffset(static_cast<int64_t*>(csr.indptr->data), csr.NumVertices(), eoff,
+                   indptr_data + voff);
+    CopyWithOffset(static_cast<int64_t*>(csr.indices->data), csr.NumEdges(), voff,
+                   indices_data + eoff);
+    CopyWithOffset(static_cast<int64_t*>(csr.edge_ids->data), csr.NumEdges(), eoff,
+                   eid_data + eoff);
+  }
+  return rst;
+}
+
+// Extract rows [voff, voff + num_rows) of a CSR whose edges are [ebeg, eend).
+ImmutableGraph::CSRPtr SliceCSR(const ImmutableGraph::CSR& csr, int64_t voff, int64_t num_rows,
+                                int64_t ebeg, int64_t eend) {
+  const int64_t* indptr_data = static_cast<int64_t*>(csr.indptr->data);
+  const int64_t row_beg = indptr_data[voff];
+  CHECK_EQ(indptr_data[voff + num_rows] - row_beg, eend - ebeg)
+    << "The edges of a partition must be contiguous.";
+  ImmutableGraph::CSRPtr rst = std::make_shared<ImmutableGraph::CSR>();
+  rst->indptr = NewIdArray(num_rows + 1);
+  rst->indices = NewIdArray(eend - ebeg);
+  rst->edge_ids = NewIdArray(eend - ebeg);
+  CopyWithOffset(indptr_data + voff, num_rows + 1, -row_beg,
+                 static_cast<int64_t*>(rst->indptr->data));
+  CopyWithOffset(static_cast<int64_t*>(csr.indices->data) + row_beg, eend - ebeg, -voff,
+                 static_cast<int64_t*>(rst->indices->data));
+  CopyWithOffset(static_cast<int64_t*>(csr.edge_ids->data) + row_beg, eend - ebeg, -ebeg,
+                 static_cast<int64_t*>(rst->edge_ids->data));
+  return rst;
+}
+
+// Run fn(i) for every i in [0, n) on the runtime thread pool. Chunks of
+// grain_size indices are stolen between the workers, which balances loops
+// whose cost per index is heavily skewed, e.g. by the vertex degrees.
+template<typename Fn>
+inline void ParallelForEach(int64_t n, int64_t grain_size, Fn fn) {
+  auto chunk = [] (int64_t begin, int64_t end, void* cdata) -> int {
+    Fn* f = static_cast<Fn*>(cdata);
+    try {
+      for (int64_t i = begin; i < end; ++i) {
+        (*f)(i);
+      }
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Parallel loop failed: " << e.what();
+      return -1;
+    }
+    return 0;
+  };
+  CHECK_EQ(DGLBackendParallelFor(0, n, grain_size, chunk, &fn), 0)
+    << "Parallel loop failed";
+}
+
+// Visit the line graph edges going through vertex v, i.e. (i -> w) for every
+// in-edge i and out-edge w of v. Both lists must be sorted by edge id, so the
+// edges are visited in the order of their line graph edge ids.
+template<typename Fn>
+inline void VisitLineGraphEdges(const dgl_id_t* in_src, const dgl_id_t* in_eid, int64_t in_len,
+                                const dgl_id_t* out_dst, const dgl_id_t* out_eid, int64_t out_len,
+                                bool backtracking, Fn fn) {
+  for (int64_t a = 0; a < in_len; ++a) {
+    for (int64_t b = 0; b < out_len; ++b) {
+      if (backtracking || out_dst[b] != in_src[a]) {
+        fn(in_eid[a], out_eid[b]);
+      }
+    }
+  }
+}
+
+// Return the (neighbor, edge id) lists of one CSR row, ordered by edge id.
+void SortRowByEdgeId(const ImmutableGraph::CSR& csr, dgl_id_t vid,
+                     std::vector<dgl_id_t>* nbrs, std::vector<dgl_id_t>* eids) {
+  const int64_t* indptr_data = static_cast<int64_t*>(csr.indptr->data);
+  const int64_t* indices_data = static_cast<int64_t*>(csr.indices->data);
+  const int64_t* eid_data = static_cast<int64_t*>(csr.edge_ids->data);
+  std::vector<std::pair<dgl_id_t, dgl_id_t>> row;
+  for (int64_t i = indptr_data[vid]; i < indptr_data[vid + 1]; ++i) {
+    row.emplace_back(eid_data[i], indices_data[i]);
+  }
+  std::sort(row.begin(), row.end());
+  nbrs->resize(row.size());
+  eids->resize(row.size());
+  for (size_t i = 0; i < row.size(); ++i) {
+    (*nbrs)[i] = row[i].second;
+    (*eids)[i] = row[i].first;
+  }
+}
 }  // namespace
 
+// The line graph is built in two passes over the vertices of the input graph.
+// All the line graph edges through vertex v start at an in-edge of v and end at
+// an out-edge of v, so every line graph vertex is touched by exactly one input
+// vertex and both passes run in parallel without synchronization. The first
+// pass counts the degrees, the second one fills the preallocated storage. The
+// cost of a vertex is the product of its in and out degrees, so the passes run
+// on the work-stealing loop of the thread pool.
 Graph GraphOp::LineGraph(const Graph* g, bool backtracking) {
+  const int64_t num_vertices = g->NumVertices();
+  const int64_t num_edges = g->NumEdges();
+  std::vector<uint64_t> out_degrees(num_edges, 0), in_degrees(num_edges, 0);
+  ParallelForEach(num_vertices, 64, [&] (int64_t v) {
+    const auto& in = g->reverse_adjlist_[v];
+    const auto& out = g->adjlist_[v];
+    VisitLineGraphEdges(in.succ.data(), in.edge_id.data(), in.succ.size(),
+                        out.succ.data(), out.edge_id.data(), out.succ.size(), backtracking,
+                        [&] (dgl_id_t i, dgl_id_t w) { ++out_degrees[i]; ++in_degrees[w]; });
+  });
+  std::vector<dgl_id_t> offsets(num_edges + 1, 0);
+  for (int64_t i = 0; i < num_edges; ++i) {
+    offsets[i + 1] = offsets[i] + out_degrees[i];
+  }
+
   Graph lg;
-  lg.AddVertices(g->NumEdges());
-  for (size_t i = 0; i < g->all_edges_src_.size(); ++i) {
-    const auto u = g->all_edges_src_[i];
-    const auto v = g->all_edges_dst_[i];
-    for (size_t j = 0; j < g->adjlist_[v].succ.size(); ++j) {
-      if (backtracking || (!backtracking && g->adjlist_[v].succ[j] != u)) {
-        lg.AddEdge(i, g->adjlist_[v].edge_id[j]);
-      }
+  lg.adjlist_.resize(num_edges);
+  lg.reverse_adjlist_.resize(num_edges);
+  lg.all_edges_src_.resize(offsets[num_edges]);
+  lg.all_edges_dst_.resize(offsets[num_edges]);
+  lg.num_edges_ = offsets[num_edges];
+  ParallelForEach(num_vertices, 64, [&] (int64_t v) {
+    const auto& in = g->reverse_adjlist_[v];
+    const auto& out = g->adjlist_[v];
+    for (dgl_id_t i : in.edge_id) {
+      lg.adjlist_[i].succ.reserve(out_degrees[i]);
+      lg.adjlist_[i].edge_id.reserve(out_degrees[i]);
+    }
+    for (dgl_id_t w : out.edge_id) {
+      lg.reverse_adjlist_[w].succ.reserve(in_degrees[w]);
+      lg.reverse_adjlist_[w].edge_id.reserve(in_degrees[w]);
     }
+    VisitLineGraphEdges(in.succ.data(), in.edge_id.data(), in.succ.size(),
+                        out.succ.data(), out.edge_id.data(), out.succ.size(), backtracking,
+                        [&] (dgl_id_t i, dgl_id_t w) {
+      const dgl_id_t eid = offsets[i] + lg.adjlist_[i].succ.size();
+      lg.adjlist_[i].succ.push_back(w);
+      lg.adjlist_[i].edge_id.push_back(eid);
+      lg.reverse_adjlist_[w].succ.push_back(i);
+      lg.reverse_adjlist_[w].edge_id.push_back(eid);
+      lg.all_edges_src_[eid] = i;
+      lg.all_edges_dst_[eid] = w;
+    });
+  });
+  return lg;
+}
+
+ImmutableGraph GraphOp::LineGraph(const ImmutableGraph* g, bool backtracking) {
+  const int64_t num_vertices = g->NumVertices();
+  const int64_t num_edges = g->NumEdges();
+  const ImmutableGraph::CSR& in_csr = g->GetInCSR();
+  const ImmutableGraph::CSR& out_csr = g->GetOutCSR();
+  std::vector<int64_t> out_pos(num_edges + 1, 0), in_pos(num_edges + 1, 0);
+#pragma omp parallel
+  {
+    std::vector<dgl_id_t> in_src, in_eid, out_dst, out_eid;
+#pragma omp for schedule(dynamic, 64)
+    for (int64_t v = 0; v < num_vertices; ++v) {
+      SortRowByEdgeId(in_csr, v, &in_src, &in_eid);
+      SortRowByEdgeId(out_csr, v, &out_dst, &out_eid);
+      VisitLineGraphEdges(in_src.data(), in_eid.data(), in_src.size(),
+                          out_dst.data(), out_eid.data(), out_dst.size(), backtracking,
+                          [&] (dgl_id_t i, dgl_id_t w) { ++out_pos[i + 1]; ++in_pos[w + 1]; });
+    }
+  }
+  for (int64_t i = 0; i < num_edges; ++i) {
+    out_pos[i + 1] += out_pos[i];
+    in_pos[i + 1] += in_pos[i];
   }
 
-  return lg;
+  const int64_t num_lg_edges = out_pos[num_edges];
+  ImmutableGraph::CSRPtr lg_out = std::make_shared<ImmutableGraph::CSR>();
+  ImmutableGraph::CSRPtr lg_in = std::make_shared<ImmutableGraph::CSR>();
+  for (auto csr : {lg_out, lg_in}) {
+    csr->indptr = NewIdArray(num_edges + 1);
+    csr->indices = NewIdArray(num_lg_edges);
+    csr->edge_ids = NewIdArray(num_lg_edges);
+  }
+  std::copy(out_pos.begin(), out_pos.end(), static_cast<int64_t*>(lg_out->indptr->data));
+  std::copy(in_pos.begin(), in_pos.end(), static_cast<int64_t*>(lg_in->indptr->data));
+  int64_t* out_indices = static_cast<int64_t*>(lg_out->indices->data);
+  int64_t* out_eids = static_cast<int64_t*>(lg_out->edge_ids->data);
+  int64_t* in_indices = static_cast<int64_t*>(lg_in->indices->data);
+  int64_t* in_eids = static_cast<int64_t*>(lg_in->edge_ids->data);
+  // The out-edges of line graph vertex i get consecutive edge ids in the order
+  // of their destinations, so the edge id of an out-edge is its CSR position.
+  // The in-edges are visited in the order of their sources, which keeps every
+  // row of both structures sorted.
+#pragma omp parallel
+  {
+    std::vector<dgl_id_t> in_src, in_eid, out_dst, out_eid;
+#pragma omp for schedule(dynamic, 64)
+    for (int64_t v = 0; v < num_vertices; ++v) {
+      SortRowByEdgeId(in_csr, v, &in_src, &in_eid);
+      SortRowByEdgeId(out_csr, v, &out_dst, &out_eid);
+      VisitLineGraphEdges(in_src.data(), in_eid.data(), in_src.size(),
+                          out_dst.data(), out_eid.data(), out_dst.size(), backtracking,
+                          [&] (dgl_id_t i, dgl_id_t w) {
+        const int64_t eid = out_pos[i]++;
+        out_indices[eid] = w;
+        out_eids[eid] = eid;
+        const int64_t pos = in_pos[w]++;
+        in_indices[pos] = i;
+        in_eids[pos] = eid;
+      });
+    }
+  }
+  return ImmutableGraph(lg_in, lg_out, false);
 }
 
 Graph GraphOp::DisjointUnion(std::vector<const Graph*> graphs) {
-  Graph rst;
-  uint64_t cumsum = 0;
-  for (const Graph* gr : graphs) {
-    rst.AddVertices(gr->NumVertices());
-    for (uint64_t i = 0; i < gr->NumEdges(); ++i) {
-      rst.AddEdge(gr->all_edges_src_[i] + cumsum, gr->all_edges_dst_[i] + cumsum);
+  const int64_t num_graphs = graphs.size();
+  std::vector<dgl_id_t> vertex_offsets(num_graphs + 1, 0), edge_offsets(num_graphs + 1, 0);
+  bool multigraph = false;
+  for (int64_t i = 0; i < num_graphs; ++i) {
+    vertex_offsets[i + 1] = vertex_offsets[i] + graphs[i]->NumVertices();
+    edge_offsets[i + 1] = edge_offsets[i] + graphs[i]->NumEdges();
+    multigraph = multigraph || graphs[i]->IsMultigraph();
+  }
+
+  Graph rst(multigraph);
+  rst.adjlist_.resize(vertex_offsets[num_graphs]);
+  rst.reverse_adjlist_.resize(vertex_offsets[num_graphs]);
+  rst.all_edges_src_.resize(edge_offsets[num_graphs]);
+  rst.all_edges_dst_.resize(edge_offsets[num_graphs]);
+  rst.num_edges_ = edge_offsets[num_graphs];
+
+#pragma omp parallel for schedule(dynamic, 16)
+  for (int64_t i = 0; i < num_graphs; ++i) {
+    const Graph* gr = graphs[i];
+    const dgl_id_t voff = vertex_offsets[i], eoff = edge_offsets[i];
+    for (uint64_t v = 0; v < gr->NumVertices(); ++v) {
+      CopyEdgeListWithOffset(gr->adjlist_[v], voff, eoff, &rst.adjlist_[voff + v]);
+      CopyEdgeListWithOffset(gr->reverse_adjlist_[v], voff, eoff, &rst.reverse_adjlist_[voff + v]);
     }
-    cumsum += gr->NumVertices();
+    CopyWithOffset(gr->all_edges_src_.data(), gr->NumEdges(), voff,
+                   rst.all_edges_src_.data() + eoff);
+    CopyWithOffset(gr->all_edges_dst_.data(), gr->NumEdges(), voff,
+                   rst.all_edges_dst_.data() + eoff);
   }
   return rst;
 }
 
+ImmutableGraph GraphOp::DisjointUnion(std::vector<const ImmutableGraph*> graphs) {
+  const int64_t num_graphs = graphs.size();
+  std::vector<dgl_id_t> vertex_offsets(num_graphs + 1, 0), edge_offsets(num_graphs + 1, 0);
+  bool multigraph = false;
+  std::vector<const ImmutableGraph::CSR*> in_csrs, out_csrs;
+  for (int64_t i = 0; i < num_graphs; ++i) {
+    vertex_offsets[i + 1] = vertex_offsets[i] + graphs[i]->NumVertices();
+    edge_offsets[i + 1] = edge_offsets[i] + graphs[i]->NumEdges();
+    multigraph = multigraph || graphs[i]->IsMultigraph();
+    in_csrs.push_back(&graphs[i]->GetInCSR());
+    out_csrs.push_back(&graphs[i]->GetOutCSR());
+  }
+  return ImmutableGraph(UnionCSR(in_csrs, vertex_offsets, edge_offsets),
+                        UnionCSR(out_csrs, vertex_offsets, edge_offsets),
+                        multigraph);
+}
+
 std::vector<Graph> GraphOp::DisjointPartitionByNum(const Graph* graph, int64_t num) {
   CHECK(num != 0 && graph->NumVertices() % num == 0)
     << "Number of partitions must evenly divide the number of nodes.";
@@ -55,51 +330,73 @@ std::vector<Graph> GraphOp::DisjointPartitionByNum(const Graph* graph, int64_t n
 std::vector<Graph> GraphOp::DisjointPartitionBySizes(const Graph* graph, IdArray sizes) {
   const int64_t len = sizes->shape[0];
   const int64_t* sizes_data = static_cast<int64_t*>(sizes->data);
-  std::vector<int64_t> cumsum;
-  cumsum.push_back(0);
+  std::vector<dgl_id_t> vertex_offsets(len + 1, 0), edge_offsets(len + 1, 0);
   for (int64_t i = 0; i < len; ++i) {
-    cumsum.push_back(cumsum[i] + sizes_data[i]);
+    vertex_offsets[i + 1] = vertex_offsets[i] + sizes_data[i];
   }
-  CHECK_EQ(cumsum[len], graph->NumVertices())
+  CHECK_EQ(vertex_offsets[len], graph->NumVertices())
     << "Sum of the given sizes must equal to the number of nodes.";
-  dgl_id_t node_offset = 0, edge_offset = 0;
-  std::vector<Graph> rst(len);
+  // The edges of one partition are the out-edges of its nodes.
   for (int64_t i = 0; i < len; ++i) {
-    // copy adj
-    rst[i].adjlist_.insert(rst[i].adjlist_.end(),
-        graph->adjlist_.begin() + node_offset,
-        graph->adjlist_.begin() + node_offset + sizes_data[i]);
-    rst[i].reverse_adjlist_.insert(rst[i].reverse_adjlist_.end(),
-        graph->reverse_adjlist_.begin() + node_offset,
-        graph->reverse_adjlist_.begin() + node_offset + sizes_data[i]);
-    // relabel adjs
-    size_t num_edges = 0;
-    for (auto& elist : rst[i].adjlist_) {
-      for (size_t j = 0; j < elist.succ.size(); ++j) {
-        elist.succ[j] -= node_offset;
-        elist.edge_id[j] -= edge_offset;
-      }
-      num_edges += elist.succ.size();
-    }
-    for (auto& elist : rst[i].reverse_adjlist_) {
-      for (size_t j = 0; j < elist.succ.size(); ++j) {
-        elist.succ[j] -= node_offset;
-        elist.edge_id[j] -= edge_offset;
-      }
+    uint64_t num_edges = 0;
+    for (dgl_id_t v = vertex_offsets[i]; v < vertex_offsets[i + 1]; ++v) {
+      num_edges += graph->adjlist_[v].succ.size();
     }
-    // copy edges
-    rst[i].all_edges_src_.reserve(num_edges);
-    rst[i].all_edges_dst_.reserve(num_edges);
-    rst[i].num_edges_ = num_edges;
-    for (size_t j = edge_offset; j < edge_offset + num_edges; ++j) {
-      rst[i].all_edges_src_.push_back(graph->all_edges_src_[j] - node_offset);
-      rst[i].all_edges_dst_.push_back(graph->all_edges_dst_[j] - node_offset);
+    edge_offsets[i + 1] = edge_offsets[i] + num_edges;
+  }
+  CHECK_EQ(edge_offsets[len], graph->NumEdges());
+
+  std::vector<Graph> rst(len);
+#pragma omp parallel for schedule(dynamic, 16)
+  for (int64_t i = 0; i < len; ++i) {
+    // Relabel by adding the two's complement of the offsets.
+    const dgl_id_t voff = 0 - vertex_offsets[i], eoff = 0 - edge_offsets[i];
+    const uint64_t num_edges = edge_offsets[i + 1] - edge_offsets[i];
+    Graph& part = rst[i];
+    part.is_multigraph_ = graph->is_multigraph_;
+    part.adjlist_.resize(sizes_data[i]);
+    part.reverse_adjlist_.resize(sizes_data[i]);
+    for (int64_t v = 0; v < sizes_data[i]; ++v) {
+      CopyEdgeListWithOffset(graph->adjlist_[vertex_offsets[i] + v], voff, eoff,
+                             &part.adjlist_[v]);
+      CopyEdgeListWithOffset(graph->reverse_adjlist_[vertex_offsets[i] + v], voff, eoff,
+                             &part.reverse_adjlist_[v]);
     }
-    // update offset
-    CHECK_EQ(rst[i].NumVertices(), sizes_data[i]);
-    CHECK_EQ(rst[i].NumEdges(), num_edges);
-    node_offset += sizes_data[i];
-    edge_offset += num_edges;
+    part.all_edges_src_.resize(num_edges);
+    part.all_edges_dst_.resize(num_edges);
+    part.num_edges_ = num_edges;
+    CopyWithOffset(graph->all_edges_src_.data() + edge_offsets[i], num_edges, voff,
+                   part.all_edges_src_.data());
+    CopyWithOffset(graph->all_edges_dst_.data() + edge_offsets[i], num_edges, voff,
+                   part.all_edges_dst_.data());
+  }
+  return rst;
+}
+
+std::vector<ImmutableGraph> GraphOp::DisjointPartitionBySizes(
+    const ImmutableGraph* graph, IdArray sizes) {
+  const int64_t len = sizes->shape[0];
+  const int64_t* sizes_data = static_cast<int64_t*>(sizes->data);
+  const int64_t* indptr_data = static_cast<int64_t*>(graph->GetOutCSR().indptr->data);
+  std::vector<dgl_id_t> vertex_offsets(len + 1, 0), edge_offsets(len + 1, 0);
+  for (int64_t i = 0; i < len; ++i) {
+    vertex_offsets[i + 1] = vertex_offsets[i] + sizes_data[i];
+  }
+  CHECK_EQ(vertex_offsets[len], graph->NumVertices())
+    << "Sum of the given sizes must equal to the number of nodes.";
+  for (int64_t i = 0; i <= len; ++i) {
+    edge_offsets[i] = indptr_data[vertex_offsets[i]];
+  }
+
+  std::vector<ImmutableGraph> rst;
+  rst.reserve(len);
+  for (int64_t i = 0; i < len; ++i) {
+    rst.emplace_back(
+        SliceCSR(graph->GetInCSR(), vertex_offsets[i], sizes_data[i],
+                 edge_offsets[i], edge_offsets[i + 1]),
+        SliceCSR(graph->GetOutCSR(), vertex_offsets[i], sizes_data[i],
+                 edge_offsets[i], edge_offsets[i + 1]),
+        graph->IsMultigraph());
   }
   return rst;
 }
@@ -0,0 +1,230 @@
+/*!
+ *  Copyright (c) 2018 by Contributors
+ * \file graph/graph_serialize.cc
+ * \brief Binary serialization of the immutable graph index
+ */
+#include <dgl/immutable_graph.h>
+#include <dgl/runtime/device_api.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // _WIN32
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace dgl {
+namespace {
+/*! \brief Magic number for graph file */
+constexpr uint64_t kDGLGraphMagic = 0xDD5E40F096B4A140;
+/*! \brief Current version of the graph file format */
+constexpr uint32_t kDGLGraphFormatVersion = 1;
+/*! \brief Header flag set when the graph is a multigraph */
+constexpr uint32_t kGraphFlagMultigraph = 1;
+/*! \brief Number of arrays stored in a graph file */
+constexpr int kNumGraphArrays = 6;
+
+/*! \brief Fixed-size header at the beginning of a graph file */
+struct GraphFileHeader {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t flags;
+  uint64_t num_vertices;
+  uint64_t num_edges;
+  /*! \brief checksum of all the arrays, see ArrayChecksum */
+  uint64_t checksum;
+  uint64_t reserved[3];
+};
+static_assert(sizeof(GraphFileHeader) == runtime::kAllocAlignment,
+              "Graph file header must fill exactly one alignment unit");
+
+/*!
+ * \brief Position of the arrays in a graph file.
+ *
+ * The arrays are, in order: out-CSR indptr, indices, edge ids, then in-CSR
+ * indptr, indices, edge ids. Each one starts at a kAllocAlignment boundary.
+ */
+struct GraphFileLayout {
+  uint64_t offset[kNumGraphArrays];
+  int64_t length[kNumGraphArrays];
+  uint64_t file_size;
+
+  GraphFileLayout(uint64_t num_vertices, uint64_t num_edges) {
+    const uint64_t align = runtime::kAllocAlignment;
+    uint64_t pos = sizeof(GraphFileHeader);
+    for (int i = 0; i < kNumGraphArrays; ++i) {
+      length[i] = (i % 3 == 0) ? num_vertices + 1 : num_edges;
+      offset[i] = pos;
+      pos += length[i] * sizeof(int64_t);
+      pos = (pos + align - 1) / align * align;
+    }
+    file_size = pos;
+  }
+};
+
+// FNV-1a over 64-bit words, chained across the arrays.
+uint64_t ArrayChecksum(uint64_t seed, const int64_t* data, int64_t len) {
+  uint64_t hash = seed;
+  for (int64_t i = 0; i < len; ++i) {
+    hash ^= static_cast<uint64_t>(data[i]);
+    hash *= 0x100000001B3ULL;
+  }
+  return hash;
+}
+
+#ifndef _WIN32
+/*! \brief A read-only, shared mapping of a whole file. */
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& filename) {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    CHECK_GE(fd, 0) << "Failed to open graph file: " << filename;
+    struct stat st;
+    CHECK_EQ(fstat(fd, &st), 0) << "Failed to stat graph file: " << filename;
+    size_ = st.st_size;
+    CHECK_GE(size_, sizeof(GraphFileHeader)) << "Invalid graph file: " << filename;
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    CHECK(addr != MAP_FAILED) << "Failed to map graph file: " << filename;
+    data_ = static_cast<char*>(addr);
+  }
+
+  ~MappedFile() {
+    munmap(data_, size_);
+  }
+
+  char* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+/*! \brief DLPack manager context keeping the mapping alive for one array. */
+struct MappedArrayContext {
+  std::shared_ptr<MappedFile> file;
+  int64_t shape;
+  DLManagedTensor tensor;
+};
+
+// Wrap a region of the mapping as a 1D int64 NDArray without copying.
+IdArray WrapMappedArray(std::shared_ptr<MappedFile> file, uint64_t offset, int64_t len) {
+  MappedArrayContext* ctx = new MappedArrayContext();
+  ctx->file = file;
+  ctx->shape = len;
+  DLManagedTensor* tensor = &ctx->tensor;
+  tensor->dl_tensor.data = file->data() + offset;
+  tensor->dl_tensor.ctx = DLContext{kDLCPU, 0};
+  tensor->dl_tensor.ndim = 1;
+  tensor->dl_tensor.dtype = DLDataType{kDLInt, 64, 1};
+  tensor->dl_tensor.shape = &ctx->shape;
+  tensor->dl_tensor.strides = nullptr;
+  tensor->dl_tensor.byte_offset = 0;
+  tensor->manager_ctx = ctx;
+  tensor->deleter = [] (DLManagedTensor* self) {
+    delete static_cast<MappedArrayContext*>(self->manager_ctx);
+  };
+  return IdArray::FromDLPack(tensor);
+}
+#endif  // _WIN32
+}  // namespace
+
+void ImmutableGraph::Save(const std::string& filename) const {
+  const IdArray arrays[kNumGraphArrays] = {
+    out_csr_->indptr, out_csr_->indices, out_csr_->edge_ids,
+    in_csr_->indptr, in_csr_->indices, in_csr_->edge_ids,
+  };
+  GraphFileLayout layout(NumVertices(), NumEdges());
+
+  GraphFileHeader header;
+  std::fill(reinterpret_cast<char*>(&header),
+            reinterpret_cast<char*>(&header) + sizeof(header), 0);
+  header.magic = kDGLGraphMagic;
+  header.version = kDGLGraphFormatVersion;
+  header.flags = is_multigraph_ ? kGraphFlagMultigraph : 0;
+  header.num_vertices = NumVertices();
+  header.num_edges = NumEdges();
+  header.checksum = kDGLGraphMagic;
+  for (int i = 0; i < kNumGraphArrays; ++i) {
+    CHECK_EQ(arrays[i]->shape[0], layout.length[i]) << "Inconsistent CSR arrays.";
+    header.checksum = ArrayChecksum(header.checksum,
+        static_cast<int64_t*>(arrays[i]->data), layout.length[i]);
+  }
+
+  std::ofstream fs(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  CHECK(fs.is_open()) << "Failed to open graph file: " << filename;
+  fs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  const std::vector<char> padding(runtime::kAllocAlignment, 0);
+  for (int i = 0; i < kNumGraphArrays; ++i) {
+    const uint64_t pos = fs.tellp();
+    CHECK_LE(pos, layout.offset[i]);
+    fs.write(padding.data(), layout.offset[i] - pos);
+    fs.write(static_cast<const char*>(arrays[i]->data), layout.length[i] * sizeof(int64_t));
+  }
+  const uint64_t pos = fs.tellp();
+  fs.write(padding.data(), layout.file_size - pos);
+  CHECK(fs.good()) << "Failed to write graph file: " << filename;
+}
+
+ImmutableGraph ImmutableGraph::Load(const std::string& filename, bool verify) {
+#ifdef _WIN32
+  LOG(FATAL) << "Loading graph files is not supported on Windows.";
+  return ImmutableGraph(nullptr, nullptr, false);
+#else
+  std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(filename);
+  const GraphFileHeader* header = reinterpret_cast<const GraphFileHeader*>(file->data());
+  CHECK_EQ(header->magic, kDGLGraphMagic) << "Invalid graph file: " << filename;
+  CHECK_EQ(header->version, kDGLGraphFormatVersion)
+    << "Unsupported graph file version " << header->version << ": " << filename;
+  // Every array holds num_vertices + 1 or num_edges words, so sizes beyond the
+  // number of words in the file are corrupt. Checking them first also keeps
+  // the offsets computed by the layout from overflowing.
+  const uint64_t num_words = file->size() / sizeof(int64_t);
+  CHECK_LT(header->num_vertices, num_words)
+    << "Invalid number of vertices " << header->num_vertices << " in graph file: " << filename;
+  CHECK_LE(header->num_edges, num_words)
+    << "Invalid number of edges " << header->num_edges << " in graph file: " << filename;
+  GraphFileLayout layout(header->num_vertices, header->num_edges);
+  CHECK_EQ(file->size(), layout.file_size) << "Truncated graph file: " << filename;
+
+  IdArray arrays[kNumGraphArrays];
+  for (int i = 0; i < kNumGraphArrays; ++i) {
+    arrays[i] = WrapMappedArray(file, layout.offset[i], layout.length[i]);
+  }
+  if (verify) {
+    uint64_t checksum = kDGLGraphMagic;
+    for (int i = 0; i < kNumGraphArrays; ++i) {
+      checksum = ArrayChecksum(checksum,
+          static_cast<int64_t*>(arrays[i]->data), layout.length[i]);
+    }
+    CHECK_EQ(checksum, header->checksum) << "Checksum mismatch in graph file: " << filename;
+  }
+  // The ends of the CSR rows must agree with the header; this reads a few pages.
+  for (int i = 0; i < kNumGraphArrays; i += 3) {
+    const int64_t* indptr = static_cast<int64_t*>(arrays[i]->data);
+    CHECK(indptr[0] == 0
+          && indptr[header->num_vertices] == static_cast<int64_t>(header->num_edges))
+      << "Invalid CSR in graph file: " << filename;
+  }
+
+  CSRPtr out_csr = std::make_shared<CSR>();
+  out_csr->indptr = arrays[0];
+  out_csr->indices = arrays[1];
+  out_csr->edge_ids = arrays[2];
+  CSRPtr in_csr = std::make_shared<CSR>();
+  in_csr->indptr = arrays[3];
+  in_csr->indices = arrays[4];
+  in_csr->edge_ids = arrays[5];
+  return ImmutableGraph(in_csr, out_csr, header->flags & kGraphFlagMultigraph);
+#endif  // _WIN32
+}
+
+}  // namespace dgl
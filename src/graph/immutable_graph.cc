@@ -0,0 +1,288 @@
+/*!
+ *  Copyright (c) 2018 by Contributors
+ * \file graph/immutable_graph.cc
+ * \brief DGL immutable graph index implementation
+ */
+#include <dgl/immutable_graph.h>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
+#include "../c_api_common.h"
+#include "./traversal.h"
+
+namespace dgl {
+namespace {
+inline IdArray NewIdArray(int64_t len) {
+  return IdArray::Empty({len}, DLDataType{kDLInt, 64, 1}, DLContext{kDLCPU, 0});
+}
+
+// Build one direction of the CSR from the vector-of-vectors adjacency.
+// Rows are sorted by (neighbor, edge id).
+template<typename NeighborFn, typename EdgeFn>
+ImmutableGraph::CSRPtr BuildCSR(const Graph& graph, NeighborFn neighbors, EdgeFn edges) {
+  const int64_t num_vertices = graph.NumVertices();
+  const int64_t num_edges = graph.NumEdges();
+  ImmutableGraph::CSRPtr csr = std::make_shared<ImmutableGraph::CSR>();
+  csr->indptr = NewIdArray(num_vertices + 1);
+  csr->indices = NewIdArray(num_edges);
+  csr->edge_ids = NewIdArray(num_edges);
+  int64_t* indptr_data = static_cast<int64_t*>(csr->indptr->data);
+  int64_t* indices_data = static_cast<int64_t*>(csr->indices->data);
+  int64_t* eid_data = static_cast<int64_t*>(csr->edge_ids->data);
+
+  indptr_data[0] = 0;
+  for (int64_t v = 0; v < num_vertices; ++v) {
+    indptr_data[v + 1] = indptr_data[v] + (graph.*neighbors)(v).size();
+  }
+  CHECK_EQ(indptr_data[num_vertices], num_edges);
+
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (int64_t v = 0; v < num_vertices; ++v) {
+    const auto& succ = (graph.*neighbors)(v);
+    const auto& eids = (graph.*edges)(v);
+    const int64_t off = indptr_data[v];
+    std::vector<std::pair<dgl_id_t, dgl_id_t>> row(succ.size());
+    for (size_t i = 0; i < succ.size(); ++i) {
+      row[i] = std::make_pair(succ[i], eids[i]);
+    }
+    std::sort(row.begin(), row.end());
+    for (size_t i = 0; i < row.size(); ++i) {
+      indices_data[off + i] = row[i].first;
+      eid_data[off + i] = row[i].second;
+    }
+  }
+  return csr;
+}
+
+// Fill one direction of the mutable adjacency from a CSR. The rows are
+// reordered by edge id, which is the order the mutable graph keeps them in.
+template<typename AdjList>
+void FillAdjlist(const ImmutableGraph::CSR& csr, AdjList* adjlist) {
+  const int64_t num_vertices = csr.NumVertices();
+  const int64_t* indptr_data = static_cast<int64_t*>(csr.indptr->data);
+  const int64_t* indices_data = static_cast<int64_t*>(csr.indices->data);
+  const int64_t* eid_data = static_cast<int64_t*>(csr.edge_ids->data);
+  adjlist->resize(num_vertices);
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (int64_t v = 0; v < num_vertices; ++v) {
+    const int64_t beg = indptr_data[v], end = indptr_data[v + 1];
+    std::vector<std::pair<dgl_id_t, dgl_id_t>> row(end - beg);
+    for (int64_t i = beg; i < end; ++i) {
+      row[i - beg] = std::make_pair(eid_data[i], indices_data[i]);
+    }
+    std::sort(row.begin(), row.end());
+    auto& elist = (*adjlist)[v];
+    elist.succ.resize(row.size());
+    elist.edge_id.resize(row.size());
+    for (size_t i = 0; i < row.size(); ++i) {
+      elist.succ[i] = row[i].second;
+      elist.edge_id[i] = row[i].first;
+    }
+  }
+}
+
+/*! \brief DLPack manager context keeping the parent array alive for a slice. */
+struct SliceContext {
+  IdArray parent;
+  int64_t shape;
+  DLManagedTensor tensor;
+};
+
+// Return elements [begin, begin + len) of a 1D array as a view, without copying.
+IdArray SliceView(IdArray arr, int64_t begin, int64_t len) {
+  SliceContext* ctx = new SliceContext();
+  ctx->parent = arr;
+  ctx->shape = len;
+  DLManagedTensor* tensor = &ctx->tensor;
+  tensor->dl_tensor = *(arr.operator->());
+  tensor->dl_tensor.data = static_cast<int64_t*>(arr->data) + begin;
+  tensor->dl_tensor.shape = &ctx->shape;
+  tensor->dl_tensor.strides = nullptr;
+  tensor->manager_ctx = ctx;
+  tensor->deleter = [] (DLManagedTensor* self) {
+    delete static_cast<SliceContext*>(self->manager_ctx);
+  };
+  return IdArray::FromDLPack(tensor);
+}
+
+/*! \brief A row of a CSR as an iterable range. */
+struct CSRRow {
+  const dgl_id_t* first;
+  const dgl_id_t* last;
+  const dgl_id_t* begin() const { return first; }
+  const dgl_id_t* end() const { return last; }
+};
+
+// Return the sorted, deduplicated neighbors of one row within radius hops.
+// The 1-hop neighbors are a view into the CSR when the row has no duplicates.
+IdArray UniqueNeighbors(const ImmutableGraph::CSR& csr, dgl_id_t vid, uint64_t radius) {
+  const int64_t* indptr_data = static_cast<int64_t*>(csr.indptr->data);
+  const dgl_id_t* indices_data = static_cast<dgl_id_t*>(csr.indices->data);
+  if (radius == 1) {
+    const int64_t beg = indptr_data[vid], end = indptr_data[vid + 1];
+    if (std::adjacent_find(indices_data + beg, indices_data + end) == indices_data + end) {
+      return SliceView(csr.indices, beg, end - beg);
+    }
+  }
+  const auto vset = traverse::KHopNeighbors(csr.NumVertices(), vid, radius,
+      [&] (dgl_id_t v) {
+        return CSRRow{indices_data + indptr_data[v], indices_data + indptr_data[v + 1]};
+      });
+  return CopyVectorToNDArray(vset);
+}
+
+// Return the edges of one row, with the row vertex on the given side.
+Graph::EdgeArray RowEdges(const ImmutableGraph::CSR& csr, dgl_id_t vid, bool row_is_src) {
+  const int64_t* indptr_data = static_cast<int64_t*>(csr.indptr->data);
+  const int64_t* indices_data = static_cast<int64_t*>(csr.indices->data);
+  const int64_t* eid_data = static_cast<int64_t*>(csr.edge_ids->data);
+  const int64_t off = indptr_data[vid];
+  const int64_t len = indptr_data[vid + 1] - off;
+  IdArray row = NewIdArray(len);
+  IdArray nbr = NewIdArray(len);
+  IdArray eid = NewIdArray(len);
+  int64_t* row_data = static_cast<int64_t*>(row->data);
+  std::fill(row_data, row_data + len, vid);
+  std::copy(indices_data + off, indices_data + off + len, static_cast<int64_t*>(nbr->data));
+  std::copy(eid_data + off, eid_data + off + len, static_cast<int64_t*>(eid->data));
+  if (row_is_src) {
+    return Graph::EdgeArray{row, nbr, eid};
+  } else {
+    return Graph::EdgeArray{nbr, row, eid};
+  }
+}
+
+// Return the degrees of the given rows.
+DegreeArray RowDegrees(const ImmutableGraph::CSR& csr, IdArray vids) {
+  CHECK(IsValidIdArray(vids)) << "Invalid vertex id array.";
+  const auto len = vids->shape[0];
+  const int64_t num_vertices = csr.NumVertices();
+  const int64_t* vid_data = static_cast<int64_t*>(vids->data);
+  const int64_t* indptr_data = static_cast<int64_t*>(csr.indptr->data);
+  DegreeArray rst = DegreeArray::Empty({len}, vids->dtype, vids->ctx);
+  int64_t* rst_data = static_cast<int64_t*>(rst->data);
+  for (int64_t i = 0; i < len; ++i) {
+    const auto vid = vid_data[i];
+    CHECK(vid >= 0 && vid < num_vertices) << "Invalid vertex: " << vid;
+    rst_data[i] = indptr_data[vid + 1] - indptr_data[vid];
+  }
+  return rst;
+}
+}  // namespace
+
+ImmutableGraph ImmutableGraph::FromGraph(const Graph& graph) {
+  CSRPtr in_csr = BuildCSR(graph, &Graph::PredVec, &Graph::InEdgeVec);
+  CSRPtr out_csr = BuildCSR(graph, &Graph::SuccVec, &Graph::OutEdgeVec);
+  return ImmutableGraph(in_csr, out_csr, graph.IsMultigraph());
+}
+
+Graph ImmutableGraph::ToGraph() const {
+  const int64_t num_vertices = NumVertices();
+  const int64_t num_edges = NumEdges();
+  Graph g(is_multigraph_);
+  FillAdjlist(*out_csr_, &g.adjlist_);
+  FillAdjlist(*in_csr_, &g.reverse_adjlist_);
+  g.all_edges_src_.resize(num_edges);
+  g.all_edges_dst_.resize(num_edges);
+  g.num_edges_ = num_edges;
+
+  const int64_t* indptr_data = static_cast<int64_t*>(out_csr_->indptr->data);
+  const int64_t* indices_data = static_cast<int64_t*>(out_csr_->indices->data);
+  const int64_t* eid_data = static_cast<int64_t*>(out_csr_->edge_ids->data);
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (int64_t v = 0; v < num_vertices; ++v) {
+    for (int64_t i = indptr_data[v]; i < indptr_data[v + 1]; ++i) {
+      g.all_edges_src_[eid_data[i]] = v;
+      g.all_edges_dst_[eid_data[i]] = indices_data[i];
+    }
+  }
+  return g;
+}
+
+// O(log(k))
+bool ImmutableGraph::HasEdgeBetween(dgl_id_t src, dgl_id_t dst) const {
+  if (!HasVertex(src) || !HasVertex(dst)) return false;
+  const int64_t* indptr_data = static_cast<int64_t*>(out_csr_->indptr->data);
+  const int64_t* indices_data = static_cast<int64_t*>(out_csr_->indices->data);
+  return std::binary_search(indices_data + indptr_data[src],
+                            indices_data + indptr_data[src + 1],
+                            static_cast<int64_t>(dst));
+}
+
+BoolArray ImmutableGraph::HasEdgesBetween(IdArray src_ids, IdArray dst_ids) const {
+  CHECK(IsValidIdArray(src_ids)) << "Invalid src id array.";
+  CHECK(IsValidIdArray(dst_ids)) << "Invalid dst id array.";
+  const auto srclen = src_ids->shape[0];
+  const auto dstlen = dst_ids->shape[0];
+  CHECK((srclen == dstlen) || (srclen == 1) || (dstlen == 1))
+    << "Invalid src and dst id array.";
+  const auto rstlen = std::max(srclen, dstlen);
+  const int64_t src_stride = (srclen == 1) ? 0 : 1;
+  const int64_t dst_stride = (dstlen == 1) ? 0 : 1;
+  BoolArray rst = BoolArray::Empty({rstlen}, src_ids->dtype, src_ids->ctx);
+  int64_t* rst_data = static_cast<int64_t*>(rst->data);
+  const int64_t* src_data = static_cast<int64_t*>(src_ids->data);
+  const int64_t* dst_data = static_cast<int64_t*>(dst_ids->data);
+#pragma omp parallel for
+  for (int64_t i = 0; i < rstlen; ++i) {
+    rst_data[i] = HasEdgeBetween(src_data[i * src_stride], dst_data[i * dst_stride])? 1 : 0;
+  }
+  return rst;
+}
+
+IdArray ImmutableGraph::Predecessors(dgl_id_t vid, uint64_t radius) const {
+  CHECK(HasVertex(vid)) << "invalid vertex: " << vid;
+  CHECK(radius >= 1) << "invalid radius: " << radius;
+  return UniqueNeighbors(*in_csr_, vid, radius);
+}
+
+IdArray ImmutableGraph::Successors(dgl_id_t vid, uint64_t radius) const {
+  CHECK(HasVertex(vid)) << "invalid vertex: " << vid;
+  CHECK(radius >= 1) << "invalid radius: " << radius;
+  return UniqueNeighbors(*out_csr_, vid, radius);
+}
+
+Graph::EdgeArray ImmutableGraph::InEdges(dgl_id_t vid) const {
+  CHECK(HasVertex(vid)) << "invalid vertex: " << vid;
+  return RowEdges(*in_csr_, vid, false);
+}
+
+Graph::EdgeArray ImmutableGraph::OutEdges(dgl_id_t vid) const {
+  CHECK(HasVertex(vid)) << "invalid vertex: " << vid;
+  return RowEdges(*out_csr_, vid, true);
+}
+
+// O(E); the out-CSR is already sorted by src and dst. The CSR arrays may be
+// mapped read-only from a graph file, so dst and eid are copies as well.
+Graph::EdgeArray ImmutableGraph::Edges() const {
+  const int64_t num_vertices = NumVertices();
+  const int64_t len = NumEdges();
+  IdArray src = NewIdArray(len);
+  IdArray dst = NewIdArray(len);
+  IdArray eid = NewIdArray(len);
+  const int64_t* indptr_data = static_cast<int64_t*>(out_csr_->indptr->data);
+  const int64_t* indices_data = static_cast<int64_t*>(out_csr_->indices->data);
+  const int64_t* eid_data = static_cast<int64_t*>(out_csr_->edge_ids->data);
+  int64_t* src_data = static_cast<int64_t*>(src->data);
+  int64_t* dst_data = static_cast<int64_t*>(dst->data);
+  int64_t* eid_out = static_cast<int64_t*>(eid->data);
+#pragma omp parallel for schedule(dynamic, 1024)
+  for (int64_t v = 0; v < num_vertices; ++v) {
+    const int64_t begin = indptr_data[v], end = indptr_data[v + 1];
+    std::fill(src_data + begin, src_data + end, v);
+    std::copy(indices_data + begin, indices_data + end, dst_data + begin);
+    std::copy(eid_data + begin, eid_data + end, eid_out + begin);
+  }
+  return Graph::EdgeArray{src, dst, eid};
+}
+
+DegreeArray ImmutableGraph::InDegrees(IdArray vids) const {
+  return RowDegrees(*in_csr_, vids);
+}
+
+DegreeArray ImmutableGraph::OutDegrees(IdArray vids) const {
+  return RowDegrees(*out_csr_, vids);
+}
+
+}  // namespace dgl
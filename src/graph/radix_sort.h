@@ -0,0 +1,135 @@
+/*!
+ *  Copyright (c) 2018 by Contributors
+ * \file graph/radix_sort.h
+ * \brief LSD radix sort on bounded integer keys.
+ */
+#ifndef DGL_GRAPH_RADIX_SORT_H_
+#define DGL_GRAPH_RADIX_SORT_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace dgl {
+
+/*! \brief number of key bits consumed by one radix pass */
+constexpr int kRadixBits = 8;
+/*! \brief number of buckets of one radix pass */
+constexpr int kRadixBuckets = 1 << kRadixBits;
+
+/*! \return the number of bits needed to represent every key up to max_key */
+inline int NumKeyBits(uint64_t max_key) {
+  int bits = 0;
+  while (bits < 64 && (max_key >> bits) != 0) {
+    ++bits;
+  }
+  return bits;
+}
+
+/*!
+ * \brief Sort the keys in place with a least-significant-digit radix sort.
+ *
+ * Only the lowest num_bits bits of the keys are examined, so the number of
+ * passes follows the key range rather than the key type. Short inputs fall
+ * back to std::sort.
+ *
+ * \param keys The keys to be sorted.
+ * \param len The number of keys.
+ * \param num_bits The number of significant bits of the keys.
+ */
+template<typename KeyType>
+void RadixSort(KeyType* keys, int64_t len, int num_bits) {
+  if (len < 256) {
+    std::sort(keys, keys + len);
+    return;
+  }
+  std::vector<KeyType> buffer(len);
+  KeyType* src = keys;
+  KeyType* dst = buffer.data();
+  for (int shift = 0; shift < num_bits; shift += kRadixBits) {
+    int64_t count[kRadixBuckets + 1] = {0};
+    for (int64_t i = 0; i < len; ++i) {
+      ++count[((src[i] >> shift) & (kRadixBuckets - 1)) + 1];
+    }
+    for (int b = 0; b < kRadixBuckets; ++b) {
+      count[b + 1] += count[b];
+    }
+    for (int64_t i = 0; i < len; ++i) {
+      dst[count[(src[i] >> shift) & (kRadixBuckets - 1)]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+  if (src != keys) {
+    std::copy(src, src + len, keys);
+  }
+}
+
+/*!
+ * \brief Sort the keys in place with a parallel LSD radix sort, permuting the
+ *        values along with them.
+ *
+ * The input is cut into fixed-size blocks. Every pass counts the digits of
+ * each block in parallel, turns the counts into per-block output offsets, and
+ * scatters the blocks in parallel. The sort is stable, so equal keys keep the
+ * order of their values.
+ *
+ * \param keys The keys to be sorted.
+ * \param values The values to be permuted with the keys.
+ * \param len The number of keys.
+ * \param num_bits The number of significant bits of the keys.
+ */
+template<typename KeyType, typename ValueType>
+void ParallelRadixSortPairs(KeyType* keys, ValueType* values, int64_t len, int num_bits) {
+  const int64_t block_size = std::max<int64_t>(1 << 16, (len + 1023) / 1024);
+  const int64_t num_blocks = (len + block_size - 1) / block_size;
+  std::vector<KeyType> key_buffer(len);
+  std::vector<ValueType> value_buffer(len);
+  std::vector<int64_t> offsets(num_blocks * kRadixBuckets);
+  KeyType* key_src = keys;
+  KeyType* key_dst = key_buffer.data();
+  ValueType* value_src = values;
+  ValueType* value_dst = value_buffer.data();
+  for (int shift = 0; shift < num_bits; shift += kRadixBits) {
+#pragma omp parallel for
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      int64_t* count = offsets.data() + b * kRadixBuckets;
+      std::fill(count, count + kRadixBuckets, 0);
+      const int64_t end = std::min(len, (b + 1) * block_size);
+      for (int64_t i = b * block_size; i < end; ++i) {
+        ++count[(key_src[i] >> shift) & (kRadixBuckets - 1)];
+      }
+    }
+    // Exclusive prefix sum in (bucket, block) order.
+    int64_t total = 0;
+    for (int d = 0; d < kRadixBuckets; ++d) {
+      for (int64_t b = 0; b < num_blocks; ++b) {
+        const int64_t cnt = offsets[b * kRadixBuckets + d];
+        offsets[b * kRadixBuckets + d] = total;
+        total += cnt;
+      }
+    }
+#pragma omp parallel for
+    for (int64_t b = 0; b < num_blocks; ++b) {
+      int64_t* pos = offsets.data() + b * kRadixBuckets;
+      const int64_t end = std::min(len, (b + 1) * block_size);
+      for (int64_t i = b * block_size; i < end; ++i) {
+        const int64_t p = pos[(key_src[i] >> shift) & (kRadixBuckets - 1)]++;
+        key_dst[p] = key_src[i];
+        value_dst[p] = value_src[i];
+      }
+    }
+    std::swap(key_src, key_dst);
+    std::swap(value_src, value_dst);
+  }
+  if (key_src != keys) {
+#pragma omp parallel for
+    for (int64_t i = 0; i < len; ++i) {
+      keys[i] = key_src[i];
+      values[i] = value_src[i];
+    }
+  }
+}
+
+}  // namespace dgl
+
+#endif  // DGL_GRAPH_RADIX_SORT_H_
@@ -1 +1,66 @@
 #include "graph/skg_graph.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/*! \brief DLPack manager context owning a read-only mapping of a column file. */
+struct MappedColumnContext {
+  void* addr = nullptr;
+  size_t size = 0;
+  int64_t shape = 0;
+  DLManagedTensor tensor;
+
+  ~MappedColumnContext() {
+    if (addr != nullptr) {
+      munmap(addr, size);
+    }
+  }
+};
+
+}  // namespace
+
+NDArray SkgGraph::VertexAttrView(const std::string& column) {
+  CHECK(HasLongIds())
+    << "Zero-copy attribute views need long vertex ids; use GetVertexAttr instead.";
+  CHECK(std::dynamic_pointer_cast<PermutedIdEncoder>(db->GetIDEncoder()) == nullptr)
+    << "Zero-copy attribute views need unreordered vertex ids; use GetVertexAttr instead.";
+  ColumnType type;
+  std::string filename;
+  s = db->GetVertexAttrColumn(this->v_label, column, &type, &filename);
+  CHECK(s.ok()) << s.ToString();
+  const DLDataType dtype = ColumnDLType(type);
+  const int64_t num_vertices = db->GetNumVertices();
+
+  MappedColumnContext* ctx = new MappedColumnContext();
+  ctx->shape = num_vertices;
+  ctx->size = num_vertices * (dtype.bits / 8);
+  if (ctx->size > 0) {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    CHECK_GE(fd, 0) << "Failed to open vertex column file: " << filename;
+    struct stat st;
+    CHECK_EQ(fstat(fd, &st), 0) << "Failed to stat vertex column file: " << filename;
+    CHECK_GE(static_cast<size_t>(st.st_size), ctx->size) << "Truncated vertex column file: " << filename;
+    void* addr = mmap(nullptr, ctx->size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    CHECK(addr != MAP_FAILED) << "Failed to map vertex column file: " << filename;
+    ctx->addr = addr;
+  }
+
+  DLManagedTensor* tensor = &ctx->tensor;
+  tensor->dl_tensor.data = ctx->addr;
+  tensor->dl_tensor.ctx = DLContext{kDLCPU, 0};
+  tensor->dl_tensor.ndim = 1;
+  tensor->dl_tensor.dtype = dtype;
+  tensor->dl_tensor.shape = &ctx->shape;
+  tensor->dl_tensor.strides = nullptr;
+  tensor->dl_tensor.byte_offset = 0;
+  tensor->manager_ctx = ctx;
+  tensor->deleter = [] (DLManagedTensor* self) {
+    delete static_cast<MappedColumnContext*>(self->manager_ctx);
+  };
+  return NDArray::FromDLPack(tensor);
+}
@@ -1,5 +1,7 @@
 #ifndef _H_SKG_GRAPH
 #define _H_SKG_GRAPH
+#include <cerrno>
+#include <cstdlib>
 #include <future>
 #include <thread>
 #include <algorithm>
@@ -22,6 +24,9 @@
 #include "fs/SubEdgePartition.h"
 #include "fs/VertexColumnList.h"
 #include "fs/ShardTree.h"
+#include "fs/VertexReordering.h"
+#include "fs/PermutedIdEncoder.h"
+#include "fs/StringToLongIdEncoder.h"
 //
 //for dgl integration
 #include "../c_api_common.h"
@@ -30,6 +35,7 @@
 
 using namespace skg;
 using namespace dgl;
+using dgl::runtime::NDArray;
 
 class SkgGraph{
 	public:
@@ -174,6 +180,8 @@ class SkgGraph{
 		  } else {
 		    // many-many
 		    CHECK(srclen == dstlen) << "Invalid src and dst id array.";
+		    ReorderVertices(src_data, dst_data, srclen);
+		    PresplitShards(dst_data, dstlen);
 		    for (int64_t i = 0; i < srclen; ++i) {
 		      sprintf(uid, "%llu",src_data[i]);
 		      sprintf(vid, "%llu",dst_data[i]);
@@ -190,7 +198,7 @@ class SkgGraph{
 		Status s;
 		vid_t vid;
 		s=pIdEncoder->GetIDByVertex("v",vidstr,&vid);
-		bool isIDLongStr= this->options.id_type==Options::VertexIdType::LONG;
+		bool isIDLongStr= HasLongIds();
 		if (isIDLongStr)
 			ret = vid<=max_vid?true:false;
 		else
@@ -205,7 +213,7 @@ class SkgGraph{
 		std::shared_ptr<IDEncoder> pIdEncoder=db->GetIDEncoder();
 		std::vector<std::string>::iterator vecIter;
 		Status s;
-		bool isIDLongStr= this->options.id_type==Options::VertexIdType::LONG;
+		bool isIDLongStr= HasLongIds();
 		for(vecIter=vids.begin();vecIter!=vids.end();vecIter++)
 		{
 				vid_t vid;
@@ -317,18 +325,11 @@ class SkgGraph{
 		std::vector<PVpair> vpair_vec;
 		db->Kout(t_req, &vpair_vec);
 		vid_t vid;
-		std::shared_ptr<IDEncoder> pIdEncoder=db->GetIDEncoder();
-		Status s;
-		bool isIDLongStr= this->options.id_type==Options::VertexIdType::LONG;
 		for (size_t i = 0; i < vpair_vec.size(); i ++) {
-		    s=pIdEncoder->GetIDByVertex("v", vpair_vec[i].first.id ,&vid);
-		    if (isIDLongStr)
-			ret.push_back( vid );
+		    if (ParseDGLId(vpair_vec[i].first.id, &vid))
+			ret.push_back(vid);
 		    else
-			if (!s.ok())
-			    SKG_LOG_ERROR("No support to convert ID for {}", vpair_vec[i].first.id);
-			else
-			    ret.push_back(vid);
+			SKG_LOG_ERROR("No support to convert ID for {}", vpair_vec[i].first.id);
 		}
 		return std::move(ret);
 	    };
@@ -348,24 +349,138 @@ class SkgGraph{
 		std::vector<PVpair> vpair_vec;
 		db->Kout(t_req, &vpair_vec);
 		vid_t vid;
-		std::shared_ptr<IDEncoder> pIdEncoder=db->GetIDEncoder();
-		Status s;
-		bool isIDLongStr= this->options.id_type==Options::VertexIdType::LONG;
 		for (size_t i = 0; i < vpair_vec.size(); i ++) {
-		    s=pIdEncoder->GetIDByVertex("v", vpair_vec[i].second.id ,&vid);
-		    if (isIDLongStr)
-			ret.push_back( vid );
+		    if (ParseDGLId(vpair_vec[i].second.id, &vid))
+			ret.push_back(vid);
 		    else
-		    {
-			if (!s.ok())
-			    SKG_LOG_ERROR("No support yet to convert ID for {}", vpair_vec[i].second.id);
-			else
-			    ret.push_back(vid);
-		    }
+			SKG_LOG_ERROR("No support yet to convert ID for {}", vpair_vec[i].second.id);
 		}
 		return std::move(ret);
 	    };
 
+	    /*!
+	     * \brief Rebuild the persistent in/out degree columns of the database.
+	     *
+	     * Only needed once for a database created before the degree columns
+	     * existed; afterwards they are maintained on every edge update.
+	     */
+	    void GenDegreeIndex()
+	    {
+		s = db->GenDegreeFile();
+		CHECK(s.ok()) << s.ToString();
+	    }
+
+	    /*! \return the in degrees of the given vertices. */
+	    DegreeArray InDegrees(IdArray vids)
+	    {
+		return Degrees(vids, true);
+	    }
+
+	    /*! \return the out degrees of the given vertices. */
+	    DegreeArray OutDegrees(IdArray vids)
+	    {
+		return Degrees(vids, false);
+	    }
+
+	    /*!
+	     * \brief Set one numeric vertex attribute for the given vertices.
+	     *
+	     * The column is created with the type of values (int32, int64, float32
+	     * or float64) if it does not exist yet.
+	     *
+	     * \param column The attribute column name.
+	     * \param vids The vertex ids.
+	     * \param values The values, aligned with vids.
+	     */
+	    void SetVertexAttr(const std::string& column, IdArray vids, NDArray values)
+	    {
+		CHECK(IsValidIdArray(vids)) << "Invalid vertex id array.";
+		CHECK_EQ(values->ndim, 1) << "Attribute values must be a vector.";
+		CHECK_EQ(values->shape[0], vids->shape[0]) << "Attribute values must be aligned with the vertices.";
+		const ColumnType type = DLColumnType(values->dtype);
+		ColumnType old_type;
+		std::string filename;
+		s = db->GetVertexAttrColumn(this->v_label, column, &old_type, &filename);
+		if (s.ok()) {
+		    CHECK(old_type == type) << "Attribute column " << column << " has another type.";
+		} else {
+		    s = db->CreateVertexAttrCol(this->v_label, ColumnDescriptor(column, type));
+		    CHECK(s.ok()) << s.ToString();
+		}
+		const int64_t* vid_data = static_cast<int64_t*>(vids->data);
+		for (int64_t i = 0; i < vids->shape[0]; ++i) {
+		    VertexRequest req;
+		    req.SetVertex(this->v_label, std::to_string(vid_data[i]));
+		    req.SetCreateIfNotExist(true);
+		    switch (type) {
+			case ColumnType::INT32: s = req.SetInt32(column, static_cast<int32_t*>(values->data)[i]); break;
+			case ColumnType::INT64: s = req.SetInt64(column, static_cast<int64_t*>(values->data)[i]); break;
+			case ColumnType::FLOAT32: s = req.SetFloat(column, static_cast<float*>(values->data)[i]); break;
+			default: s = req.SetDouble(column, static_cast<double*>(values->data)[i]); break;
+		    }
+		    CHECK(s.ok()) << s.ToString();
+		    s = db->SetVertexAttr(req);
+		    CHECK(s.ok()) << s.ToString();
+		}
+	    }
+
+	    /*!
+	     * \brief Gather one numeric vertex attribute column for the given vertices.
+	     *
+	     * The result keeps the column type (int32, int64, float32 or float64).
+	     * Unset values read as zero.
+	     *
+	     * \param column The attribute column name.
+	     * \param vids The vertex ids.
+	     * \return the attribute array, aligned with vids.
+	     */
+	    NDArray GetVertexAttr(const std::string& column, IdArray vids)
+	    {
+		ColumnType type;
+		std::string filename;
+		s = db->GetVertexAttrColumn(this->v_label, column, &type, &filename);
+		CHECK(s.ok()) << s.ToString();
+		const std::vector<vid_t> skg_vids = ToSkgIds(vids);
+		const int64_t len = skg_vids.size();
+		NDArray rst = NDArray::Empty({len}, ColumnDLType(type), vids->ctx);
+		s = db->GatherVertexAttr(this->v_label, column, skg_vids.data(), len, rst->data);
+		CHECK(s.ok()) << s.ToString();
+		return rst;
+	    }
+
+	    /*!
+	     * \brief Gather several numeric vertex attribute columns into a float32 tensor.
+	     * \param columns The attribute column names, one per feature dimension.
+	     * \param vids The vertex ids.
+	     * \return the feature tensor of shape [len(vids), len(columns)].
+	     */
+	    NDArray GetVertexAttrs(const std::vector<std::string>& columns, IdArray vids)
+	    {
+		CHECK(!columns.empty()) << "No attribute column is given.";
+		const std::vector<vid_t> skg_vids = ToSkgIds(vids);
+		const int64_t len = skg_vids.size();
+		const int64_t dim = columns.size();
+		NDArray rst = NDArray::Empty({len, dim}, DLDataType{kDLFloat, 32, 1}, vids->ctx);
+		s = db->GatherVertexAttrAsFloat(this->v_label, columns, skg_vids.data(), len,
+		                                static_cast<float*>(rst->data));
+		CHECK(s.ok()) << s.ToString();
+		return rst;
+	    }
+
+	    /*!
+	     * \brief Map a whole numeric vertex attribute column as a read-only NDArray.
+	     *
+	     * No data is copied: the array is a view of the column file, indexed by
+	     * vertex id, with one element per vertex in the database. Only supported
+	     * for databases using long vertex ids that were not reordered at load
+	     * time, where the database ids are the DGL ids. The view does not see
+	     * vertices added after it is created.
+	     *
+	     * \param column The attribute column name.
+	     * \return the column array.
+	     */
+	    NDArray VertexAttrView(const std::string& column);
+
 	    void PrNbrInfo(const char* center, const char* vlabel, int hop)
 	    {
 		TraverseRequest t_req;
@@ -392,6 +507,171 @@ class SkgGraph{
 	    }
 
 	private:
+	    /*!
+	     * \brief Parse a vertex id returned by a traversal into a DGL id.
+	     *
+	     * Traversals return the ids the vertices were added with, which are the
+	     * DGL ids. They must not go through the id encoder: on a reordered
+	     * database it would map them to the storage vids.
+	     */
+	    static bool ParseDGLId(const std::string& id, vid_t* vid)
+	    {
+		char* end = nullptr;
+		errno = 0;
+		const unsigned long long value = strtoull(id.c_str(), &end, 10);
+		if (id.empty() || errno != 0 || *end != '\0') {
+		    return false;
+		}
+		*vid = static_cast<vid_t>(value);
+		return true;
+	    }
+
+	    /*!
+	     * \brief Renumber the vertices of the first batch loaded into an empty
+	     * database, following options.vertex_order, so that neighbors get close
+	     * vids. The permutation is kept in the id encoder; DGL ids are unchanged.
+	     */
+	    void ReorderVertices(const int64_t* src_data, const int64_t* dst_data, int64_t len)
+	    {
+		if (this->options.vertex_order == Options::VertexOrder::NONE
+		    || len == 0 || db->GetNumEdges() != 0) {
+		    return;
+		}
+		std::vector<vid_t> src(len), dst(len);
+		vid_t num_vertices = 0;
+		for (int64_t i = 0; i < len; ++i) {
+		    CHECK(src_data[i] >= 0 && dst_data[i] >= 0) << "Invalid edge: "
+			<< src_data[i] << " -> " << dst_data[i];
+		    src[i] = static_cast<vid_t>(src_data[i]);
+		    dst[i] = static_cast<vid_t>(dst_data[i]);
+		    num_vertices = std::max(num_vertices, std::max(src[i], dst[i]) + 1);
+		}
+		std::vector<vid_t> new_to_old;
+		VertexReordering::ComputeOrder(this->options.vertex_order, num_vertices,
+		                               src.data(), dst.data(), len, &new_to_old);
+		s = db->SetVertexOrder(new_to_old);
+		CHECK(s.ok()) << s.ToString();
+	    }
+
+	    /*!
+	     * \brief Split an empty database into shard trees of balanced edge
+	     * counts before its first batch is loaded, when options.shard_partition
+	     * is balanced.
+	     */
+	    void PresplitShards(const int64_t* dst_data, int64_t len)
+	    {
+		if (this->options.shard_partition != Options::ShardPartition::BALANCED
+		    || len == 0 || db->GetNumEdges() != 0) {
+		    return;
+		}
+		std::shared_ptr<PermutedIdEncoder> permuted =
+		    std::dynamic_pointer_cast<PermutedIdEncoder>(db->GetIDEncoder());
+		std::vector<vid_t> dst(len);
+		for (int64_t i = 0; i < len; ++i) {
+		    dst[i] = static_cast<vid_t>(dst_data[i]);
+		    if (permuted) {
+			dst[i] = permuted->ToInternal(dst[i]);
+		    }
+		}
+		s = db->PresplitShards(dst.data(), len);
+		CHECK(s.ok()) << s.ToString();
+	    }
+
+	    /*!
+	     * \brief Read the degrees of a batch of vertices from the degree columns.
+	     * \param vids The vertex ids, as added by AddEdges.
+	     * \param in Whether to read the in degrees or the out degrees.
+	     */
+	    DegreeArray Degrees(IdArray vids, bool in)
+	    {
+		const std::vector<vid_t> skg_vids = ToSkgIds(vids);
+		const int64_t len = skg_vids.size();
+		std::vector<int32_t> degrees(len);
+		s = db->GetDegrees(skg_vids.data(), len,
+		                   in ? degrees.data() : nullptr,
+		                   in ? nullptr : degrees.data());
+		CHECK(s.ok()) << s.ToString();
+		DegreeArray rst = DegreeArray::Empty({len}, vids->dtype, vids->ctx);
+		int64_t* rst_data = static_cast<int64_t*>(rst->data);
+		std::copy(degrees.begin(), degrees.end(), rst_data);
+		return rst;
+	    }
+
+	    /*!
+	     * \brief Translate DGL vertex ids into database ids, so that a batch can
+	     * be read from the database in one call.
+	     */
+	    std::vector<vid_t> ToSkgIds(IdArray vids)
+	    {
+		CHECK(IsValidIdArray(vids)) << "Invalid vertex id array.";
+		const auto len = vids->shape[0];
+		const int64_t* vid_data = static_cast<int64_t*>(vids->data);
+		std::vector<vid_t> skg_vids(len);
+		std::shared_ptr<IDEncoder> pIdEncoder = db->GetIDEncoder();
+		if (HasLongIds()) {
+		    // long ids are stored as they are, up to the load-time reordering
+		    std::shared_ptr<PermutedIdEncoder> permuted =
+			std::dynamic_pointer_cast<PermutedIdEncoder>(pIdEncoder);
+		    for (int64_t i = 0; i < len; ++i) {
+			CHECK_GE(vid_data[i], 0) << "Invalid vertex: " << vid_data[i];
+			skg_vids[i] = static_cast<vid_t>(vid_data[i]);
+			if (permuted) {
+			    skg_vids[i] = permuted->ToInternal(skg_vids[i]);
+			}
+		    }
+		    return skg_vids;
+		}
+		for (int64_t i = 0; i < len; ++i) {
+		    s = pIdEncoder->GetIDByVertex(this->v_label, std::to_string(vid_data[i]), &skg_vids[i]);
+		    CHECK(s.ok()) << "Invalid vertex: " << vid_data[i];
+		}
+		return skg_vids;
+	    }
+
+	    /*!
+	     * \brief Whether the database stores the vertex ids as long ids.
+	     *
+	     * The database may fall back to long ids when it is opened (e.g. without
+	     * an id mapping), so this looks at its encoder rather than at the options
+	     * the graph was opened with.
+	     */
+	    bool HasLongIds() const
+	    {
+		std::shared_ptr<IDEncoder> encoder = db->GetIDEncoder();
+		std::shared_ptr<PermutedIdEncoder> permuted =
+		    std::dynamic_pointer_cast<PermutedIdEncoder>(encoder);
+		if (permuted) {
+		    encoder = permuted->base();
+		}
+		return std::dynamic_pointer_cast<StringToLongIdEncoder>(encoder) != nullptr;
+	    }
+
+	    /*! \return the DLPack type of a numeric attribute column */
+	    static DLDataType ColumnDLType(ColumnType type)
+	    {
+		switch (type) {
+		    case ColumnType::INT32: return DLDataType{kDLInt, 32, 1};
+		    case ColumnType::INT64: return DLDataType{kDLInt, 64, 1};
+		    case ColumnType::FLOAT32: return DLDataType{kDLFloat, 32, 1};
+		    case ColumnType::FLOAT64: return DLDataType{kDLFloat, 64, 1};
+		    default:
+			LOG(FATAL) << "Not a numeric attribute column: " << static_cast<int>(type);
+		}
+		return DLDataType{kDLInt, 64, 1};
+	    }
+
+	    /*! \return the numeric attribute column type holding a DLPack type */
+	    static ColumnType DLColumnType(DLDataType dtype)
+	    {
+		if (dtype.code == kDLInt && dtype.bits == 32) return ColumnType::INT32;
+		if (dtype.code == kDLInt && dtype.bits == 64) return ColumnType::INT64;
+		if (dtype.code == kDLFloat && dtype.bits == 32) return ColumnType::FLOAT32;
+		if (dtype.code == kDLFloat && dtype.bits == 64) return ColumnType::FLOAT64;
+		LOG(FATAL) << "Not a numeric attribute type: " << static_cast<int>(dtype.code)
+		           << "/" << static_cast<int>(dtype.bits);
+		return ColumnType::INT64;
+	    }
+
 	    skg::Options options;
             std::string db_dir;
 	    const std::string v_label = "v";
@@ -117,15 +117,11 @@ struct Frontiers {
 
 Frontiers BFSNodesFrontiers(const Graph& graph, IdArray source, bool reversed) {
   Frontiers front;
-  VectorQueueWrapper<dgl_id_t> queue(&front.ids);
-  auto visit = [&] (const dgl_id_t v) { };
-  auto make_frontier = [&] () {
-      if (!queue.empty()) {
-        // do not push zero-length frontier
-        front.sections.push_back(queue.size());
-      }
+  auto make_frontier = [&] (const std::vector<dgl_id_t>& frontier) {
+      front.ids.insert(front.ids.end(), frontier.begin(), frontier.end());
+      front.sections.push_back(frontier.size());
     };
-  BFSNodes(graph, source, reversed, &queue, visit, make_frontier);
+  ParallelBFSNodes(graph, source, reversed, make_frontier);
   return front;
 }
 
@@ -174,15 +170,11 @@ DGL_REGISTER_GLOBAL("traversal._CAPI_DGLBFSEdges")
 
 Frontiers TopologicalNodesFrontiers(const Graph& graph, bool reversed) {
   Frontiers front;
-  VectorQueueWrapper<dgl_id_t> queue(&front.ids);
-  auto visit = [&] (const dgl_id_t v) { };
-  auto make_frontier = [&] () {
-      if (!queue.empty()) {
-        // do not push zero-length frontier
-        front.sections.push_back(queue.size());
-      }
+  auto make_frontier = [&] (const std::vector<dgl_id_t>& frontier) {
+      front.ids.insert(front.ids.end(), frontier.begin(), frontier.end());
+      front.sections.push_back(frontier.size());
     };
-  TopologicalNodes(graph, reversed, &queue, visit, make_frontier);
+  ParallelTopologicalNodes(graph, reversed, make_frontier);
   return front;
 }
 
@@ -208,9 +200,16 @@ DGL_REGISTER_GLOBAL("traversal._CAPI_DGLDFSEdges")
     const int64_t len = source->shape[0];
     const int64_t* src_data = static_cast<int64_t*>(source->data);
     std::vector<std::vector<dgl_id_t>> edges(len);
-    for (int64_t i = 0; i < len; ++i) {
-      auto visit = [&] (dgl_id_t e, int tag) { edges[i].push_back(e); };
-      DFSLabeledEdges(*gptr, src_data[i], reversed, false, false, visit);
+    // Sources are traversed independently (e.g. the roots of batched trees),
+    // so they run in parallel, each thread reusing one visited buffer.
+#pragma omp parallel if (len > 1)
+    {
+      std::vector<bool> visited(gptr->NumVertices());
+#pragma omp for schedule(dynamic, 16)
+      for (int64_t i = 0; i < len; ++i) {
+        auto visit = [&] (dgl_id_t e, int tag) { edges[i].push_back(e); };
+        DFSLabeledEdges(*gptr, src_data[i], reversed, false, false, visit, &visited);
+      }
     }
     IdArray ids = MergeMultipleTraversals(edges);
     IdArray sections = ComputeMergedSections(edges);
@@ -236,15 +235,20 @@ DGL_REGISTER_GLOBAL("traversal._CAPI_DGLDFSLabeledEdges")
     if (return_labels) {
       tags.resize(len);
     }
-    for (int64_t i = 0; i < len; ++i) {
-      auto visit = [&] (dgl_id_t e, int tag) {
-        edges[i].push_back(e);
-        if (return_labels) {
-          tags[i].push_back(tag);
-        }
-      };
-      DFSLabeledEdges(*gptr, src_data[i], reversed,
-          has_reverse_edge, has_nontree_edge, visit);
+#pragma omp parallel if (len > 1)
+    {
+      std::vector<bool> visited(gptr->NumVertices());
+#pragma omp for schedule(dynamic, 16)
+      for (int64_t i = 0; i < len; ++i) {
+        auto visit = [&] (dgl_id_t e, int tag) {
+          edges[i].push_back(e);
+          if (return_labels) {
+            tags[i].push_back(tag);
+          }
+        };
+        DFSLabeledEdges(*gptr, src_data[i], reversed,
+            has_reverse_edge, has_nontree_edge, visit, &visited);
+      }
     }
 
     IdArray ids = MergeMultipleTraversals(edges);
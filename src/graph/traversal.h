@@ -12,9 +12,12 @@
 #define DGL_GRAPH_TRAVERSAL_H_
 
 #include <dgl/graph.h>
+#include <algorithm>
+#include <atomic>
 #include <stack>
 #include <tuple>
 #include <vector>
+#include "radix_sort.h"
 
 namespace dgl {
 namespace traverse {
@@ -81,6 +84,183 @@ void BFSNodes(const Graph& graph,
   }
 }
 
+/*!
+ * \brief A fixed-size bitmap whose bits can be set concurrently.
+ */
+class AtomicBitmap {
+ public:
+  explicit AtomicBitmap(size_t size): words_((size + 63) / 64) {
+    for (auto& w : words_) {
+      w.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /*! \return whether the i-th bit is set */
+  bool Get(size_t i) const {
+    return (words_[i >> 6].load(std::memory_order_relaxed) >> (i & 63)) & 1;
+  }
+
+  /*! \brief set the i-th bit */
+  void Set(size_t i) {
+    words_[i >> 6].fetch_or(uint64_t(1) << (i & 63), std::memory_order_relaxed);
+  }
+
+  /*! \return true if the i-th bit was clear and this call has set it */
+  bool TestAndSet(size_t i) {
+    const uint64_t mask = uint64_t(1) << (i & 63);
+    if (words_[i >> 6].load(std::memory_order_relaxed) & mask) {
+      return false;
+    }
+    return !(words_[i >> 6].fetch_or(mask, std::memory_order_relaxed) & mask);
+  }
+
+  /*! \brief clear all the bits */
+  void Reset() {
+    for (auto& w : words_) {
+      w.store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  std::vector<std::atomic<uint64_t>> words_;
+};
+
+/*!
+ * \brief Concatenate per-block output buffers into one vector.
+ *
+ * Block sizes are prefix-summed so that every block is copied into its
+ * final position in parallel. The blocks are emptied.
+ */
+template<typename DType>
+void CompactBlocks(std::vector<std::vector<DType>>* blocks, std::vector<DType>* out) {
+  const int64_t num_blocks = blocks->size();
+  std::vector<int64_t> offsets(num_blocks + 1, 0);
+  for (int64_t i = 0; i < num_blocks; ++i) {
+    offsets[i + 1] = offsets[i] + (*blocks)[i].size();
+  }
+  out->resize(offsets[num_blocks]);
+#pragma omp parallel for
+  for (int64_t i = 0; i < num_blocks; ++i) {
+    std::copy((*blocks)[i].begin(), (*blocks)[i].end(), out->begin() + offsets[i]);
+    (*blocks)[i].clear();
+  }
+}
+
+/*!
+ * \brief Traverse the graph in a breadth-first-search (BFS) order using a
+ *        parallel, direction-optimizing algorithm.
+ *
+ * Each level is expanded either top-down, where the frontier scans its neighbors,
+ * or bottom-up, where every unvisited node scans its reverse neighbors for a parent
+ * in the frontier. Following Beamer et al., the traversal switches to bottom-up when
+ * the edges to check from the frontier exceed 1/alpha of the edges left on the
+ * unvisited nodes, and back to top-down when the frontier holds less than 1/beta of
+ * the nodes. Both steps work on fixed-size blocks with their own output buffers,
+ * which are compacted by a prefix sum.
+ *
+ * The frontiers are the same as BFSNodes. The first frontier keeps the order of the
+ * given source nodes; nodes of the other frontiers are in increasing id order, which
+ * keeps the result deterministic regardless of the number of threads.
+ *
+ * The frontier function must be compatible with following interface:
+ *   void (*make_frontier)(const std::vector<dgl_id_t>& frontier);
+ *
+ * \param graph The graph.
+ * \param sources Source nodes.
+ * \param reversed If true, BFS follows the in-edge direction
+ * \param make_frontier The function to call with each frontier.
+ */
+template<typename FrontierFn>
+void ParallelBFSNodes(const Graph& graph,
+                      IdArray source,
+                      bool reversed,
+                      FrontierFn make_frontier) {
+  // Switching thresholds from the direction-optimizing BFS paper.
+  const int64_t kAlpha = 14, kBeta = 24;
+  // Number of nodes handled by one output buffer.
+  const int64_t kBlockSize = 4096;
+
+  const int64_t num_nodes = graph.NumVertices();
+  const int64_t len = source->shape[0];
+  const int64_t* src_data = static_cast<int64_t*>(source->data);
+  const auto neighbor_iter = reversed? &Graph::PredVec : &Graph::SuccVec;
+  const auto parent_iter = reversed? &Graph::SuccVec : &Graph::PredVec;
+
+  AtomicBitmap visited(num_nodes);
+  AtomicBitmap in_frontier(num_nodes);
+  std::vector<dgl_id_t> frontier(src_data, src_data + len);
+  std::vector<dgl_id_t> next;
+  std::vector<std::vector<dgl_id_t>> blocks;
+
+  int64_t unexplored_edges = graph.NumEdges();
+  bool bottom_up = false;
+  for (int64_t i = 0; i < len; ++i) {
+    visited.Set(src_data[i]);
+  }
+
+  while (!frontier.empty()) {
+    make_frontier(frontier);
+
+    const int64_t frontier_size = frontier.size();
+    int64_t frontier_edges = 0;
+#pragma omp parallel for reduction(+:frontier_edges)
+    for (int64_t i = 0; i < frontier_size; ++i) {
+      frontier_edges += (graph.*neighbor_iter)(frontier[i]).size();
+    }
+    unexplored_edges -= frontier_edges;
+    if (!bottom_up && frontier_edges > unexplored_edges / kAlpha) {
+      bottom_up = true;
+    } else if (bottom_up && frontier_size < num_nodes / kBeta) {
+      bottom_up = false;
+    }
+
+    if (bottom_up) {
+      in_frontier.Reset();
+#pragma omp parallel for
+      for (int64_t i = 0; i < frontier_size; ++i) {
+        in_frontier.Set(frontier[i]);
+      }
+      const int64_t num_blocks = (num_nodes + kBlockSize - 1) / kBlockSize;
+      blocks.resize(num_blocks);
+#pragma omp parallel for schedule(dynamic, 1)
+      for (int64_t b = 0; b < num_blocks; ++b) {
+        const int64_t end = std::min(num_nodes, (b + 1) * kBlockSize);
+        for (int64_t v = b * kBlockSize; v < end; ++v) {
+          if (visited.Get(v)) {
+            continue;
+          }
+          for (auto u : (graph.*parent_iter)(v)) {
+            if (in_frontier.Get(u)) {
+              visited.Set(v);
+              blocks[b].push_back(v);
+              break;
+            }
+          }
+        }
+      }
+      // blocks cover increasing id ranges, so the result is already sorted
+      CompactBlocks(&blocks, &next);
+    } else {
+      const int64_t num_blocks = (frontier_size + kBlockSize - 1) / kBlockSize;
+      blocks.resize(num_blocks);
+#pragma omp parallel for schedule(dynamic, 1)
+      for (int64_t b = 0; b < num_blocks; ++b) {
+        const int64_t end = std::min(frontier_size, (b + 1) * kBlockSize);
+        for (int64_t i = b * kBlockSize; i < end; ++i) {
+          for (auto v : (graph.*neighbor_iter)(frontier[i])) {
+            if (visited.TestAndSet(v)) {
+              blocks[b].push_back(v);
+            }
+          }
+        }
+      }
+      CompactBlocks(&blocks, &next);
+      std::sort(next.begin(), next.end());
+    }
+    frontier.swap(next);
+  }
+}
+
 /*!
  * \brief Traverse the graph in a breadth-first-search (BFS) order, returning
  *        the edges of the BFS tree.
@@ -211,6 +391,81 @@ void TopologicalNodes(const Graph& graph,
   }
 }
 
+/*!
+ * \brief Traverse the graph in topological order using a parallel,
+ *        level-synchronous Kahn's algorithm.
+ *
+ * The remaining in-degree of every node is kept in an atomic counter. Each level
+ * decrements the counters of the successors of its nodes in parallel; the node whose
+ * counter drops to zero joins the next level. The per-block outputs are compacted by
+ * a prefix sum.
+ *
+ * The frontiers are the same as TopologicalNodes. Nodes of each frontier are in
+ * increasing id order, so the result is deterministic regardless of the number
+ * of threads.
+ *
+ * The frontier function must be compatible with following interface:
+ *   void (*make_frontier)(const std::vector<dgl_id_t>& frontier);
+ *
+ * \param graph The graph.
+ * \param reversed If true, follows the in-edge direction
+ * \param make_frontier The function to call with each frontier.
+ */
+template<typename FrontierFn>
+void ParallelTopologicalNodes(const Graph& graph,
+                              bool reversed,
+                              FrontierFn make_frontier) {
+  // Number of nodes handled by one output buffer.
+  const int64_t kBlockSize = 4096;
+
+  const int64_t num_nodes = graph.NumVertices();
+  const auto get_degree = reversed? &Graph::OutDegree : &Graph::InDegree;
+  const auto neighbor_iter = reversed? &Graph::PredVec : &Graph::SuccVec;
+
+  std::vector<std::atomic<uint64_t>> degrees(num_nodes);
+  std::vector<std::vector<dgl_id_t>> blocks((num_nodes + kBlockSize - 1) / kBlockSize);
+  std::vector<dgl_id_t> frontier, next;
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int64_t b = 0; b < static_cast<int64_t>(blocks.size()); ++b) {
+    const int64_t end = std::min(num_nodes, (b + 1) * kBlockSize);
+    for (int64_t v = b * kBlockSize; v < end; ++v) {
+      const uint64_t deg = (graph.*get_degree)(v);
+      degrees[v].store(deg, std::memory_order_relaxed);
+      if (deg == 0) {
+        blocks[b].push_back(v);
+      }
+    }
+  }
+  CompactBlocks(&blocks, &frontier);
+
+  int64_t num_visited_nodes = 0;
+  while (!frontier.empty()) {
+    make_frontier(frontier);
+    num_visited_nodes += frontier.size();
+
+    const int64_t frontier_size = frontier.size();
+    blocks.resize((frontier_size + kBlockSize - 1) / kBlockSize);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int64_t b = 0; b < static_cast<int64_t>(blocks.size()); ++b) {
+      const int64_t end = std::min(frontier_size, (b + 1) * kBlockSize);
+      for (int64_t i = b * kBlockSize; i < end; ++i) {
+        for (auto v : (graph.*neighbor_iter)(frontier[i])) {
+          if (degrees[v].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            blocks[b].push_back(v);
+          }
+        }
+      }
+    }
+    CompactBlocks(&blocks, &next);
+    std::sort(next.begin(), next.end());
+    frontier.swap(next);
+  }
+
+  if (num_visited_nodes != num_nodes) {
+    LOG(FATAL) << "Error in topological traversal: loop detected in the given graph.";
+  }
+}
+
 /*!\brief Tags for ``DFSEdges``. */
 enum DFSEdgeTag {
   kForward = 0,
@@ -235,6 +490,10 @@ enum DFSEdgeTag {
  * \param has_nontree_edge If true, NONTREE edges are included
  * \param visit The function to call when an edge is visited; the edge id and its
  *              tag will be given as the arguments.
+ * \param visited A buffer of NumVertices() flags, all false on entry. Only the
+ *                nodes reached from the source are set, and they are cleared
+ *                again before returning, so the buffer can be reused across
+ *                sources without an O(V) reset.
  */
 template<typename VisitFn>
 void DFSLabeledEdges(const Graph& graph,
@@ -242,7 +501,8 @@ void DFSLabeledEdges(const Graph& graph,
                      bool reversed,
                      bool has_reverse_edge,
                      bool has_nontree_edge,
-                     VisitFn visit) {
+                     VisitFn visit,
+                     std::vector<bool>* visited_buf) {
   const auto succ = reversed? &Graph::PredVec : &Graph::SuccVec;
   const auto out_edge = reversed? &Graph::InEdgeVec : &Graph::OutEdgeVec;
 
@@ -253,8 +513,10 @@ void DFSLabeledEdges(const Graph& graph,
 
   typedef std::tuple<dgl_id_t, size_t, bool> StackEntry;
   std::stack<StackEntry> stack;
-  std::vector<bool> visited(graph.NumVertices());
+  std::vector<bool>& visited = *visited_buf;
+  std::vector<dgl_id_t> reached;
   visited[source] = true;
+  reached.push_back(source);
   stack.push(std::make_tuple(source, 0, false));
   dgl_id_t u = 0;
   size_t i = 0;
@@ -277,6 +539,7 @@ void DFSLabeledEdges(const Graph& graph,
       }
     } else {
       visited[v] = true;
+      reached.push_back(v);
       std::get<2>(stack.top()) = true;
       visit(uv, kForward);
       // expand
@@ -285,6 +548,77 @@ void DFSLabeledEdges(const Graph& graph,
       }
     }
   }
+
+  for (auto v : reached) {
+    visited[v] = false;
+  }
+}
+
+/*!
+ * \brief Traverse the graph in a depth-first-search (DFS) order.
+ *
+ * Same as above, with a visited buffer allocated for this call only.
+ */
+template<typename VisitFn>
+void DFSLabeledEdges(const Graph& graph,
+                     dgl_id_t source,
+                     bool reversed,
+                     bool has_reverse_edge,
+                     bool has_nontree_edge,
+                     VisitFn visit) {
+  std::vector<bool> visited(graph.NumVertices());
+  DFSLabeledEdges(graph, source, reversed, has_reverse_edge, has_nontree_edge,
+                  visit, &visited);
+}
+
+/*!
+ * \brief Find the vertices reachable from the source in 1 to radius hops.
+ *
+ * The expansion is a BFS bounded by radius, with a bitmap marking the vertices
+ * already found. The source itself is included only if it is reachable, e.g.
+ * through a self loop. The 1-hop case skips the bitmap and deduplicates the
+ * sorted neighbor list instead.
+ *
+ * The neighbor function must return an iterable range of the neighbor ids of
+ * the given vertex, e.g.:
+ *   const std::vector<dgl_id_t>& (*neighbors)(dgl_id_t);
+ *
+ * \param num_vertices The number of vertices of the graph.
+ * \param source The source vertex.
+ * \param radius The maximum number of hops.
+ * \param neighbors The function returning the neighbors of a vertex.
+ * \return the vertices found, sorted by id.
+ */
+template<typename NeighborFn>
+std::vector<dgl_id_t> KHopNeighbors(uint64_t num_vertices,
+                                    dgl_id_t source,
+                                    uint64_t radius,
+                                    NeighborFn neighbors) {
+  std::vector<dgl_id_t> rst;
+  if (radius == 1) {
+    const auto& nbrs = neighbors(source);
+    rst.assign(nbrs.begin(), nbrs.end());
+    RadixSort(rst.data(), rst.size(), NumKeyBits(num_vertices));
+    rst.erase(std::unique(rst.begin(), rst.end()), rst.end());
+    return rst;
+  }
+  std::vector<bool> found(num_vertices, false);
+  std::vector<dgl_id_t> frontier(1, source), next;
+  for (uint64_t hop = 0; hop < radius && !frontier.empty(); ++hop) {
+    next.clear();
+    for (const dgl_id_t u : frontier) {
+      for (const dgl_id_t v : neighbors(u)) {
+        if (!found[v]) {
+          found[v] = true;
+          next.push_back(v);
+        }
+      }
+    }
+    rst.insert(rst.end(), next.begin(), next.end());
+    frontier.swap(next);
+  }
+  RadixSort(rst.data(), rst.size(), NumKeyBits(num_vertices));
+  return rst;
 }
 
 }  // namespace traverse
@@ -0,0 +1,385 @@
+/*!
+ *  Copyright (c) 2018 by Contributors
+ * \file cpu_allocator.cc
+ * \brief Size-class allocator for CPU data space and workspace.
+ */
+#include <dmlc/logging.h>
+#include <dgl/runtime/registry.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif  // __linux__
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "cpu_allocator.h"
+
+namespace dgl {
+namespace runtime {
+namespace {
+/*! \brief space reserved in front of every block for its header */
+constexpr size_t kHeaderSize = 64;
+/*! \brief log2 of the smallest size class */
+constexpr int kMinClassBits = 6;
+/*! \brief number of size classes, from 64 bytes to kMaxPooledSize */
+constexpr int kNumSizeClasses = 13;
+/*! \brief bytes moved between a thread cache and the depot at once */
+constexpr size_t kTransferBytes = 64 << 10;
+/*! \brief upper bound of blocks moved between a thread cache and the depot at once */
+constexpr size_t kMaxTransferCount = 64;
+
+static_assert((size_t(1) << (kMinClassBits + kNumSizeClasses - 1)) ==
+              CPUAllocator::kMaxPooledSize, "Size classes must end at kMaxPooledSize");
+
+/*! \brief how a block was obtained */
+enum BlockKind : int32_t {
+  kPooledBlock = 0,
+  kSystemBlock = 1,
+  kMappedBlock = 2,
+};
+
+/*! \brief header stored right before the memory returned to the user */
+struct BlockHeader {
+  /*! \brief start of the underlying allocation */
+  void* base;
+  /*! \brief length of the mapping, for mapped blocks */
+  size_t map_size;
+  /*! \brief usable bytes of the block */
+  size_t bytes;
+  /*! \brief one of BlockKind */
+  int32_t kind;
+  /*! \brief size class, for pooled blocks */
+  int32_t size_class;
+};
+static_assert(sizeof(BlockHeader) <= kHeaderSize, "Block header is too large");
+
+inline size_t ClassSize(int c) {
+  return size_t(1) << (kMinClassBits + c);
+}
+
+inline size_t BlockSize(int c) {
+  return ClassSize(c) + kHeaderSize;
+}
+
+inline int SizeClass(size_t nbytes) {
+  int c = 0;
+  while (ClassSize(c) < nbytes) {
+    ++c;
+  }
+  return c;
+}
+
+inline size_t TransferCount(int c) {
+  return std::max<size_t>(1, std::min(kMaxTransferCount, kTransferBytes / BlockSize(c)));
+}
+
+inline BlockHeader* HeaderOf(void* ptr) {
+  return reinterpret_cast<BlockHeader*>(static_cast<char*>(ptr) - kHeaderSize);
+}
+
+inline void* UserPtr(BlockHeader* header) {
+  return reinterpret_cast<char*>(header) + kHeaderSize;
+}
+
+void* SystemAlloc(size_t nbytes, size_t alignment) {
+  void* ptr;
+#if _MSC_VER || defined(__MINGW32__)
+  ptr = _aligned_malloc(nbytes, alignment);
+  if (ptr == nullptr) throw std::bad_alloc();
+#elif defined(_LIBCPP_SGX_CONFIG)
+  ptr = memalign(alignment, nbytes);
+  if (ptr == nullptr) throw std::bad_alloc();
+#else
+  int ret = posix_memalign(&ptr, alignment, nbytes);
+  if (ret != 0) throw std::bad_alloc();
+#endif
+  return ptr;
+}
+
+void SystemFree(void* ptr) {
+#if _MSC_VER || defined(__MINGW32__)
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+class ThreadCache;
+
+/*! \brief Central depot of free pooled blocks shared by all the threads. */
+class Depot {
+ public:
+  static Depot* Global() {
+    // Never destroyed, so threads exiting late can still return their blocks.
+    static Depot* inst = new Depot();
+    return inst;
+  }
+
+  // Move up to count free blocks of class c into the list, carving a new
+  // chunk if the depot has none.
+  void Fetch(int c, size_t count, std::vector<BlockHeader*>* list) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& blocks = free_[c];
+      const size_t n = std::min(count, blocks.size());
+      list->insert(list->end(), blocks.end() - n, blocks.end());
+      blocks.resize(blocks.size() - n);
+      cached_bytes_ -= n * ClassSize(c);
+      if (n > 0) {
+        return;
+      }
+    }
+    char* chunk = static_cast<char*>(SystemAlloc(count * BlockSize(c), kHeaderSize));
+    for (size_t i = 0; i < count; ++i) {
+      BlockHeader* header = reinterpret_cast<BlockHeader*>(chunk + i * BlockSize(c));
+      header->base = chunk;
+      header->map_size = 0;
+      header->bytes = ClassSize(c);
+      header->kind = kPooledBlock;
+      header->size_class = c;
+      list->push_back(header);
+    }
+  }
+
+  // Move count blocks from the back of the list into the depot.
+  void Return(int c, size_t count, std::vector<BlockHeader*>* list) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_[c].insert(free_[c].end(), list->end() - count, list->end());
+    list->resize(list->size() - count);
+    cached_bytes_ += count * ClassSize(c);
+  }
+
+  // Take back one block freed by a thread whose cache is already destroyed.
+  void ReturnOrphan(BlockHeader* header) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_[header->size_class].push_back(header);
+    cached_bytes_ += header->bytes;
+    retired_allocated_bytes_ -= header->bytes;
+  }
+
+  void Register(ThreadCache* cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    caches_.push_back(cache);
+  }
+
+  void Unregister(ThreadCache* cache, int64_t allocated_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    caches_.erase(std::find(caches_.begin(), caches_.end(), cache));
+    retired_allocated_bytes_ += allocated_bytes;
+  }
+
+  int64_t AllocatedBytes();
+
+  int64_t CachedBytes();
+
+  /*! \brief bytes of the large blocks in use */
+  std::atomic<int64_t> large_bytes{0};
+
+ private:
+  Depot() = default;
+
+  std::mutex mutex_;
+  /*! \brief free blocks per size class */
+  std::vector<BlockHeader*> free_[kNumSizeClasses];
+  /*! \brief bytes of the free blocks in the depot */
+  int64_t cached_bytes_ = 0;
+  /*! \brief live thread caches, for the statistics */
+  std::vector<ThreadCache*> caches_;
+  /*! \brief allocation balance of the threads that have exited */
+  int64_t retired_allocated_bytes_ = 0;
+};
+
+/*! \brief set once the cache of this thread is destroyed, at thread exit */
+thread_local bool tls_cache_destroyed = false;
+
+/*! \brief Per-thread cache of free pooled blocks. */
+class ThreadCache {
+ public:
+  ThreadCache() {
+    Depot::Global()->Register(this);
+  }
+
+  ~ThreadCache() {
+    Depot* depot = Depot::Global();
+    for (int c = 0; c < kNumSizeClasses; ++c) {
+      if (!free_[c].empty()) {
+        depot->Return(c, free_[c].size(), &free_[c]);
+      }
+    }
+    depot->Unregister(this, allocated_bytes.load(std::memory_order_relaxed));
+    tls_cache_destroyed = true;
+  }
+
+  void* Alloc(int c) {
+    auto& list = free_[c];
+    if (list.empty()) {
+      const size_t count = TransferCount(c);
+      Depot::Global()->Fetch(c, count, &list);
+      Add(&cached_bytes, list.size() * ClassSize(c));
+    }
+    BlockHeader* header = list.back();
+    list.pop_back();
+    Add(&cached_bytes, -static_cast<int64_t>(ClassSize(c)));
+    Add(&allocated_bytes, ClassSize(c));
+    return UserPtr(header);
+  }
+
+  void Free(BlockHeader* header) {
+    const int c = header->size_class;
+    auto& list = free_[c];
+    list.push_back(header);
+    Add(&cached_bytes, ClassSize(c));
+    Add(&allocated_bytes, -static_cast<int64_t>(ClassSize(c)));
+    // Keep at most two batches; drain the older one to the depot.
+    const size_t count = TransferCount(c);
+    if (list.size() > 2 * count) {
+      std::rotate(list.begin(), list.begin() + count, list.end());
+      Depot::Global()->Return(c, count, &list);
+      Add(&cached_bytes, -static_cast<int64_t>(count * ClassSize(c)));
+    }
+  }
+
+  /*!
+   * \brief statistics of this thread; only written by the owner thread, and
+   *  read by any thread for reporting.
+   */
+  std::atomic<int64_t> allocated_bytes{0}, cached_bytes{0};
+
+ private:
+  static void Add(std::atomic<int64_t>* counter, int64_t delta) {
+    counter->store(counter->load(std::memory_order_relaxed) + delta,
+                   std::memory_order_relaxed);
+  }
+
+  std::vector<BlockHeader*> free_[kNumSizeClasses];
+};
+
+// Return the cache of the calling thread, or null if the thread is exiting.
+ThreadCache* LocalCache() {
+  if (tls_cache_destroyed) {
+    return nullptr;
+  }
+  static thread_local ThreadCache cache;
+  return &cache;
+}
+
+int64_t Depot::AllocatedBytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t total = retired_allocated_bytes_ + large_bytes.load(std::memory_order_relaxed);
+  for (ThreadCache* cache : caches_) {
+    total += cache->allocated_bytes.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+int64_t Depot::CachedBytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t total = cached_bytes_;
+  for (ThreadCache* cache : caches_) {
+    total += cache->cached_bytes.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void* LargeAlloc(size_t nbytes, size_t alignment) {
+  const size_t offset = std::max(alignment, kHeaderSize);
+  BlockHeader* header = nullptr;
+#ifdef __linux__
+  if (nbytes >= CPUAllocator::kHugePageSize) {
+    const size_t huge = CPUAllocator::kHugePageSize;
+    const size_t size = (nbytes + offset + huge - 1) / huge * huge;
+    // Over-map by one huge page and trim, so the block is huge page aligned.
+    void* raw = mmap(nullptr, size + huge, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) throw std::bad_alloc();
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t base = (addr + huge - 1) / huge * huge;
+    if (base > addr) {
+      munmap(raw, base - addr);
+    }
+    munmap(reinterpret_cast<void*>(base + size), addr + huge - base);
+#ifdef MADV_HUGEPAGE
+    madvise(reinterpret_cast<void*>(base), size, MADV_HUGEPAGE);
+#endif  // MADV_HUGEPAGE
+    header = reinterpret_cast<BlockHeader*>(base + offset - kHeaderSize);
+    header->base = reinterpret_cast<void*>(base);
+    header->map_size = size;
+    header->kind = kMappedBlock;
+  }
+#endif  // __linux__
+  if (header == nullptr) {
+    char* raw = static_cast<char*>(SystemAlloc(nbytes + offset, offset));
+    header = reinterpret_cast<BlockHeader*>(raw + offset - kHeaderSize);
+    header->base = raw;
+    header->map_size = 0;
+    header->kind = kSystemBlock;
+  }
+  header->bytes = nbytes;
+  header->size_class = -1;
+  Depot::Global()->large_bytes.fetch_add(nbytes, std::memory_order_relaxed);
+  return UserPtr(header);
+}
+
+void LargeFree(BlockHeader* header) {
+  Depot::Global()->large_bytes.fetch_sub(header->bytes, std::memory_order_relaxed);
+  if (header->kind == kSystemBlock) {
+    SystemFree(header->base);
+  } else {
+#ifdef __linux__
+    munmap(header->base, header->map_size);
+#endif  // __linux__
+  }
+}
+}  // namespace
+
+void* CPUAllocator::Alloc(size_t nbytes, size_t alignment) {
+  CHECK(alignment > 0 && (alignment & (alignment - 1)) == 0 && alignment <= kHugePageSize)
+    << "Invalid alignment: " << alignment;
+  if (alignment <= kHeaderSize && nbytes <= kMaxPooledSize) {
+    ThreadCache* cache = LocalCache();
+    if (cache != nullptr) {
+      return cache->Alloc(SizeClass(nbytes));
+    }
+  }
+  return LargeAlloc(nbytes, alignment);
+}
+
+void CPUAllocator::Free(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+  BlockHeader* header = HeaderOf(ptr);
+  if (header->kind != kPooledBlock) {
+    LargeFree(header);
+    return;
+  }
+  ThreadCache* cache = LocalCache();
+  if (cache != nullptr) {
+    cache->Free(header);
+  } else {
+    Depot::Global()->ReturnOrphan(header);
+  }
+}
+
+int64_t CPUAllocator::AllocatedBytes() {
+  return Depot::Global()->AllocatedBytes();
+}
+
+int64_t CPUAllocator::CachedBytes() {
+  return Depot::Global()->CachedBytes();
+}
+
+DGL_REGISTER_GLOBAL("runtime.cpu_allocator_allocated_bytes")
+.set_body([](DGLArgs args, DGLRetValue* rv) {
+    *rv = CPUAllocator::AllocatedBytes();
+  });
+
+DGL_REGISTER_GLOBAL("runtime.cpu_allocator_cached_bytes")
+.set_body([](DGLArgs args, DGLRetValue* rv) {
+    *rv = CPUAllocator::CachedBytes();
+  });
+
+}  // namespace runtime
+}  // namespace dgl
@@ -0,0 +1,61 @@
+/*!
+ *  Copyright (c) 2018 by Contributors
+ * \file cpu_allocator.h
+ * \brief Size-class allocator for CPU data space and workspace.
+ */
+#ifndef DGL_RUNTIME_CPU_ALLOCATOR_H_
+#define DGL_RUNTIME_CPU_ALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dgl {
+namespace runtime {
+/*!
+ * \brief Allocator of CPU memory with size classes, per-thread caches and a
+ *  central depot.
+ *
+ *  Requests up to kMaxPooledSize bytes are rounded up to a power-of-two size
+ *  class. Every thread keeps a small cache of free blocks per class, refilled
+ *  from and drained to a central depot in batches, so the steady-state
+ *  allocation of small arrays takes no lock and never reaches the system
+ *  allocator. The depot carves new blocks out of larger chunks and never
+ *  returns them to the system.
+ *
+ *  Larger requests go to the system. From kHugePageSize up, they are mapped
+ *  directly, aligned to the huge page size, and advised to use transparent
+ *  huge pages.
+ *
+ *  Blocks may be freed by any thread.
+ */
+class CPUAllocator {
+ public:
+  /*! \brief largest request served from the size classes */
+  static constexpr size_t kMaxPooledSize = 256 << 10;
+  /*! \brief smallest request mapped with huge pages */
+  static constexpr size_t kHugePageSize = 2 << 20;
+
+  /*!
+   * \brief Allocate memory.
+   * \param nbytes The number of bytes.
+   * \param alignment The alignment; must be a power of two dividing kHugePageSize.
+   * \return the allocated memory
+   */
+  static void* Alloc(size_t nbytes, size_t alignment);
+
+  /*!
+   * \brief Free memory allocated by Alloc.
+   * \param ptr The pointer to be freed; may be null.
+   */
+  static void Free(void* ptr);
+
+  /*! \return the number of bytes handed out and not freed yet */
+  static int64_t AllocatedBytes();
+
+  /*! \return the number of bytes held in the thread caches and the depot */
+  static int64_t CachedBytes();
+};
+
+}  // namespace runtime
+}  // namespace dgl
+#endif  // DGL_RUNTIME_CPU_ALLOCATOR_H_
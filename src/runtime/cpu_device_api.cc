@@ -8,6 +8,7 @@
 #include <dgl/runtime/device_api.h>
 #include <cstdlib>
 #include <cstring>
+#include "cpu_allocator.h"
 #include "workspace_pool.h"
 
 namespace dgl {
@@ -24,26 +25,11 @@ class CPUDeviceAPI final : public DeviceAPI {
                        size_t nbytes,
                        size_t alignment,
                        DGLType type_hint) final {
-    void* ptr;
-#if _MSC_VER || defined(__MINGW32__)
-    ptr = _aligned_malloc(nbytes, alignment);
-    if (ptr == nullptr) throw std::bad_alloc();
-#elif defined(_LIBCPP_SGX_CONFIG)
-    ptr = memalign(alignment, nbytes);
-    if (ptr == nullptr) throw std::bad_alloc();
-#else
-    int ret = posix_memalign(&ptr, alignment, nbytes);
-    if (ret != 0) throw std::bad_alloc();
-#endif
-    return ptr;
+    return CPUAllocator::Alloc(nbytes, alignment);
   }
 
   void FreeDataSpace(DGLContext ctx, void* ptr) final {
-#if _MSC_VER || defined(__MINGW32__)
-    _aligned_free(ptr);
-#else
-    free(ptr);
-#endif
+    CPUAllocator::Free(ptr);
   }
 
   void CopyDataFromTo(const void* from,
@@ -73,6 +59,10 @@ class CPUDeviceAPI final : public DeviceAPI {
   }
 };
 
+// Workspaces are kept in a per-thread pool and reused, since the same sizes
+// are requested over and over. Going to CPUAllocator every time would map and
+// unmap the workspaces of 2MB and more on each call, and send those between
+// the size classes and the huge pages to malloc.
 struct CPUWorkspacePool : public WorkspacePool {
   CPUWorkspacePool() :
       WorkspacePool(kDLCPU, CPUDeviceAPI::Global()) {}
@@ -52,6 +52,8 @@ void InitContextFunctions(FLookup flookup) {
   DGL_INIT_CONTEXT_FUNC(DGLBackendAllocWorkspace);
   DGL_INIT_CONTEXT_FUNC(DGLBackendFreeWorkspace);
   DGL_INIT_CONTEXT_FUNC(DGLBackendParallelLaunch);
+  DGL_INIT_CONTEXT_FUNC(DGLBackendParallelFor);
+  DGL_INIT_CONTEXT_FUNC(DGLBackendParallelFirstTouch);
   DGL_INIT_CONTEXT_FUNC(DGLBackendParallelBarrier);
 
   #undef DGL_INIT_CONTEXT_FUNC
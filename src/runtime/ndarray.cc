@@ -7,6 +7,8 @@
 #include <dgl/runtime/ndarray.h>
 #include <dgl/runtime/c_runtime_api.h>
 #include <dgl/runtime/device_api.h>
+#include <algorithm>
+#include <cstring>
 #include "runtime_base.h"
 
 // deleter for arrays used by DLPack exporter
@@ -15,6 +17,11 @@ extern "C" void NDArrayDLPackDeleter(DLManagedTensor* tensor);
 namespace dgl {
 namespace runtime {
 
+/*! \brief CPU arrays from this size up are first touched in parallel by Empty */
+constexpr size_t kFirstTouchBytes = 64 << 20;
+/*! \brief Granularity of the first touch */
+constexpr size_t kPageBytes = 4096;
+
 inline void VerifyDataType(DLDataType dtype) {
   CHECK_GE(dtype.lanes, 1);
   if (dtype.code == kDLFloat) {
@@ -145,6 +152,20 @@ NDArray NDArray::Empty(std::vector<int64_t> shape,
   ret.data_->dl_tensor.data =
       DeviceAPI::Get(ret->ctx)->AllocDataSpace(
           ret->ctx, size, alignment, ret->dtype);
+  // Place the pages of large CPU arrays on the NUMA nodes of the OpenMP
+  // threads that will process them in parallel loops. The touch runs on the
+  // OpenMP team the kernels use, not on the runtime thread pool: that pool is
+  // created per calling thread, and its workers are not the ones that later
+  // read the array.
+  if (ctx.device_type == kDLCPU && size >= kFirstTouchBytes) {
+    char* data = static_cast<char*>(ret.data_->dl_tensor.data);
+    const int64_t num_pages = (size + kPageBytes - 1) / kPageBytes;
+#pragma omp parallel for schedule(static)
+    for (int64_t p = 0; p < num_pages; ++p) {
+      const size_t offset = p * kPageBytes;
+      memset(data + offset, 0, std::min(kPageBytes, size - offset));
+    }
+  }
   return ret;
 }
 
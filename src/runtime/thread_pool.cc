@@ -19,6 +19,7 @@
 #include <string>
 #include <cstring>
 #include <memory>
+#include <new>
 #include <sstream>
 
 const constexpr int kL1CacheBytes = 64;
@@ -118,6 +119,84 @@ class ParallelLauncher {
   std::vector<std::string> par_errors_;
 };
 
+/*!
+ * \brief Shared state of one parallel loop with dynamic scheduling.
+ *
+ *  Every task owns one part of the range and a cursor into it. A task takes
+ *  chunks from its own part first, then from the parts of the other tasks,
+ *  by advancing their cursors.
+ */
+class ParallelForState {
+ public:
+  ParallelForState(int64_t begin, int64_t end, int64_t grain_size,
+                   FDGLParallelForLambda flambda, void* cdata,
+                   int num_task, const std::vector<int>& task_nodes)
+      : flambda_(flambda), cdata_(cdata), grain_size_(grain_size),
+        parts_storage_(new char[(num_task + 1) * sizeof(Part)]), victims_(num_task) {
+    // new[] does not honor the alignment of Part before C++17; align by hand.
+    void* storage = parts_storage_.get();
+    size_t space = (num_task + 1) * sizeof(Part);
+    parts_ = static_cast<Part*>(
+        std::align(alignof(Part), num_task * sizeof(Part), storage, space));
+    for (int i = 0; i < num_task; ++i) {
+      new (parts_ + i) Part();
+    }
+    const int64_t len = end - begin;
+    for (int i = 0; i < num_task; ++i) {
+      parts_[i].next.store(begin + len * i / num_task, std::memory_order_relaxed);
+      parts_[i].end = begin + len * (i + 1) / num_task;
+    }
+    // Steal from the tasks on the same NUMA node first.
+    for (int i = 0; i < num_task; ++i) {
+      for (int same_node = 1; same_node >= 0; --same_node) {
+        for (int k = 1; k < num_task; ++k) {
+          const int j = (i + k) % num_task;
+          if ((task_nodes[j] == task_nodes[i]) == (same_node == 1)) {
+            victims_[i].push_back(j);
+          }
+        }
+      }
+    }
+  }
+
+  // Entry of every task, compatible with FDGLParallelLambda.
+  static int Run(int task_id, DGLParallelGroupEnv* penv, void* cdata) {
+    ParallelForState* state = static_cast<ParallelForState*>(cdata);
+    if (state->RunPart(task_id) != 0) return -1;
+    for (int victim : state->victims_[task_id]) {
+      if (state->RunPart(victim) != 0) return -1;
+    }
+    return 0;
+  }
+
+ private:
+  /*! \brief remaining part of one task, on a cache line of its own */
+  struct alignas(kL1CacheBytes) Part {
+    std::atomic<int64_t> next;
+    int64_t end;
+  };
+  static_assert(sizeof(Part) == kL1CacheBytes, "Part must fill one cache line");
+
+  int RunPart(int part_id) {
+    Part& part = parts_[part_id];
+    while (true) {
+      const int64_t chunk_begin = part.next.fetch_add(grain_size_);
+      if (chunk_begin >= part.end) return 0;
+      const int64_t chunk_end = std::min(chunk_begin + grain_size_, part.end);
+      if ((*flambda_)(chunk_begin, chunk_end, cdata_) != 0) return -1;
+    }
+  }
+
+  FDGLParallelForLambda flambda_;
+  void* cdata_;
+  int64_t grain_size_;
+  // raw storage of the parts, with room for aligning them
+  std::unique_ptr<char[]> parts_storage_;
+  Part* parts_;
+  // tasks to steal from, in order
+  std::vector<std::vector<int> > victims_;
+};
+
 /*! \brief Lock-free single-producer-single-consumer queue for each thread */
 class SpscTaskQueue {
  public:
@@ -296,6 +375,62 @@ class ThreadPool {
     return res;
   }
 
+  int ParallelFor(int64_t begin,
+                  int64_t end,
+                  int64_t grain_size,
+                  FDGLParallelForLambda flambda,
+                  void* cdata) {
+    if (begin >= end) return 0;
+    const int num_task = num_workers_used_;
+    const int64_t len = end - begin;
+    if (grain_size <= 0) {
+      grain_size = std::max<int64_t>(1, len / (num_task * kChunksPerTask));
+    }
+    // Nested loops and loops of a single chunk run on the calling thread.
+    if (ParallelLauncher::ThreadLocal()->is_worker || num_task == 1 || len <= grain_size) {
+      return (*flambda)(begin, end, cdata);
+    }
+    std::vector<int> task_nodes(num_task);
+    for (int i = 0; i < num_task; ++i) {
+      task_nodes[i] = threads_->WorkerNumaNode(i);
+    }
+    ParallelForState state(begin, end, grain_size, flambda, cdata, num_task, task_nodes);
+    return Launch(&ParallelForState::Run, &state, num_task, 0);
+  }
+
+  int FirstTouch(void* data, uint64_t nbytes) {
+    struct Buffer {
+      char* data;
+      uint64_t num_pages;
+    } buffer{static_cast<char*>(data), (nbytes + kPageBytes - 1) / kPageBytes};
+    const uint64_t total = nbytes;
+    auto touch = [] (int task_id, DGLParallelGroupEnv* penv, void* cdata) {
+      Buffer* buf = static_cast<Buffer*>(cdata);
+      const uint64_t first = buf->num_pages * task_id / penv->num_task;
+      const uint64_t last = buf->num_pages * (task_id + 1) / penv->num_task;
+      if (last > first) {
+        memset(buf->data + first * kPageBytes, 0, (last - first) * kPageBytes);
+      }
+      return 0;
+    };
+    if (nbytes == 0) return 0;
+    // Inside a worker, or without other workers, touch on the calling thread.
+    if (ParallelLauncher::ThreadLocal()->is_worker || num_workers_used_ == 1) {
+      memset(data, 0, nbytes);
+      return 0;
+    }
+    // The last page may be partial; touch it separately after the others.
+    const uint64_t tail = total % kPageBytes;
+    if (tail != 0) {
+      --buffer.num_pages;
+    }
+    const int res = Launch(touch, &buffer, num_workers_used_, 0);
+    if (tail != 0) {
+      memset(buffer.data + buffer.num_pages * kPageBytes, 0, tail);
+    }
+    return res;
+  }
+
   static ThreadPool* ThreadLocal() {
     return dmlc::ThreadLocalStore<ThreadPool>::Get();
   }
@@ -327,6 +462,10 @@ class ThreadPool {
       }
     }
   }
+  // number of chunks per task when the grain size is picked automatically
+  static constexpr int64_t kChunksPerTask = 16;
+  // granularity of the first touch
+  static constexpr uint64_t kPageBytes = 4 << 10;
   int num_workers_;
   // number of workers used (can be restricted with affinity pref)
   int num_workers_used_;
@@ -363,6 +502,20 @@ int DGLBackendParallelLaunch(
   return res;
 }
 
+int DGLBackendParallelFor(
+    int64_t begin,
+    int64_t end,
+    int64_t grain_size,
+    FDGLParallelForLambda flambda,
+    void* cdata) {
+  return dgl::runtime::ThreadPool::ThreadLocal()->ParallelFor(
+      begin, end, grain_size, flambda, cdata);
+}
+
+int DGLBackendParallelFirstTouch(void* data, uint64_t nbytes) {
+  return dgl::runtime::ThreadPool::ThreadLocal()->FirstTouch(data, nbytes);
+}
+
 int DGLBackendParallelBarrier(int task_id, DGLParallelGroupEnv* penv) {
   using dgl::runtime::kSyncStride;
   int num_task = penv->num_task;
@@ -7,11 +7,14 @@
 #include <dmlc/logging.h>
 #include <thread>
 #include <algorithm>
+#include <cstdio>
+#include <sstream>
 #if defined(__linux__) || defined(__ANDROID__)
 #include <fstream>
 #else
 #endif
 #if defined(__linux__)
+#include <dirent.h>
 #include <sched.h>
 #endif
 
@@ -31,6 +34,8 @@ class ThreadGroup::Impl {
       threads_.emplace_back([worker_callback, i] { worker_callback(i); });
     }
     InitSortedOrder();
+    InitNumaNodes();
+    worker_nodes_.assign(num_workers_, 0);
   }
   ~Impl() { Join(); }
 
@@ -63,7 +68,9 @@ class ThreadGroup::Impl {
     const char *val = getenv("DGL_BIND_THREADS");
     if (val == nullptr || atoi(val) == 1) {
       // Do not set affinity if there are more workers than found cores
-      if (sorted_order_.size() >= static_cast<unsigned int>(num_workers_)) {
+      if (mode == kNuma) {
+        SetNumaAffinity(exclude_worker0);
+      } else if (sorted_order_.size() >= static_cast<unsigned int>(num_workers_)) {
           SetAffinity(exclude_worker0, mode == kLittle);
       } else {
         LOG(WARNING)
@@ -74,6 +81,14 @@ class ThreadGroup::Impl {
     return num_workers_used;
   }
 
+  int NumNumaNodes() const {
+    return num_nodes_;
+  }
+
+  int WorkerNumaNode(int worker_id) const {
+    return worker_nodes_[worker_id];
+  }
+
  private:
   // bind worker threads to disjoint cores
   // if worker 0 is offloaded to master, i.e. exclude_worker0 is true,
@@ -103,6 +118,9 @@ class ThreadGroup::Impl {
       } else {
         core_id = sorted_order_[i + exclude_worker0];
       }
+      if (core_id < cpu_nodes_.size()) {
+        worker_nodes_[i + exclude_worker0] = cpu_nodes_[core_id];
+      }
       cpu_set_t cpuset;
       CPU_ZERO(&cpuset);
       CPU_SET(core_id, &cpuset);
@@ -132,6 +150,60 @@ class ThreadGroup::Impl {
 #endif
   }
 
+  // Bind worker i to all the cores of NUMA node i % num_nodes, so the workers
+  // are spread evenly over the nodes and the OS may still move them within one.
+  void SetNumaAffinity(bool exclude_worker0) {
+    const int num_nodes = NumNumaNodes();
+    for (int i = 0; i < num_workers_; ++i) {
+      worker_nodes_[i] = i % num_nodes;
+    }
+#if defined(__linux__)
+    auto bind = [this] (pthread_t thread, int node) {
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      for (size_t cpu = 0; cpu < cpu_nodes_.size(); ++cpu) {
+        if (cpu_nodes_[cpu] == node) {
+          CPU_SET(cpu, &cpuset);
+        }
+      }
+      pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuset);
+    };
+    for (unsigned i = 0; i < threads_.size(); ++i) {
+      bind(threads_[i].native_handle(), worker_nodes_[i + exclude_worker0]);
+    }
+    if (exclude_worker0) {
+      bind(pthread_self(), worker_nodes_[0]);
+    }
+#endif
+  }
+
+  // Read the NUMA node of every cpu from sysfs; all cpus are on node 0 if the
+  // topology is not available.
+  void InitNumaNodes() {
+    const unsigned int threads = std::thread::hardware_concurrency();
+    cpu_nodes_.assign(threads, 0);
+    num_nodes_ = 1;
+#if defined(__linux__)
+    for (unsigned int i = 0; i < threads; ++i) {
+      std::ostringstream dirpath;
+      dirpath << "/sys/devices/system/cpu/cpu" << i;
+      DIR* dir = opendir(dirpath.str().c_str());
+      if (dir == nullptr) {
+        continue;
+      }
+      while (struct dirent* entry = readdir(dir)) {
+        int node;
+        if (sscanf(entry->d_name, "node%d", &node) == 1) {
+          cpu_nodes_[i] = node;
+          num_nodes_ = std::max(num_nodes_, node + 1);
+          break;
+        }
+      }
+      closedir(dir);
+    }
+#endif
+  }
+
   void InitSortedOrder() {
     unsigned int threads = std::thread::hardware_concurrency();
     std::vector<std::pair <unsigned int, int64_t> > max_freqs;
@@ -178,6 +250,11 @@ class ThreadGroup::Impl {
   std::vector<unsigned int> sorted_order_;
   int big_count_ = 0;
   int little_count_ = 0;
+  // NUMA node of every cpu
+  std::vector<int> cpu_nodes_;
+  // NUMA node of every worker
+  std::vector<int> worker_nodes_;
+  int num_nodes_ = 1;
 };
 
 ThreadGroup::ThreadGroup(int num_workers,
@@ -186,6 +263,10 @@ ThreadGroup::ThreadGroup(int num_workers,
   : impl_(new ThreadGroup::Impl(num_workers, worker_callback, exclude_worker0)) {}
 ThreadGroup::~ThreadGroup() { delete impl_; }
 void ThreadGroup::Join() { impl_->Join(); }
+int ThreadGroup::NumNumaNodes() const { return impl_->NumNumaNodes(); }
+int ThreadGroup::WorkerNumaNode(int worker_id) const {
+  return impl_->WorkerNumaNode(worker_id);
+}
 
 int ThreadGroup::Configure(AffinityMode mode, int nthreads, bool exclude_worker0) {
   return impl_->Configure(mode, nthreads, exclude_worker0);
@@ -0,0 +1,49 @@
+"""Benchmark batching and unbatching many small graphs.
+
+Usage: python bench_batching.py [--num-graphs N] [--num-nodes V] [--num-edges E]
+"""
+import argparse
+import time
+
+import numpy as np
+import dgl.graph_index as gi
+import dgl.utils as utils
+
+def random_graph(rng, num_nodes, num_edges):
+    g = gi.create_graph_index(multigraph=True)
+    g.add_nodes(num_nodes)
+    src = utils.toindex(rng.randint(0, num_nodes, num_edges))
+    dst = utils.toindex(rng.randint(0, num_nodes, num_edges))
+    g.add_edges(src, dst)
+    return g
+
+def timeit(fn, repeat):
+    fn()  # warm up
+    tic = time.time()
+    for _ in range(repeat):
+        rst = fn()
+    return (time.time() - tic) / repeat, rst
+
+def main(args):
+    rng = np.random.RandomState(0)
+    graphs = [random_graph(rng, args.num_nodes, args.num_edges)
+              for _ in range(args.num_graphs)]
+    sizes = utils.toindex([g.number_of_nodes() for g in graphs])
+
+    t_union, bg = timeit(lambda: gi.disjoint_union(graphs), args.repeat)
+    t_part, parts = timeit(lambda: gi.disjoint_partition(bg, sizes), args.repeat)
+    assert len(parts) == args.num_graphs
+    assert bg.number_of_edges() == args.num_graphs * args.num_edges
+
+    print('#graphs={} #nodes/graph={} #edges/graph={}'.format(
+        args.num_graphs, args.num_nodes, args.num_edges))
+    print('disjoint_union:     {:.3f} ms'.format(t_union * 1000))
+    print('disjoint_partition: {:.3f} ms'.format(t_part * 1000))
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Batching benchmark')
+    parser.add_argument('--num-graphs', type=int, default=1000)
+    parser.add_argument('--num-nodes', type=int, default=30)
+    parser.add_argument('--num-edges', type=int, default=100)
+    parser.add_argument('--repeat', type=int, default=10)
+    main(parser.parse_args())
@@ -0,0 +1,63 @@
+"""Benchmark the per-query overhead of scalar graph queries.
+
+Compares calling the scalar C APIs one by one from Python with running the
+same queries through GraphIndex.batch_query.
+
+Usage: python bench_query_dispatch.py [--num-nodes V] [--num-edges E] [--num-queries Q]
+"""
+import argparse
+import time
+
+import numpy as np
+import dgl.graph_index as gi
+import dgl.utils as utils
+
+def timeit(fn, repeat):
+    fn()  # warm up
+    tic = time.time()
+    for _ in range(repeat):
+        rst = fn()
+    return (time.time() - tic) / repeat, rst
+
+def main(args):
+    rng = np.random.RandomState(0)
+    g = gi.create_graph_index(multigraph=True)
+    g.add_nodes(args.num_nodes)
+    g.add_edges(utils.toindex(rng.randint(0, args.num_nodes, args.num_edges)),
+                utils.toindex(rng.randint(0, args.num_nodes, args.num_edges)))
+
+    nq = args.num_queries
+    u = rng.randint(0, args.num_nodes, nq)
+    v = rng.randint(0, args.num_nodes, nq)
+    ops = rng.choice([gi.QUERY_HAS_NODE, gi.QUERY_IN_DEGREE, gi.QUERY_OUT_DEGREE,
+                      gi.QUERY_HAS_EDGE_BETWEEN], nq)
+    scalar_fns = {
+        gi.QUERY_HAS_NODE: lambda a, b: int(g.has_node(a)),
+        gi.QUERY_IN_DEGREE: lambda a, b: g.in_degree(a),
+        gi.QUERY_OUT_DEGREE: lambda a, b: g.out_degree(a),
+        gi.QUERY_HAS_EDGE_BETWEEN: lambda a, b: int(g.has_edge_between(a, b)),
+    }
+
+    def run_scalar():
+        return [scalar_fns[op](int(a), int(b)) for op, a, b in zip(ops, u, v)]
+
+    ops_idx, u_idx, v_idx = utils.toindex(ops), utils.toindex(u), utils.toindex(v)
+    out = np.empty(nq, dtype=np.int64)
+    def run_batch():
+        return g.batch_query(ops_idx, u_idx, v_idx, out)
+
+    t_scalar, rst_scalar = timeit(run_scalar, args.repeat)
+    t_batch, rst_batch = timeit(run_batch, args.repeat)
+    assert list(rst_batch.tonumpy()) == rst_scalar
+
+    print('#nodes={} #edges={} #queries={}'.format(args.num_nodes, args.num_edges, nq))
+    print('scalar calls: {:.3f} us/query'.format(t_scalar / nq * 1e6))
+    print('batch_query:  {:.3f} us/query'.format(t_batch / nq * 1e6))
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description='Query dispatch benchmark')
+    parser.add_argument('--num-nodes', type=int, default=10000)
+    parser.add_argument('--num-edges', type=int, default=100000)
+    parser.add_argument('--num-queries', type=int, default=100000)
+    parser.add_argument('--repeat', type=int, default=3)
+    main(parser.parse_args())
@@ -1,7 +1,11 @@
 from dgl import DGLError
 from dgl.utils import toindex
-from dgl.graph_index import create_graph_index
+from dgl.graph_index import create_graph_index, load_graph_index
+import dgl.graph_index as gidx
 import networkx as nx
+import numpy as np
+import os
+import tempfile
 
 def test_edge_id():
     gi = create_graph_index(multigraph=False)
@@ -139,6 +143,38 @@ def test_predsucc():
     assert 2 in succ
     assert 0 in succ
 
+def test_khop_predsucc():
+    # chain 0 -> 1 -> 2 -> 3 -> 4 plus a self loop on 4
+    gi = create_graph_index()
+    gi.add_nodes(5)
+    gi.add_edges(toindex([0, 1, 2, 3, 4]), toindex([1, 2, 3, 4, 4]))
+
+    for g in [gi, _load_csr(gi)]:
+        assert list(g.successors(0, 1).tonumpy()) == [1]
+        assert list(g.successors(0, 2).tonumpy()) == [1, 2]
+        assert list(g.successors(1, 3).tonumpy()) == [2, 3, 4]
+        assert list(g.successors(3, 5).tonumpy()) == [4]
+        assert list(g.predecessors(4, 2).tonumpy()) == [2, 3, 4]
+        assert list(g.predecessors(0, 3).tonumpy()) == []
+
+def test_reverse():
+    gi = create_graph_index(multigraph=True)
+    gi.add_nodes(4)
+    gi.add_edges(toindex([0, 0, 1, 2, 2]), toindex([1, 1, 2, 3, 0]))
+    rgi = gi.reverse()
+    assert rgi.number_of_nodes() == 4
+    assert rgi.number_of_edges() == 5
+    src, dst, eid = gi.edges()
+    rsrc, rdst, reid = rgi.edges()
+    assert list(rsrc.tonumpy()) == list(dst.tonumpy())
+    assert list(rdst.tonumpy()) == list(src.tonumpy())
+    assert list(reid.tonumpy()) == list(eid.tonumpy())
+    # mutating one graph does not affect the other
+    gi.add_edge(3, 0)
+    assert rgi.number_of_edges() == 5
+    assert not rgi.has_edge_between(0, 3)
+    assert rgi.has_edge_between(1, 0)
+
 def test_create_from_elist():
     elist = [(2, 1), (1, 0), (2, 0), (3, 0), (0, 2)]
     g = create_graph_index(elist)
@@ -150,8 +186,200 @@ def test_create_from_elist():
         print(u, v, g.edge_id(u, v)[0])
         assert g.edge_id(u, v)[0] == i
 
+def test_save_load():
+    gi = create_graph_index(multigraph=True)
+    gi.add_nodes(5)
+    gi.add_edges(toindex([0, 0, 2, 3, 0, 4]), toindex([1, 1, 0, 2, 2, 4]))
+    fd, path = tempfile.mkstemp()
+    os.close(fd)
+    try:
+        gi.save(path)
+        gi2 = load_graph_index(path, verify=True)
+        gi3 = load_graph_index(path, readonly=False)
+    finally:
+        os.remove(path)
+    src, dst, eid = gi.edges()
+    order = np.argsort(eid.tonumpy())
+
+    # read-only index over the mapped arrays
+    assert gi2.is_readonly()
+    assert gi2.is_multigraph()
+    assert gi2.number_of_nodes() == 5
+    assert gi2.number_of_edges() == 6
+    src2, dst2, eid2 = gi2.edges()
+    order2 = np.argsort(eid2.tonumpy())
+    assert np.array_equal(src.tonumpy()[order], src2.tonumpy()[order2])
+    assert np.array_equal(dst.tonumpy()[order], dst2.tonumpy()[order2])
+    assert list(gi2.edge_id(0, 1).tonumpy()) == [0, 1]
+    assert gi2.has_edge_between(3, 2) and not gi2.has_edge_between(2, 3)
+    assert list(gi2.in_degrees(toindex([0, 1, 2, 4])).tonumpy()) == [1, 2, 2, 1]
+    assert list(gi2.out_degrees(toindex([0, 1, 2, 4])).tonumpy()) == [3, 0, 1, 1]
+    _, _, in_eid = gi2.in_edges(toindex([2]))
+    assert sorted(in_eid.tonumpy()) == [3, 4]
+    rgi = gi2.reverse()
+    assert rgi.out_degree(2) == 2 and rgi.in_degree(0) == 3
+    try:
+        gi2.add_nodes(1)
+        assert False
+    except RuntimeError:
+        pass
+    # the edge arrays are copies, writing them leaves the mapped file alone
+    dst_nd = gidx._CAPI_DGLImmutableGraphEdges(gi2._handle)(1)
+    dst_nd.copyfrom(np.zeros(6, dtype=np.int64))
+    assert list(gi2.edge_id(0, 1).tonumpy()) == [0, 1]
+    assert list(gi2.in_degrees(toindex([0, 1, 2, 4])).tonumpy()) == [1, 2, 2, 1]
+
+    # mutable copies
+    for g in [gi3, gi2.to_mutable()]:
+        assert not g.is_readonly()
+        src3, dst3, eid3 = g.edges()
+        assert np.array_equal(src.tonumpy(), src3.tonumpy())
+        assert np.array_equal(dst.tonumpy(), dst3.tonumpy())
+        assert np.array_equal(eid.tonumpy(), eid3.tonumpy())
+        g.add_nodes(1)
+        assert g.number_of_nodes() == 6
+
+def test_load_corrupt_header():
+    gi = create_graph_index()
+    gi.add_nodes(3)
+    gi.add_edges(toindex([0, 1]), toindex([1, 2]))
+    fd, path = tempfile.mkstemp()
+    os.close(fd)
+    try:
+        gi.save(path)
+        with open(path, 'rb') as f:
+            data = bytearray(f.read())
+        # num_vertices and num_edges follow magic, version and flags
+        for offset, value in [(16, 1 << 62), (16, 1 << 20), (24, 1 << 62), (24, 3)]:
+            corrupt = bytearray(data)
+            corrupt[offset:offset + 8] = np.array([value], dtype=np.uint64).tobytes()
+            with open(path, 'wb') as f:
+                f.write(corrupt)
+            try:
+                load_graph_index(path)
+                fail = False
+            except DGLError:
+                fail = True
+            assert fail
+    finally:
+        os.remove(path)
+
+def _load_csr(gi):
+    fd, path = tempfile.mkstemp()
+    os.close(fd)
+    try:
+        gi.save(path)
+        return load_graph_index(path)
+    finally:
+        os.remove(path)
+
+def test_csr_disjoint_union_partition():
+    g1 = create_graph_index()
+    g1.add_nodes(3)
+    g1.add_edges(toindex([0, 1, 2]), toindex([1, 2, 0]))
+    g2 = create_graph_index()
+    g2.add_nodes(2)
+    g2.add_edges(toindex([1, 0]), toindex([0, 0]))
+    c1, c2 = _load_csr(g1), _load_csr(g2)
+    union = gidx.disjoint_union([c1, c2])
+    ref = gidx.disjoint_union([g1, g2])
+    assert union.is_readonly()
+    assert union.number_of_nodes() == 5
+    assert union.number_of_edges() == 5
+    for u in range(5):
+        for v in range(5):
+            assert union.has_edge_between(u, v) == ref.has_edge_between(u, v)
+    parts = gidx.disjoint_partition(union, toindex([3, 2]))
+    assert len(parts) == 2
+    for part, orig in zip(parts, [g1, g2]):
+        assert part.is_readonly()
+        assert part.number_of_nodes() == orig.number_of_nodes()
+        assert part.number_of_edges() == orig.number_of_edges()
+        src, dst, _ = orig.edges()
+        assert all(part.has_edge_between(u, v)
+                   for u, v in zip(src.tonumpy(), dst.tonumpy()))
+    parts = gidx.disjoint_partition(_load_csr(ref), 1)
+    assert len(parts) == 1 and parts[0].number_of_edges() == 5
+    # mixed inputs fall back to a mutable union
+    mixed = gidx.disjoint_union([c1, g2])
+    assert not mixed.is_readonly() and mixed.number_of_edges() == 5
+
+def test_csr_line_graph():
+    gi = create_graph_index()
+    gi.add_nodes(4)
+    gi.add_edges(toindex([0, 1, 1, 2, 3]), toindex([1, 2, 0, 3, 1]))
+    csr = _load_csr(gi)
+    for backtracking in [True, False]:
+        lg = csr.line_graph(backtracking)
+        ref = gi.line_graph(backtracking)
+        assert lg.is_readonly()
+        assert lg.number_of_nodes() == ref.number_of_nodes()
+        assert lg.number_of_edges() == ref.number_of_edges()
+        src, dst, _ = ref.edges()
+        assert all(lg.has_edge_between(u, v)
+                   for u, v in zip(src.tonumpy(), dst.tonumpy()))
+
+def test_line_graph_skewed():
+    # a hub on a long path, so the cost per vertex is heavily skewed
+    n = 300
+    src = list(range(1, n)) + [0] * (n - 1) + list(range(1, n - 1))
+    dst = [0] * (n - 1) + list(range(1, n)) + list(range(2, n))
+    gi = create_graph_index()
+    gi.add_nodes(n)
+    gi.add_edges(toindex(src), toindex(dst))
+    for backtracking in [True, False]:
+        lg = gi.line_graph(backtracking)
+        expected = set((i, j) for i in range(len(src)) for j in range(len(src))
+                       if dst[i] == src[j] and (backtracking or dst[j] != src[i]))
+        lsrc, ldst, _ = lg.edges()
+        edges = list(zip(lsrc.tonumpy().tolist(), ldst.tonumpy().tolist()))
+        assert len(edges) == len(expected)
+        assert set(edges) == expected
+
+def test_batch_query():
+    gi = create_graph_index(multigraph=True)
+    gi.add_nodes(4)
+    gi.add_edges(toindex([0, 0, 1, 2, 0]), toindex([1, 2, 2, 3, 1]))
+    ops = [gidx.QUERY_HAS_NODE, gidx.QUERY_HAS_NODE, gidx.QUERY_HAS_EDGE_BETWEEN,
+           gidx.QUERY_HAS_EDGE_BETWEEN, gidx.QUERY_IN_DEGREE, gidx.QUERY_OUT_DEGREE,
+           gidx.QUERY_EDGE_ID, gidx.QUERY_EDGE_ID, gidx.QUERY_NUM_EDGES_BETWEEN,
+           gidx.QUERY_EDGE_SRC, gidx.QUERY_EDGE_DST]
+    arg0 = [3, 4, 0, 3, 2, 0, 0, 1, 0, 3, 3]
+    arg1 = [0, 0, 2, 0, 0, 0, 1, 0, 1, 0, 0]
+    rst = gi.batch_query(toindex(ops), toindex(arg0), toindex(arg1)).tonumpy()
+    assert list(rst) == [1, 0, 1, 0, 2, 3, 0, -1, 2, 2, 3]
+    # results are written into the given array
+    out = np.zeros(len(ops), dtype=np.int64)
+    gi.batch_query(toindex(ops), toindex(arg0), toindex(arg1), out)
+    assert list(out) == list(rst)
+    # out must be filled in place, so copies are refused
+    for bad in [np.zeros(len(ops), dtype=np.int32),
+                np.zeros(2 * len(ops), dtype=np.int64)[::2],
+                np.zeros(len(ops) + 1, dtype=np.int64)]:
+        try:
+            gi.batch_query(toindex(ops), toindex(arg0), toindex(arg1), bad)
+            fail = False
+        except DGLError:
+            fail = True
+        assert fail
+    # invalid queries fail before any result is written
+    try:
+        gi.batch_query(toindex([gidx.QUERY_IN_DEGREE]), toindex([4]), toindex([0]))
+        fail = False
+    except DGLError:
+        fail = True
+    assert fail
+
 if __name__ == '__main__':
     test_edge_id()
     test_nx()
     test_predsucc()
+    test_khop_predsucc()
+    test_reverse()
     test_create_from_elist()
+    test_save_load()
+    test_load_corrupt_header()
+    test_csr_disjoint_union_partition()
+    test_csr_line_graph()
+    test_line_graph_skewed()
+    test_batch_query()
@@ -0,0 +1,78 @@
+import ctypes
+import time
+import numpy as np
+import dgl.ndarray as nd
+from dgl._ffi.base import _LIB
+from dgl._ffi.function import get_global_func
+
+_LIB.DGLBackendAllocWorkspace.restype = ctypes.c_void_p
+_LIB.DGLBackendAllocWorkspace.argtypes = [
+        ctypes.c_int, ctypes.c_int, ctypes.c_uint64, ctypes.c_int, ctypes.c_int]
+_LIB.DGLBackendFreeWorkspace.argtypes = [ctypes.c_int, ctypes.c_int, ctypes.c_void_p]
+_LIB.DGLBackendParallelFirstTouch.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+_FOR_LAMBDA = ctypes.CFUNCTYPE(ctypes.c_int, ctypes.c_int64, ctypes.c_int64, ctypes.c_void_p)
+_LIB.DGLBackendParallelFor.argtypes = [
+        ctypes.c_int64, ctypes.c_int64, ctypes.c_int64, _FOR_LAMBDA, ctypes.c_void_p]
+
+def _alloc_workspace(nbytes):
+    ptr = _LIB.DGLBackendAllocWorkspace(1, 0, nbytes, 0, 8)
+    assert ptr
+    return ptr
+
+def _free_workspace(ptr):
+    assert _LIB.DGLBackendFreeWorkspace(1, 0, ptr) == 0
+
+def test_workspace_reuse():
+    allocated_bytes = get_global_func('runtime.cpu_allocator_allocated_bytes')
+    # both above the huge page size and between the size classes and it
+    for nbytes in [4 << 20, 1 << 20]:
+        ptr = _alloc_workspace(nbytes)
+        _free_workspace(ptr)
+        # the pool keeps the memory after the first round
+        allocated = allocated_bytes()
+        for _ in range(10):
+            ptr2 = _alloc_workspace(nbytes)
+            assert ptr2 == ptr
+            _free_workspace(ptr2)
+            assert allocated_bytes() == allocated
+        # a smaller request reuses the same memory as well
+        ptr2 = _alloc_workspace(nbytes // 2)
+        assert ptr2 == ptr
+        _free_workspace(ptr2)
+        assert allocated_bytes() == allocated
+
+def test_first_touch():
+    # whole pages plus a partial one
+    for nbytes in [0, 100, 4096, (1 << 20) + 100]:
+        buf = np.ones(nbytes + 1, dtype=np.uint8)
+        assert _LIB.DGLBackendParallelFirstTouch(buf.ctypes.data, nbytes) == 0
+        assert not buf[:nbytes].any()
+        assert buf[nbytes] == 1
+    # large CPU arrays come zeroed from Empty
+    arr = nd.empty((17 << 20,), dtype='int32')
+    assert not arr.asnumpy().any()
+
+def test_parallel_for_steal():
+    begin, end, grain = 100, 4100, 8
+    counts = np.zeros(end, dtype=np.int64)
+    def chunk(b, e, _):
+        assert begin <= b < e <= end
+        # the chunks of the first worker are much slower, so the others
+        # run out of work and steal them
+        if b < begin + (end - begin) // 8:
+            time.sleep(0.001)
+        counts[b:e] += 1
+        return 0
+    flambda = _FOR_LAMBDA(chunk)
+    assert _LIB.DGLBackendParallelFor(begin, end, grain, flambda, None) == 0
+    # every index runs exactly once
+    assert not counts[:begin].any()
+    assert (counts[begin:] == 1).all()
+    # a failed chunk fails the loop
+    fail = _FOR_LAMBDA(lambda b, e, _: -1 if b <= 2000 < e else 0)
+    assert _LIB.DGLBackendParallelFor(0, 4000, grain, fail, None) == -1
+
+if __name__ == '__main__':
+    test_workspace_reuse()
+    test_first_touch()
+    test_parallel_for_steal()
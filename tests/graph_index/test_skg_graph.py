@@ -2,7 +2,9 @@ import sys
 sys.path.insert(0,'../../python/build/lib')
 
 import argparse
+import numpy as np
 from dgl import DGLError
+from dgl import backend as F
 from dgl.utils import toindex
 from dgl.graph_index import create_graph_index
 from dgl.skg_graph import create_skg_graph, skg_open_gfs
@@ -169,6 +171,53 @@ def test_new_skg():
     g.print_pred("1");
     g.print_succ("1");
 
+def test_skg_predsucc():
+    src = [0, 0, 2, 3, 1, 4]
+    dst = [1, 2, 0, 0, 4, 2]
+    g = create_skg_graph()
+    g.add_edges(toindex(src), toindex(dst))
+    gi = create_graph_index(list(zip(src, dst)))
+    # the ids seen by DGL do not depend on how the database stores them
+    for v in range(5):
+        assert sorted(g.predecessors(v).tonumpy()) == sorted(gi.predecessors(v).tonumpy())
+        assert sorted(g.successors(v).tonumpy()) == sorted(gi.successors(v).tonumpy())
+
+def test_skg_node_attr():
+    g = create_skg_graph()
+    g.add_edges(toindex([0, 1, 2, 3]), toindex([1, 2, 3, 4]))
+    n = 5
+    columns = [('a_int32', np.int32), ('a_int64', np.int64),
+               ('a_float32', np.float32), ('a_float64', np.float64)]
+    def expected(j, dtype):
+        return (np.arange(n) * 10 + j).astype(dtype)
+    for j, (column, dtype) in enumerate(columns):
+        g.set_node_attr(column, toindex(list(range(n))), expected(j, dtype))
+
+    for j, (column, dtype) in enumerate(columns):
+        # the gather keeps the column type and the order of the nodes
+        vals = F.asnumpy(g.node_attr(column, toindex([4, 0, 2, 2])))
+        assert vals.dtype == dtype
+        assert np.array_equal(vals, expected(j, dtype)[[4, 0, 2, 2]])
+        # nodes beyond the stored ones read as zero
+        vals = F.asnumpy(g.node_attr(column, toindex([1, 100000])))
+        assert vals[0] == expected(j, dtype)[1]
+        assert vals[1] == 0
+        # the whole column, indexed by node id, without copying
+        view = F.asnumpy(g.node_attr(column))
+        assert view.dtype == dtype
+        assert len(view) >= n
+        assert np.array_equal(view[:n], expected(j, dtype))
+
+    # several columns are packed into a float32 [N, D] tensor, one row per node
+    names = [column for column, _ in columns]
+    nodes = [3, 1, 100000]
+    feats = F.asnumpy(g.node_attrs(names, toindex(nodes)))
+    assert feats.shape == (len(nodes), len(names))
+    assert feats.dtype == np.float32
+    for i, vid in enumerate(nodes):
+        for j in range(len(names)):
+            assert feats[i, j] == (np.float32(vid * 10 + j) if vid < n else 0)
+
 def test_open_skg(gname):
     g = skg_open_gfs(gname)
 